@@ -0,0 +1,314 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		bench_kernels					*/
+/*								*/
+/*	bench_kernels.c - micro-benchmarks for hot kernels	*/
+/*								*/
+/*	NAME							*/
+/*	bench_kernels.c - micro-benchmarks for hot kernels	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	bench_kernels -json <file> [-reps <n>] <rhessys options>*/
+/*								*/
+/*	OPTIONS							*/
+/*	-json	file the timings are written to			*/
+/*	-reps	passes over all patches per kernel (default 20)	*/
+/*	all remaining options are handed to			*/
+/*	construct_command_line and must describe a world	*/
+/*	(-w/-whdr/-t/-st/-ed, -r for the routing kernels, ...)	*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Builds the world with construct_world and times each	*/
+/*	kernel over every patch (or stratum), so inputs come	*/
+/*	from real soil and vegetation defaults rather than	*/
+/*	constants.  Kernels that need a routing topology are	*/
+/*	skipped without -r.  update_drainage_land changes	*/
+/*	patch state, so patches are restored from a snapshot	*/
+/*	before every pass and only the kernel is timed.		*/
+/*								*/
+/*	Results are written as JSON: for each kernel, the	*/
+/*	number of calls, total seconds and nanoseconds per	*/
+/*	call, plus a checksum of the results so that a		*/
+/*	regression in the answer is as visible as one in time.	*/
+/*								*/
+/*	Used by bench/run_bench.py (make bench).		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rhessys.h"
+
+struct bench_result {
+	char *name;
+	long calls;
+	double seconds;
+	double checksum;
+};
+
+static double bench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bench_record(struct bench_result *r, char *name, long calls,
+	double seconds, double checksum)
+{
+	r->name = name;
+	r->calls = calls;
+	r->seconds = seconds;
+	r->checksum = checksum;
+	fprintf(stderr, "%-24s %10ld calls %10.3f ns/call\n", name, calls,
+		(calls > 0) ? seconds * 1e9 / calls : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	struct command_line_object *construct_command_line(int, char **);
+	struct world_object *construct_world(struct command_line_object *);
+	double compute_field_capacity(int, int, double, double, double, double,
+		double, double, double, double, double);
+	double compute_varbased_flow(int, double, double, double, double,
+		double *, struct patch_object *);
+	double compute_N_leached(int, double, double, double, double, double,
+		double, double, double, double, double, double, double, double *);
+	double penman_monteith(int, double, double, double, double, double,
+		double, int);
+	int compute_farq_psn(struct psnin_struct *, struct psnout_struct *, int);
+	void update_drainage_land(struct patch_object *,
+		struct command_line_object *, double, int);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int b, h, z, p, c, i, rep, reps, rhessys_argc, num_patches, num_strata, n;
+	char *json_filename;
+	char **rhessys_argv;
+	double start, elapsed, sum;
+	FILE *json;
+	struct command_line_object *command_line;
+	struct world_object *world;
+	struct patch_object **patches, *patch, *snapshot;
+	struct canopy_strata_object **strata, *stratum;
+	struct psnin_struct psnin;
+	struct psnout_struct psnout;
+	struct bench_result results[6];
+
+	/*--------------------------------------------------------------*/
+	/*	Strip our own options, pass the rest to RHESSys.	*/
+	/*--------------------------------------------------------------*/
+	reps = 20;
+	json_filename = NULL;
+	rhessys_argv = (char **) calloc(argc + 1, sizeof(char *));
+	rhessys_argv[0] = argv[0];
+	rhessys_argc = 1;
+	for (i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-json") == 0) && (i + 1 < argc))
+			json_filename = argv[++i];
+		else if ((strcmp(argv[i], "-reps") == 0) && (i + 1 < argc))
+			reps = atoi(argv[++i]);
+		else
+			rhessys_argv[rhessys_argc++] = argv[i];
+	}
+	if ((json_filename == NULL) || (reps < 1)) {
+		fprintf(stderr, "usage: %s -json <file> [-reps <n>] <rhessys options>\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	command_line = construct_command_line(rhessys_argc, rhessys_argv);
+	world = construct_world(command_line);
+
+	/*--------------------------------------------------------------*/
+	/*	Flatten the patch and stratum lists.			*/
+	/*--------------------------------------------------------------*/
+	num_patches = 0;
+	num_strata = 0;
+	for (b = 0; b < world[0].num_basin_files; b++)
+		for (h = 0; h < world[0].basins[b][0].num_hillslopes; h++)
+			for (z = 0; z < world[0].basins[b][0].hillslopes[h][0].num_zones; z++) {
+				struct zone_object *zone = world[0].basins[b][0].hillslopes[h][0].zones[z];
+				num_patches += zone[0].num_patches;
+				for (p = 0; p < zone[0].num_patches; p++)
+					num_strata += zone[0].patches[p][0].num_canopy_strata;
+			}
+	patches = (struct patch_object **) calloc(num_patches + 1, sizeof(struct patch_object *));
+	strata = (struct canopy_strata_object **) calloc(num_strata + 1, sizeof(struct canopy_strata_object *));
+	snapshot = (struct patch_object *) calloc(num_patches + 1, sizeof(struct patch_object));
+	num_patches = 0;
+	num_strata = 0;
+	for (b = 0; b < world[0].num_basin_files; b++)
+		for (h = 0; h < world[0].basins[b][0].num_hillslopes; h++)
+			for (z = 0; z < world[0].basins[b][0].hillslopes[h][0].num_zones; z++) {
+				struct zone_object *zone = world[0].basins[b][0].hillslopes[h][0].zones[z];
+				for (p = 0; p < zone[0].num_patches; p++) {
+					patch = zone[0].patches[p];
+					patches[num_patches++] = patch;
+					for (c = 0; c < patch[0].num_canopy_strata; c++)
+						strata[num_strata++] = patch[0].canopy_strata[c];
+				}
+			}
+	fprintf(stderr, "\nbench_kernels: %d patches, %d strata, %d reps\n",
+		num_patches, num_strata, reps);
+	n = 0;
+
+	/*--------------------------------------------------------------*/
+	/*	compute_field_capacity					*/
+	/*--------------------------------------------------------------*/
+	sum = 0.0;
+	start = bench_now();
+	for (rep = 0; rep < reps; rep++)
+		for (i = 0; i < num_patches; i++) {
+			patch = patches[i];
+			sum += compute_field_capacity(0,
+				patch[0].soil_defaults[0][0].theta_psi_curve,
+				patch[0].soil_defaults[0][0].psi_air_entry,
+				patch[0].soil_defaults[0][0].pore_size_index,
+				patch[0].soil_defaults[0][0].p3,
+				patch[0].soil_defaults[0][0].p4,
+				patch[0].soil_defaults[0][0].porosity_0,
+				patch[0].soil_defaults[0][0].porosity_decay,
+				patch[0].sat_deficit_z,
+				patch[0].sat_deficit_z,
+				0.0);
+		}
+	elapsed = bench_now() - start;
+	bench_record(&results[n++], "compute_field_capacity", (long) reps * num_patches, elapsed, sum);
+
+	/*--------------------------------------------------------------*/
+	/*	penman_monteith over a sweep of weather inputs		*/
+	/*--------------------------------------------------------------*/
+	sum = 0.0;
+	start = bench_now();
+	for (rep = 0; rep < reps; rep++)
+		for (i = 0; i < num_patches; i++) {
+			double Tair = -10.0 + (i % 45);
+			double vpd = 50.0 + 20.0 * (i % 100);
+			sum += penman_monteith(0, Tair, 95000.0, vpd, 50.0 + (i % 500),
+				100.0 + (rep % 10) * 20.0, 20.0 + (i % 30), 2);
+		}
+	elapsed = bench_now() - start;
+	bench_record(&results[n++], "penman_monteith", (long) reps * num_patches, elapsed, sum);
+
+	/*--------------------------------------------------------------*/
+	/*	compute_farq_psn with each stratum's leaf N		*/
+	/*--------------------------------------------------------------*/
+	sum = 0.0;
+	start = bench_now();
+	for (rep = 0; rep < reps; rep++)
+		for (i = 0; i < num_strata; i++) {
+			stratum = strata[i];
+			psnin.c3 = 1;
+			psnin.pa = 95000.0;
+			psnin.co2 = 400.0;
+			psnin.t = 5.0 + (i + rep) % 25;
+			psnin.irad = 200.0 + 50.0 * ((i + rep) % 30);
+			psnin.g = 2.0;
+			psnin.Rd = 0.5;
+			psnin.lnc = (stratum[0].cs.leafc > ZERO) ?
+				stratum[0].ns.leafn / stratum[0].cs.leafc / 20.0 : 0.002;
+			psnin.flnr = 0.1;
+			psnin.netpabs = 0.85;
+			compute_farq_psn(&psnin, &psnout, 1);
+			sum += psnout.A;
+		}
+	elapsed = bench_now() - start;
+	bench_record(&results[n++], "compute_farq_psn", (long) reps * num_strata, elapsed, sum);
+
+	/*--------------------------------------------------------------*/
+	/*	Routing kernels need the flow table.			*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].routing_flag == 1) {
+		sum = 0.0;
+		start = bench_now();
+		for (rep = 0; rep < reps; rep++)
+			for (i = 0; i < num_patches; i++) {
+				patch = patches[i];
+				sum += compute_varbased_flow(
+					patch[0].num_soil_intervals,
+					patch[0].std * command_line[0].std_scale,
+					patch[0].sat_deficit,
+					patch[0].innundation_list[0].gamma,
+					patch[0].soil_defaults[0][0].interval_size,
+					patch[0].transmissivity_profile,
+					patch);
+			}
+		elapsed = bench_now() - start;
+		bench_record(&results[n++], "compute_varbased_flow", (long) reps * num_patches, elapsed, sum);
+
+		sum = 0.0;
+		start = bench_now();
+		for (rep = 0; rep < reps; rep++)
+			for (i = 0; i < num_patches; i++) {
+				patch = patches[i];
+				sum += compute_N_leached(0,
+					patch[0].soil_ns.nitrate + 0.001,
+					0.001 * (1 + i % 10),
+					patch[0].sat_deficit,
+					patch[0].soil_defaults[0][0].soil_water_cap,
+					patch[0].m,
+					patch[0].innundation_list[0].gamma / patch[0].area,
+					patch[0].soil_defaults[0][0].porosity_0,
+					patch[0].soil_defaults[0][0].porosity_decay,
+					patch[0].soil_defaults[0][0].N_decay_rate,
+					patch[0].soil_defaults[0][0].active_zone_z,
+					patch[0].soil_defaults[0][0].soil_depth,
+					patch[0].soil_defaults[0][0].NO3_adsorption_rate,
+					patch[0].transmissivity_profile);
+			}
+		elapsed = bench_now() - start;
+		bench_record(&results[n++], "compute_N_leached", (long) reps * num_patches, elapsed, sum);
+
+		for (i = 0; i < num_patches; i++)
+			snapshot[i] = *patches[i];
+		sum = 0.0;
+		elapsed = 0.0;
+		for (rep = 0; rep < reps; rep++) {
+			for (i = 0; i < num_patches; i++)
+				*patches[i] = snapshot[i];
+			start = bench_now();
+			for (i = 0; i < num_patches; i++)
+				update_drainage_land(patches[i], command_line, 1.0, 0);
+			elapsed += bench_now() - start;
+			for (i = 0; i < num_patches; i++)
+				sum += patches[i][0].Qout;
+		}
+		for (i = 0; i < num_patches; i++)
+			*patches[i] = snapshot[i];
+		bench_record(&results[n++], "update_drainage_land", (long) reps * num_patches, elapsed, sum);
+	}
+	else
+		fprintf(stderr, "bench_kernels: no -r flow table, skipping routing kernels\n");
+
+	/*--------------------------------------------------------------*/
+	/*	Write the results.					*/
+	/*--------------------------------------------------------------*/
+	if ((json = fopen(json_filename, "w")) == NULL) {
+		fprintf(stderr, "FATAL ERROR: cannot open %s\n", json_filename);
+		exit(EXIT_FAILURE);
+	}
+	fprintf(json, "{\"patches\": %d, \"strata\": %d, \"reps\": %d, \"kernels\": {",
+		num_patches, num_strata, reps);
+	for (i = 0; i < n; i++)
+		fprintf(json, "%s\n  \"%s\": {\"calls\": %ld, \"seconds\": %.9f, \"ns_per_call\": %.3f, \"checksum\": %.17g}",
+			(i > 0) ? "," : "", results[i].name, results[i].calls, results[i].seconds,
+			(results[i].calls > 0) ? results[i].seconds * 1e9 / results[i].calls : 0.0,
+			results[i].checksum);
+	fprintf(json, "\n}}\n");
+	fclose(json);
+
+	free(snapshot);
+	free(strata);
+	free(patches);
+	free(rhessys_argv);
+	return(EXIT_SUCCESS);
+}
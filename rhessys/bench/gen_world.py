@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+""" Generate a synthetic RHESSys world for benchmarking
+
+    The world is built by cloning the basin, hillslope, zone, patch and
+    canopy stratum records of an existing worldfile (by default the W8
+    test case in ../Testing) so that every state variable has a realistic
+    value, then laying the patches out on a regular grid:
+
+    - one basin of num_hillslopes hillslopes
+    - each hillslope is a rows x cols grid of zones, each zone split into
+      patches_per_zone equal patches of strata_per_patch strata
+    - every upslope patch drains to the patch in the same position of the
+      zone below it; the bottom row is stream and drains along the row to
+      the hillslope outlet
+
+    Alongside the worldfile, a header, flow table, tec file, base station
+    and daily climate (seasonal, seeded, so runs are reproducible) are
+    written.  All paths inside the generated files are relative to the
+    output directory, so RHESSys must be run from there.
+
+    Usage:
+    gen_world.py --out DIR [--hillslopes N] [--rows N] [--cols N]
+                 [--patches-per-zone N] [--strata-per-patch N]
+                 [--years N] [--start-year YYYY] [--seed N]
+
+    The worldfile and flow table are read back and checked to list the
+    same patches before the generator exits.
+"""
+import argparse
+import math
+import os
+import random
+import shutil
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+TESTING = os.path.normpath(os.path.join(HERE, '..', '..', 'Testing'))
+
+DEFAULT_TEMPLATE = os.path.join(TESTING, 'worldfiles', 'w8TC.world')
+DEFAULT_DEFS = os.path.join(TESTING, 'defs')
+
+NAME = 'bench'
+PATCH_AREA = 900.0
+CELL = 30.0
+BASE_Z = 900.0
+ROW_RISE = 4.0
+GAMMA = 200.0
+
+
+def readTemplate(path):
+    """ Split the first record of each level out of a worldfile
+
+        @return dict mapping level name to a list of (indent, value, name)
+    """
+    with open(path) as f:
+        lines = [l.rstrip('\n') for l in f if l.strip()]
+    fields = []
+    for l in lines:
+        parts = l.split()
+        indent = l[:len(l) - len(l.lstrip())]
+        fields.append((indent, parts[0], parts[1]))
+
+    def block(start, stop):
+        i = next(k for k, f in enumerate(fields) if f[2] == start)
+        j = next(k for k, f in enumerate(fields) if k > i and f[2] == stop)
+        return fields[i:j]
+
+    stratum = block('canopy_strata_ID', 'canopy_strata_n_basestations')
+    stratum.append(next(f for f in fields if f[2] == 'canopy_strata_n_basestations'))
+    return {
+        'world': block('world_ID', 'basin_ID'),
+        'basin': block('basin_ID', 'num_hillslopes'),
+        'hillslope': block('hillslope_ID', 'num_zones'),
+        'zone': block('zone_ID', 'num_patches'),
+        'patch': block('patch_ID', 'num_canopy_strata'),
+        'stratum': stratum,
+    }
+
+
+def emit(out, record, values):
+    """ Write one record, overriding fields named in values """
+    for indent, value, name in record:
+        if name in values:
+            value = values[name]
+        out.write('%s%-31s%s\n' % (indent, value, name))
+
+
+def emitCount(out, record, name, count):
+    """ Write a num_* line at the indentation of the record it precedes """
+    out.write('%s%-31d%s\n' % (record[0][0], count, name))
+
+
+def zoneID(h, r, c, args):
+    return (h + 1) * 100000 + r * args.cols + c + 1
+
+
+def patchID(h, r, c, p, args):
+    """ Patch p of a zone; with one patch per zone this is the zone ID """
+    return ((h + 1) * 100000 + r * args.cols + c) * args.patches_per_zone + p + 1
+
+
+def writeWorld(path, tmpl, args):
+    rng = random.Random(args.seed)
+    satDeficit = float(next(f[1] for f in tmpl['patch'] if f[2] == 'sat_deficit'))
+    with open(path, 'w') as out:
+        emit(out, tmpl['world'], {'world_ID': 1, 'num_basins': 1})
+        emit(out, tmpl['basin'], {'basin_ID': 1, 'basin_n_basestations': 0})
+        emitCount(out, tmpl['basin'], 'num_hillslopes', args.hillslopes)
+        for h in range(args.hillslopes):
+            emit(out, tmpl['hillslope'], {'hillslope_ID': h + 1,
+                                          'hillslope_n_basestations': 0})
+            emitCount(out, tmpl['hillslope'], 'num_zones', args.rows * args.cols)
+            for r in range(args.rows):
+                for c in range(args.cols):
+                    zID = zoneID(h, r, c, args)
+                    x = '%.8f' % (c * CELL)
+                    y = '%.8f' % ((h * args.rows + r) * CELL)
+                    z = '%.8f' % (BASE_Z + r * ROW_RISE + rng.uniform(0, 1))
+                    emit(out, tmpl['zone'], {'zone_ID': zID, 'x': x, 'y': y, 'z': z,
+                                             'area': '%.8f' % PATCH_AREA,
+                                             'zone_n_basestations': 1,
+                                             'zone_basestation_ID': 101})
+                    emitCount(out, tmpl['zone'], 'num_patches', args.patches_per_zone)
+                    for p in range(args.patches_per_zone):
+                        ID = patchID(h, r, c, p, args)
+                        # Perturb the initial stores so patches don't all
+                        # follow the same trajectory
+                        scale = rng.uniform(0.8, 1.2)
+                        emit(out, tmpl['patch'], {
+                            'patch_ID': ID, 'x': x, 'y': y, 'z': z,
+                            'area': '%.8f' % (PATCH_AREA / args.patches_per_zone),
+                            'sat_deficit': '%.8f' % (satDeficit * scale),
+                            'patch_n_basestations': 0})
+                        emitCount(out, tmpl['patch'], 'num_canopy_strata',
+                                  args.strata_per_patch)
+                        for s in range(args.strata_per_patch):
+                            emit(out, tmpl['stratum'], {
+                                'canopy_strata_ID': ID * 10 + s + 1,
+                                'canopy_strata_n_basestations': 0})
+
+
+def writeFlowTable(path, args):
+    """ Grid routing: upslope patches drain down their column, the bottom
+        row is stream and drains along the row to column 0.  Each patch
+        drains to the patch in the same position of the next zone.
+    """
+    area = PATCH_AREA / args.patches_per_zone
+    with open(path, 'w') as out:
+        out.write('%d\n' % args.hillslopes)
+        for h in range(args.hillslopes):
+            hill = h + 1
+            out.write('%d\t%d\n' % (hill, args.rows * args.cols * args.patches_per_zone))
+            # Highest patches first, as the preprocessor writes them
+            for r in reversed(range(args.rows)):
+                for c in range(args.cols):
+                    for p in range(args.patches_per_zone):
+                        ID = patchID(h, r, c, p, args)
+                        acc = (args.rows - r) * area
+                        z = BASE_Z + r * ROW_RISE
+                        if r > 0:
+                            down = [(patchID(h, r - 1, c, p, args), zoneID(h, r - 1, c, args))]
+                            drainage = 0
+                        elif c > 0:
+                            down = [(patchID(h, 0, c - 1, p, args), zoneID(h, 0, c - 1, args))]
+                            drainage = 1
+                        else:
+                            down = []
+                            drainage = 1
+                        out.write('%d %d %d %.1f %.1f %.1f %.0f %.0f %d %.4f %d\n' % (
+                            ID, zoneID(h, r, c, args), hill, c * CELL,
+                            (h * args.rows + r) * CELL, z,
+                            acc, acc, drainage, GAMMA, len(down)))
+                        for d, dz in down:
+                            out.write('\t%d %d %d %.7f\n' % (d, dz, hill, 1.0))
+
+
+def readWorldPatches(path):
+    """ @return set of (patch, zone, hillslope) IDs in a worldfile, and a
+        dict mapping each patch to its number of strata
+    """
+    patches, strata = set(), {}
+    hill = zone = patch = None
+    with open(path) as f:
+        for l in f:
+            parts = l.split()
+            if len(parts) < 2:
+                continue
+            value, name = parts[0], parts[1]
+            if name == 'hillslope_ID':
+                hill = int(value)
+            elif name == 'zone_ID':
+                zone = int(value)
+            elif name == 'patch_ID':
+                patch = int(value)
+                patches.add((patch, zone, hill))
+                strata[patch] = 0
+            elif name == 'canopy_strata_ID':
+                strata[patch] += 1
+    return patches, strata
+
+
+def readFlowTablePatches(path):
+    """ @return set of (patch, zone, hillslope) IDs listed in a flow
+        table, and the set of its edges' destinations
+    """
+    patches, targets = set(), set()
+    with open(path) as f:
+        tokens = f.read().split()
+    pos = 1
+    for _ in range(int(tokens[0])):
+        numPatches = int(tokens[pos + 1])
+        pos += 2
+        for _ in range(numPatches):
+            row = tokens[pos:pos + 11]
+            patches.add((int(row[0]), int(row[1]), int(row[2])))
+            numEdges = int(row[10])
+            pos += 11
+            # A road's cut edge adds one more line
+            if int(row[8]) == 2:
+                numEdges += 1
+            for _ in range(numEdges):
+                edge = tokens[pos:pos + 4]
+                targets.add((int(edge[0]), int(edge[1]), int(edge[2])))
+                pos += 4
+    return patches, targets
+
+
+def checkWorldMatchesFlowTable(worldPath, flowPath, args):
+    """ Exit if the worldfile and flow table do not describe the same
+        patches, or a patch lacks the requested strata
+    """
+    worldPatches, strata = readWorldPatches(worldPath)
+    flowPatches, targets = readFlowTablePatches(flowPath)
+    expected = args.hillslopes * args.rows * args.cols * args.patches_per_zone
+    if len(worldPatches) != expected:
+        raise SystemExit('%s: %d patches, expected %d' % (worldPath, len(worldPatches), expected))
+    if worldPatches != flowPatches:
+        raise SystemExit('%s and %s list different patches' % (worldPath, flowPath))
+    if not targets <= worldPatches:
+        raise SystemExit('%s drains to patches not in %s' % (flowPath, worldPath))
+    if any(n != args.strata_per_patch for n in strata.values()):
+        raise SystemExit('%s: patches without %d strata' % (worldPath, args.strata_per_patch))
+
+
+def writeHeader(path, defs):
+    with open(path, 'w') as out:
+        for kind in ('basin', 'hill', 'zone', 'soil', 'lu', 'veg'):
+            names = sorted(d for d in defs if d.startswith(kind))
+            out.write('%d \n' % len(names))
+            for d in names:
+                suffix = {'zone': ' zone_default_filename',
+                          'veg': ' veg_default_filename'}.get(kind, '')
+                out.write('defs/%s%s\n' % (d, suffix))
+        out.write('1 \nclim/%s_base\n' % NAME)
+
+
+def writeClimate(dirname, args):
+    with open(os.path.join(dirname, '%s_base' % NAME), 'w') as out:
+        out.write('101  base_station_id\n'
+                  '100.0 x_coordinate\n'
+                  '100.0 y_coordinate\n'
+                  '%.1f z_coordinate\n'
+                  '3.5  effective_lai\n'
+                  '160.0 screen_height\n'
+                  'clim/%s_annual	annual_climate_prefix\n'
+                  '0			number_non_critical_annual_sequences\n'
+                  'clim/%s_monthly 	monthly_climate_prefix\n'
+                  '0			number_non_critical_monthly_sequences\n'
+                  'clim/%s_daily	daily_climate_prefix\n'
+                  '0\n'
+                  'clim/%s_hourly 	hourly_climate_prefix\n'
+                  '0			number_non_critical_hourly_sequences\n'
+                  % (BASE_Z, NAME, NAME, NAME, NAME))
+
+    rng = random.Random(args.seed + 1)
+    # One extra year so the run never reads past the end
+    days = int(366 * (args.years + 1))
+    rain, tmax, tmin = [], [], []
+    for d in range(days):
+        season = math.cos(2 * math.pi * (d - 200) / 365.25)
+        hi = 14.0 + 12.0 * season + rng.gauss(0, 3)
+        lo = hi - 8.0 - rng.uniform(0, 6)
+        wet = rng.random() < 0.35 - 0.2 * season
+        rain.append(rng.expovariate(1 / 0.008) if wet else 0.0)
+        tmax.append(hi)
+        tmin.append(lo)
+    for ext, series in (('rain', rain), ('tmax', tmax), ('tmin', tmin)):
+        with open(os.path.join(dirname, '%s_daily.%s' % (NAME, ext)), 'w') as out:
+            out.write('%d 1 1 1\n' % args.start_year)
+            out.write(''.join('%.4f\n' % v for v in series))
+
+
+def writeTec(path, args):
+    with open(path, 'w') as out:
+        out.write('%d 1 1 1 print_daily_on\n' % args.start_year)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a synthetic RHESSys world')
+    parser.add_argument('--out', required=True, help='output directory')
+    parser.add_argument('--hillslopes', type=int, default=4)
+    parser.add_argument('--rows', type=int, default=10)
+    parser.add_argument('--cols', type=int, default=10)
+    parser.add_argument('--patches-per-zone', type=int, default=1)
+    parser.add_argument('--strata-per-patch', type=int, default=1,
+                        help='at most 9, as stratum IDs are patch ID * 10 + n')
+    parser.add_argument('--years', type=int, default=1)
+    parser.add_argument('--start-year', type=int, default=2000)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--template', default=DEFAULT_TEMPLATE)
+    parser.add_argument('--defs', default=DEFAULT_DEFS)
+    args = parser.parse_args()
+    if args.patches_per_zone < 1 or not 1 <= args.strata_per_patch <= 9:
+        parser.error('--patches-per-zone must be at least 1 and '
+                     '--strata-per-patch between 1 and 9')
+
+    tmpl = readTemplate(args.template)
+    for d in ('worldfiles', 'flowtables', 'tecfiles', 'clim', 'out'):
+        os.makedirs(os.path.join(args.out, d), exist_ok=True)
+    defsOut = os.path.join(args.out, 'defs')
+    if os.path.exists(defsOut):
+        shutil.rmtree(defsOut)
+    shutil.copytree(args.defs, defsOut)
+
+    worldPath = os.path.join(args.out, 'worldfiles', NAME + '.world')
+    flowPath = os.path.join(args.out, 'flowtables', NAME + '.flow')
+    writeWorld(worldPath, tmpl, args)
+    writeHeader(os.path.join(args.out, 'worldfiles', NAME + '.hdr'), sorted(os.listdir(defsOut)))
+    writeFlowTable(flowPath, args)
+    checkWorldMatchesFlowTable(worldPath, flowPath, args)
+    writeClimate(os.path.join(args.out, 'clim'), args)
+    writeTec(os.path.join(args.out, 'tecfiles', NAME + '.tec'), args)
+
+    print('%s: %d patches' % (args.out, args.hillslopes * args.rows * args.cols
+                              * args.patches_per_zone))
+
+
+if __name__ == '__main__':
+    main()
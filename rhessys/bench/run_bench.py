@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+""" Run the RHESSys benchmark suite and write the results as JSON
+
+    For each world size the suite
+    - generates a synthetic world with gen_world.py
+    - runs bench_kernels on it for per-kernel timings
+    - times end-to-end runs of the model for each flag combination
+
+    OpenMP is a build option (make openmp=T), so the threading variant
+    reruns each combination with OMP_NUM_THREADS=1 and with every core;
+    on a serial build the two timings are the same.
+
+    Results are keyed by commit so files from different revisions can be
+    compared directly.
+
+    Usage (normally via make bench):
+    run_bench.py --rhessys ./rhessys7.3 --kernels bench/bench_kernels
+                 [--out bench/results.json] [--sizes small,medium]
+                 [--repeat N] [--workdir DIR]
+"""
+import argparse
+import datetime
+import json
+import os
+import platform
+import shlex
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# hillslopes, rows, cols, years
+SIZES = {
+    'small': (4, 10, 10, 1),
+    'medium': (16, 25, 25, 1),
+    'large': (64, 40, 40, 1),
+}
+
+# Calibration from the W8 functional test
+BASE_ARGS = '-b -s 0.812 58.038 -sv 0.812 58.038 -gw 0.042 0.716'
+
+VARIANTS = [
+    ('base', ''),
+    ('grow', '-g'),
+    ('routing', '-r flowtables/bench.flow'),
+    ('grow_routing', '-g -r flowtables/bench.flow'),
+]
+
+
+def gitCommit():
+    try:
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'], cwd=HERE,
+                                       stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def worldArgs(years, startYear=2000):
+    return ('-t tecfiles/bench.tec -w worldfiles/bench.world -whdr worldfiles/bench.hdr '
+            '-st %d 1 1 1 -ed %d 1 1 1 -pre out/bench' % (startYear, startYear + years))
+
+
+def timeRun(cmd, cwd, env):
+    """ @return wall seconds of one run; raises if the model fails """
+    start = time.monotonic()
+    with open(os.path.join(cwd, 'out', 'run.log'), 'w') as log:
+        subprocess.check_call(cmd, cwd=cwd, env=env, stdout=log, stderr=subprocess.STDOUT)
+    return time.monotonic() - start
+
+
+def benchSize(name, args):
+    hillslopes, rows, cols, years = SIZES[name]
+    worldDir = os.path.join(args.workdir, name)
+    subprocess.check_call([sys.executable, os.path.join(HERE, 'gen_world.py'), '--out', worldDir,
+                           '--hillslopes', str(hillslopes), '--rows', str(rows),
+                           '--cols', str(cols), '--years', str(years)])
+    result = {'patches': hillslopes * rows * cols, 'years': years}
+
+    # Kernels, with the flow table so routing kernels are included
+    kernelsJson = os.path.join(worldDir, 'out', 'kernels.json')
+    cmd = [args.kernels, '-json', kernelsJson, '-reps', str(args.reps)] + \
+        shlex.split(worldArgs(years) + ' ' + BASE_ARGS + ' -r flowtables/bench.flow')
+    timeRun(cmd, worldDir, os.environ.copy())
+    with open(kernelsJson) as f:
+        result['kernels'] = json.load(f)['kernels']
+
+    # End to end
+    threads = sorted(set([1, os.cpu_count() or 1]))
+    result['runs'] = {}
+    for variant, flags in VARIANTS:
+        for t in threads:
+            env = os.environ.copy()
+            env['OMP_NUM_THREADS'] = str(t)
+            cmd = [args.rhessys] + shlex.split(worldArgs(years) + ' ' + BASE_ARGS + ' ' + flags)
+            times = [timeRun(cmd, worldDir, env) for _ in range(args.repeat)]
+            key = '%s_t%d' % (variant, t)
+            result['runs'][key] = {'flags': flags, 'threads': t,
+                                   'seconds': min(times), 'all_seconds': times}
+            print('%-8s %-20s %8.3f s' % (name, key, min(times)))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run the RHESSys benchmarks')
+    parser.add_argument('--rhessys', required=True, help='RHESSys binary')
+    parser.add_argument('--kernels', required=True, help='bench_kernels binary')
+    parser.add_argument('--out', default=os.path.join(HERE, 'results.json'))
+    parser.add_argument('--sizes', default='small,medium')
+    parser.add_argument('--repeat', type=int, default=3, help='runs per variant, best is kept')
+    parser.add_argument('--reps', type=int, default=20, help='kernel passes over the world')
+    parser.add_argument('--workdir', default=os.path.join(HERE, 'worlds'))
+    args = parser.parse_args()
+    args.rhessys = os.path.abspath(args.rhessys)
+    args.kernels = os.path.abspath(args.kernels)
+
+    results = {
+        'commit': gitCommit(),
+        'date': datetime.datetime.now().isoformat(timespec='seconds'),
+        'host': platform.node(),
+        'machine': platform.machine(),
+        'cpus': os.cpu_count(),
+        'sizes': {},
+    }
+    for name in args.sizes.split(','):
+        if name not in SIZES:
+            parser.error('unknown size %s (choose from %s)' % (name, ', '.join(SIZES)))
+        results['sizes'][name] = benchSize(name, args)
+
+    with open(args.out, 'w') as f:
+        json.dump(results, f, indent=2)
+    print('wrote %s' % args.out)
+
+
+if __name__ == '__main__':
+    main()
@@ -44,6 +44,7 @@
 #include <math.h>
 #include <openmp.h>
 #include "rhessys.h"
+#include "profile.h"
 
 void	basin_daily_F(
 					  long	day,
@@ -72,12 +73,7 @@ void	basin_daily_F(
 		struct stream_network_object *,
 		int, struct	date);
 
-	void	update_basin_patch_accumulator(
-		struct command_line_object *command_line,
-		struct basin_object *basin,
-		struct date current_date);
-
-	void	update_hillslope_accumulator(
+	void	reduce_basin_accumulator(
 		struct command_line_object *command_line,
 		struct basin_object *basin);
 	/*--------------------------------------------------------------*/
@@ -100,12 +96,12 @@ void	basin_daily_F(
 	/*--------------------------------------------------------------*/
 	/*	Simulate the hillslopes in this basin for the whole day		*/
 	/*--------------------------------------------------------------*/
-    #pragma omp parallel for                                                     //schedule(dynamic) num_threads(4)
+    #pragma omp parallel for schedule(dynamic,1)
     for (int h = 0 ; h < basin[0].num_hillslopes; h ++ ){
 		hillslope_daily_F(	day,
 			world,
 			basin,
-			basin[0].hillslopes[h],
+			basin[0].hillslopes[basin[0].hillslope_order[h]],
 			command_line, 
 			event,
 			current_date );
@@ -123,24 +119,21 @@ void	basin_daily_F(
 	/*      the basin                                               */
 	/*--------------------------------------------------------------*/
     	if ( command_line[0].stream_routing_flag == 1) {
+		 PROFILE_BEGIN(PROFILE_STREAM_ROUTING);
 		 basin[0].stream_list.streamflow=compute_stream_routing(command_line,
 			basin[0].stream_list.stream_network,
 			basin[0].stream_list.num_reaches,
                         current_date);
+		 PROFILE_END(PROFILE_STREAM_ROUTING);
 	}
 
 	/*--------------------------------------------------------------*/
-	/* update basin patch accumulator				*/
-	/*--------------------------------------------------------------*/
-	update_basin_patch_accumulator(command_line,
-					basin,
-					current_date);
-
-	/*--------------------------------------------------------------*/
-	/* update hillslope accumulator					*/
+	/* add the hillslopes' shares to the basin accumulator		*/
+	/* (patch and hillslope accumulators are updated at the end	*/
+	/* of hillslope_daily_F)					*/
 	/*--------------------------------------------------------------*/
-    update_hillslope_accumulator(command_line,
-                    basin);
+	reduce_basin_accumulator(command_line,
+					basin);
 
 	return;
 } /*end basin_daily_F*/
@@ -66,47 +66,40 @@ void		basin_daily_I(
 		struct	command_line_object *,
 		struct	tec_entry *,
 		struct	date );
+	double	compute_daylength(double, double, double);
+	void	construct_solar_table(struct basin_object *);
+	void	schedule_hillslopes(struct basin_object *);
 	
 	/*--------------------------------------------------------------*/
-	/*  Local variable definition.                                  */
+	/*	Daylength (seconds), from the basin solar table when	*/
+	/*	the year day is in range (see compute_solar_geometry.c)	*/
 	/*--------------------------------------------------------------*/
-	double	cosegeom;
-	double	sinegeom;
-	double	coshss;
-	double	hss;
-   
-	/*--------------------------------------------------------------*/
-	/*	Daylength (seconds)											*/
-	/*	Now using GBGC computation taken from Jones,		*/
-	/*	Plans and Microclimate.					*/
-	/*	Note that I am assuming this is the time when the solar		*/
-	/*		zenith angle has a cosine >0.   						*/
-	/*	Note that we may want to consider daylengths with both		*/
-	/*		diffuse and direct irradiance and only diffuse irradianc*/
-	/*		This can be computed using the zone level horizons.		*/
-	/*--------------------------------------------------------------*/
-	cosegeom = cos(basin[0].latitude*DtoR) * world[0].cos_declin;
-	sinegeom = sin(basin[0].latitude*DtoR) * world[0].sin_declin;
-	coshss = -(sinegeom) / cosegeom;
-	if (coshss < -1.0) coshss = -1.0; /* 24-hr daylight */
-	if (coshss > 1.0) coshss = 1.0;   /* 0-hr daylight */
-	hss = acos(coshss);  /* hour angle at sunset (radians) */
-	basin[0].daylength= 2.0 * hss * SECPERRAD;
+	if ((basin[0].solar_table != NULL)
+		&& (basin[0].solar_table[0].latitude != basin[0].latitude))
+		construct_solar_table(basin);
+	if ((basin[0].solar_table != NULL) && (world[0].year_day >= 1)
+		&& (world[0].year_day <= SOLAR_TABLE_DAYS))
+		basin[0].daylength = basin[0].solar_table[0].daylength[world[0].year_day - 1];
+	else
+		basin[0].daylength = compute_daylength(basin[0].latitude,
+			world[0].cos_declin, world[0].sin_declin);
 	/*--------------------------------------------------------------*/
 	/*	Find solar zenith angle at noon (not elevation angle)	*/
 	/*	Form Linacre.						*/
 	/*--------------------------------------------------------------*/
 	basin[0].theta_noon =  basin[0].latitude*DtoR - world[0].declin;
 	/*--------------------------------------------------------------*/
-	/*	Simulate the hillslopes in this basin for the whole day		*/
+	/*	Simulate the hillslopes in this basin for the whole day,	*/
+	/*	most expensive first (see schedule_hillslopes.c)		*/
 	/*--------------------------------------------------------------*/
-    #pragma omp parallel for
+	schedule_hillslopes(basin);
+    #pragma omp parallel for schedule(dynamic,1)
     for (int hillslope = 0 ; hillslope < basin[0].num_hillslopes; hillslope ++ ){
 		hillslope_daily_I(
 			day,
 			world,
 			basin,
-			basin[0].hillslopes[hillslope],
+			basin[0].hillslopes[basin[0].hillslope_order[hillslope]],
 			command_line,
 			event,
 			current_date );
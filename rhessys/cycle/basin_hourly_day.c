@@ -0,0 +1,114 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*						basin_hourly_day.c						*/
+/* 																*/
+/*	basin_hourly_day - performs basin cycling for all 24 hours	*/
+/*					of a day in one pass						*/
+/*																*/
+/*	NAME														*/
+/*																*/
+/*	basin_hourly_day - performs basin cycling for all 24 hours	*/
+/*					of a day in one pass						*/
+/*																*/
+/*	SYNOPSIS													*/
+/*																*/
+/*	void	basin_hourly_day( 									*/
+/*					struct  world_object    *,					*/
+/*					struct  basin_object    *,					*/
+/*					struct  command_line_object *,				*/
+/*					struct  tec_entry       *,					*/
+/*					struct  date );								*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Daily-only counterpart of 24 calls to basin_hourly.  Used	*/
+/*	by execute_tec when no zone has hourly forcing, no hourly	*/
+/*	output is requested and no tec event falls inside the day	*/
+/*	(see world_hourly_day).										*/
+/*																*/
+/*	Without hourly forcing hillslopes do not interact within	*/
+/*	the hourly pass: the only basin level input is the solar	*/
+/*	geometry, which depends on year day and hour alone.  So		*/
+/*	the day's 24 geometry entries are taken from the basin		*/
+/*	solar table once and each hillslope then runs its own 24	*/
+/*	hours back to back, rather than the whole basin being		*/
+/*	walked once per hour.  Every patch sees exactly the same	*/
+/*	sequence of hourly updates as it would through				*/
+/*	basin_hourly.												*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	current_date.hour is expected to be 1 on entry.				*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void	basin_hourly_day(
+						 struct	world_object	*world,
+						 struct 	basin_object 	*basin,
+						 struct 	command_line_object *command_line,
+						 struct	tec_entry		*event,
+						 struct	date	current_date)
+{
+	/*--------------------------------------------------------------*/
+	/*  Local Function Declarations.                                */
+	/*--------------------------------------------------------------*/
+	void    hillslope_hourly (
+		struct world_object *,
+		struct basin_object *,
+		struct hillslope_object *,
+		struct basin_hourly_object *,
+		struct command_line_object *,
+		struct tec_entry *,
+		struct date);
+	
+	void	compute_basin_solar_geometry(double, double, double, double,
+		int, struct basin_hourly_object *);
+	void	construct_solar_table(struct basin_object *);
+
+	/*--------------------------------------------------------------*/
+	/*  Local variable definition.                                  */
+	/*--------------------------------------------------------------*/
+	int	hour;
+	struct	basin_hourly_object	day_geometry[SOLAR_TABLE_HOURS];
+
+	/*--------------------------------------------------------------*/
+	/*	Solar geometry for each hour of the day, as basin_hourly	*/
+	/*	would set it.												*/
+	/*--------------------------------------------------------------*/
+	if ((basin[0].solar_table != NULL)
+		&& (basin[0].solar_table[0].latitude != basin[0].latitude))
+		construct_solar_table(basin);
+	for ( hour = 1; hour <= SOLAR_TABLE_HOURS; hour++ ){
+		if ((basin[0].solar_table != NULL)
+			&& (world[0].year_day >= 1) && (world[0].year_day <= SOLAR_TABLE_DAYS))
+			day_geometry[hour-1] = basin[0].solar_table[0].hourly
+				[world[0].year_day - 1][hour - 1];
+		else
+			compute_basin_solar_geometry(world[0].cos_declin, world[0].sin_declin,
+				basin[0].cos_latitude, basin[0].sin_latitude,
+				hour, &(day_geometry[hour-1]));
+	}
+	/*--------------------------------------------------------------*/
+	/*	Simulate the hillslopes, each through the whole day.		*/
+	/*--------------------------------------------------------------*/
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int hillslope=0 ; hillslope < basin[0].num_hillslopes ;hillslope++ ){
+		struct	date	hour_date = current_date;
+		for ( hour_date.hour = 1; hour_date.hour <= SOLAR_TABLE_HOURS; hour_date.hour++ ){
+			hillslope_hourly(
+				world,
+				basin,
+				basin[0].hillslopes[basin[0].hillslope_order[hillslope]],
+				&(day_geometry[hour_date.hour-1]),
+				command_line,
+				event,
+				hour_date);
+		}
+	}
+	return;
+} /*end basin_hourly_day.c*/
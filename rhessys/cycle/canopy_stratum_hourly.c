@@ -47,7 +47,8 @@ void	canopy_stratum_hourly(
 	/*--------------------------------------------------------------*/
 	/*	Local Function Declaration				*/
 	/*--------------------------------------------------------------*/
-	void	*alloc(	size_t, char *, char *);
+	void	reset_hourly_scratch(void *, size_t);
+	void	release_hourly_scratch(void *, size_t);
 
 	double compute_hourly_rain_stored(
 		int,
@@ -66,11 +67,11 @@ void	canopy_stratum_hourly(
 	NO3_throughfall=0;
 
 	/*--------------------------------------------------------------*/
-	/*	Create canopy stratum hourly object.						*/
+	/*	Reset the canopy stratum hourly object (see		*/
+	/*	construct_hourly_arena).				*/
 	/*--------------------------------------------------------------*/
-	stratum[0].hourly = (struct canopy_strata_hourly_object*)
-		alloc(1 * sizeof(struct canopy_strata_hourly_object),
-		"hourly","canopy_stratum_hourly");
+	reset_hourly_scratch(stratum[0].hourly,
+		sizeof(struct canopy_strata_hourly_object));
 	rain_throughfall = patch[0].hourly[0].rain_throughfall;
 	if ((zone[0].hourly_rain_flag == 1) && ( rain_throughfall > 0.0)) {
 		stratum[0].rain_stored = compute_hourly_rain_stored(
@@ -120,8 +121,9 @@ void	canopy_stratum_hourly(
 
 	
 	/*--------------------------------------------------------------*/
-	/*	Destroy the canopy stratum hourly object.					*/
+	/*	Release the canopy stratum hourly object.					*/
 	/*--------------------------------------------------------------*/
-	free( stratum[0].hourly );
+	release_hourly_scratch(stratum[0].hourly,
+		sizeof(struct canopy_strata_hourly_object));
 	return;
 } /*end canopy_stratum_hourly.c*/
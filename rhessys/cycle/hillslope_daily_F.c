@@ -46,6 +46,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "profile.h"
 
 void		hillslope_daily_F(
 							  long	day,
@@ -86,24 +87,58 @@ void		hillslope_daily_F(
 		struct hillslope_object *,
 		struct  zone_object ** ,
 		struct	date );
+
+	double	schedule_clock(void);
+
+	void	update_basin_patch_accumulator(
+		struct command_line_object *,
+		struct basin_object *,
+		struct hillslope_object *,
+		struct date);
+
+	void	update_hillslope_accumulator(
+		struct command_line_object *,
+		struct hillslope_object *);
+
+	void	add_zone_gw_drainage(
+		struct hillslope_object *);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
-	int	i,j,zone;
+	int	i,j,chunk;
 	double slow_store, fast_store,scale;
+	double	start;
 	struct patch_object *patch;
 	
-	
-	for ( zone=0 ; zone<hillslope[0].num_zones; zone++ ){
-		zone_daily_F(	day,
-			world,
-			basin,
-			hillslope,
-			hillslope[0].zones[zone],
-			command_line,
-			event,
-			current_date );
+	/*--------------------------------------------------------------*/
+	/*	Zones are run in chunks, as tasks when the hillslope is	*/
+	/*	split; each chunk's time goes into the hillslope cost	*/
+	/*	used by schedule_hillslopes().				*/
+	/*--------------------------------------------------------------*/
+	for ( chunk=0 ; chunk<hillslope[0].num_zone_chunks; chunk++ ){
+		#pragma omp task if(hillslope[0].split_flag) firstprivate(chunk)
+		{
+			double	chunk_start = schedule_clock();
+			for (int zone = hillslope[0].zone_chunk_start[chunk];
+				zone < hillslope[0].zone_chunk_start[chunk+1]; zone++ ){
+				PROFILE_BEGIN(PROFILE_ZONE_DAILY_F);
+				zone_daily_F(	day,
+					world,
+					basin,
+					hillslope,
+					hillslope[0].zones[zone],
+					command_line,
+					event,
+					current_date );
+				PROFILE_END(PROFILE_ZONE_DAILY_F);
+			}
+			#pragma omp atomic
+			hillslope[0].measured_cost += schedule_clock() - chunk_start;
+		}
 	}
+	#pragma omp taskwait
+	add_zone_gw_drainage(hillslope);
+	start = schedule_clock();
 	/*----------------------------------------------------------------------*/
 	/*  baseflow calculations                                               */
 	/*----------------------------------------------------------------------*/
@@ -131,33 +166,47 @@ void		hillslope_daily_F(
 	/*      the hillslope                                           */
 	/*--------------------------------------------------------------*/
     if ( command_line[0].routing_flag == 1 && hillslope[0].zones[0]->hourly_rain_flag == 0) {
+		  PROFILE_BEGIN(PROFILE_SUBSURFACE_ROUTING);
 		  compute_subsurface_routing(
         command_line,
 			  hillslope,
 			  basin[0].defaults[0][0].n_routing_timesteps,
 			  current_date
       );
+		  PROFILE_END(PROFILE_SUBSURFACE_ROUTING);
     }
+	hillslope[0].measured_cost += schedule_clock() - start;
 
 	/*----------------------------------------------------------------------*/
 	/*	accumulate monthly and yearly streamflow variables		*/
 	/*----------------------------------------------------------------------*/
 	scale = hillslope[0].area / basin[0].area;
 	if((command_line[0].output_flags.monthly == 1)&&(command_line[0].b != NULL)){
-		basin[0].acc_month.streamflow += (hillslope[0].base_flow) * scale;
-		basin[0].acc_month.stream_NO3 += (hillslope[0].streamflow_NO3) * scale;
-		basin[0].acc_month.stream_NH4 += (hillslope[0].streamflow_NH4) * scale;
-		basin[0].acc_month.stream_DON += (hillslope[0].streamflow_DON) * scale;
-		basin[0].acc_month.stream_DOC += (hillslope[0].streamflow_DOC) * scale;
+		hillslope[0].basin_acc_month.streamflow += (hillslope[0].base_flow) * scale;
+		hillslope[0].basin_acc_month.stream_NO3 += (hillslope[0].streamflow_NO3) * scale;
+		hillslope[0].basin_acc_month.stream_NH4 += (hillslope[0].streamflow_NH4) * scale;
+		hillslope[0].basin_acc_month.stream_DON += (hillslope[0].streamflow_DON) * scale;
+		hillslope[0].basin_acc_month.stream_DOC += (hillslope[0].streamflow_DOC) * scale;
 		}
 	if((command_line[0].output_flags.yearly == 1)&&(command_line[0].b != NULL)){
-		basin[0].acc_year.streamflow += (hillslope[0].base_flow) * scale;
-		basin[0].acc_year.stream_NO3 += (hillslope[0].streamflow_NO3) * scale;
-		basin[0].acc_year.stream_NH4 += (hillslope[0].streamflow_NH4) * scale;
-		basin[0].acc_year.stream_DON += (hillslope[0].streamflow_DON) * scale;
-		basin[0].acc_year.stream_DOC += (hillslope[0].streamflow_DOC) * scale;
+		hillslope[0].basin_acc_year.streamflow += (hillslope[0].base_flow) * scale;
+		hillslope[0].basin_acc_year.stream_NO3 += (hillslope[0].streamflow_NO3) * scale;
+		hillslope[0].basin_acc_year.stream_NH4 += (hillslope[0].streamflow_NH4) * scale;
+		hillslope[0].basin_acc_year.stream_DON += (hillslope[0].streamflow_DON) * scale;
+		hillslope[0].basin_acc_year.stream_DOC += (hillslope[0].streamflow_DOC) * scale;
 		}
 
+	/*--------------------------------------------------------------*/
+	/*	update this hillslope's patch, hillslope and basin	*/
+	/*	accumulators while its patches are still in cache	*/
+	/*--------------------------------------------------------------*/
+	update_basin_patch_accumulator(command_line,
+		basin,
+		hillslope,
+		current_date);
+	update_hillslope_accumulator(command_line,
+		hillslope);
+
 
 	return;
 } /*end hillslope_daily_F.c*/
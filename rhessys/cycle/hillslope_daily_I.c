@@ -72,7 +72,7 @@ void		hillslope_daily_I(
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
-	int zone;
+	int chunk;
 	/*--------------------------------------------------------------*/
 	/* zero hillslope hydro fluxes					*/
 	/*--------------------------------------------------------------*/
@@ -100,16 +100,24 @@ void		hillslope_daily_I(
 	/*	processes for all objects of a level; before switching to	*/
 	/*	hourly processes for objects below it; however this woukld 	*/
 	/*	mean storing all of the (numerous) daily parameters .		*/
+	/*								*/
+	/*	Zones are run in chunks, as tasks when the hillslope is	*/
+	/*	split (see schedule_hillslopes.c).			*/
 	/*--------------------------------------------------------------*/
-	for ( zone=0 ; zone<hillslope[0].num_zones; zone++ ){
-		zone_daily_I( 	day,
-			world,
-			basin,
-			hillslope,
-			hillslope[0].zones[zone],
-			command_line,
-			event,
-			current_date );
+	for ( chunk=0 ; chunk<hillslope[0].num_zone_chunks; chunk++ ){
+		#pragma omp task if(hillslope[0].split_flag) firstprivate(chunk)
+		for (int zone = hillslope[0].zone_chunk_start[chunk];
+			zone < hillslope[0].zone_chunk_start[chunk+1]; zone++ ){
+			zone_daily_I( 	day,
+				world,
+				basin,
+				hillslope,
+				hillslope[0].zones[zone],
+				command_line,
+				event,
+				current_date );
+		}
 	}
+	#pragma omp taskwait
 	return;
 } /*end hillslopee_daily_I.c*/
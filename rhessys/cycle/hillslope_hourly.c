@@ -12,6 +12,7 @@
 /*					struct	world_object		*,				*/
 /*					struct	basin_object		*,				*/
 /*					struct 	hillslope_object 	*,				*/
+/*					struct	basin_hourly_object	*,				*/
 /*					struct 	command_line_object *,				*/
 /*					struct 	tec_entry 			*,				*/
 /*					struct 	date 				);				*/
@@ -42,6 +43,7 @@ void		hillslope_hourly(
 							 struct	world_object		*world,
 							 struct	basin_object		*basin,
 							 struct 	hillslope_object 	*hillslope,
+							 struct	basin_hourly_object	*geometry,
 							 struct 	command_line_object *command_line,
 							 struct 	tec_entry 			*event,
 							 struct 	date 				current_date)
@@ -54,6 +56,7 @@ void		hillslope_hourly(
 		struct basin_object *,
 		struct hillslope_object *,
 		struct zone_object *,
+		struct basin_hourly_object *,
 		struct command_line_object *,
 		struct tec_entry *,
 		struct date);
@@ -64,24 +67,23 @@ void		hillslope_hourly(
 		int n_timesteps, 
 		struct date current_date);
 
+	void	reset_hourly_scratch(void *, size_t);
+	void	release_hourly_scratch(void *, size_t);
+	void	add_zone_gw_drainage(struct hillslope_object *);
 
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
-	int	zone, i, j;
+	int	chunk, i, j;
 	double	slow_store, fast_store;
 	double  hourly_gw_Qout;
 	double	gw_Qout_ratio;
 	struct patch_object *patch;
 	
 	/*--------------------------------------------------------------*/
-	/*	Allocate the hillslope houly parameter array.				*/
+	/*	Reset the hillslope houly parameter array.				*/
 	/*--------------------------------------------------------------*/
-	if ( (hillslope[0].hourly = (struct hillslope_hourly_object *)
-		calloc(1,sizeof(struct hillslope_hourly_object))) == NULL ){
-		fprintf(stderr,"FATAL ERROR: in hillslope_hourly\n");
-		exit(EXIT_FAILURE);
-	}
+	reset_hourly_scratch(hillslope[0].hourly, sizeof(struct hillslope_hourly_object));
 	/*--------------------------------------------------------------*/
 	/* do redistribution of saturated zone at patch level based on 	*/
 	/* previous time steps hillslope level soilwater 				*/
@@ -90,29 +92,37 @@ void		hillslope_hourly(
 	/* an alternative to TOPMODEL could go here (with a flag)		*/
 	/*--------------------------------------------------------------*/
 	/*--------------------------------------------------------------*/
-	/*	Simulate zones requested.								*/
+	/*	Simulate zones requested, in chunks (as tasks when the	*/
+	/*	hillslope is split, see schedule_hillslopes.c).		*/
 	/*--------------------------------------------------------------*/
-	for ( zone=0 ; zone < hillslope[0].num_zones ; zone++ ){
-		if ( hillslope[0].zones[zone][0].Kdown_diffuse > 1.0e100)
-			printf("\n Date %d %d %d %d is Zone Hourly Diffuse is %10.6f",
-			current_date.year,
-			current_date.month,
-			current_date.day,
-			current_date.hour,
-			hillslope[0].zones[zone][0].Kdown_diffuse);
-		zone_hourly(
-			world,
-			basin,
-			hillslope,
-			hillslope[0].zones[zone],
-			command_line,
-			event,
-			current_date );
+	for ( chunk=0 ; chunk < hillslope[0].num_zone_chunks ; chunk++ ){
+		#pragma omp task if(hillslope[0].split_flag) firstprivate(chunk)
+		for (int zone = hillslope[0].zone_chunk_start[chunk];
+			zone < hillslope[0].zone_chunk_start[chunk+1]; zone++ ){
+			if ( hillslope[0].zones[zone][0].Kdown_diffuse > 1.0e100)
+				printf("\n Date %d %d %d %d is Zone Hourly Diffuse is %10.6f",
+				current_date.year,
+				current_date.month,
+				current_date.day,
+				current_date.hour,
+				hillslope[0].zones[zone][0].Kdown_diffuse);
+			zone_hourly(
+				world,
+				basin,
+				hillslope,
+				hillslope[0].zones[zone],
+				geometry,
+				command_line,
+				event,
+				current_date );
+		}
 	}
+	#pragma omp taskwait
+	add_zone_gw_drainage(hillslope);
 	/*--------------------------------------------------------------*/
-	/*	Destroy the hillslope hourloy object.						*/
+	/*	Release the hillslope hourly object.						*/
 	/*--------------------------------------------------------------*/
-	free( hillslope[0].hourly );
+	release_hourly_scratch(hillslope[0].hourly, sizeof(struct hillslope_hourly_object));
 
 	/*--------------------------------------------------------------*/
 	/*	do subsurface routing					*/
@@ -77,6 +77,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "rhessys.h"
+#include "profile.h"
 
 void		patch_daily_F(
 						  struct	world_object	*world,
@@ -91,6 +92,8 @@ void		patch_daily_F(
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	double	compute_sat_deficit_z(struct soil_default *, double);
+	double	compute_sat_deficit(struct soil_default *, double);
 	double compute_delta_water(int, double, double,	double, double, double);
 	
 	
@@ -427,6 +430,7 @@ void		patch_daily_F(
 	double 	surfaceN_to_soil;
 	double	FERT_TO_SOIL;
 	double	pond_height;
+	double	preday_lai;
 	double tmpra, tmpga, tmpgasnow, tmpwind, tmpwindcan, tmpwindsnow, tmpustar;
 	double Kup_direct_snow, Kup_diffuse_snow;
 	double Kdown_direct_covered, Kdown_diffuse_covered, Kdown_direct_exposed, Kdown_diffuse_exposed;
@@ -795,6 +799,7 @@ void		patch_daily_F(
 			/*--------------------------------------------------------------*/
 			for ( stratum=0 ; stratum<patch[0].layers[layer].count; stratum++ ){
 
+					PROFILE_BEGIN(PROFILE_CANOPY_STRATUM_DAILY_F);
 					canopy_stratum_daily_F(
 						world,
 						basin,
@@ -807,6 +812,7 @@ void		patch_daily_F(
 						command_line,
 						event,
 						current_date );
+					PROFILE_END(PROFILE_CANOPY_STRATUM_DAILY_F);
 				
 				dum += 1;
 			}
@@ -1127,6 +1133,7 @@ void		patch_daily_F(
 			patch[0].T_canopy_final = patch[0].layers[layer].null_cover * patch[0].T_canopy;
 			for ( stratum=0 ;stratum<patch[0].layers[layer].count; stratum++ ){
 
+					PROFILE_BEGIN(PROFILE_CANOPY_STRATUM_DAILY_F);
 					canopy_stratum_daily_F(
 						world,
 						basin,
@@ -1139,6 +1146,7 @@ void		patch_daily_F(
 						command_line,
 						event,
 						current_date );
+					PROFILE_END(PROFILE_CANOPY_STRATUM_DAILY_F);
 			}
 			patch[0].Kdown_direct = patch[0].Kdown_direct_final;
 			patch[0].Kdown_diffuse = patch[0].Kdown_diffuse_final;
@@ -1176,6 +1184,7 @@ void		patch_daily_F(
 			for ( stratum=0 ; stratum<patch[0].layers[layer].count; stratum++ ){
 
 
+					PROFILE_BEGIN(PROFILE_CANOPY_STRATUM_DAILY_F);
 					canopy_stratum_daily_F(
 						world,
 						basin,
@@ -1188,6 +1197,7 @@ void		patch_daily_F(
 						command_line,
 						event,
 						current_date );
+					PROFILE_END(PROFILE_CANOPY_STRATUM_DAILY_F);
 			}
 			patch[0].Kdown_direct = patch[0].Kdown_direct_final;
 			patch[0].Kdown_diffuse = patch[0].Kdown_diffuse_final;
@@ -1503,6 +1513,7 @@ void		patch_daily_F(
 	patch[0].net_plant_psn = 0.0;
 	patch[0].totalc = 0.0;
 	patch[0].totaln = 0.0;
+	preday_lai = patch[0].lai;
 	patch[0].lai = 0.0;
 	unsat_zone_patch_demand = patch[0].exfiltration_unsat_zone;
 	sat_zone_patch_demand = patch[0].exfiltration_sat_zone;
@@ -1624,13 +1635,8 @@ void		patch_daily_F(
 	/*-------------------------------------------------------------------------*/
 	/*	Compute current actual depth to water table				*/
 	/*-------------------------------------------------------------------------*/
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * patch[0].sat_deficit);
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit);
 
 	
 	available_sat_water = min((compute_delta_water(
@@ -1644,13 +1650,8 @@ void		patch_daily_F(
 	available_sat_water = max(available_sat_water, 0.0);
 
 	temp = patch[0].sat_deficit_z;
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * (patch[0].sat_deficit+available_sat_water));
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit+available_sat_water);
 
 	/* to prevent instability if available sat water is close to soil depth  don't allow its use */
 	if ((patch[0].soil_defaults[0][0].soil_depth - patch[0].sat_deficit_z) < ZERO) {
@@ -1990,6 +1991,7 @@ void		patch_daily_F(
 			patch[0].rootzone.depth = max(patch[0].rootzone.depth,strata->rootzone.depth);
 		}
 	}
+	patch[0].zone[0].lai_sum += (patch[0].lai - preday_lai) * patch[0].area;
 
 
 
@@ -2023,13 +2025,8 @@ void		patch_daily_F(
 	/*-------------------------------------------------------------------------*/
 	/*	Compute current actual depth to water table				*/
 	/*------------------------------------------------------------------------*/
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * patch[0].sat_deficit);
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit);
 
 	/*--------------------------------------------------------------*/
 	/*      Recompute patch soil moisture storage                   */
@@ -2111,12 +2108,8 @@ void		patch_daily_F(
 	/*  re-Compute potential saturation for rootzone layer   */
 	/*-----------------------------------------------------*/			
 	if (patch[0].rootzone.depth > ZERO)
-		patch[0].rootzone.potential_sat = compute_delta_water(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		patch[0].rootzone.depth, 0.0);			
+		patch[0].rootzone.potential_sat = compute_sat_deficit(patch[0].soil_defaults[0],
+			patch[0].rootzone.depth);			
 
 	patch[0].delta_snowpack = patch[0].snowpack.water_depth
 		+ patch[0].snowpack.water_equivalent_depth - patch[0].preday_snowpack;
@@ -2128,13 +2121,8 @@ void		patch_daily_F(
 	/*------------------------------------------------------------------------*/
 	/*	Compute current actual depth to water table				*/
 	/*------------------------------------------------------------------------*/
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * patch[0].sat_deficit);
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit);
 
 	theta = patch[0].rootzone.S;
 	patch[0].theta_std = (patch[0].soil_defaults[0][0].theta_mean_std_p2*theta*theta + 
@@ -2209,9 +2197,13 @@ void		patch_daily_F(
 
 	/* track variables for snow assimilation  */
 	if (patch[0].snowpack.water_equivalent_depth > ZERO) {
+		#pragma omp atomic
 		basin[0].snowpack.energy_deficit += patch[0].snowpack.energy_deficit * patch[0].area;
+		#pragma omp atomic
 		basin[0].snowpack.surface_age += patch[0].snowpack.surface_age * patch[0].area;
+		#pragma omp atomic
 		basin[0].snowpack.T += patch[0].snowpack.T * patch[0].area;
+		#pragma omp atomic
 		basin[0].area_withsnow += patch[0].area;
 		}
 
@@ -102,6 +102,7 @@ void		patch_daily_I(
 		double);
 	
 	
+	double	compute_sat_deficit(struct soil_default *, double);
 	double	compute_delta_water(
 		int,
 		double,
@@ -183,6 +184,7 @@ void		patch_daily_I(
 	int	layer, inx, rec;
 	int	stratum;
 	double	cnt, count, theta;
+	double	preday_effective_lai, preday_total_stemc, preday_height;
 	
 	double  edible_leafc, grazing_mean_nc, grazing_Closs;
 	double root_growth, water_transfer;
@@ -207,12 +209,8 @@ void		patch_daily_I(
 	/*  Compute potential saturation for rootzone layer   */
 	/*-----------------------------------------------------*/			
 	if (patch[0].rootzone.depth > ZERO)  {
-	patch[0].rootzone.potential_sat = compute_delta_water(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		patch[0].rootzone.depth, 0.0);			
+	patch[0].rootzone.potential_sat = compute_sat_deficit(patch[0].soil_defaults[0],
+		patch[0].rootzone.depth);			
 	 if (patch[0].rootzone.potential_sat > ZERO)
 		if (patch[0].sat_deficit_z > patch[0].rootzone.depth)	
 		patch[0].rootzone.S = patch[0].rz_storage/patch[0].rootzone.potential_sat;
@@ -474,6 +472,9 @@ void		patch_daily_I(
 	/*	also determine total plant carbon			*/
 	/*	- if grow option is specified				*/
 	/*--------------------------------------------------------------*/
+	preday_effective_lai = patch[0].effective_lai;
+	preday_total_stemc = patch[0].total_stemc;
+	preday_height = patch[0].height;
 	patch[0].effective_lai = 0.0;
 	patch[0].total_stemc = 0.0; //New
 	patch[0].height = 0.0;
@@ -503,6 +504,15 @@ void		patch_daily_I(
 			 patch[0].canopy_strata[stratum][0].rootzone.depth);
 	}
 	patch[0].effective_lai = patch[0].effective_lai / patch[0].num_canopy_strata;
+	/*--------------------------------------------------------------*/
+	/*	keep the zone's area weighted sums (zone_daily_F) current	*/
+	/*--------------------------------------------------------------*/
+	patch[0].zone[0].effective_lai_sum
+		+= (patch[0].effective_lai - preday_effective_lai) * patch[0].area;
+	patch[0].zone[0].total_stemc_sum
+		+= (patch[0].total_stemc - preday_total_stemc) * patch[0].area;
+	patch[0].zone[0].height_sum
+		+= (patch[0].height - preday_height) * patch[0].area;
 	
 	/*--------------------------------------------------------------*/
 	/*	re-sort patch layers to account for any changes in 	*/
@@ -57,6 +57,8 @@ void		patch_hourly(
 		struct tec_entry *,
 		struct date);
 	
+	double	compute_sat_deficit_z(struct soil_default *, double);
+	double	compute_sat_deficit(struct soil_default *, double);
 	double	compute_delta_water(
 		int,
 		double,
@@ -378,13 +380,8 @@ void		patch_hourly(
 	/*-------------------------------------------------------------------------*/
 	/*	Compute current actual depth to water table				*/
 	/*------------------------------------------------------------------------*/
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * patch[0].sat_deficit);
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit);
 
 	/*--------------------------------------------------------------*/
 	/*	compute new field capacity				*/
@@ -438,13 +435,8 @@ void		patch_hourly(
 	/*-------------------------------------------------------------------------*/
 	/*	Compute current actual depth to water table				*/
 	/*------------------------------------------------------------------------*/
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * patch[0].sat_deficit);	
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit);	
 
 
 	/*--------------------------------------------------------------*/
@@ -529,23 +521,14 @@ void		patch_hourly(
 	/*  re-Compute potential saturation for rootzone layer   */
 	/*-----------------------------------------------------*/			
 	if (patch[0].rootzone.depth > ZERO)
-		patch[0].rootzone.potential_sat = compute_delta_water(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		patch[0].rootzone.depth, 0.0);	
+		patch[0].rootzone.potential_sat = compute_sat_deficit(patch[0].soil_defaults[0],
+			patch[0].rootzone.depth);	
 
 	/*------------------------------------------------------------------------*/
 	/*	Compute current actual depth to water table				*/
 	/*------------------------------------------------------------------------*/
-	patch[0].sat_deficit_z = compute_z_final(
-		command_line[0].verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		0.0,
-		-1.0 * patch[0].sat_deficit);
+	patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+		patch[0].sat_deficit);
 
 	theta = patch[0].rootzone.S;
 	patch[0].theta_std = (patch[0].soil_defaults[0][0].theta_mean_std_p2*theta*theta + 
@@ -47,19 +47,17 @@ void		world_hourly(
 		struct command_line_object *,
 		struct tec_entry *,
 		struct date);
+	void	reset_hourly_scratch(void *, size_t);
+	void	release_hourly_scratch(void *, size_t);
 	
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
 	int	basin;
 	/*--------------------------------------------------------------*/
-	/*	Create world hourly parameter array.						*/
+	/*	Reset world hourly parameter array.						*/
 	/*--------------------------------------------------------------*/
-	if ( (world[0].hourly = (struct world_hourly_object *)
-		calloc(1,sizeof(struct world_hourly_object))) == NULL ){
-		fprintf(stderr,"FATAL ERROR: in simulate_world_hourly\n");
-		exit(EXIT_FAILURE);
-	}
+	reset_hourly_scratch(world[0].hourly, sizeof(struct world_hourly_object));
 	/*--------------------------------------------------------------*/
 	/*	Simulate the basins											*/
 	/*--------------------------------------------------------------*/
@@ -72,8 +70,8 @@ void		world_hourly(
 			current_date);
 	}
 	/*--------------------------------------------------------------*/
-	/*	Destory world hourly object									*/
+	/*	Release world hourly object									*/
 	/*--------------------------------------------------------------*/
-	free ( world[0].hourly );
+	release_hourly_scratch(world[0].hourly, sizeof(struct world_hourly_object));
 	return;
 } /*end world_hourly.c*/
@@ -0,0 +1,121 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*						world_hourly_day						*/
+/*																*/
+/*	NAME														*/
+/*	world_hourly_day 											*/
+/*				 - performs the 24 hourly cycles of a day		*/
+/*				   in one pass over the world					*/
+/*																*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void world_hourly_day 										*/
+/*				(  struct world_object *,						*/
+/*					struct command_line_object *,				*/
+/*					struct tec_entry *,							*/
+/*					struct date)								*/
+/*																*/
+/*	int world_daily_only( struct world_object *,				*/
+/*					struct command_line_object *)				*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	When nothing in a run is hourly - no base station used by	*/
+/*	a zone has hourly rain and no hourly output is on - the		*/
+/*	hourly cycle of each hillslope depends only on that			*/
+/*	hillslope and the basin solar geometry.  execute_tec then	*/
+/*	calls world_hourly_day once at hour 1 instead of calling	*/
+/*	world_hourly 24 times, and basin_hourly_day runs each		*/
+/*	hillslope through the day while its zones and patches are	*/
+/*	still in cache.  Results are identical to the hourly loop.	*/
+/*																*/
+/*	world_daily_only reports whether the run qualifies.  Hourly	*/
+/*	climate is fixed for the run, but hourly output can be		*/
+/*	switched on by a tec event, so execute_tec checks the		*/
+/*	output flags again every day.								*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	The per-hour hillslope routing (hillslope_hourly) only		*/
+/*	runs with hourly rain and would couple hours across the		*/
+/*	basin; it never runs on this path.							*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void		world_hourly_day(
+						 struct world_object *world,
+						 struct command_line_object *command_line,
+						 struct tec_entry *event,
+						 struct date current_date)
+{
+	/*--------------------------------------------------------------*/
+	/*  Local Function Declarations.                                */
+	/*--------------------------------------------------------------*/
+	void	basin_hourly_day (
+		struct world_object *,
+		struct basin_object *,
+		struct command_line_object *,
+		struct tec_entry *,
+		struct date);
+	void	reset_hourly_scratch(void *, size_t);
+	void	release_hourly_scratch(void *, size_t);
+	
+	/*--------------------------------------------------------------*/
+	/*  Local variable definition.                                  */
+	/*--------------------------------------------------------------*/
+	int	basin;
+	/*--------------------------------------------------------------*/
+	/*	Reset world hourly parameter array.						*/
+	/*--------------------------------------------------------------*/
+	reset_hourly_scratch(world[0].hourly, sizeof(struct world_hourly_object));
+	/*--------------------------------------------------------------*/
+	/*	Simulate the basins											*/
+	/*--------------------------------------------------------------*/
+	for ( basin = 0 ; basin < world[0].num_basin_files ; basin++ ){
+		basin_hourly_day(
+			world,
+			world[0].basins[basin],
+			command_line,
+			event,
+			current_date);
+	}
+	/*--------------------------------------------------------------*/
+	/*	Release world hourly object									*/
+	/*--------------------------------------------------------------*/
+	release_hourly_scratch(world[0].hourly, sizeof(struct world_hourly_object));
+	return;
+} /*end world_hourly_day*/
+
+int		world_daily_only(
+						 struct world_object *world,
+						 struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*  Local variable definition.                                  */
+	/*--------------------------------------------------------------*/
+	int	b, h, z;
+	struct	basin_object	*basin;
+	struct	hillslope_object	*hillslope;
+	struct	zone_object	*zone;
+
+	if ((command_line[0].output_flags.hourly == 1)
+		|| (command_line[0].output_flags.hourly_growth == 1))
+		return(0);
+	for ( b = 0 ; b < world[0].num_basin_files ; b++ ){
+		basin = world[0].basins[b];
+		for ( h = 0 ; h < basin[0].num_hillslopes ; h++ ){
+			hillslope = basin[0].hillslopes[h];
+			for ( z = 0 ; z < hillslope[0].num_zones ; z++ ){
+				zone = hillslope[0].zones[z];
+				if ( zone[0].base_stations[0][0].hourly_clim[0].rain_slots.value != NULL )
+					return(0);
+			}
+		}
+	}
+	return(1);
+} /*end world_daily_only*/
@@ -124,6 +124,7 @@
 #include <math.h>
 
 #include "rhessys.h"
+#include "profile.h"
 #include "phys_constants.h"
 #include "functions.h"
 
@@ -155,6 +156,7 @@ void		zone_daily_F(
 	void 	compute_patch_family_routing(
   		struct 	zone_object 	*,
 		struct	command_line_object *);
+	void	update_zone_canopy_sums(struct zone_object *);
 	void	compute_family_shading(
 		struct	zone_object	*,
 		struct	command_line_object	*);
@@ -379,29 +381,14 @@ void		zone_daily_F(
 		/*		zone lai.												*/
 		/*--------------------------------------------------------------*/
 		
-		zone[0].effective_lai = 0.0; //calculate zone level LAI and use it as target
-		zone[0].lai = 0.0;
-		zone[0].total_stemc = 0.0;
-		zone[0].height = 0.0;
-		for ( patch=0 ; patch<zone[0].num_patches ; patch++ ){
-		  zone[0].effective_lai
-		    += zone[0].patches[patch][0].effective_lai
-		   * zone[0].patches[patch][0].area;
-		  zone[0].lai
-		    += zone[0].patches[patch][0].lai
-		    * zone[0].patches[patch][0].area;
-		  zone[0].total_stemc
-		    += zone[0].patches[patch][0].total_stemc
-		    * zone[0].patches[patch][0].area;
-		  zone[0].height
-		    += zone[0].patches[patch][0].height
-		    * zone[0].patches[patch][0].area;
-		        
-		}
-		zone[0].effective_lai = zone[0].effective_lai / zone[0].area;
-		zone[0].lai = zone[0].lai / zone[0].area;
-		zone[0].total_stemc = zone[0].total_stemc / zone[0].area;
-		zone[0].height = zone[0].height / zone[0].area;
+		//calculate zone level LAI and use it as target
+		/*--------------------------------------------------------------*/
+		/*	patch_daily_I and patch_daily_F add each patch's change	*/
+		/*	to the zone sums as they go; every			*/
+		/*	ZONE_CANOPY_RESYNC_DAYS the sums are redone from the	*/
+		/*	patches so rounding in the updates cannot build up.	*/
+		/*--------------------------------------------------------------*/
+		update_zone_canopy_sums(zone);
 		
 		//if ( zone[0].radrat <  1.0 ){
 		//	zone[0].LAI_temp_adjustment
@@ -652,6 +639,7 @@ void		zone_daily_F(
 	/*	Cycle through the patches for day end computations		    	*/
 	/*--------------------------------------------------------------*/
 	for ( patch=0 ; patch<zone[0].num_patches; patch++ ){
+		PROFILE_BEGIN(PROFILE_PATCH_DAILY_F);
 		patch_daily_F(
 			world,
 			basin,
@@ -661,6 +649,7 @@ void		zone_daily_F(
 			command_line,
 			event,
 			current_date );
+		PROFILE_END(PROFILE_PATCH_DAILY_F);
 
 	  if(command_line[0].vegspinup_flag > 0){
       if (zone[0].patches[patch]->target_status == 0){
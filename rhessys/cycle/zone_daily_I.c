@@ -172,7 +172,7 @@ void zone_daily_I(
 
 	double unifdist(double, double);
 
-	long  julday(struct date);
+	int	hourly_clim_day_has_event(struct hourly_clim_slots *, struct date);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
@@ -186,8 +186,6 @@ void zone_daily_I(
 	int		season;
 	season = 0;
 
-	int	inx;
-	struct	dated_sequence	clim_event;
 	int num_world_base_stations;
 
 
@@ -460,13 +458,12 @@ void zone_daily_I(
 			zone[0].rain_duration = temp * 3600;
 		}
 	}
-	inx = zone[0].base_stations[0][0].hourly_clim[0].rain.inx;
-	if (inx==0){inx=-1;}
-	if(inx>-999){
-		clim_event=zone[0].base_stations[0][0].hourly_clim[0].rain.seq[inx+1];
-		if ((clim_event.edate.year!=0)&&(julday(clim_event.edate)==julday(current_date))){
-			zone[0].rain_duration = 0;
-		}
+	/*--------------------------------------------------------------*/
+	/*	with hourly rain today zone_hourly counts the duration		*/
+	/*--------------------------------------------------------------*/
+	if (hourly_clim_day_has_event(
+		&(zone[0].base_stations[0][0].hourly_clim[0].rain_slots), current_date)){
+		zone[0].rain_duration = 0;
 	}
 
 
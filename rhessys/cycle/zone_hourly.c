@@ -13,6 +13,7 @@
 /*						 struct basin_object *	,				*/
 /*						 struct hillslope_object *	,			*/
 /*						 struct zone_object *	,				*/
+/*						 struct basin_hourly_object *,			*/
 /*						 struct command_line_object * ,			*/
 /*						 struct tec_entry *,					*/
 /*						 struct date) 							*/
@@ -25,6 +26,10 @@
 /*	intervals in the zone.  The routine also prints out results	*/
 /*	where specified by current tec events files.				*/
 /*																*/
+/*	geometry is the basin solar geometry for this hour; it is	*/
+/*	passed in rather than read from basin.hourly so that		*/
+/*	basin_hourly_day can run all 24 hours of a hillslope		*/
+/*	without a shared per-hour basin object.						*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
@@ -48,6 +53,7 @@ void		zone_hourly(
 						struct	basin_object	*basin,
 						struct	hillslope_object	*hillslope,
 						struct 	zone_object 	*zone,
+						struct	basin_hourly_object	*geometry,
 						struct 	command_line_object *command_line,
 						struct	tec_entry		*event,
 						struct 	date 			current_date)
@@ -66,15 +72,16 @@ void		zone_hourly(
 		struct date);
 	
 	void	*alloc(	size_t, char *, char *);
-	long  julday( struct date );
+	double	hourly_clim_value(struct hourly_clim_slots *, struct date);
+	void	compute_zone_solar_coefs(struct zone_object *, struct basin_object *);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
 	int 	patch;
-	int	inx;
 	double	Kdown_direct_flat_toa;
 	double	temp;
-	struct	dated_sequence	clim_event;
+	double	clim_value;
+	struct	hourly_clim_object	*hourly_clim;
 	double 	snow_rain_range;
 	/*--------------------------------------------------------------*/
 	/* 	check for hourly precipitation data			*/
@@ -83,20 +90,13 @@ void		zone_hourly(
 	zone[0].hourly_rain_flag = 0;
 	zone[0].hourly[0].rain = 0.0;
 	zone[0].hourly[0].snow = 0.0; 
-	inx = zone[0].base_stations[0][0].hourly_clim[0].rain.inx;
+	hourly_clim = zone[0].base_stations[0][0].hourly_clim;
 
-	if (inx > -999)  {
-		clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain.seq[inx];
-		while (clim_event.edate.year!=0 && (julday(clim_event.edate) + clim_event.edate.hour/24.0 < julday(current_date) + current_date.hour/24.0)) {
-			zone[0].base_stations[0][0].hourly_clim[0].rain.inx += 1;
-			inx = zone[0].base_stations[0][0].hourly_clim[0].rain.inx;
-			clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain.seq[inx];
-			}
-		
-		if ( (clim_event.edate.year != 0) &&
-			(julday(clim_event.edate) == julday(current_date)) && (clim_event.edate.hour == current_date.hour) ) {
+	if (hourly_clim[0].rain_slots.value != NULL)  {
+		clim_value = hourly_clim_value(&(hourly_clim[0].rain_slots), current_date);
+		if ( clim_value != -999.0 ) {
 			zone[0].hourly_rain_flag = 1;
-			zone[0].hourly[0].rain = clim_event.value;
+			zone[0].hourly[0].rain = clim_value;
 
 			/*--------------------------------------------------------------*/
 			/*if there is hourly input, turn daily rain to 0 		*/
@@ -165,22 +165,14 @@ void		zone_hourly(
 			}
 			
 
-			inx = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.inx;
 			/*--------------------------------------------------------------*/
 			/* 	check for corresponding duration data			*/
 			/*	if not there assume full hour				*/
 			/*--------------------------------------------------------------*/
-			if (inx > -999) {
-				clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.seq[inx];
-				while (julday(clim_event.edate) + clim_event.edate.hour/24.0 < julday(current_date) + current_date.hour/24.0) {
-					zone[0].base_stations[0][0].hourly_clim[0].rain_duration.inx += 1;
-					inx = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.inx;
-					clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.seq[inx];
-					}
-				if ( (julday(clim_event.edate) == julday(current_date)) && (clim_event.edate.hour == current_date.hour) ) {
-					zone[0].hourly[0].rain_duration = clim_event.value;
-				}
-				else zone[0].hourly[0].rain_duration = 3600;
+			clim_value = hourly_clim_value(&(hourly_clim[0].rain_duration_slots),
+				current_date);
+			if ( clim_value != -999.0 ) {
+				zone[0].hourly[0].rain_duration = clim_value;
 			}
 			else zone[0].hourly[0].rain_duration = 3600;
 		}
@@ -218,12 +210,12 @@ void		zone_hourly(
 		/*  It is likely that Kdown_diffuse is non-zero even if         */
 		/*  cos_sza < 0 but we ignore this for now.                     */
 		/*--------------------------------------------------------------*/
-		if ( basin[0].hourly[0].cos_sza  > 0 ){
+		if ( geometry[0].cos_sza  > 0 ){
 			/*--------------------------------------------------------------*/
 			/*		Atmospheric attenuation to direct radiation	(no units)  */
 			/*--------------------------------------------------------------*/
 			zone[0].hourly[0].direct_attenuation
-				= pow( zone[0].atm_trans, basin[0].hourly[0].optical_air_mass);
+				= pow( zone[0].atm_trans, geometry[0].optical_air_mass);
 			/*--------------------------------------------------------------*/
 			/*		Downwelling total irradiance at BOA along sza			*/
 			/*		W / m ** 2  = W /m ** 2  								*/
@@ -234,7 +226,7 @@ void		zone_hourly(
 				printf("\n Io(W/m^2)= %f, Atm_trans= %f, air_mass= %f direct_att= %f Kdown_BOA(W/m^2)= %f ",
 				world[0].Io,
 				zone[0].atm_trans,
-				basin[0].hourly[0].optical_air_mass,
+				geometry[0].optical_air_mass,
 				zone[0].hourly[0].direct_attenuation,
 				zone[0].hourly[0].Kdown_BOA);
 			/*--------------------------------------------------------------*/
@@ -264,8 +256,8 @@ void		zone_hourly(
 			/*	the zone is still in shade.  We should decide if we should	*/
 			/*	define daylength (and horizons) based on basin or zone.		*/
 			/*--------------------------------------------------------------*/
-			if ( (basin[0].hourly[0].cos_sza > zone[0].e_horizon) &&
-				(basin[0].hourly[0].cos_sza > zone[0].w_horizon) ){
+			if ( (geometry[0].cos_sza > zone[0].e_horizon) &&
+				(geometry[0].cos_sza > zone[0].w_horizon) ){
 				/*--------------------------------------------------------------*/
 				/*	Increment zone daylength				*/
 				/*--------------------------------------------------------------*/
@@ -281,22 +273,22 @@ void		zone_hourly(
 					/*     Required to adjust max temp.                            */
 					/*-------------------------------------------------------------*/
 					zone[0].hourly[0].Kdown_direct_flat
-						= basin[0].hourly[0].cos_sza * zone[0].hourly[0].Kdown_BOA;
+						= geometry[0].cos_sza * zone[0].hourly[0].Kdown_BOA;
 					/*-------------------------------------------------------------*/
 					/*     Cosine of beam slope angle. (no units)                  */
 					/*                                                             */
 					/*     Eq. 8 Appendix D of "MTCLIM"                            */
+					/*     The slope, aspect and latitude terms are cached  */
+					/*     on the zone (compute_solar_geometry.c)           */
 					/*-------------------------------------------------------------*/
+					if (!zone[0].solar_coefs_valid)
+						compute_zone_solar_coefs(zone, basin);
 					zone[0].hourly[0].cos_beam_slope
-						= -1 * zone[0].sin_slope * zone[0].sin_aspect
-						* basin[0].hourly[0].cos_declin_sin_hourangle
-						+ ( -1 * zone[0].cos_aspect * zone[0].sin_slope
-						* basin[0].sin_latitude + zone[0].cos_slope
-						* basin[0].cos_latitude)
-						* basin[0].hourly[0].cos_declin_cos_hourangle
-						+( zone[0].cos_aspect * zone[0].sin_slope
-						* basin[0].cos_latitude + zone[0].cos_slope
-						* basin[0].sin_latitude ) * world[0].sin_declin;
+						= zone[0].beam_slope_coef[0]
+						* geometry[0].cos_declin_sin_hourangle
+						+ zone[0].beam_slope_coef[1]
+						* geometry[0].cos_declin_cos_hourangle
+						+ zone[0].beam_slope_coef[2] * world[0].sin_declin;
 					/*-------------------------------------------------------------*/
 					/*	if sun angle is below the slope angle then		*/
 					/*	hill is blocking sun and Kdown_direct is zero		*/
@@ -331,10 +323,10 @@ void		zone_hourly(
 							= temp * (1.0 - temp / Kdown_direct_flat_toa);
 					zone[0].hourly[0].Kdown_diffuse
 						= zone[0].hourly[0].Kdown_diffuse_flat
-						* pow(cos(zone[0].slope/2.0),2.0);
+						* zone[0].diffuse_view_factor;
 					if ( command_line[0].verbose_flag > 5 )
 						printf("\n-111.3 cos_sza : %8.4f Kdown_dir_flat= %8.4f Kdown_dif_flat= %8.4f ",
-						basin[0].hourly[0].cos_sza,
+						geometry[0].cos_sza,
 						zone[0].hourly[0].Kdown_direct_flat,
 						zone[0].hourly[0].Kdown_diffuse_flat);
 					if ( command_line[0].verbose_flag > 5 )
@@ -0,0 +1,55 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		add_zone_gw_drainage				*/
+/*								*/
+/*	NAME							*/
+/*	add_zone_gw_drainage.c - add the zones' drainage to	*/
+/*		the hillslope groundwater store			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void add_zone_gw_drainage(				*/
+/*			struct hillslope_object *hillslope)	*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	update_gw_drainage sums each patch's drainage to	*/
+/*	groundwater (water, DON, DOC, NH4 and NO3) into its	*/
+/*	zone's gw_drainage.  Called by hillslope_daily_F and	*/
+/*	hillslope_hourly once all of the hillslope's zones	*/
+/*	have run, this adds the zone sums to the hillslope's	*/
+/*	gw in zone order and clears them.			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	The zones of a split hillslope run as concurrent tasks	*/
+/*	(see schedule_hillslopes.c), so they cannot add to the	*/
+/*	hillslope's gw directly.  Adding in zone order gives	*/
+/*	the same sums whether or not the hillslope is split.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void add_zone_gw_drainage(struct hillslope_object *hillslope)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int z;
+	struct gw_drainage_object *drainage;
+
+	for ( z=0 ; z<hillslope[0].num_zones ; z++ ){
+		drainage = &(hillslope[0].zones[z][0].gw_drainage);
+		hillslope[0].gw.storage += drainage[0].storage;
+		hillslope[0].gw.NO3 += drainage[0].NO3;
+		hillslope[0].gw.NH4 += drainage[0].NH4;
+		hillslope[0].gw.DOC += drainage[0].DOC;
+		hillslope[0].gw.DON += drainage[0].DON;
+		drainage[0].storage = 0.0;
+		drainage[0].NO3 = 0.0;
+		drainage[0].NH4 = 0.0;
+		drainage[0].DOC = 0.0;
+		drainage[0].DON = 0.0;
+	}
+	return;
+} /*end add_zone_gw_drainage.c*/
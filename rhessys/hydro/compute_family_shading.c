@@ -85,6 +85,7 @@ void compute_family_shading(    struct zone_object *zone,
                 if (command_line[0].verbose_flag == -6) printf("Strata %d | height %f |\n", s, zone[0].patch_families[pf][0].patches[i][0].canopy_strata[s][0].epv.height);
 		
             }
+            zone[0].patch_families[pf][0].patches[i][0].tallest_stratum = maxs;
 
             // max/avg of family
             max_height = max(max_height, height);
@@ -112,16 +113,8 @@ void compute_family_shading(    struct zone_object *zone,
         /*--------------------------------------------------------------*/
         for (i = 0; i < zone[0].patch_families[pf][0].num_patches_in_fam ; i++)
         {
-            // get index of  highest  strata
-	    maxs=0;
-	    strata_max_height=0.0;
-            for (s = 0; s < zone[0].patch_families[pf][0].patches[i][0].num_canopy_strata; s++)
-            {
-                strata_max_height = max(strata_max_height, zone[0].patch_families[pf][0].patches[i][0].canopy_strata[s][0].epv.height);
-		if (zone[0].patch_families[pf][0].patches[i][0].canopy_strata[s][0].epv.height >= strata_max_height)
-			maxs = s;
-		
-            }
+            // index of highest strata, from the first loop
+	    maxs = zone[0].patch_families[pf][0].patches[i][0].tallest_stratum;
 
             d_height = avg_height - 0.75 * zone[0].patch_families[pf][0].patches[i][0].canopy_strata[maxs][0].epv.height;
 
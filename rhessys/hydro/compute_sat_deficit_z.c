@@ -0,0 +1,120 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		compute_sat_deficit_z				*/
+/*								*/
+/*	NAME							*/
+/*	compute_sat_deficit_z.c - saturation deficit and water	*/
+/*		table depth of a soil class, from its porosity	*/
+/*		profile table					*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	double	compute_sat_deficit_z(				*/
+/*			struct soil_default *defaults,		*/
+/*			double sat_deficit)			*/
+/*								*/
+/*	double	compute_sat_deficit(				*/
+/*			struct soil_default *defaults,		*/
+/*			double z)				*/
+/*								*/
+/*	returns:						*/
+/*	sat_deficit_z (m) - water table depth			*/
+/*	sat_deficit (m water) - water needed to fill the soil	*/
+/*		from depth z to the surface			*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	compute_sat_deficit_z(defaults, s) stands for		*/
+/*								*/
+/*	compute_z_final(verbose_flag, porosity_0,		*/
+/*		porosity_decay, soil_depth, 0.0, -s)		*/
+/*								*/
+/*	and compute_sat_deficit(defaults, z) for		*/
+/*								*/
+/*	compute_delta_water(verbose_flag, porosity_0,		*/
+/*		porosity_decay, soil_depth, z, 0.0)		*/
+/*								*/
+/*	Down to the table's max_z they interpolate the soil	*/
+/*	class's porosity profile table (see			*/
+/*	construct_porosity_profile.c), within			*/
+/*	POROSITY_PROFILE_TOLERANCE of the exact values and of	*/
+/*	inverting each other.  Ponded water tables,		*/
+/*	depths past max_z and classes without a table		*/
+/*	(-exactporosity) use the exact routines.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+double	compute_sat_deficit_z(
+							  struct	soil_default *defaults,
+							  double	sat_deficit)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function declaration				*/
+	/*--------------------------------------------------------------*/
+	double	compute_z_final(int, double, double, double, double, double);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int j, lo, hi, mid;
+	struct porosity_profile_object *profile;
+
+	profile = defaults[0].porosity_profile;
+	if ((profile == NULL) || (sat_deficit <= 0.0)
+		|| (sat_deficit > profile[0].sat_deficit[profile[0].num_segments]))
+		return(compute_z_final(0, defaults[0].porosity_0,
+			defaults[0].porosity_decay, defaults[0].soil_depth,
+			0.0, -1.0 * sat_deficit));
+
+	/*--------------------------------------------------------------*/
+	/*	Find the segment, searching only this bucket's range.	*/
+	/*--------------------------------------------------------------*/
+	j = (int) (sat_deficit / profile[0].bucket_size);
+	if (j >= profile[0].num_segments) j = profile[0].num_segments - 1;
+	lo = profile[0].bucket[j];
+	hi = profile[0].bucket[j+1];
+	while ((lo > 0) && (profile[0].sat_deficit[lo] > sat_deficit))
+		lo--;
+	while (lo < hi) {
+		mid = (lo + hi + 1) / 2;
+		if (profile[0].sat_deficit[mid] <= sat_deficit)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	return(lo * profile[0].dz + (sat_deficit - profile[0].sat_deficit[lo])
+		* profile[0].dz
+		/ (profile[0].sat_deficit[lo+1] - profile[0].sat_deficit[lo]));
+} /*end compute_sat_deficit_z*/
+
+double	compute_sat_deficit(
+							struct	soil_default *defaults,
+							double	z)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function declaration				*/
+	/*--------------------------------------------------------------*/
+	double	compute_delta_water(int, double, double, double, double, double);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int k;
+	struct porosity_profile_object *profile;
+
+	profile = defaults[0].porosity_profile;
+	if ((profile == NULL) || (z <= 0.0) || (z > profile[0].max_z))
+		return(compute_delta_water(0, defaults[0].porosity_0,
+			defaults[0].porosity_decay, defaults[0].soil_depth,
+			z, 0.0));
+
+	k = (int) (z / profile[0].dz);
+	if (k >= profile[0].num_segments) k = profile[0].num_segments - 1;
+	return(profile[0].sat_deficit[k] + (z - k * profile[0].dz)
+		* (profile[0].sat_deficit[k+1] - profile[0].sat_deficit[k])
+		/ profile[0].dz);
+} /*end compute_sat_deficit*/
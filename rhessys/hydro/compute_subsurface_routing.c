@@ -51,6 +51,7 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	double compute_infiltration(int, double, double, double, double, double,
 			double, double, double, double, double);
 
+	double	compute_sat_deficit_z(struct soil_default *, double);
 	double compute_z_final(int, double, double, double, double, double);
 
 	double compute_N_leached(int, double, double, double, double, double,
@@ -154,11 +155,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 
 		patch[0].preday_sat_deficit = patch[0].sat_deficit;
 
-		patch[0].preday_sat_deficit_z = compute_z_final(verbose_flag,
-				patch[0].soil_defaults[0][0].porosity_0,
-				patch[0].soil_defaults[0][0].porosity_decay,
-				patch[0].soil_defaults[0][0].soil_depth, 0.0,
-				-1.0 * patch[0].sat_deficit);
+		patch[0].preday_sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+			patch[0].sat_deficit);
 
 		patch[0].interim_sat = patch[0].sat_deficit - patch[0].unsat_storage;
 		if ((patch[0].sat_deficit - patch[0].unsat_storage) < ZERO)
@@ -276,11 +274,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			/*-------------------------------------------------------------------------*/
 			patch[0].sat_deficit += (patch[0].Qout - patch[0].Qin);
 
-			patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-					patch[0].soil_defaults[0][0].porosity_0,
-					patch[0].soil_defaults[0][0].porosity_decay,
-					patch[0].soil_defaults[0][0].soil_depth, 0.0,
-					-1.0 * patch[0].sat_deficit);
+			patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+				patch[0].sat_deficit);
 
 			if (grow_flag > 0) {
 				patch[0].soil_ns.nitrate += (patch[0].soil_ns.NO3_Qin
@@ -621,11 +616,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 				/*-------------------------------------------------------------------------*/
 				/*Recompute current actual depth to water table				*/
 				/*-------------------------------------------------------------------------*/
-				patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-						patch[0].soil_defaults[0][0].porosity_0,
-						patch[0].soil_defaults[0][0].porosity_decay,
-						patch[0].soil_defaults[0][0].soil_depth, 0.0,
-						-1.0 * patch[0].sat_deficit);
+				patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+					patch[0].sat_deficit);
 
 				/*--------------------------------------------------------------*/
 				/* 	leave behind field capacity			*/
@@ -822,11 +814,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 				/*--------------------------------------------------------------*/
 				/* recompute saturation deficit					*/
 				/*--------------------------------------------------------------*/
-				patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-						patch[0].soil_defaults[0][0].porosity_0,
-						patch[0].soil_defaults[0][0].porosity_decay,
-						patch[0].soil_defaults[0][0].soil_depth, 0.0,
-						-1.0 * patch[0].sat_deficit);
+				patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+					patch[0].sat_deficit);
 
 				/*--------------------------------------------------------------*/
 				/*	compute new field capacity				*/
@@ -952,11 +941,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 				/*-------------------c------------------------------------------------------*/
 				/*	Recompute current actual depth to water table				*/
 				/*-------------------------------------------------------------------------*/
-				patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-						patch[0].soil_defaults[0][0].porosity_0,
-						patch[0].soil_defaults[0][0].porosity_decay,
-						patch[0].soil_defaults[0][0].soil_depth, 0.0,
-						-1.0 * patch[0].sat_deficit);
+				patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+					patch[0].sat_deficit);
 
 
 
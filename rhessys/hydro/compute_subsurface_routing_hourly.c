@@ -54,6 +54,7 @@ void compute_subsurface_routing_hourly(
 	double compute_infiltration(int, double, double, double, double, double,
 			double, double, double, double, double);
 
+	double	compute_sat_deficit_z(struct soil_default *, double);
 	double compute_z_final(int, double, double, double, double, double);
 
 	double compute_N_leached(int, double, double, double, double, double,
@@ -213,11 +214,8 @@ void compute_subsurface_routing_hourly(
 			patch = hillslope->route_list->list[i];
 						
 			patch[0].preday_sat_deficit = patch[0].sat_deficit;
-			patch[0].preday_sat_deficit_z = compute_z_final(verbose_flag,
-					patch[0].soil_defaults[0][0].porosity_0,
-					patch[0].soil_defaults[0][0].porosity_decay,
-					patch[0].soil_defaults[0][0].soil_depth, 0.0,
-					-1.0 * patch[0].sat_deficit);
+			patch[0].preday_sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+				patch[0].sat_deficit);
 			
 		      	patch[0].hourly_subsur2stream_flow = 0;
 			patch[0].hourly_sur2stream_flow = 0;
@@ -271,11 +269,8 @@ void compute_subsurface_routing_hourly(
 			/*-------------------------------------------------------------------------*/
 			patch[0].sat_deficit += (patch[0].Qout - patch[0].Qin); // this part need to put into some where else
 
-			patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-					patch[0].soil_defaults[0][0].porosity_0,
-					patch[0].soil_defaults[0][0].porosity_decay,
-					patch[0].soil_defaults[0][0].soil_depth, 0.0,
-					-1.0 * patch[0].sat_deficit);
+			patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+				patch[0].sat_deficit);
 
 			if (grow_flag > 0) {
 				patch[0].soil_ns.nitrate += (patch[0].soil_ns.NO3_Qin
@@ -604,11 +599,8 @@ void compute_subsurface_routing_hourly(
 				/*-------------------------------------------------------------------------*/
 				/*Recompute current actual depth to water table				*/
 				/*-------------------------------------------------------------------------*/
-				patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-						patch[0].soil_defaults[0][0].porosity_0,
-						patch[0].soil_defaults[0][0].porosity_decay,
-						patch[0].soil_defaults[0][0].soil_depth, 0.0,
-						-1.0 * patch[0].sat_deficit);
+				patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+					patch[0].sat_deficit);
 
 				/*--------------------------------------------------------------*/
 				/* 	leave behind field capacity			*/
@@ -804,11 +796,8 @@ void compute_subsurface_routing_hourly(
 				/*--------------------------------------------------------------*/
 				/* recompute saturation deficit					*/
 				/*--------------------------------------------------------------*/
-				patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-						patch[0].soil_defaults[0][0].porosity_0,
-						patch[0].soil_defaults[0][0].porosity_decay,
-						patch[0].soil_defaults[0][0].soil_depth, 0.0,
-						-1.0 * patch[0].sat_deficit);
+				patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+					patch[0].sat_deficit);
 
 
 			
@@ -936,11 +925,8 @@ void compute_subsurface_routing_hourly(
 				/*-------------------c------------------------------------------------------*/
 				/*	Recompute current actual depth to water table				*/
 				/*-------------------------------------------------------------------------*/
-				patch[0].sat_deficit_z = compute_z_final(verbose_flag,
-						patch[0].soil_defaults[0][0].porosity_0,
-						patch[0].soil_defaults[0][0].porosity_decay,
-						patch[0].soil_defaults[0][0].soil_depth, 0.0,
-						-1.0 * patch[0].sat_deficit);
+				patch[0].sat_deficit_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+					patch[0].sat_deficit);
 
 
 
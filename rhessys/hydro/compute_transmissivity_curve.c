@@ -48,7 +48,8 @@
 double 	*compute_transmissivity_curve( 
 					double  gamma,
 					struct patch_object *patch,
-					struct command_line_object *command_line
+					struct command_line_object *command_line,
+					struct arena_object *arena
 					)
 {
 
@@ -70,6 +71,7 @@ double 	*compute_transmissivity_curve(
 		double);
 
 
+	double	compute_sat_deficit_z(struct soil_default *, double);
 	double	compute_delta_water(
 		int,
 		double,
@@ -88,6 +90,7 @@ double 	*compute_transmissivity_curve(
 		double);
 
 	 void    *alloc( size_t, char *, char *);
+	 void    *arena_alloc(struct arena_object *, size_t, char *, char *);
 
 
 	/*--------------------------------------------------------------*/
@@ -103,7 +106,7 @@ double 	*compute_transmissivity_curve(
 
 	m = patch[0].soil_defaults[0][0].m;
 
-	transmissivity = (double *) alloc((patch[0].num_soil_intervals+1) * sizeof(double),
+	transmissivity = (double *) arena_alloc(arena, (patch[0].num_soil_intervals+1) * sizeof(double),
 					"trans","compute_transmissivity_cuve");
 
 
@@ -121,21 +124,11 @@ double 	*compute_transmissivity_curve(
 			depth = depth-patch[0].soil_defaults[0][0].interval_size;
 
 			
-			lower_z = compute_z_final(
-				command_line[0].verbose_flag,
-				patch[0].soil_defaults[0][0].porosity_0,
-				patch[0].soil_defaults[0][0].porosity_decay,
-				patch[0].soil_defaults[0][0].soil_depth,
-				0.0,
-				-1.0*lower);
+			lower_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+				lower);
 
-			depth_z = compute_z_final(
-				command_line[0].verbose_flag,
-				patch[0].soil_defaults[0][0].porosity_0,
-				patch[0].soil_defaults[0][0].porosity_decay,
-				patch[0].soil_defaults[0][0].soil_depth,
-				0.0,
-				-1.0*depth);
+			depth_z = compute_sat_deficit_z(patch[0].soil_defaults[0],
+				depth);
 
 	       		fclayer = compute_field_capacity(
 				command_line[0].verbose_flag,
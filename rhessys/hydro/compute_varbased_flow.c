@@ -34,6 +34,9 @@
 /*								*/
 /*								*/
 /*	PROGRAMMER NOTES					*/
+/*	The fill and spill threshold is the soil class's	*/
+/*	fs_threshold_sat_deficit, computed once in		*/
+/*	construct_soil_defaults.				*/
 /*								*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
@@ -53,24 +56,24 @@ double	compute_varbased_flow(
 
 
 	/*--------------------------------------------------------------*/
-	/*	Local sub	definition				*/
+	/*	Nine point normal quadrature: quantiles and weights	*/
 	/*--------------------------------------------------------------*/
+	static const double normal[9] = {0.0, 0.253, 0.524, 0.842, 1.283,
+		-0.253, -0.524, -0.842, -1.283};
+	static const double perc[9] = {0.2, 0.1, 0.1, 0.1, 0.1,
+		0.1, 0.1, 0.1, 0.1};
 
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
 
-	double	flow, accum,thre_flow,abovthre_flow;
-	double	normal[9], perc[9];
-	int i;
+	double	flow, thre_flow,abovthre_flow;
 	int didx,didthr;
 	
 
 	// soil deficit threshold, not the soil moisture threshold, fs_threshold is defined as the soil moiture threshold as
 	// percentage of the max soil moisture holding capacity
 	double threshold;
-	double p;
-	double n_0;
 	double soil_depth;
 	double fs_spill;
 	double fs_percolation;
@@ -79,10 +82,8 @@ double	compute_varbased_flow(
 	/*--------------------------------------------------------------*/
 	/* calculate or initialize value    				*/
 	/*--------------------------------------------------------------*/
-	p = patch[0].soil_defaults[0][0].porosity_decay;
-	n_0 = patch[0].soil_defaults[0][0].porosity_0;
 	soil_depth = patch[0].soil_defaults[0][0].soil_depth;
-	threshold = n_0 * p * (1 - exp(-soil_depth/p))*(1 - patch[0].soil_defaults[0][0].fs_threshold);
+	threshold = patch[0].soil_defaults[0][0].fs_threshold_sat_deficit;
 	fs_spill = patch[0].soil_defaults[0][0].fs_spill;
 	fs_percolation = patch[0].soil_defaults[0][0].fs_percolation;
 
@@ -95,37 +96,22 @@ double	compute_varbased_flow(
 
 	else {
 
-
-	normal[0] = 0;
-	normal[1] = 0.253;
-	normal[2] = 0.524;
-	normal[3] = 0.842;
-	normal[4] = 1.283;
-	normal[5] = -0.253;
-	normal[6] = -0.524;
-	normal[7] = -0.842;
-	normal[8] = -1.283;
-
-	perc[0] = 0.2;
-	for (i=1; i<9; i++)
-		perc[i] = 0.1;
-
-	
 	flow = 0.0;
 	if (s1 < 0.0) s1 = 0.0;	
 
 	if (std > ZERO) {
-	for (i=0; i <9; i++) {
-		didx = (int) lround((s1 + normal[i]*std)/interval_size);
-		if (didx > num_soil_intervals) didx = num_soil_intervals;
-
-		accum = transmissivity[didx] * 1;
-		/* fill and spill */
-		if ((patch[0].sat_deficit <= threshold) && ((s1 + normal[i]*std) <= threshold)){
-		    accum=transmissivity[didx] * 1;
-		}
-
-		flow += accum * perc[i];
+	/*--------------------------------------------------------------*/
+	/*	All nine quantiles at once: round to the nearest	*/
+	/*	interval (quantiles above the surface use the first)	*/
+	/*	and gather its transmissivity.  Fill and spill does not	*/
+	/*	change the result here, so there is no branch.		*/
+	/*--------------------------------------------------------------*/
+	#pragma omp simd reduction(+:flow)
+	for (int i=0; i <9; i++) {
+		double s = s1 + normal[i]*std;
+		int idx = (int) (max(s, 0.0)/interval_size + 0.5);
+		if (idx > num_soil_intervals) idx = num_soil_intervals;
+		flow += transmissivity[idx] * perc[i];
 	}
 	}
 	else  {
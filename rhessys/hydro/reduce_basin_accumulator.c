@@ -0,0 +1,92 @@
+/*--------------------------------------------------------------------------------------*/
+/* 											*/
+/*			reduce_basin_accumulator					*/
+/*											*/
+/*	NAME										*/
+/*	reduce_basin_accumulator.c - add each hillslope's share of the basin		*/
+/*					accumulators to the basin			*/
+/*											*/
+/*	SYNOPSIS									*/
+/*	void reduce_basin_accumulator( 							*/
+/*					struct command_line_object *command_line,	*/
+/*					struct basin_object *basin)			*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*	hillslope_daily_F (through update_basin_patch_accumulator) sums its		*/
+/*	patches' basin monthly and yearly variables into the hillslope's		*/
+/*	basin_acc_month and basin_acc_year, so hillslopes running on different		*/
+/*	threads do not share the basin sums.  This function is called in		*/
+/*	basin_daily_F once every hillslope is done; it adds those to the		*/
+/*	basin's acc_month and acc_year and clears them for the next day.		*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*	Only the variables update_basin_patch_accumulator and hillslope_daily_F	*/
+/*	fill in are reduced.								*/
+/*											*/
+/*--------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+static void add_basin_acc(struct accumulate_patch_object *acc,
+			struct accumulate_patch_object *share)
+{
+	acc[0].length += share[0].length;
+	acc[0].streamflow += share[0].streamflow;
+	acc[0].et += share[0].et;
+	acc[0].PET += share[0].PET;
+	acc[0].denitrif += share[0].denitrif;
+	acc[0].nitrif += share[0].nitrif;
+	acc[0].mineralized += share[0].mineralized;
+	acc[0].uptake += share[0].uptake;
+	acc[0].DON_loss += share[0].DON_loss;
+	acc[0].DOC_loss += share[0].DOC_loss;
+	acc[0].stream_NO3 += share[0].stream_NO3;
+	acc[0].stream_NH4 += share[0].stream_NH4;
+	acc[0].stream_DON += share[0].stream_DON;
+	acc[0].stream_DOC += share[0].stream_DOC;
+	acc[0].psn += share[0].psn;
+	acc[0].lai += share[0].lai;
+	acc[0].leach += share[0].leach;
+
+	share[0].length = 0.0;
+	share[0].streamflow = 0.0;
+	share[0].et = 0.0;
+	share[0].PET = 0.0;
+	share[0].denitrif = 0.0;
+	share[0].nitrif = 0.0;
+	share[0].mineralized = 0.0;
+	share[0].uptake = 0.0;
+	share[0].DON_loss = 0.0;
+	share[0].DOC_loss = 0.0;
+	share[0].stream_NO3 = 0.0;
+	share[0].stream_NH4 = 0.0;
+	share[0].stream_DON = 0.0;
+	share[0].stream_DOC = 0.0;
+	share[0].psn = 0.0;
+	share[0].lai = 0.0;
+	share[0].leach = 0.0;
+}
+
+void reduce_basin_accumulator(
+			struct command_line_object 	*command_line,
+			struct basin_object 		*basin)
+{
+	/*----------------------------------------------------------------------*/
+	/* Local variables definition                                           */
+	/*-----------------------------------------------------------------------*/
+	int h;
+
+	if (command_line[0].b == NULL)
+		return;
+	for (h=0; h < basin[0].num_hillslopes; h++) {
+		if (command_line[0].output_flags.monthly == 1)
+			add_basin_acc(&(basin[0].acc_month),
+				&(basin[0].hillslopes[h][0].basin_acc_month));
+		if (command_line[0].output_flags.yearly == 1)
+			add_basin_acc(&(basin[0].acc_year),
+				&(basin[0].hillslopes[h][0].basin_acc_year));
+	}
+	return;
+} /* end of reduce_basin_accumulator.c */
@@ -9,6 +9,7 @@
 /*	void update_basin_patch_accumulator( 						*/
 /*					struct command_line_object *command_line,	*/
 /*					struct basin_object *basin			*/
+/*					struct hillslope_object *hillslope		*/
 /*					struct date current_date)			*/
 /*											*/
 /* 											*/
@@ -19,6 +20,10 @@
 /*	DESCRIPTION									*/
 /*	this function is called in basin_daily_F at the end of each day, it was in  	*/
 /*	the compute_subsurface_routing, 										*/
+/*	it is now called by hillslope_daily_F for that hillslope's patches, while	*/
+/*	they are still in cache; the basin sums go into the hillslope's		*/
+/*	basin_acc_month and basin_acc_year and reduce_basin_accumulator adds	*/
+/*	those to the basin after every hillslope is done.				*/
 /*											*/
 /*											*/
 /*	PROGRAMMER NOTES								*/
@@ -31,6 +36,7 @@
 void update_basin_patch_accumulator(
 			struct command_line_object 	*command_line,
 			struct basin_object 		*basin,
+			struct hillslope_object 	*hillslope,
 			struct date		 	current_date)
 {
 	/*----------------------------------------------------------------------*/
@@ -39,7 +45,7 @@ void update_basin_patch_accumulator(
 	double scale;
 	double tmp;
 	struct patch_object *patch;
-	int b,h,p,z,c,s;
+	int p,z;
 	/*----------------------------------------------------------------------*/
 	/* initializations		                                           */
 	/*----------------------------------------------------------------------*/	
@@ -47,94 +53,93 @@ void update_basin_patch_accumulator(
 	/*---------------------------------------------------------------------*/
 	/*update accumulator variables                                            */
 	/*-----------------------------------------------------------------------*/
-	for (h=0; h < basin->num_hillslopes; ++h) {
-		for(z=0; z < basin->hillslopes[h][0].num_zones; ++z) {
-			for (p=0; p < basin->hillslopes[h][0].zones[z][0].num_patches; p++) {
+		for(z=0; z < hillslope[0].num_zones; ++z) {
+			for (p=0; p < hillslope[0].zones[z][0].num_patches; p++) {
 
-		patch=basin->hillslopes[h]->zones[z]->patches[p];
+		patch=hillslope[0].zones[z][0].patches[p];
 
 		patch[0].acc_year_trans += (patch[0].transpiration_unsat_zone
 						+ patch[0].transpiration_sat_zone);
 				if ((command_line[0].output_flags.monthly == 1)
 						&& (command_line[0].b != NULL )) {
 					scale = patch[0].area / basin[0].area;
-					basin[0].acc_month.streamflow += (patch[0].streamflow)
+					hillslope[0].basin_acc_month.streamflow += (patch[0].streamflow)
 							* scale;
-					basin[0].acc_month.et += (patch[0].transpiration_unsat_zone
+					hillslope[0].basin_acc_month.et += (patch[0].transpiration_unsat_zone
 							+ patch[0].evaporation_surf
 							+ patch[0].exfiltration_unsat_zone
 							+ patch[0].exfiltration_sat_zone
 							+ patch[0].transpiration_sat_zone
 							+ patch[0].evaporation) * scale;
-					basin[0].acc_month.denitrif += patch[0].ndf.denitrif
+					hillslope[0].basin_acc_month.denitrif += patch[0].ndf.denitrif
 							* scale;
-					basin[0].acc_month.nitrif += patch[0].ndf.sminn_to_nitrate
+					hillslope[0].basin_acc_month.nitrif += patch[0].ndf.sminn_to_nitrate
 							* scale;
-					basin[0].acc_month.mineralized +=
+					hillslope[0].basin_acc_month.mineralized +=
 							patch[0].ndf.net_mineralized * scale;
-					basin[0].acc_month.uptake += patch[0].ndf.sminn_to_npool
+					hillslope[0].basin_acc_month.uptake += patch[0].ndf.sminn_to_npool
 							* scale;
-					basin[0].acc_month.DON_loss +=
+					hillslope[0].basin_acc_month.DON_loss +=
 							(patch[0].soil_ns.DON_Qout_total
 									- patch[0].soil_ns.DON_Qin_total) * scale;
-					basin[0].acc_month.DOC_loss +=
+					hillslope[0].basin_acc_month.DOC_loss +=
 							(patch[0].soil_cs.DOC_Qout_total
 									- patch[0].soil_cs.DOC_Qin_total) * scale;
-					basin[0].acc_month.length += 1;
-					basin[0].acc_month.stream_NO3 += patch[0].streamflow_NO3
+					hillslope[0].basin_acc_month.length += 1;
+					hillslope[0].basin_acc_month.stream_NO3 += patch[0].streamflow_NO3
 							* scale;
-					basin[0].acc_month.stream_NH4 += patch[0].streamflow_NH4
+					hillslope[0].basin_acc_month.stream_NH4 += patch[0].streamflow_NH4
 							* scale;
-					basin[0].acc_month.stream_DON += patch[0].streamflow_DON
+					hillslope[0].basin_acc_month.stream_DON += patch[0].streamflow_DON
 							* scale;
-					basin[0].acc_month.stream_DOC += patch[0].streamflow_DOC
+					hillslope[0].basin_acc_month.stream_DOC += patch[0].streamflow_DOC
 							* scale;
-					basin[0].acc_month.psn += patch[0].net_plant_psn * scale;
-					basin[0].acc_month.lai += patch[0].lai * scale;
-					basin[0].acc_month.leach += (patch[0].soil_ns.leach
+					hillslope[0].basin_acc_month.psn += patch[0].net_plant_psn * scale;
+					hillslope[0].basin_acc_month.lai += patch[0].lai * scale;
+					hillslope[0].basin_acc_month.leach += (patch[0].soil_ns.leach
 							+ patch[0].surface_ns_leach) * scale;
 				}
 
 				if ((command_line[0].output_flags.yearly == 1)
 						&& (command_line[0].b != NULL )) {
 					scale = patch[0].area / basin[0].area;
-					basin[0].acc_year.length += 1;
-					basin[0].acc_year.leach += (patch[0].soil_ns.leach
+					hillslope[0].basin_acc_year.length += 1;
+					hillslope[0].basin_acc_year.leach += (patch[0].soil_ns.leach
 							+ patch[0].surface_ns_leach) * scale;
-					basin[0].acc_year.stream_NH4 += patch[0].streamflow_NH4
+					hillslope[0].basin_acc_year.stream_NH4 += patch[0].streamflow_NH4
 							* scale;
-					basin[0].acc_year.stream_NO3 += patch[0].streamflow_NO3
+					hillslope[0].basin_acc_year.stream_NO3 += patch[0].streamflow_NO3
 							* scale;
-					basin[0].acc_year.denitrif += patch[0].ndf.denitrif * scale;
-					basin[0].acc_year.nitrif += patch[0].ndf.sminn_to_nitrate
+					hillslope[0].basin_acc_year.denitrif += patch[0].ndf.denitrif * scale;
+					hillslope[0].basin_acc_year.nitrif += patch[0].ndf.sminn_to_nitrate
 							* scale;
-					basin[0].acc_year.mineralized +=
+					hillslope[0].basin_acc_year.mineralized +=
 							patch[0].ndf.net_mineralized * scale;
-					basin[0].acc_year.uptake += patch[0].ndf.sminn_to_npool
+					hillslope[0].basin_acc_year.uptake += patch[0].ndf.sminn_to_npool
 							* scale;
-					basin[0].acc_year.DON_loss +=
+					hillslope[0].basin_acc_year.DON_loss +=
 							(patch[0].soil_ns.DON_Qout_total
 									- patch[0].soil_ns.DON_Qin_total) * scale;
-					basin[0].acc_year.DOC_loss +=
+					hillslope[0].basin_acc_year.DOC_loss +=
 							(patch[0].soil_cs.DOC_Qout_total
 									- patch[0].soil_cs.DOC_Qin_total) * scale;
-					basin[0].acc_year.stream_DON += patch[0].streamflow_DON
+					hillslope[0].basin_acc_year.stream_DON += patch[0].streamflow_DON
 							* scale;
-					basin[0].acc_year.stream_DOC += patch[0].streamflow_DOC
+					hillslope[0].basin_acc_year.stream_DOC += patch[0].streamflow_DOC
 							* scale;
-					basin[0].acc_year.psn += patch[0].net_plant_psn * scale;
-					basin[0].acc_year.PET += (patch[0].PE + patch[0].PET)
+					hillslope[0].basin_acc_year.psn += patch[0].net_plant_psn * scale;
+					hillslope[0].basin_acc_year.PET += (patch[0].PE + patch[0].PET)
 							* scale;
 
-					basin[0].acc_year.et += (patch[0].evaporation
+					hillslope[0].basin_acc_year.et += (patch[0].evaporation
 							+ patch[0].evaporation_surf
 							+ patch[0].exfiltration_unsat_zone
 							+ patch[0].exfiltration_sat_zone
 							+ patch[0].transpiration_unsat_zone
 							+ patch[0].transpiration_sat_zone) * scale;
-					basin[0].acc_year.streamflow += (patch[0].streamflow)
+					hillslope[0].basin_acc_year.streamflow += (patch[0].streamflow)
 							* scale;
-					basin[0].acc_year.lai += patch[0].lai * scale;
+					hillslope[0].basin_acc_year.lai += patch[0].lai * scale;
 				}
 
 				if ((command_line[0].output_flags.monthly == 1) &&
@@ -321,7 +326,6 @@ void update_basin_patch_accumulator(
 		} /* end if */		
 	} /* end of p*/
 	} /* end of z*/
-	} /* end of h*/
 
 
 	return;
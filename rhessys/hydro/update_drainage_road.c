@@ -44,6 +44,7 @@ void  update_drainage_road(
 	/*	Local function definition.				*/
 	/*--------------------------------------------------------------*/
 	
+	double	compute_sat_deficit(struct soil_default *, double);
 	double  compute_delta_water(
 		int,
 		double,
@@ -151,13 +152,8 @@ void  update_drainage_road(
 	/*--------------------------------------------------------------*/
 	/*	calculate water_equivalent depth of road		*/
 	/*--------------------------------------------------------------*/
-	road_int_depth = compute_delta_water(
-		verbose_flag,
-		patch[0].soil_defaults[0][0].porosity_0,
-		patch[0].soil_defaults[0][0].porosity_decay,
-		patch[0].soil_defaults[0][0].soil_depth,
-		patch[0].road_cut_depth,
-		0.0);
+	road_int_depth = compute_sat_deficit(patch[0].soil_defaults[0],
+		patch[0].road_cut_depth);
 	if (road_int_depth > patch[0].sat_deficit) {
 	/*------------------------------------------------------------*/
 	/*	calculate amuount of water output to patches			*/
@@ -30,6 +30,11 @@
 /*	preset code just uses a user assigned loading rate	*/
 /*	and all of it is nitrate				*/
 /*								*/
+/*	Drainage goes into the zone's gw_drainage sums, not	*/
+/*	the hillslope's gw, since the zones of a split		*/
+/*	hillslope run concurrently; add_zone_gw_drainage adds	*/
+/*	them to the hillslope once its zones are done.		*/
+/*								*/
 /*								*/
 /*--------------------------------------------------------------*/
 #include <stdlib.h>
@@ -82,20 +87,20 @@ int update_gw_drainage(
 	drainage = sat_to_gw_coeff * patch[0].detention_store;
 	patch[0].detention_store -= drainage;
 	patch[0].gw_drainage = drainage;
-	hillslope[0].gw.storage += (drainage * patch[0].area / hillslope[0].area);
+	zone[0].gw_drainage.storage += (drainage * patch[0].area / hillslope[0].area);
 
 	/*------------------------------------------------------*/
 	/*	determine associated N leached			*/
 	/*------------------------------------------------------*/
 	if (patch[0].surface_DON > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_DON;
-		hillslope[0].gw.DON += (N_loss * patch[0].area / hillslope[0].area);
+		zone[0].gw_drainage.DON += (N_loss * patch[0].area / hillslope[0].area);
 		patch[0].ndf.DON_to_gw += N_loss;
 		patch[0].surface_DON -= N_loss;
 		}
 	if (patch[0].surface_DOC > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_DOC;
-		hillslope[0].gw.DOC += (N_loss * patch[0].area / hillslope[0].area);
+		zone[0].gw_drainage.DOC += (N_loss * patch[0].area / hillslope[0].area);
 		patch[0].cdf.DOC_to_gw += N_loss;
 		patch[0].surface_DOC -= N_loss;
 		}
@@ -103,14 +108,14 @@ int update_gw_drainage(
 	
 	if (patch[0].surface_NH4 > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_NH4;
-		hillslope[0].gw.NH4 += (N_loss * patch[0].area / hillslope[0].area);
+		zone[0].gw_drainage.NH4 += (N_loss * patch[0].area / hillslope[0].area);
 		patch[0].ndf.N_to_gw += N_loss;
 		patch[0].surface_NH4 -= N_loss;
 		}
 	
 	if (patch[0].surface_NO3 > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_NO3;
-		hillslope[0].gw.NO3 += (N_loss * patch[0].area / hillslope[0].area);
+		zone[0].gw_drainage.NO3 += (N_loss * patch[0].area / hillslope[0].area);
 		patch[0].ndf.N_to_gw += N_loss;
 		patch[0].surface_NO3 -= N_loss;
 		}
@@ -8,7 +8,7 @@
 /*	SYNOPSIS									*/
 /*	void update_hillslope_accumulator( 						*/
 /*					struct command_line_object *command_line,	*/
-/*					struct basin_object *basin			*/
+/*					struct hillslope_object *hillslope		*/
 /*											*/
 /* 											*/
 /*											*/
@@ -16,7 +16,8 @@
 /*											*/
 /*											*/
 /*	DESCRIPTION									*/
-/*	this function is called in basin_daily_F at the end of each day,		*/
+/*	this function is called in hillslope_daily_F at the end of each day,	*/
+/*	once routing is done, for that hillslope only				*/
 /*											*/
 /*											*/
 /*	PROGRAMMER NOTES								*/
@@ -26,18 +27,14 @@
 #include "rhessys.h"
 void update_hillslope_accumulator(
 			struct command_line_object *command_line,
-			struct basin_object *basin){
+			struct hillslope_object *hillslope){
 	/*--------------------------------------------------------------------------------------*/
 	/* Local variables definition								*/
 	/*--------------------------------------------------------------------------------------*/
-  // moved these into for loop below for openmp functionality
 	/*--------------------------------------------------------------------------------------*/
 	/* update hillslope accumulator								*/
 	/*--------------------------------------------------------------------------------------*/
-    #pragma omp parallel for
-    for (int h = 0 ; h < basin[0].num_hillslopes; h++ ){
-        struct hillslope_object *hillslope = basin[0].hillslopes[h];
-		hillslope[0].acc_month.length += 1;
+	hillslope[0].acc_month.length += 1;
         for (int z = 0; z < hillslope[0].num_zones; z++) {
             for (int p=0; p < hillslope[0].zones[z][0].num_patches; p++) {
                 struct patch_object *patch = hillslope[0].zones[z][0].patches[p];
@@ -82,6 +79,5 @@ void update_hillslope_accumulator(
 				}
 			} /* end of patch p  */
 		} /* end of zones z */
-	} /* end of hillslope  */	
 	return;
 } /* end of file update_hillslope_accumulator.c */
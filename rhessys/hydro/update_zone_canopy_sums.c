@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		update_zone_canopy_sums				*/
+/*								*/
+/*	NAME							*/
+/*	update_zone_canopy_sums.c - zone canopy means from the	*/
+/*		area weighted patch sums			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void update_zone_canopy_sums(struct zone_object *zone)	*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	patch_daily_I and patch_daily_F add each patch's change	*/
+/*	to the zone's effective_lai, lai, total_stemc and	*/
+/*	height sums as they go.  Called once a day from		*/
+/*	zone_daily_F, this redoes the sums from the patches	*/
+/*	when canopy_sums_age reaches ZONE_CANOPY_RESYNC_DAYS,	*/
+/*	so rounding in the updates cannot build up, and sets	*/
+/*	the zone means.						*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	The updates assume patch areas do not change, so	*/
+/*	anything that changes a patch or zone area or a		*/
+/*	stratum cover fraction (the input_new_* redefines,	*/
+/*	state deltas) sets canopy_sums_age to			*/
+/*	ZONE_CANOPY_RESYNC_DAYS to force a resync.		*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void update_zone_canopy_sums(struct zone_object *zone)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int patch;
+
+	if (zone[0].canopy_sums_age >= ZONE_CANOPY_RESYNC_DAYS) {
+		zone[0].effective_lai_sum = 0.0;
+		zone[0].lai_sum = 0.0;
+		zone[0].total_stemc_sum = 0.0;
+		zone[0].height_sum = 0.0;
+		for ( patch=0 ; patch<zone[0].num_patches ; patch++ ){
+		  zone[0].effective_lai_sum
+		    += zone[0].patches[patch][0].effective_lai
+		   * zone[0].patches[patch][0].area;
+		  zone[0].lai_sum
+		    += zone[0].patches[patch][0].lai
+		    * zone[0].patches[patch][0].area;
+		  zone[0].total_stemc_sum
+		    += zone[0].patches[patch][0].total_stemc
+		    * zone[0].patches[patch][0].area;
+		  zone[0].height_sum
+		    += zone[0].patches[patch][0].height
+		    * zone[0].patches[patch][0].area;
+		}
+		zone[0].canopy_sums_age = 0;
+	}
+	zone[0].canopy_sums_age++;
+	zone[0].effective_lai = zone[0].effective_lai_sum / zone[0].area;
+	zone[0].lai = zone[0].lai_sum / zone[0].area;
+	zone[0].total_stemc = zone[0].total_stemc_sum / zone[0].area;
+	zone[0].height = zone[0].height_sum / zone[0].area;
+	return;
+} /* end update_zone_canopy_sums */
@@ -0,0 +1,36 @@
+/** @file alloc_accounting.h
+ *  @brief Per-tag accounting of memory allocated with alloc(), enabled
+ *  with the -memprofile command line option.
+ *
+ *  Every block alloc() returns is recorded in a side table under its
+ *  (array_name, calling_function) tag, so live bytes, peak live bytes and
+ *  call counts can be reported for each tag.  Blocks released with
+ *  alloc_free() are credited back to their tag at once.  A block released
+ *  with plain free() stays live until malloc hands its address out again,
+ *  when it is credited back, so live bytes can only be overstated.
+ *
+ *  The report, sorted by peak bytes, is written at exit (including fatal
+ *  error exits) and whenever the process receives SIGUSR1.
+ *
+ *  alloc() and alloc_free() may be called from several threads at once;
+ *  the side table is only updated inside one named critical section.
+ *
+ *  @note When -memprofile is not given alloc() and alloc_free() cost one
+ *  predictable branch.
+ */
+#ifndef INCLUDE_ALLOC_ACCOUNTING_H_
+#define INCLUDE_ALLOC_ACCOUNTING_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+extern int alloc_accounting_enabled;
+
+void alloc_accounting_init(char *report_filename);
+void alloc_accounting_add(void *array, size_t size, const char *array_name,
+	const char *calling_function);
+void alloc_accounting_remove(void *array);
+void alloc_accounting_poll(void);
+void alloc_accounting_report(FILE *out);
+
+#endif /* INCLUDE_ALLOC_ACCOUNTING_H_ */
@@ -0,0 +1,51 @@
+/** @file fast_format.h
+ *  @brief Builds output rows in memory and writes each with one fwrite.
+ *
+ *  Most of the cost of writing daily patch and stratum output is libc
+ *  turning doubles into text.  The row builder formats integers, strings
+ *  and doubles itself: a double is scaled to an integer number of
+ *  decimal units, rounded exactly as printf rounds it, and printed as
+ *  digits, so rows are byte for byte what fprintf writes.  Values too
+ *  large to scale exactly, infinities and NaNs go through snprintf.
+ *
+ *  fast_fprintf() is a drop-in replacement for fprintf() for the legacy
+ *  output writers: %d, %ld, %f, %lf and %s without flags, width or
+ *  precision take the fast path and any other conversion is handed to
+ *  snprintf, so a format string can be used unchanged.
+ *  fast_format_appendf() formats the same way into a row.
+ *
+ *  Bare %f and %lf conversions (and the doubles of filter CSV output) are
+ *  written with fast_format_decimals digits after the decimal point; 6,
+ *  the printf default, unless changed with -outprecision.
+ */
+#ifndef INCLUDE_FAST_FORMAT_H_
+#define INCLUDE_FAST_FORMAT_H_
+
+#include <stdio.h>
+
+#define FAST_FORMAT_ROW_LEN 4096
+#define FAST_FORMAT_DEFAULT_DECIMALS 6
+#define FAST_FORMAT_MAX_DECIMALS 15
+
+typedef struct fast_format_row_s {
+	char *buf;
+	size_t len;
+	size_t size;
+	char local[FAST_FORMAT_ROW_LEN];
+} FastFormatRow;
+
+extern int fast_format_decimals;
+
+void fast_format_set_decimals(int decimals);
+
+void fast_format_row_init(FastFormatRow *row);
+void fast_format_row_free(FastFormatRow *row);
+void fast_format_append_string(FastFormatRow *row, const char *s);
+void fast_format_append_long(FastFormatRow *row, long n);
+void fast_format_append_double(FastFormatRow *row, double x, int decimals);
+void fast_format_appendf(FastFormatRow *row, const char *format, ...);
+int fast_format_write_row(FastFormatRow *row, FILE *fp);
+
+int fast_fprintf(FILE *fp, const char *format, ...);
+
+#endif /* INCLUDE_FAST_FORMAT_H_ */
@@ -21,6 +21,7 @@ double compute_prop_alloc_daily(
 		struct epconst_struct);
 
 void *alloc(size_t size, char *array_name, char *calling_function);
+void alloc_free(void *array);
 
 struct routing_list_object *construct_topmodel_patchlist(struct hillslope_object * const hillslope);
 
@@ -0,0 +1,43 @@
+/** @file id_index.h
+ *  @brief Defines data and functions for a sorted index mapping integer
+ *  object IDs (patch, zone, hillslope, ...) to object pointers.
+ *
+ *  @note Entries are appended with idIndexInsert() and the index must be
+ *  finalized with idIndexFinalize() before lookups.  When the same ID is
+ *  inserted more than once, the entry inserted last wins, matching the
+ *  behaviour of a full hierarchy scan that keeps the last match.
+ *
+ *  @note Entries may optionally be scoped to a parent object (e.g. the
+ *  zone a patch belongs to), in which case the key is (parent, id) and
+ *  lookups must use idIndexGetInParent().
+ */
+#ifndef INCLUDE_ID_INDEX_H_
+#define INCLUDE_ID_INDEX_H_
+
+#include <stddef.h>
+
+typedef struct id_index_entry_s {
+	const void *parent;
+	int id;
+	size_t seq;
+	void *ptr;
+} IdIndexEntry_t;
+
+typedef struct id_index_s {
+	size_t num_entries;
+	size_t capacity;
+	size_t next_seq; // only ever increases, so later inserts always win
+	int finalized;
+	IdIndexEntry_t *entries;
+} IdIndex_t;
+
+IdIndex_t *newIdIndex(size_t capacity);
+void freeIdIndex(IdIndex_t *index);
+
+void idIndexInsert(IdIndex_t *index, int id, void *ptr);
+void idIndexInsertInParent(IdIndex_t *index, const void *parent, int id, void *ptr);
+void idIndexFinalize(IdIndex_t *index);
+void *idIndexGet(const IdIndex_t *index, int id);
+void *idIndexGetInParent(const IdIndex_t *index, const void *parent, int id);
+
+#endif /* INCLUDE_ID_INDEX_H_ */
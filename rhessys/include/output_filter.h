@@ -13,6 +13,18 @@
 #define OUTPUT_FORMAT_CSV "csv"
 #define OUTPUT_FORMAT_NETCDF "netcdf"
 
+#define OUTPUT_GROUP_BY_BASIN "basin"
+#define OUTPUT_GROUP_BY_HILLSLOPE "hillslope"
+#define OUTPUT_GROUP_BY_ZONE "zone"
+#define OUTPUT_GROUP_BY_PATCH "patch"
+#define OUTPUT_GROUP_BY_FAMILY "family"
+#define OUTPUT_GROUP_BY_MAP "map"
+
+#define OUTPUT_AGGREGATE_MEAN "mean"
+#define OUTPUT_AGGREGATE_SUM "sum"
+#define OUTPUT_AGGREGATE_MIN "min"
+#define OUTPUT_AGGREGATE_MAX "max"
+
 #define OF_VAR_EXPR_AST_NODE_UNARY_MINUS 'M'
 #define OF_VAR_EXPR_AST_NODE_CONST 'K'
 #define OF_VAR_EXPR_AST_NODE_NAME 'N'
@@ -41,6 +53,25 @@ typedef enum {
 	OUTPUT_TYPE_NETCDF
 } OutputFormat;
 
+// Spatial unit the entities of a zone, patch or stratum filter are
+// aggregated to before output; see output_filter_group_entities()
+typedef enum {
+	GROUP_BY_NONE,
+	GROUP_BY_BASIN,
+	GROUP_BY_HILLSLOPE,
+	GROUP_BY_ZONE,
+	GROUP_BY_PATCH,
+	GROUP_BY_FAMILY,
+	GROUP_BY_MAP
+} OutputGroupBy;
+
+typedef enum {
+	AGGREGATE_MEAN,
+	AGGREGATE_SUM,
+	AGGREGATE_MIN,
+	AGGREGATE_MAX
+} OutputAggregate;
+
 typedef enum {
 	ANY_VAR,
 	NAMED,
@@ -172,6 +203,26 @@ typedef struct of_stratum {
 	struct canopy_strata_object *stratum;
 } OutputFilterStratum;
 
+#define OUTPUT_FILTER_ID_EMPTY -1
+
+typedef struct entity_id_s {
+	int basin_ID;
+	int hillslope_ID;
+	int zone_ID;
+	int patch_ID;
+	int canopy_strata_ID;
+} EntityID;
+
+// An entity output by a zone, patch or stratum filter, with the IDs written
+// alongside it (those of its group for grouped filters) and the area it is
+// weighted by, read when output is written so redefined areas are used;
+// see output_filter_resolve_entities()
+typedef struct of_entity {
+	EntityID id;
+	void *entity;
+	double const *area;
+} OutputFilterEntity;
+
 typedef enum {
 	OUTPUT_FILTER_UNDEFINED,
 	OUTPUT_FILTER_BASIN,
@@ -191,6 +242,11 @@ typedef struct of_filter {
 	OutputFilterStratum *strata;
 	OutputFilterVariable *variables;
 	num_elements_t num_variables;
+	OutputGroupBy group_by;
+	OutputAggregate aggregate;
+	char *group_map;
+	OutputFilterEntity *entities;
+	size_t num_entities;
 	bool parse_error;
 } OutputFilter;
 
@@ -10,15 +10,8 @@
 
 #include "output_filter.h"
 
-#define OUTPUT_FILTER_ID_EMPTY -1
-
-typedef struct entity_id_s {
-	int basin_ID;
-	int hillslope_ID;
-	int zone_ID;
-	int patch_ID;
-	int canopy_strata_ID;
-} EntityID;
+bool output_filter_resolve_entities(char * const error, size_t error_len,
+		OutputFilter * const f);
 
 bool output_filter_output_daily(char * const error, size_t error_len, bool verbose,
 		struct date date, OutputFilter const * const filters);
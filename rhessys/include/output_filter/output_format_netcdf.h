@@ -22,6 +22,8 @@
 #define OF_VAR_ZONE "zoneID"
 #define OF_VAR_PATCH "patchID"
 #define OF_VAR_STRATUM "stratumID"
+#define OF_VAR_FAMILY "familyID"
+#define OF_VAR_GROUP "groupID"
 
 
 typedef struct of_fmt_netcdf_meta {
@@ -0,0 +1,58 @@
+/** @file profile.h
+ *  @brief Defines a low-overhead hierarchical phase profiler enabled with
+ *  the -profile command line option.
+ *
+ *  Regions are bracketed with PROFILE_BEGIN()/PROFILE_END().  Each thread
+ *  keeps its own stack of open regions and its own counters, so regions
+ *  entered inside OpenMP loops need no synchronisation.  Time spent in a
+ *  region is reported inclusive and exclusive of nested regions opened on
+ *  the same thread, along with call counts and the imbalance (max / mean)
+ *  of inclusive time across the threads that entered the region.
+ *
+ *  @note When -profile is not given the macros cost one predictable
+ *  branch.  Building with -DRHESSYS_NO_PROFILE (make noprofile=T) removes
+ *  them entirely.
+ */
+#ifndef INCLUDE_PROFILE_H_
+#define INCLUDE_PROFILE_H_
+
+#include <stdio.h>
+
+typedef enum {
+	PROFILE_CONSTRUCT_WORLD,
+	PROFILE_CLIMATE_LOAD,
+	PROFILE_TEC_EVENT,
+	PROFILE_WORLD_DAILY_I,
+	PROFILE_WORLD_HOURLY,
+	PROFILE_WORLD_DAILY_F,
+	PROFILE_ZONE_DAILY_F,
+	PROFILE_PATCH_DAILY_F,
+	PROFILE_CANOPY_STRATUM_DAILY_F,
+	PROFILE_SUBSURFACE_ROUTING,
+	PROFILE_STREAM_ROUTING,
+	PROFILE_FIRE,
+	PROFILE_OUTPUT_HOURLY,
+	PROFILE_OUTPUT_DAILY,
+	PROFILE_OUTPUT_MONTHLY,
+	PROFILE_OUTPUT_YEARLY,
+	PROFILE_OUTPUT_STATE,
+	PROFILE_NUM_REGIONS
+} ProfileRegion;
+
+extern int profile_enabled;
+
+void profile_init(char *trace_filename);
+void profile_begin(ProfileRegion region);
+void profile_end(ProfileRegion region);
+void profile_report(FILE *out);
+void profile_destroy(void);
+
+#ifdef RHESSYS_NO_PROFILE
+#define PROFILE_BEGIN(region)
+#define PROFILE_END(region)
+#else
+#define PROFILE_BEGIN(region) do { if (profile_enabled) profile_begin(region); } while (0)
+#define PROFILE_END(region) do { if (profile_enabled) profile_end(region); } while (0)
+#endif
+
+#endif /* INCLUDE_PROFILE_H_ */
@@ -308,8 +308,104 @@ struct world_object
         struct  world_hourly_object     *hourly;
         struct  fire_object             **fire_grid;
 	struct patch_fire_object **patch_fire_grid;  //mk
+	struct patch_object **patch_fire_grid_patches; /* CSR storage backing patch_fire_grid[i][j].patches */
+	double *patch_fire_grid_prop; /* CSR storage backing patch_fire_grid[i][j].prop_patch_in_grid / prop_grid_in_patch */
+	struct patch_fire_cells_object *patch_fire_cells; /* inverse patch -> cells mapping of patch_fire_grid */
         struct  spinup_thresholds_list_object  *spinup_thresholds ;
 	struct  date			**master_hourly_date;
+	struct  world_id_index_object	*id_index; /* built on first use by construct_world_id_index */
+	struct  hourly_arena_object	*hourly_arena; /* backs world/basin/hillslope/stratum hourly objects */
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the world ID index object.                   */
+/*      Sorted (parent, ID) indexes over the hierarchy, see  */
+/*      init/construct_world_id_index.c                      */
+/*----------------------------------------------------------*/
+struct  id_index_s;
+struct  world_id_index_object
+        {
+        struct  id_index_s      *basins;
+        struct  id_index_s      *hillslopes;
+        struct  id_index_s      *zones;
+        struct  id_index_s      *patches;
+        struct  id_index_s      *strata;
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the hourly arena object.                     */
+/*      One block holding the hourly scratch objects of     */
+/*      the world, basins, hillslopes and strata, see       */
+/*      init/construct_hourly_arena.c                       */
+/*----------------------------------------------------------*/
+struct  hourly_arena_object
+        {
+        size_t  size;
+        char    *base;
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the hillslope arena object.                  */
+/*      Chunks of memory handed out in construction order,  */
+/*      freed together, see util/arena.c                    */
+/*----------------------------------------------------------*/
+struct  arena_chunk_object
+        {
+        struct  arena_chunk_object      *next;
+        size_t  size;
+        size_t  used;
+        char    *base;
+        };
+
+struct  arena_object
+        {
+        struct  arena_chunk_object      *chunks;
+        size_t  next_chunk_size;
+        size_t  num_bytes;
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the worldfile index objects.                 */
+/*      Where each basin and hillslope record starts in     */
+/*      the worldfile, see util/worldfile_index.c           */
+/*----------------------------------------------------------*/
+struct  hillslope_index_object
+        {
+        int     ID;
+        int     num_zones;
+        int     num_patches;
+        int     num_strata;
+        long    offset;
+        };
+
+struct  basin_index_object
+        {
+        int     ID;
+        int     num_hillslopes;
+        long    offset;
+        long    end_offset; /* just past the basin's last hillslope */
+        struct  hillslope_index_object  *hillslopes;
+        };
+
+struct  worldfile_index_object
+        {
+        int     num_basins;
+        long    offset; /* of the first basin record */
+        long    size;
+        unsigned long long      hash; /* FNV-1a of the whole worldfile */
+        struct  basin_index_object      *basins;
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the sub-catchment patch object.              */
+/*      A patch upstream of the -subcatchment outlet, see   */
+/*      util/subcatchment.c                                 */
+/*----------------------------------------------------------*/
+struct  subcatchment_patch_object
+        {
+        int     hill_ID;
+        int     zone_ID;
+        int     patch_ID;
         };
 
 
@@ -557,8 +653,10 @@ struct basin_object
         struct  base_station_object     **base_stations;
         struct  basin_default           **defaults;
         struct  basin_hourly_object     *hourly;
+        struct  solar_table_object      *solar_table;
         struct  grow_basin_object       *grow;
         struct  hillslope_object        **hillslopes;
+        int                             *hillslope_order;       /* by descending cost, see schedule_hillslopes.c */
         struct  patch_object            *outside_region;
         struct  stream_list_object      stream_list;
         struct  accumulate_patch_object acc_month;
@@ -580,6 +678,21 @@ struct  basin_hourly_object
         double  optical_air_mass;               /*      DIM     */
         };
 
+/*----------------------------------------------------------*/
+/*      Define the basin solar geometry table.              */
+/*      Hourly geometry and daylength for every year day    */
+/*      at the basin latitude, see                          */
+/*      init/construct_solar_table.c                        */
+/*----------------------------------------------------------*/
+#define SOLAR_TABLE_DAYS        366
+#define SOLAR_TABLE_HOURS       24
+struct  solar_table_object
+        {
+        double  latitude;       /* decimal degrees the table was built for */
+        double  daylength[SOLAR_TABLE_DAYS];            /*      s       */
+        struct  basin_hourly_object     hourly[SOLAR_TABLE_DAYS][SOLAR_TABLE_HOURS];
+        };
+
 /*----------------------------------------------------------*/
 /*      Define grow_basin_object extension.                             */
 /*----------------------------------------------------------*/
@@ -713,11 +826,23 @@ struct  dated_input_object
 
 /*----------------------------------------------------------*/
 /*      Define base station hourly  climate record .                    */
+/*      Hourly events are also indexed by (day, hour) at load   */
+/*      time (construct_hourly_clim_slots) so the hourly cycle  */
+/*      looks them up without moving the shared inx cursor.     */
 /*----------------------------------------------------------*/
+struct  hourly_clim_slots
+        {
+        long    first_day;                      /* julian day of slot 0 */
+        long    num_days;
+        double  *value;                         /* [num_days*24], -999.0 if no event, NULL if no sequence */
+        };
+
 struct  hourly_clim_object
         {
         struct clim_event_sequence rain;
         struct clim_event_sequence rain_duration;
+        struct hourly_clim_slots rain_slots;
+        struct hourly_clim_slots rain_duration_slots;
         };
 
 /*----------------------------------------------------------*/
@@ -836,6 +961,21 @@ struct  gw_object
 
         };
 /*----------------------------------------------------------*/
+/*      Patch drainage to the hillslope groundwater, summed     */
+/*      per zone by update_gw_drainage and added to the         */
+/*      hillslope's gw by add_zone_gw_drainage, in zone order,  */
+/*      once the zones have run.                                */
+/*----------------------------------------------------------*/
+
+struct  gw_drainage_object
+        {
+        double  storage;                /* m (water) */
+        double  NO3;            /* kgN/m2       */
+        double  NH4;            /* kgN/m2       */
+        double  DOC;            /* kgC/m2       */
+        double  DON;            /* kgN/m2       */
+        };
+/*----------------------------------------------------------*/
 /*      Define a hillslope object.                                                              */
 /*----------------------------------------------------------*/
 struct hillslope_object
@@ -871,9 +1011,12 @@ struct hillslope_object
         struct  zone_object             **zones;
         struct  accumulate_patch_object acc_month;
         struct  accumulate_patch_object acc_year;
+        struct  accumulate_patch_object basin_acc_month;        /* this hillslope's share of the basin's */
+        struct  accumulate_patch_object basin_acc_year;         /* until reduce_basin_accumulator */
 
         struct  routing_list_object     *route_list;
         struct  routing_list_object     *surface_route_list;
+        struct  arena_object            *arena; /* backs zones, patches, strata and innundation lists, NULL with -memprofile */
 
 /*      used in subsurface computation          */
         double hillslope_outflow;
@@ -890,6 +1033,12 @@ struct hillslope_object
         double preday_hillslope_return_flow;
         double preday_hillslope_detention_store;
 
+/*      used by the hillslope scheduler (util/schedule_hillslopes.c)    */
+        int     split_flag;             /* run zone chunks as separate tasks */
+        int     num_zone_chunks;
+        int     *zone_chunk_start;      /* [num_zone_chunks+1] zone index   */
+        double  cost;                   /* last day's cost, patches or s    */
+        double  measured_cost;          /* s spent today in zone_daily_F and routing */
         };
 
 /*----------------------------------------------------------*/
@@ -997,6 +1146,8 @@ struct accumulate_zone_object
    double tmin;
 };
 
+#define ZONE_CANOPY_RESYNC_DAYS 30    /* days between exact zone canopy sums */
+
 /*----------------------------------------------------------*/
 /*      Define a microclimate zone object.                                              */
 /*----------------------------------------------------------*/
@@ -1079,6 +1230,27 @@ struct zone_object
         double  w_horizon_topog;      /* cos of angle to normal of flat       */
         double  wind;                                   /* m/s          */
         double  wind_direction;                                 /* degrees      */
+        /*------------------------------------------------------*/
+        /*  cos_beam_slope = beam_slope_coef[0] * cos_declin_sin_hourangle */
+        /*      + beam_slope_coef[1] * cos_declin_cos_hourangle */
+        /*      + beam_slope_coef[2] * sin_declin               */
+        /*  set by compute_zone_solar_coefs when not valid      */
+        /*------------------------------------------------------*/
+        int     solar_coefs_valid;
+        double  beam_slope_coef[3];                     /*      DIM     */
+        double  diffuse_view_factor;                    /*      DIM     */
+        /*------------------------------------------------------*/
+        /*  area weighted patch canopy sums (m^2 * value),      */
+        /*  kept up to date by patch_daily_I and patch_daily_F  */
+        /*  and recomputed exactly by zone_daily_F every        */
+        /*  ZONE_CANOPY_RESYNC_DAYS days                        */
+        /*------------------------------------------------------*/
+        int     canopy_sums_age;                        /* days */
+        double  effective_lai_sum;
+        double  lai_sum;
+        double  total_stemc_sum;
+        double  height_sum;
+        struct  gw_drainage_object      gw_drainage;
         struct  base_station_object     **base_stations;
         struct  grow_zone_object        *grow;
         struct  metvar_struct           metv;
@@ -1148,6 +1320,24 @@ struct  landuse_default
         double  sh_l;                                   /* 0 - 1 */
         double  sh_g;                                   /* 0 - 1 */
 };
+/*----------------------------------------------------------*/
+/*      Define the soil class porosity profile table.       */
+/*      Saturation deficit at evenly spaced water table     */
+/*      depths, interpolated linearly both ways; see        */
+/*      init/construct_porosity_profile.c                   */
+/*----------------------------------------------------------*/
+#define POROSITY_PROFILE_TOLERANCE      1.0e-6  /* m */
+#define POROSITY_PROFILE_MAX_SEGMENTS   16384
+struct  porosity_profile_object
+        {
+        int     num_segments;
+        double  max_z;          /* m, depth of the last knot */
+        double  dz;             /* m, depth between knots */
+        double  bucket_size;    /* m water, sat_deficit per bucket */
+        double  *sat_deficit;   /* m water, [num_segments+1] knots */
+        int     *bucket;        /* [num_segments+1] segment at each bucket start */
+        };
+
 /*----------------------------------------------------------*/
 /*	Define an soil 	default object.						*/
 /*----------------------------------------------------------*/
@@ -1190,6 +1380,7 @@ struct	soil_default
 	double	fs_spill;					/* multiplier*/
 	double	fs_percolation;					/* multiplier */
 	double	fs_threshold;					/* percent of max sat_deficit, for fill and spill  */
+	double	fs_threshold_sat_deficit;			/* m water, sat_deficit at fs_threshold */
 	int	snow_albedo_flag;	/* (DIM) set as 1 for age model and 2 for BATS model */
 	double  bats_b;				/* unitless */
 	double  bats_r3;				/* unitless */
@@ -1210,6 +1401,7 @@ struct	soil_default
 	double  overstory_height_thresh;        /* Defines lower limit of overstory (m) */
 	double  understory_height_thresh;       /* Defines upper limit of understory (m) */
 	struct soil_class	soil_type;
+	struct porosity_profile_object	*porosity_profile;	/* NULL for exact math */
 	};
 
 /*----------------------------------------------------------*/
@@ -1658,6 +1850,7 @@ struct patch_object
         double  evaporation;            /* m  water*/
         double  evaporation_surf;       /* m  water*/
         double  family_horizon;         /* angle (theta) from flat to family horizon in radians */
+        int     tallest_stratum;        /* strata index, set by compute_family_shading */
         double  family_pct_cover;       /* 0 - 1, pct of patch family covered by patch */
         double  ga;                     /* m/s */
         double  ga_final;               /* m/s */
@@ -1833,6 +2026,7 @@ struct patch_object
         struct  patch_object            *shadow_litter;
         struct  patch_hourly_object     *hourly;
         struct  layer_object            *layers;
+        long                            *layer_strata;  /* [num_canopy_strata], backs layers[i].strata */
         struct  innundation_object      *innundation_list; // Used for subsurface routing, and surface routing when no surface table is provided
         struct  innundation_object      *surface_innundation_list; // Used for surface routing
         struct  neighbour_object        *neighbours;
@@ -2186,6 +2380,27 @@ struct  command_line_object
         bool					output_filter_strata_accum_yearly;
 
         bool    legacy_output_flag; // Remove when legacy output is removed.
+        int     profile_flag;
+        char    *profile_trace_filename; // Chrome trace JSON, NULL for summary only
+        int     exact_porosity_flag; // skip the soil porosity profile tables
+        int     output_precision; // digits after the decimal point of %f output
+        int     memprofile_flag;
+        char    *memprofile_filename; // memory report, NULL for stderr
+        int     scenarios_flag;
+        char    *scenarios_filename; // one scenario per line, see fork_scenarios.c
+        int     scenario_jobs; // scenarios run at once, 0 for one per core
+        struct  world_object    *scenario_world; // loaded world whose climate a scenario reuses
+        int     worldindex_flag;
+        int     num_hillslope_subset;
+        int     *hillslope_subset; // sorted IDs of the only hillslopes to load
+        int     subcatchment_flag;
+        int     subcatchment_patch_ID; // outlet patch of the sub-catchment
+        int     subcatchment_zone_ID;
+        int     subcatchment_hill_ID;
+        int     num_subcatchment_patches;
+        struct  subcatchment_patch_object       *subcatchment_patches; // sorted by hill, zone, patch
+        int     num_subcatchment_reaches;
+        int     *subcatchment_reaches; // sorted IDs of the stream reaches kept with -str
         struct  b_option        *b;
         struct  h_option        *h;
         struct  z_option        *z;
@@ -3030,6 +3245,19 @@ struct patch_fire_object
 	int wui_flag; // a flag, 1 if pixel within wui buffer, 0 otherwise
 };
 
+/*----------------------------------------------------------*/
+/* Inverse (patch -> cells) mapping of the patch fire grid, */
+/* in CSR form, so fire effects can be applied per patch.   */
+/*----------------------------------------------------------*/
+struct patch_fire_cells_object
+{
+	int num_patches;
+	struct patch_object **patches; /* unique patches on the fire grid */
+	int *cell_start; /* num_patches+1 offsets into cells/slots */
+	int *cells; /* row-major cell index, i*num_fire_grid_col + j, in row-major order per patch */
+	int *slots; /* index of the patch within patch_fire_grid cell's patches array */
+};
+
 /*----------------------------------------------------------*/
 /* Define Surface Temperature Object */
 /*----------------------------------------------------------*/
@@ -9,7 +9,8 @@
 /*  SYNOPSIS                                                    */
 /*  assign_neighbours( struct patch_object *patch)				*/
 /*						int num_neighbours,						*/
-/*						FILE *routing_file)						*/
+/*						FILE *routing_file,						*/
+/*						struct command_line_object *command_line) */
 /*                                                              */
 /*  OPTIONS                                                     */
 /*                                                              */
@@ -18,6 +19,11 @@
 /*                                                              */
 /*	assigns pointers to neighbours of each patch				*/
 /*	as given in topology input file								*/
+/*																*/
+/*	With -subcatchment, neighbours outside the sub-catchment	*/
+/*	were not constructed and are left out like zero gamma		*/
+/*	ones; their share of the flow leaves the model.  A NULL		*/
+/*	command_line keeps every neighbour.							*/
 /*                                                              */
 /*  PROGRAMMER NOTES                                            */
 /*                                                              */
@@ -29,13 +35,15 @@
 int assign_neighbours_in_hillslope( struct neighbour_object *neighbours,
 					   int num_neighbours,
              struct hillslope_object *hillslope,
-					   FILE *routing_file)
+					   FILE *routing_file,
+					   struct command_line_object *command_line)
 {
 	/*--------------------------------------------------------------*/
 	/*  Local function declaration                                  */
 	/*--------------------------------------------------------------*/
 	void *alloc (size_t, char *, char *);
 	struct patch_object *find_patch_in_hillslope( int, int, struct hillslope_object*);
+	int	patch_in_subcatchment(struct command_line_object *, int, int, int);
 	
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
@@ -69,6 +77,10 @@ int assign_neighbours_in_hillslope( struct neighbour_object *neighbours,
 
 //		printf("\t\tassign_neigh(%d): patch: %d, zone: %d, hill: %d\n", i, patch_ID, zone_ID, hill_ID);
 
+		if ((gamma > 0.0) && (command_line != NULL) &&
+				(patch_in_subcatchment(command_line, patch_ID, zone_ID, hill_ID) == 0))
+			gamma = 0.0;
+
 		if (gamma > 0.0) {
 			if( (patch_ID != 0) && (zone_ID != 0) && (hill_ID != 0) ) {
 				neigh = find_patch_in_hillslope( patch_ID, zone_ID, hillslope);
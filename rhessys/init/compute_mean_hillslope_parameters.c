@@ -30,6 +30,7 @@
 /*	Original code, January 16, 2003.							*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include "rhessys.h"
 
 void compute_mean_hillslope_parameters( struct hillslope_object *hillslope)
@@ -103,3 +104,37 @@ void compute_mean_hillslope_parameters( struct hillslope_object *hillslope)
 	return;
 
 	} /* end compute_mean_hillslope_parameters */
+
+/*--------------------------------------------------------------*/
+/*	compute_mean_hillslope_parameters_list			*/
+/*	Recomputes the means of a list of hillslopes in parallel.	*/
+/*	The list may contain repeats (e.g. a hillslope redefined	*/
+/*	twice); it is sorted and made unique first so no two		*/
+/*	threads update the same hillslope.			*/
+/*--------------------------------------------------------------*/
+static int compare_hillslope_ptr(const void *a, const void *b)
+{
+	const struct hillslope_object *h1 = *(struct hillslope_object * const *) a;
+	const struct hillslope_object *h2 = *(struct hillslope_object * const *) b;
+	return (h1 < h2) ? -1 : (h1 > h2);
+}
+
+void compute_mean_hillslope_parameters_list( struct hillslope_object **hillslopes,
+											int num_hillslopes)
+{
+	int i, n;
+
+	if (num_hillslopes <= 0) return;
+	qsort(hillslopes, num_hillslopes, sizeof(struct hillslope_object *), compare_hillslope_ptr);
+	n = 1;
+	for (i = 1; i < num_hillslopes; i++) {
+		if (hillslopes[i] != hillslopes[n-1])
+			hillslopes[n++] = hillslopes[i];
+	}
+
+	#pragma omp parallel for
+	for (int h = 0; h < n; h++)
+		compute_mean_hillslope_parameters(hillslopes[h]);
+
+	return;
+} /* end compute_mean_hillslope_parameters_list */
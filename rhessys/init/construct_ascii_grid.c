@@ -310,6 +310,8 @@ struct base_station_object **construct_ascii_grid (
 		/*	Initialize non - critical sequences.						*/
 		base_stations[i][0].hourly_clim[0].rain.inx = -999;
 		base_stations[i][0].hourly_clim[0].rain_duration.inx = -999;
+		base_stations[i][0].hourly_clim[0].rain_slots.value = NULL;
+		base_stations[i][0].hourly_clim[0].rain_duration_slots.value = NULL;
 	}
 
 	fclose(base_station_file );	
@@ -14,7 +14,8 @@
 /*			int		num_world_base_stations,					*/
 /*			struct base_station_object	**world_base_stations,	*/
 /*			struct basin_object	**basin_list,					*/
-/*			struct default_object *defaults)					*/
+/*			struct default_object *defaults,					*/
+/*			struct basin_index_object *basin_index)				*/
 /* 																*/
 /*																*/
 /*	OPTIONS														*/
@@ -26,6 +27,13 @@
 /*		- a possible extension to a grow object					*/
 /*		- a list of hillslopes in the basin.					*/
 /*																*/
+/*	With a worldfile index (basin_index not NULL) the			*/
+/*	hillslopes are constructed in parallel, biggest first,		*/
+/*	each thread reading its hillslope through its own FILE,		*/
+/*	and only those listed with -hillslopes are loaded.			*/
+/*	world_file is then left just past the basin's last			*/
+/*	hillslope, where the sequential read would leave it.		*/
+/*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
 /*	Basins dont own climate files since all of their hillslopes	*/
@@ -60,6 +68,19 @@
 #include "functions.h"
 #include "params.h"
 
+static struct basin_index_object *sort_index;
+static int *sort_selected;
+
+static int compare_hillslope_size(const void *a, const void *b)
+{
+  int na = sort_index[0].hillslopes[sort_selected[*(const int *)a]].num_patches;
+  int nb = sort_index[0].hillslopes[sort_selected[*(const int *)b]].num_patches;
+
+  if (na > nb) return(-1);
+  if (na < nb) return(1);
+  return(*(const int *)a - *(const int *)b);
+}
+
 struct basin_object *construct_basin(
     struct	command_line_object	*command_line,
     FILE	*world_file,
@@ -67,7 +88,8 @@ struct basin_object *construct_basin(
     struct base_station_object	**world_base_stations,
     struct	default_object	*defaults,
     struct base_station_ncheader_object *base_station_ncheader,
-    struct world_object *world)
+    struct world_object *world,
+    struct basin_index_object *basin_index)
 {
   /*--------------------------------------------------------------*/
   /*	Local function definition.									*/
@@ -87,6 +109,11 @@ struct basin_object *construct_basin(
       struct world_object *);
 
   void	*alloc( 	size_t, char *, char *);
+  void	alloc_free(void *);
+
+  int	hillslope_in_subset(struct command_line_object *, int);
+
+  void	skip_routing_topology(FILE *);
 
   void	sort_by_elevation( struct basin_object *);
 
@@ -115,6 +142,7 @@ struct basin_object *construct_basin(
   FILE  *surface_routing_file;
   struct hillslope_object *hillslope;
   int hillslope_ID;
+  int *selected, *order;
 
   /*--------------------------------------------------------------*/
   /*	Allocate a basin object.								*/
@@ -141,6 +169,8 @@ struct basin_object *construct_basin(
   /*	Create cosine of latitude to save future computations.		*/
   /*--------------------------------------------------------------*/
   basin[0].cos_latitude = cos(basin[0].latitude*DtoR);
+  basin[0].solar_table = NULL;
+  basin[0].hillslope_order = NULL;
   basin[0].sin_latitude = sin(basin[0].latitude*DtoR);
 
   /*--------------------------------------------------------------*/
@@ -209,6 +239,19 @@ struct basin_object *construct_basin(
   fscanf(world_file,"%d",&(basin[0].num_hillslopes));
   read_record(world_file, record);
 
+  /*--------------------------------------------------------------*/
+  /*	With the worldfile index, pick out the hillslopes to load	*/
+  /*	in worldfile order.											*/
+  /*--------------------------------------------------------------*/
+  selected = NULL;
+  if (basin_index != NULL) {
+    selected = (int *) alloc(basin_index[0].num_hillslopes * sizeof(int),
+        "selected","construct_basin");
+    basin[0].num_hillslopes = 0;
+    for (i=0; i<basin_index[0].num_hillslopes; i++)
+      if (hillslope_in_subset(command_line, basin_index[0].hillslopes[i].ID))
+        selected[basin[0].num_hillslopes++] = i;
+  }
 
   /*--------------------------------------------------------------*/
   /*	Allocate a list of pointers to hillslope objects.			*/
@@ -224,13 +267,61 @@ struct basin_object *construct_basin(
   /*--------------------------------------------------------------*/
   /*	Construct the hillslopes for this basin.					*/
   /*--------------------------------------------------------------*/
-  for (int i=0; i<basin[0].num_hillslopes; i++){
-    printf("\n Reading hillslope %d\n", i);
-    basin[0].hillslopes[i] = construct_hillslope(
-        command_line, world_file, num_world_base_stations,
-        world_base_stations, defaults, base_station_ncheader, world
-        );
+  if (basin_index == NULL) {
+    for (int i=0; i<basin[0].num_hillslopes; i++){
+      printf("\n Reading hillslope %d\n", i);
+      basin[0].hillslopes[i] = construct_hillslope(
+          command_line, world_file, num_world_base_stations,
+          world_base_stations, defaults, base_station_ncheader, world
+          );
+    }
+  } else {
+    /*--------------------------------------------------------------*/
+    /*	Biggest first, so a large hillslope is not left to the end.	*/
+    /*--------------------------------------------------------------*/
+    order = (int *) alloc(basin[0].num_hillslopes * sizeof(int),
+        "order","construct_basin");
+    for (i=0; i<basin[0].num_hillslopes; i++)
+      order[i] = i;
+    sort_index = basin_index;
+    sort_selected = selected;
+    qsort(order, basin[0].num_hillslopes, sizeof(int), compare_hillslope_size);
 
+    /*--------------------------------------------------------------*/
+    /*	Hillslopes are built in parallel; alloc() is thread safe,	*/
+    /*	including its -memprofile accounting.			*/
+    /*--------------------------------------------------------------*/
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int k=0; k<basin[0].num_hillslopes; k++){
+      int h = order[k];
+      struct hillslope_index_object *hillslope_index = &(basin_index[0].hillslopes[selected[h]]);
+      FILE *hillslope_file;
+
+      if ( (hillslope_file = fopen(command_line[0].world_filename,"r")) == NULL ){
+        fprintf(stderr,"FATAL ERROR:  Cannot open world file %s\n",
+            command_line[0].world_filename);
+        exit(EXIT_FAILURE);
+      }
+      fseek(hillslope_file, hillslope_index[0].offset, SEEK_SET);
+      printf("\n Reading hillslope %d\n", h);
+      basin[0].hillslopes[h] = construct_hillslope(
+          command_line, hillslope_file, num_world_base_stations,
+          world_base_stations, defaults, base_station_ncheader, world
+          );
+      fclose(hillslope_file);
+      if (basin[0].hillslopes[h][0].ID != hillslope_index[0].ID) {
+        fprintf(stderr,
+            "FATAL ERROR: in construct_basin, worldfile index has hillslope %d where hillslope %d is\n",
+            hillslope_index[0].ID, basin[0].hillslopes[h][0].ID);
+        exit(EXIT_FAILURE);
+      }
+    }
+    fseek(world_file, basin_index[0].end_offset, SEEK_SET);
+    alloc_free(order);
+    alloc_free(selected);
+  }
+
+  for (int i=0; i<basin[0].num_hillslopes; i++){
     basin[0].area += basin[0].hillslopes[i][0].area;
     n_routing_timesteps += basin[0].hillslopes[i][0].area * basin[0].hillslopes[i][0].defaults[0][0].n_routing_timesteps;
     if (basin[0].max_slope < basin[0].hillslopes[i][0].slope)
@@ -360,6 +451,14 @@ struct basin_object *construct_basin(
     // THIS IS WHERE OPENMP WILL PARALLELIZE
     for (int i=0; i<num_hillslopes; i++){
       fscanf( routing_file, "%d", &hillslope_ID );
+      if ( hillslope_in_subset(command_line, hillslope_ID) == 0 ) {
+        skip_routing_topology( routing_file );
+        if ( command_line->surface_routing_flag == 1 ) {
+          fscanf( surface_routing_file, "%d", &hillslope_ID );
+          skip_routing_topology( surface_routing_file );
+        }
+        continue;
+      }
       hillslope = find_hillslope_in_basin( hillslope_ID, basin );
       if ( command_line[0].ddn_routing_flag == 1 ) {
         hillslope->route_list = construct_ddn_routing_topology( routing_file, hillslope);
@@ -406,6 +505,10 @@ struct basin_object *construct_basin(
 
       for (int i=0; i<num_hillslopes; i++){
         fscanf( routing_file, "%d", &hillslope_ID );
+        if ( hillslope_in_subset(command_line, hillslope_ID) == 0 ) {
+          skip_routing_topology( routing_file );
+          continue;
+        }
         hillslope = find_hillslope_in_basin( hillslope_ID, basin );
         hillslope->surface_route_list = construct_routing_topology( routing_file, hillslope, command_line, true );
       }	
@@ -47,7 +47,8 @@ struct canopy_strata_object *construct_canopy_strata(
 													 struct	patch_object	*patch,
 													 int		num_world_base_stations,
 													 struct base_station_object **world_base_stations,
-													 struct	default_object	*defaults)
+													 struct	default_object	*defaults,
+													 struct	arena_object	*arena)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -101,6 +102,7 @@ struct canopy_strata_object *construct_canopy_strata(
 		double);
 
 	void	*alloc(size_t, char *, char *);
+	void	*arena_alloc(struct arena_object *, size_t, char *, char *);
 
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -116,7 +118,7 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*--------------------------------------------------------------*/
 	/*  Allocate a canopy_strata object.                                */
 	/*--------------------------------------------------------------*/
-	canopy_strata = (struct canopy_strata_object *) alloc( 1 *
+	canopy_strata = (struct canopy_strata_object *) arena_alloc(arena, 1 *
 		sizeof( struct canopy_strata_object ),"canopy_strata",
 		"construct_canopy_strata" );
 	
@@ -274,7 +276,7 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*	Assign	defaults for this canopy_strata								*/
 	/*--------------------------------------------------------------*/
 	canopy_strata[0].defaults = (struct stratum_default **)
-		alloc( sizeof(struct stratum_default *),"defaults",
+		arena_alloc(arena, sizeof(struct stratum_default *),"defaults",
 		"construct_canopy_strata" );
 	i = 0;
 	while (defaults[0].stratum[i].ID != canopy_strata[0].veg_parm_ID) {
@@ -297,7 +299,7 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*--------------------------------------------------------------*/
 	if (command_line[0].vegspinup_flag > 0) {
 	canopy_strata[0].spinup_defaults = (struct spinup_default **)
-		alloc( sizeof(struct spinup_default *),"defaults",
+		arena_alloc(arena, sizeof(struct spinup_default *),"defaults",
 		"construct_stratum" );
 	i = 0;
 	while (defaults[0].spinup[i].ID != spinup_default_object_ID) {
@@ -696,7 +698,7 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*    Allocate a list of base stations for this strata.			*/
 	/*--------------------------------------------------------------*/
 	canopy_strata[0].base_stations = (struct base_station_object **)
-		alloc(canopy_strata[0].num_base_stations *
+		arena_alloc(arena, canopy_strata[0].num_base_stations *
 		sizeof(struct base_station_object *),"base_stations",
 		"construct_canopy_strata");
 	/*--------------------------------------------------------------*/
@@ -39,6 +39,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include "rhessys.h"
+#include "fast_format.h"
+
+static int compare_hillslope_ID(const void *a, const void *b)
+{
+	return((*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b));
+}
+
 struct	command_line_object	*construct_command_line(
 													int main_argc,
 													char **main_argv)
@@ -53,7 +60,7 @@ struct	command_line_object	*construct_command_line(
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
-	int		i;
+	int		i, j, k;
 	struct	command_line_object	*command_line;
 	
 	/*--------------------------------------------------------------*/
@@ -143,6 +150,24 @@ struct	command_line_object	*construct_command_line(
 	command_line[0].thresholds[STREAMFLOW] = 0.0;
 	command_line[0].snow_scale_tol = 999999999;
 	command_line[0].multiscale_flag = 0;
+	command_line[0].profile_flag = 0;
+	command_line[0].profile_trace_filename = NULL;
+	command_line[0].exact_porosity_flag = 0;
+	command_line[0].output_precision = FAST_FORMAT_DEFAULT_DECIMALS;
+	command_line[0].memprofile_flag = 0;
+	command_line[0].memprofile_filename = NULL;
+	command_line[0].scenarios_flag = 0;
+	command_line[0].scenarios_filename = NULL;
+	command_line[0].scenario_jobs = 0;
+	command_line[0].scenario_world = NULL;
+	command_line[0].worldindex_flag = 0;
+	command_line[0].num_hillslope_subset = 0;
+	command_line[0].hillslope_subset = NULL;
+	command_line[0].subcatchment_flag = 0;
+	command_line[0].num_subcatchment_patches = 0;
+	command_line[0].subcatchment_patches = NULL;
+	command_line[0].num_subcatchment_reaches = 0;
+	command_line[0].subcatchment_reaches = NULL;
 	command_line[0].cpool_mort_fract = 0;
 	command_line[0].sat_to_gw_coeff_mult = 1;
 	command_line[0].gw_loss_coeff_mult = 1;
@@ -1247,6 +1272,137 @@ struct	command_line_object	*construct_command_line(
 			}/* end if */
 
 
+			/*--------------------------------------------------------------*/
+			/*	Phase profiler, with an optional Chrome trace filename	*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-profile") == 0) {
+				command_line[0].profile_flag = 1;
+				i++;
+				if ((i != main_argc) && (main_argv[i][0] != '-')) {
+					command_line[0].profile_trace_filename =
+						(char *) alloc((1+strlen(main_argv[i]))*sizeof(char),
+						"profile_trace_filename","construct_command_line");
+					strcpy(command_line[0].profile_trace_filename, main_argv[i]);
+					i++;
+				}/*end if*/
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Exact porosity math instead of the soil profile tables	*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-exactporosity") == 0) {
+				command_line[0].exact_porosity_flag = 1;
+				i++;
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Digits after the decimal point of %f output values	*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-outprecision") == 0) {
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Value for output precision not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].output_precision = atoi(main_argv[i]);
+				i++;
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Memory accounting by alloc() tag, with an optional report	*/
+			/*	filename													*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-memprofile") == 0) {
+				command_line[0].memprofile_flag = 1;
+				i++;
+				if ((i != main_argc) && (main_argv[i][0] != '-')) {
+					command_line[0].memprofile_filename =
+						(char *) alloc((1+strlen(main_argv[i]))*sizeof(char),
+						"memprofile_filename","construct_command_line");
+					strcpy(command_line[0].memprofile_filename, main_argv[i]);
+					i++;
+				}/*end if*/
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Scenario batch over one loaded world, with an optional	*/
+			/*	number of scenarios to run at once						*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-scenarios") == 0) {
+				command_line[0].scenarios_flag = 1;
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Scenarios filename not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].scenarios_filename =
+					(char *) alloc((1+strlen(main_argv[i]))*sizeof(char),
+					"scenarios_filename","construct_command_line");
+				strcpy(command_line[0].scenarios_filename, main_argv[i]);
+				i++;
+				if ((i != main_argc) && (valid_option(main_argv[i])==0)){
+					command_line[0].scenario_jobs = atoi(main_argv[i]);
+					if (command_line[0].scenario_jobs < 1) {
+						fprintf(stderr,"FATAL ERROR: Number of scenario jobs must be at least 1\n");
+						exit(EXIT_FAILURE);
+					} /*end if*/
+					i++;
+				}/*end if*/
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Load hillslopes in parallel from the worldfile index	*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-worldindex") == 0) {
+				command_line[0].worldindex_flag = 1;
+				i++;
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Load only the listed hillslopes							*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-hillslopes") == 0) {
+				i++;
+				for (j = i; (j != main_argc) && (valid_option(main_argv[j])==0); j++);
+				if (j == i){
+					fprintf(stderr,"FATAL ERROR: Hillslope IDs not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].hillslope_subset = (int *) alloc((j - i) * sizeof(int),
+					"hillslope_subset","construct_command_line");
+				command_line[0].num_hillslope_subset = 0;
+				for (; i < j; i++)
+					command_line[0].hillslope_subset[command_line[0].num_hillslope_subset++] =
+						atoi(main_argv[i]);
+				/*--------------------------------------------------------------*/
+				/*	Sorted, without duplicates, for hillslope_in_subset		*/
+				/*--------------------------------------------------------------*/
+				qsort(command_line[0].hillslope_subset, command_line[0].num_hillslope_subset,
+					sizeof(int), compare_hillslope_ID);
+				for (j = 1, k = 1; j < command_line[0].num_hillslope_subset; j++)
+					if (command_line[0].hillslope_subset[j] != command_line[0].hillslope_subset[k-1])
+						command_line[0].hillslope_subset[k++] = command_line[0].hillslope_subset[j];
+				command_line[0].num_hillslope_subset = k;
+			}/* end if */
+
+			/*--------------------------------------------------------------*/
+			/*	Load only the patches upstream of an outlet patch		*/
+			/*	following the subsurface flow table (the first -r file)	*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-subcatchment") == 0) {
+				if ((i + 3 >= main_argc) || (valid_option(main_argv[i+1]) == 1) ||
+						(valid_option(main_argv[i+2]) == 1) ||
+						(valid_option(main_argv[i+3]) == 1)) {
+					fprintf(stderr,"FATAL ERROR: Sub-catchment outlet patch, zone and hillslope IDs not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].subcatchment_flag = 1;
+				command_line[0].subcatchment_patch_ID = atoi(main_argv[i+1]);
+				command_line[0].subcatchment_zone_ID = atoi(main_argv[i+2]);
+				command_line[0].subcatchment_hill_ID = atoi(main_argv[i+3]);
+				i += 4;
+			}/* end if */
+
 			/*--------------------------------------------------------------*/
 			/*	NOTE:  ADD MORE OPTION PARSING HERE.						*/
 			/*--------------------------------------------------------------*/
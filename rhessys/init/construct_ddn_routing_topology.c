@@ -49,9 +49,11 @@ struct routing_list_object *construct_ddn_routing_topology(
 		struct neighbour_object *,
 		int,
     	struct hillslope_object *,
-		FILE *);
+		FILE *,
+		struct command_line_object *);
 	
 	void *alloc(size_t, char *, char *);
+	void	*arena_alloc(struct arena_object *, size_t, char *, char *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -110,7 +112,7 @@ struct routing_list_object *construct_ddn_routing_topology(
 		/*--------------------------------------------------------------*/
 		/*  Allocate innundation depth array				*/
 		/*--------------------------------------------------------------*/
-		patch[0].innundation_list = (struct innundation_object *)alloc(num_innundation_depths *
+		patch[0].innundation_list = (struct innundation_object *)arena_alloc(hillslope[0].arena, num_innundation_depths *
 		sizeof(struct innundation_object), "innundation_list", "assign_neighbours");
 
 		for (d=0; d<num_innundation_depths; d++) {
@@ -127,9 +129,9 @@ struct routing_list_object *construct_ddn_routing_topology(
 			/*--------------------------------------------------------------*/
 			/*  Allocate neighbour array									*/
 			/*--------------------------------------------------------------*/
-			patch[0].innundation_list[d].neighbours = (struct neighbour_object *)alloc(num_neighbours *
+			patch[0].innundation_list[d].neighbours = (struct neighbour_object *)arena_alloc(hillslope[0].arena, num_neighbours *
 			sizeof(struct neighbour_object), "neighbours", "assign_neighbours");
-			patch[0].innundation_list[d].num_neighbours = assign_neighbours_in_hillslope(patch[0].innundation_list[d].neighbours, num_neighbours,  hillslope, routing_file);
+			patch[0].innundation_list[d].num_neighbours = assign_neighbours_in_hillslope(patch[0].innundation_list[d].neighbours, num_neighbours,  hillslope, routing_file, NULL);
 		
 		}
 		if (drainage_type == 2) {
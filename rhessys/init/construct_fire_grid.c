@@ -29,391 +29,330 @@
 /*	Assumes patches are square.  No guarantee of performance otherwise		*/
 /* Updated May 16, 2013 to allow for a raster grid of patch id's be used to create	*/
 /* the fire grid. gives a better approximation of irregularly-shaped patches		*/
+/*															*/
+/* Cells are stored contiguously (rows point into a single block) and the	*/
+/* cell->patch mapping is kept in compressed sparse row form: each cell's	*/
+/* patches/prop arrays point into shared arrays owned by the world.		*/
+/* Patch IDs are resolved through an ID index rather than a hierarchy scan.	*/
+/*															*/
+/* The patch and DEM grids may be tab-delimited text (no header) or binary.	*/
+/* A binary grid starts with a 16 byte header:				*/
+/*	char magic[4] = "RHFG"							*/
+/*	int32 n_rows, int32 n_cols						*/
+/*	int32 type  (1 = float32, 2 = float64, 3 = int32)			*/
+/* followed by n_rows*n_cols values in row-major order, native byte order.	*/
 /*-----------------------------------------------------------------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <math.h>
 #include <time.h>
 #include "rhessys.h"
-// local function definition:
-/*double calc_patch_area_in_grid(double curMinX,double curMinY,double curMaxX,double curMaxY,double cellMaxX,
-							double cellMaxY,double cellMinX,double cellMinY,double cell_res);*/
+#include "id_index.h"
 
-struct fire_object **construct_patch_fire_grid (struct world_object *world, struct command_line_object *command_line,struct fire_default def)
+#define FIRE_RASTER_MAGIC "RHFG"
+#define FIRE_RASTER_FLOAT32 1
+#define FIRE_RASTER_FLOAT64 2
+#define FIRE_RASTER_INT32 3
 
+struct fire_raster_reader
 {
-	/*--------------------------------------------------------------*/
-	/*	Local function definition.									*/
-	/*--------------------------------------------------------------*/
-
-	/*--------------------------------------------------------------*/
-	/*	Local variable definition.									*/
-	/*--------------------------------------------------------------*/
-	
-	//MCK: time process
-	clock_t start, end;
-	double time_used;
-	start=clock();
-	struct patch_fire_object **fire_grid;
-	struct patch_object *patch;
-	int  b, h, p, z, i, j, k, pf;
-//	double maxx, maxy, minx, miny, tmp,halfSideLength,curMinX,curMinY,curMaxX,curMaxY, cell_res;
-	double cell_res,tmp;
-/*	maxx=-10000; // depends on the origin for the coordinates, this was set for HJA centered at 0,0
-	minx=-10000;
-	maxy=-10000;
-	miny=-10000;*/
-	int grid_dimX,grid_dimY;
-	
-	//typedef struct node_fire_wui_dist *node;
-//	node *tmp_node; // for wui linked list
+	FILE *file;
+	int binary; /* 0 for tab-delimited text, 1 for binary */
+	int type; /* FIRE_RASTER_* value type of a binary raster */
+	char *filename;
+};
 
-	cell_res =  command_line[0].fire_grid_res; //  grid resolution 
-//	printf("cell res: %lf\n",cell_res);
+/*--------------------------------------------------------------*/
+/*	Open a patch or DEM raster, detecting the binary header.	*/
+/*--------------------------------------------------------------*/
+static void open_fire_raster(struct fire_raster_reader *reader, char *filename, int n_rows, int n_cols)
+{
+	char magic[4];
+	int32_t header[3];
 
+	reader->filename = filename;
+	reader->binary = 0;
+	reader->type = 0;
+	if ((reader->file = fopen(filename, "rb")) == NULL) {
+		fprintf(stderr, "FATAL ERROR: Unable to open fire grid file %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	if (fread(magic, sizeof(char), 4, reader->file) == 4 && memcmp(magic, FIRE_RASTER_MAGIC, 4) == 0) {
+		if (fread(header, sizeof(int32_t), 3, reader->file) != 3) {
+			fprintf(stderr, "FATAL ERROR: Truncated binary fire grid header in %s\n", filename);
+			exit(EXIT_FAILURE);
+		}
+		if (header[0] != n_rows || header[1] != n_cols) {
+			fprintf(stderr, "FATAL ERROR: Fire grid %s is %d x %d, fire defaults expect %d x %d\n",
+				filename, header[0], header[1], n_rows, n_cols);
+			exit(EXIT_FAILURE);
+		}
+		if (header[2] != FIRE_RASTER_FLOAT32 && header[2] != FIRE_RASTER_FLOAT64 && header[2] != FIRE_RASTER_INT32) {
+			fprintf(stderr, "FATAL ERROR: Unknown value type %d in binary fire grid %s\n", header[2], filename);
+			exit(EXIT_FAILURE);
+		}
+		reader->binary = 1;
+		reader->type = header[2];
+	} else {
+		rewind(reader->file);
+	}
+}
 
-	if(def.n_rows!=-1) // then we just read in the raster structure
-	{
-		// allocate the fire grid
-		printf("reading patch raster structure\n");
-		
-		grid_dimX=def.n_cols;
-		grid_dimY=def.n_rows;
-		
-                world[0].num_fire_grid_row = grid_dimY;
-                world[0].num_fire_grid_col = grid_dimX;
+/*--------------------------------------------------------------*/
+/*	Read one full raster in row-major order into values.		*/
+/*--------------------------------------------------------------*/
+static void read_fire_raster(struct fire_raster_reader *reader, double *values, size_t num_cells, double nodata)
+{
+	size_t k, n_read;
+	float *buf32;
+	int32_t *bufi;
 
+	if (reader->binary == 0) {
+		for (k = 0; k < num_cells; k++) {
+			values[k] = nodata;
+			if (fscanf(reader->file, "%lf", &values[k]) != 1) {
+				fprintf(stderr, "WARNING: Fire grid %s ended after %zu of %zu cells\n",
+					reader->filename, k, num_cells);
+				for (; k < num_cells; k++) values[k] = nodata;
+				break;
+			}
+		}
+		return;
+	}
 
-		
-		fire_grid=(struct patch_fire_object **) malloc(grid_dimY*sizeof(struct patch_fire_object *)); // first allocate the rows
-		for(i=0;i<grid_dimY;i++) // for each row, allocate the columns
-			fire_grid[i]=(struct patch_fire_object *) malloc(grid_dimX*sizeof(struct patch_fire_object ));
-		printf("allocate the fire grid\n");
-			
-		
-	 
-		/*if(def.include_wui==1)
-		{	
-			double tmp.dists[def.nWUI];// intended to initialize an array of distances to all wuis in a watershed
-			for(w=0;w<def.nWUI;w++)
-				tmp.dists[w]=0;	
-		}*/	
+	switch (reader->type) {
+	case FIRE_RASTER_FLOAT64:
+		n_read = fread(values, sizeof(double), num_cells, reader->file);
+		break;
+	case FIRE_RASTER_FLOAT32:
+		buf32 = (float *) malloc(num_cells * sizeof(float));
+		n_read = fread(buf32, sizeof(float), num_cells, reader->file);
+		for (k = 0; k < n_read; k++) values[k] = (double) buf32[k];
+		free(buf32);
+		break;
+	default:
+		bufi = (int32_t *) malloc(num_cells * sizeof(int32_t));
+		n_read = fread(bufi, sizeof(int32_t), num_cells, reader->file);
+		for (k = 0; k < n_read; k++) values[k] = (double) bufi[k];
+		free(bufi);
+		break;
+	}
+	if (n_read != num_cells) {
+		fprintf(stderr, "FATAL ERROR: Binary fire grid %s has %zu of %zu cells\n",
+			reader->filename, n_read, num_cells);
+		exit(EXIT_FAILURE);
+	}
+}
 
-                double tmpPatchID;
-                FILE *patchesIn;
-                patchesIn=fopen(command_line[0].firegrid_patch_filename,"r");
-		FILE *demIn;
-		demIn=fopen(command_line[0].firegrid_dem_filename,"r");
+/*--------------------------------------------------------------*/
+/*	Build an ID -> patch index over the whole world.		*/
+/*	Traversal order matches the former hierarchy scan so that	*/
+/*	duplicate patch IDs resolve to the same (last) patch.		*/
+/*--------------------------------------------------------------*/
+static IdIndex_t *construct_fire_patch_index(struct world_object *world)
+{
+	int b, h, z, p;
+	struct zone_object *zone;
+	IdIndex_t *index;
 
-		// then initialize values: e.g., 0's 
-		// readin patch structure
-		// find matching patches
-		// readin dem
-		 for(i=0;i<grid_dimY;i++){
-			for(j=0;j<grid_dimX;j++){
-				fire_grid[i][j].occupied_area=0;
-		//		fire_grid[j][i].num_patches=0;
-				fire_grid[i][j].tmp_patch=0;
-				//if(def.include_wui==1)
-			//		fire_grid[j][i].wui_dists=tmp.dists; intended to be distance to wuis
-//				patch_grid[j][i]=-1;
-//			}
-//		}
-//		world[0].num_fire_grid_row = grid_dimY;
-//		world[0].num_fire_grid_col = grid_dimX;
-		
-//		printf("Rows: %d Cols: %d\n",world[0].num_fire_grid_row,world[0].num_fire_grid_col);
+	index = newIdIndex(1024);
+	for (b=0; b< world[0].num_basin_files; ++b) {
+		for (h=0; h< world[0].basins[b][0].num_hillslopes; ++h) {
+			for (z=0; z< world[0].basins[b][0].hillslopes[h][0].num_zones; ++z) {
+				zone = world[0].basins[b][0].hillslopes[h][0].zones[z];
+				for (p=0; p< zone[0].num_patches; ++p)
+					idIndexInsert(index, zone[0].patches[p][0].ID, zone[0].patches[p]);
+			}
+		}
+	}
+	idIndexFinalize(index);
+	return(index);
+}
 
-//		int tmpPatchID;
-//		FILE *patchesIn;
-//		patchesIn=fopen(command_line[0].firegrid_patch_filename,"r");
-/*		if(def.include_wui==1) // then readin the wui LUT
-		{
-			FILE *wuiIn;
-			wuiIn=fopen(command_line[0].wui_lut_filename,"r");
-		}*/
-		//patchesIn=fopen("../auxdata/patchGrid.txt","r");
-		// for now do away with the header
-//		for(i=0; i<grid_dimY;i++){
-//			for(j=0;j<grid_dimX;j++){
-				// first initialize the fire grid
-			//	fire_grid[j][i].occupied_area=0;
-		//		fire_grid[j][i].num_patches=0;
-			//	fire_grid[j][i].tmp_patch=0;					
-				// now point to the corresponding patch
-				tmpPatchID=-9999;
-				fscanf(patchesIn,"%lf\t",&tmpPatchID);
-//printf("read patch\n")
-			//	if(i==203&j==48)
-			//		printf("Successfully read this patchID %ld at %d, %d\n",tmpPatchID,i,j);
-	                        fscanf(demIn,"%lf\t",&fire_grid[i][j].elev);				
-//		printf("read dem \n");	
-				// here read in the wuiLUT, 
-				/*if(def.include_wui==1)
-				{
-					double dummy1,dummy2;
-					fscanf(wuiIn,"%d\t%d\t,&dumm1,&dummy2); // throw away the first two elements of each row ? or 3 , depending on LUT structure
-					for(int w=0;w<def.nWUI;w++)
-					{
-						fscanf(wuiIn,"%d\t",&fire_grid[i][j].wui_dists[w]);
-					}					
-				}
-				*/
-		//		printf("Current patch id: %d, X: %d  Y: %d\n",tmpPatchID,i,j);
-				if(tmpPatchID>=0){ // then find the corresponding patch and allocate it--only one patch per grid cell!
-				//	printf("numPatches 0: %d\n",fire_grid[j][i].num_patches);	
-			//		printf("Current patch id: %d, X: %d  Y: %d\n",tmpPatchID,j,i);
-					fire_grid[i][j].num_patches=1;
-					//printf("numPatches 1: %d\n",fire_grid[j][i].num_patches);
-					fire_grid[i][j].patches=(struct patch_object **) malloc(fire_grid[i][j].num_patches*sizeof(struct patch_object *));
-					fire_grid[i][j].prop_patch_in_grid=(double *) malloc(fire_grid[i][j].num_patches*sizeof(double)); 
-					fire_grid[i][j].prop_grid_in_patch=(double *) malloc(fire_grid[i][j].num_patches*sizeof(double)); 
-//					printf("allocated patch array");
-					
-//				}
-//			}
-//		}			
-  //              fclose(patchesIn);
-	
-//1	#pragma omp parallel for 	
-  //             for(i=0; i<grid_dimY;i++){
-//		 #pragma omp parallel for
-    //                 for(j=0;j<grid_dimX;j++){
-//			if(fire_grid[i][j].num_patches==1)
-//			{
-  
-				for (b=0; b< world[0].num_basin_files; ++b) {
-						for (h=0; h< world[0].basins[b][0].num_hillslopes; ++h) {
-							for (z=0; z< world[0].basins[b][0].hillslopes[h][0].num_zones; ++z) {
-								tmp = world[0].basins[b][0].hillslopes[h][0].zones[z][0].aspect; /* aspect */
-/* 																
-								// if multistcale
-								if (command_line[0].multiscale_flag == 1) {
-									// loop through zone[z][0].patch_families
-									for (pf = 0; pf < world[0].basins[b][0].hillslopes[h][0].zones[z][0].num_patch_families; ++pf) {
-										// loop through patches pointed to by family
-										
-										for (p=0; p< world[0].basins[b][0].hillslopes[h][0].zones[z][0].patch_families[pf][0].patches; ++p) {
-											patch = world[0].basins[b][0].hillslopes[h][0].zones[z][0].patch_families[pf][0].patches[p];
+struct fire_cell_entry
+{
+	struct patch_object *patch;
+	int cell;
+	int slot;
+};
 
-											if(patch[0].ID==tmpPatchID)
-											{
-												//printf("now filling in array--found a match!\n");
-												fire_grid[i][j].patches[0]=patch; // assign the current patch to this grid cell
-												//printf("patch1\n");
-												fire_grid[i][j].occupied_area=cell_res*cell_res; // this grid cell is 100% occupied
-												//printf("patch2: area, cell res %lf, %lf\n",patch[0].area,cell_res);
-												fire_grid[i][j].prop_grid_in_patch[0]=(cell_res*cell_res)/patch[0].area; // the proportion of this patch in this cell
-												//printf("patch3\n");
-												fire_grid[i][j].prop_patch_in_grid[0]= patch[0].family_pct_cover;// the whole cell is occupied this patch
-												//printf("array filled\n");
-												
-												if(def.include_wui==0)
-													break; //? or keep loop to help point to wui patches as well// break would speed this up a little bit
-												
-												// if we have found the correct patch, stop looking
-											}
-										} // end patch loop (patches in patch family)
-									} // end patch family loop
-									// end multiscale IF
-								} else {
-									// normal code goes here
+static int compare_fire_cell_entry(const void *a, const void *b)
+{
+	const struct fire_cell_entry *e1 = (const struct fire_cell_entry *) a;
+	const struct fire_cell_entry *e2 = (const struct fire_cell_entry *) b;
+	if (e1->patch != e2->patch) return ((uintptr_t) e1->patch < (uintptr_t) e2->patch) ? -1 : 1;
+	if (e1->cell != e2->cell) return (e1->cell < e2->cell) ? -1 : 1;
+	return (e1->slot < e2->slot) ? -1 : (e1->slot > e2->slot);
+}
 
-								} // end non multiscale */
+/*--------------------------------------------------------------*/
+/*	Build the inverse patch -> cells CSR mapping so fire effects	*/
+/*	can be applied to each patch independently (and in parallel).	*/
+/*	Cells of a patch keep row-major order, the order the serial	*/
+/*	grid sweep used to visit them.					*/
+/*--------------------------------------------------------------*/
+static void construct_patch_fire_cells(struct world_object *world, struct patch_fire_object **fire_grid)
+{
+	struct patch_fire_cells_object *pfc;
+	struct fire_cell_entry *entries;
+	int i, j, k, n, num_entries;
 
-								for (p=0; p< world[0].basins[b][0].hillslopes[h][0].zones[z][0].num_patches; ++p) {
-									patch = world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p]; //zone object has linked list to point to patch families to point to patches
-				//					printf("is my world ok? %d\n",&patch[0].ID);
-									if(patch[0].ID==tmpPatchID)
-									{
-			//							if(i==203&j==48)
-			//								printf("Found patch ID %d matching %lf at %d, %d in world\n",patch[0].ID,tmpPatchID,i,j);
-//								printf("now filling in array--found a match!\n");
-										fire_grid[i][j].patches[0]=patch; // assign the current patch to this grid cell
-										//printf("patch1\n");
-										fire_grid[i][j].occupied_area=cell_res*cell_res; // this grid cell is 100% occupied
-										//printf("patch2: area, cell res %lf, %lf\n",patch[0].area,cell_res);
-										fire_grid[i][j].prop_grid_in_patch[0]=(cell_res*cell_res)/patch[0].area; // the proportion of this patch in this cell
-										//printf("patch3\n");
-										fire_grid[i][j].prop_patch_in_grid[0]=1;// the whole cell is occupied this patch
-//										printf("array filled\n");
-										
-										if(def.include_wui==0)
-											break; //? or keep loop to help point to wui patches as well// break would speed this up a little bit
-										
-										// if we have found the correct patch, stop looking
-									}										
-									/*if(patch[0].wuiID>=0&&def.include_wui==1) // then see if this pixel is within salience distance of this wui patch, and if it is add this patch to the pixel linked list
-									{
-										if(fire_grid[i][j].wui_dists[patch[0].wuiID]<=3)
-										{
-											tmp_node=(node)malloc(sizeof(struct node_fire_wui_dist));
-											tmp_node.dist=fire_grid[i][j].wui_dists[patch[0].wuiID];
-											tmp_node.patches[0]=patch;
-											tmp_node.next=NULL;
-											if(fire_grid[i][j].patch_wui_dist[0]==NULL)
-												fire_grid[i][j].patch_wui_dist[0]=tmp_node);
-											else
-											{
-												cur_node=fire_grid[i][j].patch_wui_dist[0].next;
-												while(cur_node->next!=NULL)
-												{
-													cur_node=cur_node.next;
-												}
-												cur_node->next=tmp_node;
-											}	
-											// then update linked list arr index 0; this patch is within first salience distance
-										}
-										else
-										{
-											if(fire_grid[i][j].wui_dists[patch[0].wuiID]<=5)
-											{
-												tmp_node=(node)malloc(sizeof(struct node_fire_wui_dist));
-												tmp_node.dist=fire_grid[i][j].wui_dists[patch[0].wuiID];
-												tmp_node.patches[0]=patch;
-												tmp_node.next=NULL;
-												if(fire_grid[i][j].patch_wui_dist[1]==NULL)
-													fire_grid[i][j].patch_wui_dist[1]=tmp_node);
-												else
-												{
-													cur_node=fire_grid[i][j].patch_wui_dist[1].next;
-													while(cur_node->next!=NULL)
-													{
-														cur_node=cur_node.next;
-													}
-													cur_node->next=tmp_node;
-												}	
-											
-												// then update linked list arr index 1; this patch is within second salience distance
-											}
-											else if(fire_grid[i][j].wui_dists[patch[0].wuiID]<=10)
-											{
-												tmp_node=(node)malloc(sizeof(struct node_fire_wui_dist));
-												tmp_node.dist=fire_grid[i][j].wui_dists[patch[0].wuiID];
-												tmp_node.patches[0]=patch;
-												tmp_node.next=NULL;
-												if(fire_grid[i][j].patch_wui_dist[2]==NULL)
-													fire_grid[i][j].patch_wui_dist[2]=tmp_node);
-												else
-												{
-													cur_node=fire_grid[i][j].patch_wui_dist[2].next;
-													while(cur_node->next!=NULL)
-													{
-														cur_node=cur_node.next;
-													}
-													cur_node->next=tmp_node;
-se(patchesIn);
-/
-												}	
-											
-												// then update linked list arr index 2; this patch is within third salience distance
-											}
-										}
-									}*/
-								}
-							}
-						}
-					}
-				}
+	pfc = (struct patch_fire_cells_object *) malloc(sizeof(struct patch_fire_cells_object));
+	world[0].patch_fire_cells = pfc;
+	num_entries = 0;
+	for (i=0; i<world[0].num_fire_grid_row; i++)
+		for (j=0; j<world[0].num_fire_grid_col; j++)
+			num_entries += fire_grid[i][j].num_patches;
 
-//			}
-//		}
-/*		if(def.include_wui==1) // then readin the wui LUT
-			fclose(wuiIn);
-*/		
-//		FILE *demIn;
-//		demIn=fopen(command_line[0].firegrid_dem_filename,"r");
-//		demIn=fopen("../auxdata/DemGrid.txt","r");
-		// for now do away with the header, so this file has no header
-//		for(i=0; i<grid_dimY;i++){
-//for(j=0;j<grid_dimX;j++){				
-//				fscanf(demIn,"%lf\t",&fire_grid[i][j].elev);
+	entries = (struct fire_cell_entry *) malloc((num_entries + 1) * sizeof(struct fire_cell_entry));
+	n = 0;
+	for (i=0; i<world[0].num_fire_grid_row; i++) {
+		for (j=0; j<world[0].num_fire_grid_col; j++) {
+			for (k=0; k<fire_grid[i][j].num_patches; k++) {
+				entries[n].patch = fire_grid[i][j].patches[k];
+				entries[n].cell = i * world[0].num_fire_grid_col + j;
+				entries[n].slot = k;
+				n++;
 			}
-//printf("Which column? %d \n",i);
 		}
-//printf("Before closing files\n");
-		fclose(patchesIn);
-//printf("patchesInClosed\n");
-		fclose(demIn);
-		printf("done assigning dem\n");
-		//printf("assigning dem\n");
+	}
+	qsort(entries, num_entries, sizeof(struct fire_cell_entry), compare_fire_cell_entry);
 
-/*		if(def.include_wui==1) // then readin the wui LUT
-		{
-			FILE *wuiIn;
-			wuiIn=fopen("../auxdata/WUILUT.txt","r");
-			// for now do away with the header, so this file has no header // a placeholder, replace with a linked list of wui blocks for each grid cell with distance to wui block
-			for(i=0; i<grid_dimY;i++){
-				for(j=0;j<grid_dimX;j++){				
-					fscanf(wuiIn,"%d\t",&fire_grid[i][j].wui_flag);
-				}
-			}
-			fclose(wuiIn);
-			printf("done assigning wui\n");
-		}*/
+	pfc[0].patches = (struct patch_object **) malloc((num_entries + 1) * sizeof(struct patch_object *));
+	pfc[0].cell_start = (int *) malloc((num_entries + 1) * sizeof(int));
+	pfc[0].cells = (int *) malloc((num_entries + 1) * sizeof(int));
+	pfc[0].slots = (int *) malloc((num_entries + 1) * sizeof(int));
+	pfc[0].num_patches = 0;
+	for (n=0; n<num_entries; n++) {
+		if (n == 0 || entries[n].patch != entries[n-1].patch) {
+			pfc[0].patches[pfc[0].num_patches] = entries[n].patch;
+			pfc[0].cell_start[pfc[0].num_patches] = n;
+			pfc[0].num_patches++;
+		}
+		pfc[0].cells[n] = entries[n].cell;
+		pfc[0].slots[n] = entries[n].slot;
 	}
+	pfc[0].cell_start[pfc[0].num_patches] = num_entries;
+	free(entries);
+}
+
+struct patch_fire_object **construct_patch_fire_grid (struct world_object *world, struct command_line_object *command_line,struct fire_default def)
+
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
 	
-	else
-	{
+	//MCK: time process
+	clock_t start, end;
+	double time_used;
+	start=clock();
+	struct patch_fire_object **fire_grid;
+	struct patch_fire_object *cells;
+	struct patch_object *patch;
+	struct patch_object **cell_patch;
+	struct fire_raster_reader patchesIn, demIn;
+	IdIndex_t *patch_index;
+	int i, j, k;
+	size_t c, num_cells, num_occupied, offset;
+	double cell_res;
+	double *patch_ids, *dem;
+	int grid_dimX,grid_dimY;
+
+	cell_res =  command_line[0].fire_grid_res; //  grid resolution 
+
+	if(def.n_rows==-1) {
 		fprintf(stderr,"******\nNo patch grid file! Create a 30 m raster grid with patch ids\n********");
-		fire_grid = NULL;
 		exit(EXIT_FAILURE);
 	}
-	// for debugging, write out the fire grid and patches
-	
-	// comment out for now.
-/*	FILE *gridout;
 
-	gridout=fopen("FireGridPatchCheckOccupiedArea.txt","w");
-	for(i=0;i<grid_dimY;i++){
-		for(j=0;j<grid_dimX;j++){
-			fprintf(gridout,"%lf\t",fire_grid[i][j].occupied_area);
-		}
-		fprintf(gridout,"\n");
+	printf("reading patch raster structure\n");
+	grid_dimX=def.n_cols;
+	grid_dimY=def.n_rows;
+	world[0].num_fire_grid_row = grid_dimY;
+	world[0].num_fire_grid_col = grid_dimX;
+	num_cells = (size_t) grid_dimX * (size_t) grid_dimY;
+
+	/*--------------------------------------------------------------*/
+	/*	Read the patch and DEM rasters in one pass each.		*/
+	/*--------------------------------------------------------------*/
+	patch_ids = (double *) malloc(num_cells * sizeof(double));
+	dem = (double *) malloc(num_cells * sizeof(double));
+	if (patch_ids == NULL || dem == NULL) {
+		fprintf(stderr, "FATAL ERROR: Unable to allocate %zu fire grid cells\n", num_cells);
+		exit(EXIT_FAILURE);
 	}
-	fclose(gridout);
+	open_fire_raster(&patchesIn, command_line[0].firegrid_patch_filename, grid_dimY, grid_dimX);
+	read_fire_raster(&patchesIn, patch_ids, num_cells, -9999);
+	fclose(patchesIn.file);
+	open_fire_raster(&demIn, command_line[0].firegrid_dem_filename, grid_dimY, grid_dimX);
+	read_fire_raster(&demIn, dem, num_cells, 0.0);
+	fclose(demIn.file);
 
-	gridout=fopen("FireGridPatchCheckPatches.txt","w");
-	for(i=0;i<grid_dimY;i++){
-		for(j=0;j<grid_dimX;j++){
-			if(fire_grid[i][j].occupied_area>0){
-			for(k=0;k<fire_grid[i][j].num_patches;k++)
-			{	
-				patch = fire_grid[i][j].patches[k];
-				fprintf(gridout,"%d",patch[0].ID);
-			}
-			fprintf(gridout,"\t");
-		}
-		}
-		fprintf(gridout,"\n");
+	/*--------------------------------------------------------------*/
+	/*	Allocate the grid as one contiguous block of cells, with	*/
+	/*	row pointers so fire_grid[i][j] indexing is unchanged.		*/
+	/*--------------------------------------------------------------*/
+	fire_grid=(struct patch_fire_object **) malloc(grid_dimY*sizeof(struct patch_fire_object *));
+	cells=(struct patch_fire_object *) calloc(num_cells, sizeof(struct patch_fire_object));
+	if (fire_grid == NULL || cells == NULL) {
+		fprintf(stderr, "FATAL ERROR: Unable to allocate %zu fire grid cells\n", num_cells);
+		exit(EXIT_FAILURE);
 	}
-	fclose(gridout);
-	
-	gridout=fopen("FireGridCheckPatchesAndAreas.txt","w");
-	fprintf(gridout,"IDY\tIDX\tID\tPropPatchInGrid\tPropGridInPatch\tOccupiedArea\n");
-	for(i=0;i<grid_dimY;i++){
-		for(j=0;j<grid_dimX;j++){
-			if(fire_grid[i][j].occupied_area>0){
-			for(k=0;k<fire_grid[i][j].num_patches;k++)
-			{		    	
-				patch = fire_grid[i][j].patches[k];
-				fprintf(gridout,"%d\t%d\t%d\t%lf\t%lf\t%lf\n",i,j,patch[0].ID,fire_grid[i][j].prop_patch_in_grid[k],fire_grid[i][j].prop_grid_in_patch[k],fire_grid[i][j].occupied_area);
-			}
-		}
-		else
-			fprintf(gridout,"%d\t%d\t-1\t-1\t-1\t-1\n",i,j);
+	for(i=0;i<grid_dimY;i++)
+		fire_grid[i] = cells + (size_t) i * grid_dimX;
+	printf("allocate the fire grid\n");
+
+	/*--------------------------------------------------------------*/
+	/*	Resolve patch IDs through the index; only one patch per	*/
+	/*	grid cell, so the CSR row length is 0 or 1.			*/
+	/*--------------------------------------------------------------*/
+	patch_index = construct_fire_patch_index(world);
+	cell_patch = (struct patch_object **) malloc(num_cells * sizeof(struct patch_object *));
+	num_occupied = 0;
+	for (c = 0; c < num_cells; c++) {
+		cell_patch[c] = NULL;
+		if (patch_ids[c] >= 0) {
+			cell_patch[c] = (struct patch_object *) idIndexGet(patch_index, (int) patch_ids[c]);
+			if (cell_patch[c] != NULL) num_occupied++;
 		}
 	}
-	fclose(gridout);*/
-/*	gridout=fopen("RhessyDEMOut.txt","w");
+	freeIdIndex(patch_index);
+
+	world[0].patch_fire_grid_patches = (struct patch_object **) malloc((num_occupied + 1) * sizeof(struct patch_object *));
+	world[0].patch_fire_grid_prop = (double *) malloc(2 * (num_occupied + 1) * sizeof(double));
+
+	offset = 0;
 	for(i=0;i<grid_dimY;i++){
 		for(j=0;j<grid_dimX;j++){
-				fprintf(gridout,"%lf\t",fire_grid[i][j].elev);
+			c = (size_t) i * grid_dimX + j;
+			fire_grid[i][j].elev = dem[c];
+			fire_grid[i][j].tmp_patch = 0;
+			fire_grid[i][j].occupied_area = 0;
+			fire_grid[i][j].patches = world[0].patch_fire_grid_patches + offset;
+			fire_grid[i][j].prop_patch_in_grid = world[0].patch_fire_grid_prop + offset;
+			fire_grid[i][j].prop_grid_in_patch = world[0].patch_fire_grid_prop + (num_occupied + 1) + offset;
+			fire_grid[i][j].num_patches = 0;
+			patch = cell_patch[c];
+			if (patch == NULL)
+				continue;
+			k = fire_grid[i][j].num_patches++;
+			fire_grid[i][j].patches[k]=patch; // assign the current patch to this grid cell
+			fire_grid[i][j].occupied_area=cell_res*cell_res; // this grid cell is 100% occupied
+			fire_grid[i][j].prop_grid_in_patch[k]=(cell_res*cell_res)/patch[0].area; // the proportion of this patch in this cell
+			fire_grid[i][j].prop_patch_in_grid[k]=1;// the whole cell is occupied this patch
+			offset += fire_grid[i][j].num_patches;
 		}
-		fprintf(gridout,"\n");
 	}
-	fclose(gridout);
-*/
+	free(cell_patch);
+	free(patch_ids);
+	free(dem);
+	printf("done assigning dem\n");
+
+	construct_patch_fire_cells(world, fire_grid);
+
 	/* done allocating fire grid, return to RHESSys*/
 	end=clock();
 	time_used=((double) (end-start))/CLOCKS_PER_SEC;
@@ -431,9 +370,11 @@ struct fire_object **construct_fire_grid(struct world_object *world)
 {
 	struct fire_object **fire_grid;
 	int i,j;
+	struct fire_object *cells;
 	fire_grid=(struct fire_object **) malloc(world[0].num_fire_grid_row*sizeof(struct fire_object *)); // first allocate the rows
-	for(i=0;i<world[0].num_fire_grid_row;i++) // for each row, allocate the columns
-		fire_grid[i]=(struct fire_object *) malloc(world[0].num_fire_grid_col*sizeof(struct fire_object ));
+	cells=(struct fire_object *) calloc((size_t) world[0].num_fire_grid_row*world[0].num_fire_grid_col, sizeof(struct fire_object)); // one contiguous block of cells
+	for(i=0;i<world[0].num_fire_grid_row;i++) // each row points into the block
+		fire_grid[i]=cells + (size_t) i*world[0].num_fire_grid_col;
 		
 	// then initialize values: e.g., 0's 
 	 for(i=0;i<world[0].num_fire_grid_row;i++){
@@ -46,6 +46,7 @@
 #include <stdlib.h>
 #include "rhessys.h"
 #include "params.h"
+#include "alloc_accounting.h"
 
 struct hillslope_object *construct_hillslope(
 											 struct	command_line_object	*command_line,
@@ -67,19 +68,27 @@ struct hillslope_object *construct_hillslope(
 	struct zone_object *construct_zone(
 		struct command_line_object *,
 		FILE	*,
+		int,
 		int		*num_world_base_stations,
 		struct	base_station_object	**world_base_stations,
 		struct	default_object *,
 		struct base_station_ncheader_object *,
-	    struct world_object *);
+	    struct world_object *,
+		struct arena_object *);
 	
 	void	*alloc(	size_t,
 		char	*,
 		char	*);
+	struct arena_object *construct_arena(char *);
+	void	*arena_alloc(struct arena_object *, size_t, char *, char *);
+	int	zone_in_subcatchment(struct command_line_object *, int, int);
+	int	peek_worldfile_ID(FILE *, char *);
+	void	skip_worldfile_zone(FILE *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
-	int		i,j;
+	int		i,j,z;
+	int		num_zones;
 	int		base_stationID;
 	char		record[MAXSTR];
 	struct	hillslope_object *hillslope;
@@ -91,6 +100,15 @@ struct hillslope_object *construct_hillslope(
 	hillslope = (struct hillslope_object *) alloc( 1 *
 		sizeof( struct hillslope_object ),"hillslope",
 		"construct_hillsope" );
+	/*--------------------------------------------------------------*/
+	/*	Zones, patches and strata are carved out of the		*/
+	/*	hillslope's arena, unless memory is being accounted	*/
+	/*	by alloc() tag.						*/
+	/*--------------------------------------------------------------*/
+	if (alloc_accounting_enabled)
+		hillslope[0].arena = NULL;
+	else
+		hillslope[0].arena = construct_arena("construct_hillslope");
 	
 	/*--------------------------------------------------------------*/
 	/*	Create the grow extension to the hillslope object if 		*/
@@ -119,6 +137,7 @@ struct hillslope_object *construct_hillslope(
 	hillslope[0].num_base_stations = getIntWorldfile(&paramCnt,&paramPtr,"hillslope_n_basestations","%d",0,0);
 	hillslope[0].streamflow_NO3 = 0.0;	
 	hillslope[0].streamflow_NH4 = 0.0;	
+	hillslope[0].zone_chunk_start = NULL;
 	/*--------------------------------------------------------------*/
 	/*  Assign  defaults for this hillslope                             */
 	/*--------------------------------------------------------------*/
@@ -175,7 +194,7 @@ struct hillslope_object *construct_hillslope(
 	/*	Allocate list of pointers to zone objects .					*/
 	/*--------------------------------------------------------------*/
 	hillslope[0].zones = ( struct zone_object ** )
-		alloc( hillslope[0].num_zones * sizeof( struct zone_object *),
+		arena_alloc(hillslope[0].arena, hillslope[0].num_zones * sizeof( struct zone_object *),
 		"zones","construct_hillslopes");
 	
 	hillslope[0].streamflow_NO3 = 0.0;
@@ -209,12 +228,27 @@ struct hillslope_object *construct_hillslope(
 	hillslope[0].aggdefs.DOC_adsorption_rate = 0.0;
 
 	
-	for ( i=0 ; i<hillslope[0].num_zones ; i++ ){
+	num_zones = hillslope[0].num_zones;
+	hillslope[0].num_zones = 0;
+	for ( z=0 ; z<num_zones ; z++ ){
+		/*--------------------------------------------------------------*/
+		/*	With -subcatchment leave out zones with no patch	*/
+		/*	upstream of the outlet.					*/
+		/*--------------------------------------------------------------*/
+		if ((command_line[0].subcatchment_flag == 1) &&
+				(zone_in_subcatchment(command_line,
+				peek_worldfile_ID(world_file, "zone_ID"), hillslope[0].ID) == 0)) {
+			skip_worldfile_zone(world_file);
+			continue;
+		}
+		i = hillslope[0].num_zones++;
 		hillslope[0].zones[i] = construct_zone( command_line,
 			world_file,
+			hillslope[0].ID,
 			num_world_base_stations,
 			world_base_stations, defaults,
-			base_station_ncheader, world);
+			base_station_ncheader, world,
+			hillslope[0].arena);
 		for	 (j =0; j < hillslope[0].zones[i][0].num_patches ; j++) {
 			hillslope[0].area += hillslope[0].zones[i][0].patches[j][0].area;
 			if (hillslope[0].zones[i][0].patches[j][0].soil_defaults[0][0].ID == 42) 
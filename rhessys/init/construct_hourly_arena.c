@@ -0,0 +1,147 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_hourly_arena				*/
+/*								*/
+/*	construct_hourly_arena.c - preallocate hourly objects	*/
+/*								*/
+/*	NAME							*/
+/*	construct_hourly_arena.c - preallocate hourly objects	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct hourly_arena_object *construct_hourly_arena(	*/
+/*			struct world_object *world)		*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Carves the hourly scratch objects of the world, every	*/
+/*	basin, hillslope and canopy stratum out of a single	*/
+/*	block and points each object's hourly member at its	*/
+/*	slot.  The hourly objects are only used between the	*/
+/*	start and end of the matching *_hourly routine, which	*/
+/*	previously allocated and freed them every hour; they	*/
+/*	now call reset_hourly_scratch() on entry (same zeroed	*/
+/*	state calloc gave) and release_hourly_scratch() on	*/
+/*	exit.  Zone and patch hourly objects were already	*/
+/*	persistent and are left as they are.			*/
+/*								*/
+/*	Each object owns its slot, so hillslopes and strata	*/
+/*	simulated on different threads share nothing.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	Built with -DRHESSYS_POISON_HOURLY (make poison=T),	*/
+/*	released slots are filled with 0xff bytes, which reads	*/
+/*	back as NaN for doubles and -1 for ints, so a stale	*/
+/*	read of an hourly object outside its hour shows up in	*/
+/*	the output instead of silently reusing last hour.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+#define HOURLY_POISON 0xff
+
+/* Round slots up so every object stays aligned for doubles */
+#define HOURLY_SLOT(type) \
+	((sizeof(type) + sizeof(double) - 1) / sizeof(double) * sizeof(double))
+
+struct hourly_arena_object *construct_hourly_arena(struct world_object *world)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int b, h, z, p, c;
+	size_t num_hillslopes, num_strata;
+	char *next;
+	struct hourly_arena_object *arena;
+	struct basin_object *basin;
+	struct hillslope_object *hillslope;
+	struct patch_object *patch;
+
+	/*--------------------------------------------------------------*/
+	/*	Size the block.						*/
+	/*--------------------------------------------------------------*/
+	num_hillslopes = 0;
+	num_strata = 0;
+	for (b = 0; b < world[0].num_basin_files; b++) {
+		basin = world[0].basins[b];
+		num_hillslopes += basin[0].num_hillslopes;
+		for (h = 0; h < basin[0].num_hillslopes; h++) {
+			hillslope = basin[0].hillslopes[h];
+			for (z = 0; z < hillslope[0].num_zones; z++)
+				for (p = 0; p < hillslope[0].zones[z][0].num_patches; p++)
+					num_strata += hillslope[0].zones[z][0].patches[p][0].num_canopy_strata;
+		}
+	}
+
+	arena = (struct hourly_arena_object *) alloc(1 * sizeof(struct hourly_arena_object),
+		"hourly_arena", "construct_hourly_arena");
+	arena[0].size = HOURLY_SLOT(struct world_hourly_object)
+		+ world[0].num_basin_files * HOURLY_SLOT(struct basin_hourly_object)
+		+ num_hillslopes * HOURLY_SLOT(struct hillslope_hourly_object)
+		+ num_strata * HOURLY_SLOT(struct canopy_strata_hourly_object);
+	arena[0].base = (char *) alloc(arena[0].size, "base", "construct_hourly_arena");
+#ifdef RHESSYS_POISON_HOURLY
+	memset(arena[0].base, HOURLY_POISON, arena[0].size);
+#else
+	memset(arena[0].base, 0, arena[0].size);
+#endif
+
+	/*--------------------------------------------------------------*/
+	/*	Hand out the slots, in simulation order.		*/
+	/*--------------------------------------------------------------*/
+	next = arena[0].base;
+	world[0].hourly = (struct world_hourly_object *) next;
+	next += HOURLY_SLOT(struct world_hourly_object);
+	for (b = 0; b < world[0].num_basin_files; b++) {
+		basin = world[0].basins[b];
+		basin[0].hourly = (struct basin_hourly_object *) next;
+		next += HOURLY_SLOT(struct basin_hourly_object);
+		for (h = 0; h < basin[0].num_hillslopes; h++) {
+			hillslope = basin[0].hillslopes[h];
+			hillslope[0].hourly = (struct hillslope_hourly_object *) next;
+			next += HOURLY_SLOT(struct hillslope_hourly_object);
+			for (z = 0; z < hillslope[0].num_zones; z++) {
+				for (p = 0; p < hillslope[0].zones[z][0].num_patches; p++) {
+					patch = hillslope[0].zones[z][0].patches[p];
+					for (c = 0; c < patch[0].num_canopy_strata; c++) {
+						patch[0].canopy_strata[c][0].hourly =
+							(struct canopy_strata_hourly_object *) next;
+						next += HOURLY_SLOT(struct canopy_strata_hourly_object);
+					}
+				}
+			}
+		}
+	}
+	return(arena);
+} /*end construct_hourly_arena*/
+
+void destroy_hourly_arena(struct hourly_arena_object *arena)
+{
+	if (arena == NULL) return;
+	free(arena[0].base);
+	free(arena);
+} /*end destroy_hourly_arena*/
+
+/*--------------------------------------------------------------*/
+/*	Start and end of an hourly object's life within an hour.	*/
+/*--------------------------------------------------------------*/
+void reset_hourly_scratch(void *hourly, size_t size)
+{
+	memset(hourly, 0, size);
+} /*end reset_hourly_scratch*/
+
+void release_hourly_scratch(void *hourly, size_t size)
+{
+#ifdef RHESSYS_POISON_HOURLY
+	memset(hourly, HOURLY_POISON, size);
+#endif
+	return;
+} /*end release_hourly_scratch*/
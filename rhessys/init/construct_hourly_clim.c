@@ -54,6 +54,8 @@ struct	hourly_clim_object *construct_hourly_clim(
 	/*--------------------------------------------------------------*/
 	struct clim_event_sequence construct_dated_clim_sequence(char *,
 		struct date);
+	struct hourly_clim_slots construct_hourly_clim_slots(
+		struct clim_event_sequence);
 	void	*alloc(size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
@@ -120,5 +122,11 @@ struct	hourly_clim_object *construct_hourly_clim(
 			exit(EXIT_FAILURE);
 			}
 	} /*end for*/
+	/*--------------------------------------------------------------*/
+	/*	Index the sequences by day and hour for zone_hourly.		*/
+	/*--------------------------------------------------------------*/
+	hourly_clim[0].rain_slots = construct_hourly_clim_slots(hourly_clim[0].rain);
+	hourly_clim[0].rain_duration_slots = construct_hourly_clim_slots(
+		hourly_clim[0].rain_duration);
 	return(hourly_clim);
 } /*end construct_hourly_clim*/
@@ -0,0 +1,96 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_hourly_clim_slots					*/
+/*																*/
+/*	construct_hourly_clim_slots.c - index an hourly clim		*/
+/*				sequence by day and hour						*/
+/*																*/
+/*	NAME														*/
+/*	construct_hourly_clim_slots.c - index an hourly clim		*/
+/*				sequence by day and hour						*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	struct hourly_clim_slots construct_hourly_clim_slots(		*/
+/*				struct clim_event_sequence)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Lays the events of a dated hourly sequence out in a dense	*/
+/*	array with one slot per hour from the first to the last		*/
+/*	day of the sequence.  Hours without an event hold -999.0.	*/
+/*	zone_hourly and zone_daily_I then find the current hour		*/
+/*	with hourly_clim_value() in constant time instead of		*/
+/*	advancing the sequence's inx cursor, which lived on the		*/
+/*	base station and so was shared by every zone (and thread)	*/
+/*	using that station.											*/
+/*																*/
+/*	A sequence with inx == -999 (not read) gives value NULL.	*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	The cursor matched the first event at or after the current	*/
+/*	hour, so where a file repeats an hour the first event is	*/
+/*	kept here too.  Events with an hour outside 1-24 could		*/
+/*	never match and are skipped.								*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+struct	hourly_clim_slots construct_hourly_clim_slots(
+											 struct clim_event_sequence sequence)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	long	julday(struct date);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	long	i, day, last_day, slot;
+	struct	dated_sequence	*event;
+	struct	hourly_clim_slots	slots;
+
+	slots.first_day = 0;
+	slots.num_days = 0;
+	slots.value = NULL;
+	if ( sequence.inx == -999 )
+		return(slots);
+	/*--------------------------------------------------------------*/
+	/*	Find the span of days covered.								*/
+	/*--------------------------------------------------------------*/
+	last_day = 0;
+	for ( event = sequence.seq; event[0].edate.year != 0; event++ ){
+		if ( (event[0].edate.hour < 1) || (event[0].edate.hour > 24) )
+			continue;
+		day = julday(event[0].edate);
+		if ( (slots.num_days == 0) || (day < slots.first_day) )
+			slots.first_day = day;
+		if ( (slots.num_days == 0) || (day > last_day) )
+			last_day = day;
+		slots.num_days = 1;
+	}
+	if ( slots.num_days == 0 )
+		return(slots);
+	slots.num_days = last_day - slots.first_day + 1;
+	/*--------------------------------------------------------------*/
+	/*	Fill the slots.												*/
+	/*--------------------------------------------------------------*/
+	slots.value = (double *) alloc(slots.num_days * 24 * sizeof(double),
+		"value", "construct_hourly_clim_slots");
+	for ( i = 0; i < slots.num_days * 24; i++ )
+		slots.value[i] = -999.0;
+	for ( event = sequence.seq; event[0].edate.year != 0; event++ ){
+		if ( (event[0].edate.hour < 1) || (event[0].edate.hour > 24) )
+			continue;
+		slot = (julday(event[0].edate) - slots.first_day) * 24
+			+ event[0].edate.hour - 1;
+		if ( slots.value[slot] == -999.0 )
+			slots.value[slot] = event[0].value;
+	}
+	return(slots);
+} /*end construct_hourly_clim_slots*/
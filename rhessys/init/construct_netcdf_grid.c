@@ -259,6 +259,8 @@ struct base_station_object *construct_netcdf_grid (
         /*	Initialize non - critical sequences.						*/
         base_station[0].hourly_clim[0].rain.inx = -999;
         base_station[0].hourly_clim[0].rain_duration.inx = -999;
+        base_station[0].hourly_clim[0].rain_slots.value = NULL;
+        base_station[0].hourly_clim[0].rain_duration_slots.value = NULL;
         /* Calculate start day index */
         instartday = get_indays((int)start_date->year,
                         (int)start_date->month,
@@ -47,7 +47,8 @@ struct patch_object *construct_patch(
 									 FILE	*world_file,
 									 int     num_world_base_stations,
 									 struct  base_station_object **world_base_stations,
-									 struct	default_object	*defaults)
+									 struct	default_object	*defaults,
+									 struct	arena_object	*arena)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -62,7 +63,8 @@ struct patch_object *construct_patch(
 		struct	patch_object *,
 		int     num_world_base_stations,
 		struct  base_station_object **world_base_stations,
-		struct	default_object	*defaults);
+		struct	default_object	*defaults,
+		struct	arena_object	*);
 	  struct 	canopy_strata_object *construct_empty_shadow_strata( 
 		struct command_line_object *,
 		struct	patch_object *,
@@ -82,6 +84,7 @@ struct patch_object *construct_patch(
 	
 	void	sort_patch_layers(struct patch_object *, int *);
 	void	*alloc(	size_t, char *, char *);
+	void	*arena_alloc(struct arena_object *, size_t, char *, char *);
 
 	/*--------------------------------------------------------------*/
 	/*	Local variable definitions				*/
@@ -97,23 +100,23 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	/*  Allocate a patch object.                                */
 	/*--------------------------------------------------------------*/
-	patch = (struct patch_object *) alloc( 1 *
+	patch = (struct patch_object *) arena_alloc(arena, 1 *
 		sizeof( struct patch_object ),"patch","construct_patch");
 
   /*---------------------------------------------------------------------------------*/
   /*  Allocate a shadow_litter object, and shadow_soil object if spinup flag is set  */
   /*---------------------------------------------------------------------------------*/
  	if ( (command_line[0].vegspinup_flag > 0) ) {
-   patch[0].shadow_litter_cs = (struct litter_c_object *) alloc( 1 *
+   patch[0].shadow_litter_cs = (struct litter_c_object *) arena_alloc(arena, 1 *
       sizeof( struct litter_c_object ),"shadow_litter_cs", "construct_patch" );
         
-   patch[0].shadow_litter_ns = (struct litter_n_object *) alloc( 1 *
+   patch[0].shadow_litter_ns = (struct litter_n_object *) arena_alloc(arena, 1 *
       sizeof( struct litter_n_object ),"shadow_litter_ns", "construct_patch" );
     
-   patch[0].shadow_soil_cs = (struct soil_c_object *) alloc( 1 *
+   patch[0].shadow_soil_cs = (struct soil_c_object *) arena_alloc(arena, 1 *
       sizeof( struct soil_c_object ),"shadow_soil_cs", "construct_patch" );
         
-   patch[0].shadow_soil_ns = (struct soil_n_object *) alloc( 1 *
+   patch[0].shadow_soil_ns = (struct soil_n_object *) arena_alloc(arena, 1 *
       sizeof( struct soil_n_object ),"shadow_soil_ns", "construct_patch" );
   }
 	
@@ -360,7 +363,7 @@ struct patch_object *construct_patch(
 	/*	Assign	defaults for this patch								*/
 	/*--------------------------------------------------------------*/
 	patch[0].soil_defaults = (struct soil_default **)
-		alloc( sizeof(struct soil_default *),"defaults",
+		arena_alloc(arena, sizeof(struct soil_default *),"defaults",
 		"construct_patch" );
 	
 	i = 0;
@@ -380,7 +383,7 @@ struct patch_object *construct_patch(
 	patch[0].soil_defaults[0] = &defaults[0].soil[i];
 
 	patch[0].landuse_defaults = (struct landuse_default **)
-		alloc( sizeof(struct landuse_default *),"defaults",
+		arena_alloc(arena, sizeof(struct landuse_default *),"defaults",
 		"construct_patch" );
 	i = 0;
 	while (defaults[0].landuse[i].ID != patch[0].landuse_parm_ID) {
@@ -407,7 +410,7 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	if (command_line[0].firespread_flag == 1) {
 	patch[0].fire_defaults = (struct fire_default **)
-		alloc( sizeof(struct fire_default *),"defaults",
+		arena_alloc(arena, sizeof(struct fire_default *),"defaults",
 		"construct_patch" );
 	i = 0;
 	while (defaults[0].fire[i].ID != fire_default_object_ID) {
@@ -433,11 +436,11 @@ struct patch_object *construct_patch(
 	if (command_line[0].surface_energy_flag == 1) {
 
 		patch[0].surface_energy_profile = (struct surface_energy_object *)
-		alloc(4* sizeof(struct surface_energy_object),"energy_object",
+		arena_alloc(arena, 4* sizeof(struct surface_energy_object),"energy_object",
 		"construct_patch");
 
 		patch[0].surface_energy_defaults = (struct surface_energy_default **)
-		alloc( sizeof(struct surface_energy_default *),"defaults",
+		arena_alloc(arena, sizeof(struct surface_energy_default *),"defaults",
 		"construct_patch" );
 		i = 0;
 	while (defaults[0].surface_energy[i].ID != surface_energy_default_object_ID) {
@@ -518,7 +521,11 @@ struct patch_object *construct_patch(
 	/* compute a biological soil depth based on the minimum of soil depth */
 	/* and m, K parameters defining conductivity < 0.1% original value */
 	/* turn this off for now */
+	/*	the soil defaults are shared by patches that construct_basin	*/
+	/*	may be constructing in parallel								*/
 	/*--------------------------------------------------------------*/
+	#pragma omp critical(construct_patch_soil_defaults)
+	{
 	patch[0].soil_defaults[0][0].effective_soil_depth = patch[0].soil_defaults[0][0].soil_depth;
 	/*
 	patch[0].soil_defaults[0][0].effective_soil_depth = min(patch[0].soil_defaults[0][0].soil_depth,
@@ -532,11 +539,12 @@ struct patch_object *construct_patch(
 	patch[0].soil_defaults[0][0].detention_store_size = 
 				max(patch[0].landuse_defaults[0][0].detention_store_size,
 				patch[0].soil_defaults[0][0].detention_store_size);
+	}
 	/*--------------------------------------------------------------*/
 	/*    Allocate a list of base stations for this patch.			*/
 	/*--------------------------------------------------------------*/
 	patch[0].base_stations = (struct base_station_object **)
-		alloc(patch[0].num_base_stations *
+		arena_alloc(arena, patch[0].num_base_stations *
 		sizeof(struct base_station_object *),
 		"base_stations","construct_patch" );
 	/*--------------------------------------------------------------*/
@@ -564,23 +572,20 @@ struct patch_object *construct_patch(
 	/*	Allocate list of pointers to stratum objects .				*/
 	/*--------------------------------------------------------------*/
 	patch[0].canopy_strata = ( struct canopy_strata_object ** )
-		alloc( patch[0].num_canopy_strata *
+		arena_alloc(arena, patch[0].num_canopy_strata *
 		sizeof( struct canopy_strata_object *),
 		"canopy_strata","construct_patch");
  	
 		patch[0].shadow_strata = ( struct canopy_strata_object ** )
-			alloc( patch[0].num_canopy_strata * 
+			arena_alloc(arena, patch[0].num_canopy_strata * 
 			sizeof( struct canopy_strata_object *),
 			"shadow_strata","construct_patch");
 
 	/*--------------------------------------------------------------*/
 	/*      Allocate the patch hourly object.	  */
 	/*--------------------------------------------------------------*/
-	if ((patch[0].hourly = (struct patch_hourly_object *) calloc(1,
-		sizeof(struct patch_hourly_object))) == NULL ){
-		fprintf(stderr,"FATAL ERROR: in patch_hourly\n");
-		exit(EXIT_FAILURE);
-	}
+	patch[0].hourly = (struct patch_hourly_object *) arena_alloc(arena,
+		sizeof(struct patch_hourly_object), "hourly", "construct_patch");
 	
 	/*--------------------------------------------------------------*/
 	/*      Initialize patch level rainand snow stored              */
@@ -604,7 +609,8 @@ struct patch_object *construct_patch(
 			world_file,
 			patch,
 			num_world_base_stations,
-			world_base_stations,defaults);
+			world_base_stations,defaults,
+			arena);
 		/*--------------------------------------------------------------*/
 		/*      Aggregate rain and snow stored already for water balance*/
 		/*--------------------------------------------------------------*/
@@ -677,8 +683,10 @@ struct patch_object *construct_patch(
 	/*	Define a list of canopy strata layers that can at least	*/
 	/*	fit all of the canopy strata.				*/
 	/*--------------------------------------------------------------*/
-	patch[0].layers = (struct layer_object *) alloc( patch[0].num_canopy_strata *
+	patch[0].layers = (struct layer_object *) arena_alloc(arena, patch[0].num_canopy_strata *
 		sizeof( struct layer_object ),"layers","construct_patch");
+	patch[0].layer_strata = (long *) arena_alloc(arena, patch[0].num_canopy_strata *
+		sizeof(long),"layer_strata","construct_patch");
 	patch[0].num_layers = 0;
 	rec = 0;
 	sort_patch_layers(patch, &rec);
@@ -0,0 +1,148 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_porosity_profile			*/
+/*								*/
+/*	construct_porosity_profile.c - tabulate a soil class's	*/
+/*		water table depth / saturation deficit curve	*/
+/*								*/
+/*	NAME							*/
+/*	construct_porosity_profile.c - tabulate a soil class's	*/
+/*		water table depth / saturation deficit curve	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct porosity_profile_object *construct_porosity_profile(*/
+/*			struct soil_default *defaults)		*/
+/*								*/
+/*	void	destroy_porosity_profile(			*/
+/*			struct porosity_profile_object *profile)*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	compute_sat_deficit() and compute_sat_deficit_z() look	*/
+/*	up the table built here instead of calling		*/
+/*	compute_delta_water(z, 0) and compute_z_final(0, -s).	*/
+/*	Knots are evenly spaced in depth from the surface down	*/
+/*	to max_z (below) and hold the exact saturation deficit	*/
+/*	(compute_delta_water) at that depth.  Both directions	*/
+/*	interpolate linearly along the same segments, so the	*/
+/*	two lookups are inverses of each other up to rounding,	*/
+/*	as compute_z_final requires.				*/
+/*								*/
+/*	The spacing dz bounds the error against the exact	*/
+/*	exponential: linear interpolation of			*/
+/*	n_0*p*(1-exp(-z/p)) is off by at most			*/
+/*	n_0*dz^2/(8p) in water, which is off by at most		*/
+/*	about dz^2/(8p) in depth.  dz = sqrt(4p*tol) keeps	*/
+/*	both to half of POROSITY_PROFILE_TOLERANCE, leaving	*/
+/*	room for the slope change across a segment and for	*/
+/*	rounding.						*/
+/*								*/
+/*	Deep in the column the curve flattens out and the	*/
+/*	inverse amplifies rounding error by exp(z/p), so the	*/
+/*	table stops at the depth max_z where that error would	*/
+/*	pass the tolerance (or at soil_depth if sooner); past	*/
+/*	max_z the lookups use the exact math.			*/
+/*								*/
+/*	The bucket array maps evenly spaced saturation deficits	*/
+/*	to the segment they fall in, so the inverse lookup	*/
+/*	only searches the few segments of one bucket.		*/
+/*								*/
+/*	Returns NULL, and the lookups use the exact math, when	*/
+/*	porosity does not decay (p = 0 or p >= 999 are linear	*/
+/*	already) or the class would need more than		*/
+/*	POROSITY_PROFILE_MAX_SEGMENTS knots.			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	-exactporosity skips the tables for every soil class.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "rhessys.h"
+
+/* Rounding error allowed for in the knot values */
+#define PROFILE_ROUNDOFF (64.0 * DBL_EPSILON)
+
+struct porosity_profile_object *construct_porosity_profile(
+	struct soil_default *defaults)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	double	compute_delta_water(int, double, double, double, double, double);
+	void	destroy_porosity_profile(struct porosity_profile_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int k, j, num_segments;
+	double p, n_0, soil_depth, max_z, dz, z;
+	struct porosity_profile_object *profile;
+
+	p = defaults[0].porosity_decay;
+	n_0 = defaults[0].porosity_0;
+	soil_depth = defaults[0].soil_depth;
+	if ((p <= 0.0) || (p >= 999.0) || (n_0 <= 0.0) || (soil_depth <= 0.0))
+		return(NULL);
+
+	max_z = min(soil_depth,
+		-1.0 * p * log(PROFILE_ROUNDOFF * p / POROSITY_PROFILE_TOLERANCE));
+	dz = sqrt(4.0 * p * POROSITY_PROFILE_TOLERANCE / max(n_0, 1.0));
+	if ((max_z <= 0.0) || (max_z / dz >= POROSITY_PROFILE_MAX_SEGMENTS))
+		return(NULL);
+	num_segments = max((int) ceil(max_z / dz), 1);
+
+	profile = (struct porosity_profile_object *) alloc(
+		1 * sizeof(struct porosity_profile_object),
+		"porosity_profile", "construct_porosity_profile");
+	profile[0].num_segments = num_segments;
+	profile[0].max_z = max_z;
+	profile[0].dz = max_z / num_segments;
+	profile[0].sat_deficit = (double *) alloc(
+		(num_segments + 1) * sizeof(double),
+		"sat_deficit", "construct_porosity_profile");
+	profile[0].bucket = NULL;
+
+	/*--------------------------------------------------------------*/
+	/*	Knots, from the exact forward relation.			*/
+	/*--------------------------------------------------------------*/
+	for (k = 0; k <= num_segments; k++) {
+		z = (k == num_segments) ? max_z : k * profile[0].dz;
+		profile[0].sat_deficit[k] = compute_delta_water(0, n_0, p,
+			soil_depth, z, 0.0);
+		/*--------------------------------------------------------------*/
+		/*	A flat segment has no inverse; use the exact math.	*/
+		/*--------------------------------------------------------------*/
+		if ((k > 0) && (profile[0].sat_deficit[k] <= profile[0].sat_deficit[k-1])) {
+			destroy_porosity_profile(profile);
+			return(NULL);
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Buckets: the segment holding each bucket's lower bound.	*/
+	/*--------------------------------------------------------------*/
+	profile[0].bucket_size = profile[0].sat_deficit[num_segments] / num_segments;
+	profile[0].bucket = (int *) alloc((num_segments + 1) * sizeof(int),
+		"bucket", "construct_porosity_profile");
+	k = 0;
+	for (j = 0; j <= num_segments; j++) {
+		while ((k < num_segments - 1)
+			&& (profile[0].sat_deficit[k+1] <= j * profile[0].bucket_size))
+			k++;
+		profile[0].bucket[j] = k;
+	}
+	return(profile);
+} /*end construct_porosity_profile*/
+
+void	destroy_porosity_profile(struct porosity_profile_object *profile)
+{
+	if (profile == NULL) return;
+	free(profile[0].sat_deficit);
+	free(profile[0].bucket);
+	free(profile);
+} /*end destroy_porosity_profile*/
@@ -49,16 +49,20 @@ struct routing_list_object *construct_routing_topology(
 	int assign_neighbours_in_hillslope (struct neighbour_object *,
 		int,
     struct hillslope_object *,
-		FILE *);
+		FILE *,
+		struct command_line_object *);
+	int	patch_in_subcatchment(struct command_line_object *, int, int, int);
 	
 	void *alloc(size_t, char *, char *);
+	void	*arena_alloc(struct arena_object *, size_t, char *, char *);
 
-	double * compute_transmissivity_curve( double, struct patch_object *, struct command_line_object *);
+	double * compute_transmissivity_curve( double, struct patch_object *, struct command_line_object *,
+		struct arena_object *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
-	int		i,d,j;
+	int		i,d,j,p;
 	int		num_patches, num_neighbours;
 	int		patch_ID, zone_ID, hill_ID;
 	int		drainage_type;
@@ -81,7 +85,7 @@ struct routing_list_object *construct_routing_topology(
 	//} /*end if*/
 
 	fscanf(routing_file,"%d",&num_patches);
-	rlist->num_patches = num_patches;
+	rlist->num_patches = 0;
 	rlist->list = (struct patch_object **)alloc(
 		num_patches * sizeof(struct patch_object *), "patch list",
 		"construct_routing_topography");
@@ -91,7 +95,7 @@ struct routing_list_object *construct_routing_topology(
 	/*	if it is a stream add it to the basin level routing list	*/
 	/*	otherwise add it to the hillslope level routing list		*/
 	/*--------------------------------------------------------------*/
-	for (i=0; i< num_patches; ++i) {
+	for (p=0; p< num_patches; ++p) {
 		fscanf(routing_file,"%d %d %d %lf %lf %lf %lf %lf %d %lf %d",
 			&patch_ID,
 			&zone_ID,
@@ -103,6 +107,27 @@ struct routing_list_object *construct_routing_topology(
 			&gamma,
 			&num_neighbours);
 
+		/*--------------------------------------------------------------*/
+		/*	With -subcatchment skip the records of patches that	*/
+		/*	were not constructed.					*/
+		/*--------------------------------------------------------------*/
+		if (patch_in_subcatchment(command_line, patch_ID, zone_ID, hill_ID) == 0) {
+			for (j=0; j< num_neighbours; ++j)
+				fscanf(routing_file,"%d %d %d %lf",
+					&patch_ID,
+					&zone_ID,
+					&hill_ID,
+					&gamma);
+			if ( drainage_type == ROAD )
+				fscanf(routing_file,"%d %d %d %lf",
+					&patch_ID,
+					&zone_ID,
+					&hill_ID,
+					&width);
+			continue;
+		}
+		i = rlist->num_patches++;
+
 		if  ( (patch_ID != 0) && (zone_ID != 0) && (hill_ID != 0) ) {
 			patch = find_patch_in_hillslope(patch_ID, zone_ID, hillslope );
 		}else{
@@ -127,11 +152,11 @@ struct routing_list_object *construct_routing_topology(
 		/*--------------------------------------------------------------*/
 		d=0;
 		if ( surface ) {
-			patch->surface_innundation_list = (struct innundation_object *)alloc( 1 *
+			patch->surface_innundation_list = (struct innundation_object *)arena_alloc(hillslope[0].arena, 1 *
 								sizeof(struct innundation_object), "surface_innundation_list", "construct_routing_topology");
 			innundation_list = patch->surface_innundation_list;
 		} else {
-			patch->innundation_list = (struct innundation_object *)alloc( 1 *
+			patch->innundation_list = (struct innundation_object *)arena_alloc(hillslope[0].arena, 1 *
 					sizeof(struct innundation_object), "innundation_list", "construct_routing_topology");
 			innundation_list = patch->innundation_list;
 		}
@@ -160,9 +185,10 @@ struct routing_list_object *construct_routing_topology(
 		/*--------------------------------------------------------------*/
 		/*  Allocate neighbour array									*/
 		/*--------------------------------------------------------------*/
-		innundation_list->neighbours = (struct neighbour_object *)alloc(num_neighbours *
+		innundation_list->neighbours = (struct neighbour_object *)arena_alloc(hillslope[0].arena, num_neighbours *
 				sizeof(struct neighbour_object), "neighbours", "construct_routing_topology");
-		num_neighbours = assign_neighbours_in_hillslope(innundation_list->neighbours, num_neighbours, hillslope, routing_file);
+		num_neighbours = assign_neighbours_in_hillslope(innundation_list->neighbours, num_neighbours, hillslope, routing_file,
+			command_line);
 		if ((num_neighbours == -9999) && (patch[0].drainage_type != STREAM)) {
 			printf("\n WARNING sum of patch %d neigh gamma is not equal to 1.0", patch[0].ID); 
 		} else {
@@ -193,7 +219,8 @@ struct routing_list_object *construct_routing_topology(
 				patch[0].num_soil_intervals = MAX_NUM_INTERVAL;
 				patch[0].soil_defaults[0][0].interval_size = patch[0].soil_defaults[0][0].soil_water_cap / MAX_NUM_INTERVAL;
 				}
-			patch[0].transmissivity_profile = compute_transmissivity_curve(gamma, patch, command_line);
+			patch[0].transmissivity_profile = compute_transmissivity_curve(gamma, patch, command_line,
+				hillslope[0].arena);
 			}
 
 
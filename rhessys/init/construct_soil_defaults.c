@@ -49,6 +49,8 @@ struct soil_default *construct_soil_defaults(
 		char	*);
 	
 	double compute_delta_water(int, double, double,	double, double, double);
+	struct porosity_profile_object *construct_porosity_profile(
+		struct soil_default *);
 	int	parse_albedo_flag( char *);
 	
 	/*--------------------------------------------------------------*/
@@ -235,6 +237,26 @@ struct soil_default *construct_soil_defaults(
 			default_object_list[i].soil_depth,
 			0.0);
 
+		/*--------------------------------------------------------------*/
+		/*      fill and spill sat_deficit threshold                    */
+		/*      (used by compute_varbased_flow)                         */
+		/*--------------------------------------------------------------*/
+		default_object_list[i].fs_threshold_sat_deficit =
+			default_object_list[i].porosity_0
+			* default_object_list[i].porosity_decay
+			* (1 - exp(-default_object_list[i].soil_depth
+				/ default_object_list[i].porosity_decay))
+			* (1 - default_object_list[i].fs_threshold);
+
+		/*--------------------------------------------------------------*/
+		/*      tabulate sat_deficit against water table depth          */
+		/*--------------------------------------------------------------*/
+		if (command_line[0].exact_porosity_flag == 1)
+			default_object_list[i].porosity_profile = NULL;
+		else
+			default_object_list[i].porosity_profile =
+				construct_porosity_profile(&(default_object_list[i]));
+
 		/*--------------------------------------------------------------*/
 		/* initialization of optional default file parms		*/
 		/*--------------------------------------------------------------*/
@@ -0,0 +1,90 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_solar_table				*/
+/*								*/
+/*	construct_solar_table.c - tabulate basin solar geometry	*/
+/*								*/
+/*	NAME							*/
+/*	construct_solar_table.c - tabulate basin solar geometry	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void construct_solar_table(struct basin_object *basin)	*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Fills basin[0].solar_table with the hourly solar	*/
+/*	geometry (hour angle, cos_sza, optical air mass and	*/
+/*	declination products) and the daylength for every year	*/
+/*	day at the basin latitude.  These depend only on year	*/
+/*	day, hour and latitude, and were recomputed every hour	*/
+/*	by basin_hourly and every day by basin_daily_I.  The	*/
+/*	entries come from the same compute_solar_geometry.c	*/
+/*	routines, so the table gives identical results.		*/
+/*								*/
+/*	Climate dependent terms (atmospheric transmissivity	*/
+/*	and horizon limits, which move with stem density) are	*/
+/*	still applied hourly in zone_hourly.			*/
+/*								*/
+/*	The table records the latitude it was built for;	*/
+/*	basin_hourly and basin_daily_I rebuild it if a		*/
+/*	redefine event changes the basin latitude.  Rebuilding	*/
+/*	also clears the cached zone slope/aspect terms.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "rhessys.h"
+
+void construct_solar_table(struct basin_object *basin)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	double	compute_declination(int);
+	double	compute_daylength(double, double, double);
+	void	compute_basin_solar_geometry(double, double, double, double,
+		int, struct basin_hourly_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int h, z;
+	struct solar_table_object *table;
+
+	if (basin[0].solar_table == NULL)
+		basin[0].solar_table = (struct solar_table_object *) alloc(
+			1 * sizeof(struct solar_table_object),
+			"solar_table", "construct_solar_table");
+	table = basin[0].solar_table;
+	memset(table, 0, sizeof(struct solar_table_object));
+	table[0].latitude = basin[0].latitude;
+
+	/*--------------------------------------------------------------*/
+	/*	Year days are 1 based, hours run 1 to 24.		*/
+	/*--------------------------------------------------------------*/
+	#pragma omp parallel for
+	for (int day = 0; day < SOLAR_TABLE_DAYS; day++) {
+		double declin = compute_declination(day + 1);
+		double cos_declin = cos(declin);
+		double sin_declin = sin(declin);
+		table[0].daylength[day] = compute_daylength(basin[0].latitude,
+			cos_declin, sin_declin);
+		for (int hour = 0; hour < SOLAR_TABLE_HOURS; hour++)
+			compute_basin_solar_geometry(cos_declin, sin_declin,
+				basin[0].cos_latitude, basin[0].sin_latitude,
+				hour + 1, &(table[0].hourly[day][hour]));
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Zone beam slope terms depend on latitude too.		*/
+	/*--------------------------------------------------------------*/
+	for (h = 0; h < basin[0].num_hillslopes; h++)
+		for (z = 0; z < basin[0].hillslopes[h][0].num_zones; z++)
+			basin[0].hillslopes[h][0].zones[z][0].solar_coefs_valid = 0;
+	return;
+} /*end construct_solar_table*/
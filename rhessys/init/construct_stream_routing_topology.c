@@ -62,12 +62,14 @@ struct stream_list_object construct_stream_routing_topology(
 						   FILE *);
 	
 	void *alloc(size_t, char *, char *);
+	int	reach_in_subcatchment(struct command_line_object *, int);
 	
 	
 	/*--------------------------------------------------------------*/
 	/*      Local variable definition.                                                                      */
 	/*--------------------------------------------------------------*/
 	int i, j, num_reaches,m,k,num_reservoir,reach_ID,reservoir_ID,flag_min_flow_storage;
+	int r, num_records;
 	int hillID, patchID, zoneID;
 	int neighbour_hill_num,neighbour_hill_count_0,neighbour_hill_count_1;    
 	double month_max_storage[12],min_storage, min_outflow;
@@ -93,25 +95,26 @@ struct stream_list_object construct_stream_routing_topology(
 	} /*end if*/
 	
 	
-	fscanf(stream_file,"%d",&num_reaches);
-	stream_list.num_reaches = num_reaches;
+	fscanf(stream_file,"%d",&num_records);
 	
 	/*--------------------------------------------------------------*/
 	/* allocate stream network					*/
 	/*--------------------------------------------------------------*/
 	
 	stream_network_ini = (struct stream_network_object *)alloc(
-							   num_reaches * sizeof(struct stream_network_object), " streamlist",
+							   num_records * sizeof(struct stream_network_object), " streamlist",
 							   "construct_stream_routing_topography");
 	stream_network = (struct stream_network_object *)alloc(
-							  num_reaches * sizeof(struct stream_network_object), " streamlist",
+							  num_records * sizeof(struct stream_network_object), " streamlist",
 							  "construct_stream_routing_topography");
 	
 	
 	/*--------------------------------------------------------------*/
 	/*      Read  each reach record.                                */
 	/*--------------------------------------------------------------*/
-	for (i=0; i< num_reaches; ++i) {
+	num_reaches = 0;
+	for (r=0; r< num_records; ++r) {
+		i = num_reaches;
 		neighbour_hill_num=0;
 		neighbour_hill_count_0=0;
 		neighbour_hill_count_1=0;
@@ -125,6 +128,22 @@ struct stream_list_object construct_stream_routing_topology(
 			   &(stream_network_ini[i].manning),
 			   &(stream_network_ini[i].length),
 			   &(stream_network_ini[i].num_lateral_inputs));
+
+		/*--------------------------------------------------------------*/
+		/*	With -subcatchment skip the reaches outside it.		*/
+		/*--------------------------------------------------------------*/
+		if (reach_in_subcatchment(command_line, stream_network_ini[i].reach_ID) == 0) {
+			for (j=0; j< stream_network_ini[i].num_lateral_inputs; ++j)
+				fscanf(stream_file,"%d %d %d", &patchID, &zoneID, &hillID);
+			fscanf(stream_file,"%d",&k);
+			for (j=0; j< k; ++j)
+				fscanf(stream_file,"%d",&reach_ID);
+			fscanf(stream_file,"%d",&k);
+			for (j=0; j< k; ++j)
+				fscanf(stream_file,"%d",&reach_ID);
+			continue;
+		}
+		num_reaches++;
 		
 	
 		/* initializations */
@@ -192,6 +211,21 @@ struct stream_list_object construct_stream_routing_topology(
 	
 	// see if this fixes resource leak
 	fclose(stream_file);
+	stream_list.num_reaches = num_reaches;
+
+	/*--------------------------------------------------------------*/
+	/*   with -subcatchment the outlet reach's downstream		*/
+	/*   neighbours were skipped, so it becomes the outlet		*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].subcatchment_flag == 1) {
+		for (i=0; i< num_reaches; ++i) {
+			for (j=0, k=0; j< stream_network_ini[i].num_downstream_neighbours; ++j)
+				if (reach_in_subcatchment(command_line, stream_network_ini[i].downstream_neighbours[j]))
+					stream_network_ini[i].downstream_neighbours[k++] =
+						stream_network_ini[i].downstream_neighbours[j];
+			stream_network_ini[i].num_downstream_neighbours = k;
+		}
+	}
 
 	/*--------------------------------------------------------------*/
 	/*   code to search the outlet reach*/
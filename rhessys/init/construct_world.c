@@ -343,6 +343,7 @@
 #include <errno.h>
 
 #include "rhessys.h"
+#include "profile.h"
 
 
 struct world_object *construct_world(struct command_line_object *command_line){
@@ -365,9 +366,17 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	struct basin_object *construct_basin(struct command_line_object *, FILE *, int *, 
 		struct base_station_object **, struct default_object *, 
         struct base_station_ncheader_object *,
-        struct world_object *);
-	struct fire_patch_object **construct_patch_fire_grid(struct world_object *, struct command_line_object *,struct fire_default def);
+        struct world_object *,
+        struct basin_index_object *);
+	struct worldfile_index_object *construct_worldfile_index(char *, long, int);
+	void destroy_worldfile_index(struct worldfile_index_object *);
+	int hillslope_in_subset(struct command_line_object *, int);
+	void construct_subcatchment(struct command_line_object *);
+	struct patch_fire_object **construct_patch_fire_grid(struct world_object *, struct command_line_object *,struct fire_default def);
 	struct fire_object **construct_fire_grid(struct world_object *);
+	struct hourly_arena_object *construct_hourly_arena(struct world_object *);
+	void construct_solar_table(struct basin_object *);
+	void construct_hillslope_schedule(struct basin_object *);
 	struct base_station_object **construct_ascii_grid(char *, struct date, struct date);
 	struct base_station_ncheader_object *construct_netcdf_header(struct world_object *, char *);
 	struct base_station_object *construct_netcdf_grid(struct base_station_object *, struct base_station_ncheader *, int *, float, float, float, struct date *, struct date *, struct command_line_object *);
@@ -382,9 +391,12 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	FILE	*header_file;
 	int 	header_file_flag = 0;
 	int		legacy_worldfile = 0;
-	int	i;
+	int	i, b, h, num_basins, num_loaded;
+	char	*subset_option;
 	char	record[MAXSTR];
 	struct world_object *world;
+	struct worldfile_index_object *worldfile_index;
+	struct basin_index_object *basin_index;
 	/*--------------------------------------------------------------*/
 	/*	Allocate a world array.										*/
 	/*--------------------------------------------------------------*/
@@ -758,7 +770,18 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	/*	Construct the list of base stations.			*/
 	/*--------------------------------------------------------------*/
 
-	if (command_line[0].dclim_flag == 0) {
+	PROFILE_BEGIN(PROFILE_CLIMATE_LOAD);
+	if (command_line[0].scenario_world != NULL) {
+		/*--------------------------------------------------------------*/
+		/*	A -scenarios worker rebuilding the world for its own	*/
+		/*	sensitivity parameters shares the base stations its	*/
+		/*	parent already read; they do not depend on them.	*/
+		/*--------------------------------------------------------------*/
+		world[0].num_base_stations = command_line[0].scenario_world[0].num_base_stations;
+		world[0].base_stations = command_line[0].scenario_world[0].base_stations;
+		world[0].base_station_ncheader = command_line[0].scenario_world[0].base_station_ncheader;
+	}
+	else if (command_line[0].dclim_flag == 0) {
 		/*--------------------------------------------------------------*/
 		/*	Construct the base_stations.				*/
 		/*--------------------------------------------------------------*/
@@ -848,6 +871,7 @@ struct world_object *construct_world(struct command_line_object *command_line){
 
 		}
 	} /*end if dclim_flag*/
+	PROFILE_END(PROFILE_CLIMATE_LOAD);
 	
         
 
@@ -866,6 +890,58 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	fscanf(world_file,"%d",&(world[0].num_basin_files));
 	read_record(world_file, record);
 
+	/*--------------------------------------------------------------*/
+	/*	Index the worldfile, so hillslopes can be constructed	*/
+	/*	in parallel and a subset of them loaded.  With		*/
+	/*	-subcatchment the subset is the hillslopes with		*/
+	/*	patches upstream of the outlet.				*/
+	/*--------------------------------------------------------------*/
+	worldfile_index = NULL;
+	subset_option = (command_line[0].subcatchment_flag == 1) ? "-subcatchment" : "-hillslopes";
+	if ((command_line[0].subcatchment_flag == 1) &&
+			(command_line[0].num_hillslope_subset > 0)) {
+		fprintf(stderr,"FATAL ERROR: -subcatchment cannot be used with -hillslopes\n");
+		exit(EXIT_FAILURE);
+	}
+	if ((command_line[0].worldindex_flag == 1) ||
+			(command_line[0].num_hillslope_subset > 0) ||
+			(command_line[0].subcatchment_flag == 1)) {
+		if ((command_line[0].num_hillslope_subset > 0) ||
+				(command_line[0].subcatchment_flag == 1)) {
+			if (command_line[0].ddn_routing_flag == 1) {
+				fprintf(stderr,"FATAL ERROR: %s cannot be used with ddn routing\n", subset_option);
+				exit(EXIT_FAILURE);
+			}
+			if ((command_line[0].stream_routing_flag == 1) &&
+					(command_line[0].subcatchment_flag == 0)) {
+				fprintf(stderr,"FATAL ERROR: -hillslopes cannot be used with stream routing\n");
+				exit(EXIT_FAILURE);
+			}
+			if (command_line[0].firespread_flag == 1) {
+				fprintf(stderr,"FATAL ERROR: %s cannot be used with -firespread\n", subset_option);
+				exit(EXIT_FAILURE);
+			}
+			if (command_line[0].gridded_netcdf_flag == 1) {
+				fprintf(stderr,"FATAL ERROR: %s cannot be used with netcdf climate\n", subset_option);
+				exit(EXIT_FAILURE);
+			}
+		}
+		if (command_line[0].subcatchment_flag == 1)
+			construct_subcatchment(command_line);
+		if (command_line[0].gridded_netcdf_flag == 1) {
+			printf("\n Not using the worldfile index with netcdf climate\n");
+		}
+		else {
+			worldfile_index = construct_worldfile_index(command_line[0].world_filename,
+				ftell(world_file), world[0].num_basin_files);
+			if ((worldfile_index == NULL) && (command_line[0].num_hillslope_subset > 0)) {
+				fprintf(stderr,"FATAL ERROR: Cannot index worldfile %s for %s\n",
+					command_line[0].world_filename, subset_option);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
 	printf("\n Constructing basins\n");
 	/*--------------------------------------------------------------*/
 	/*	Construct the list of basins. 								*/
@@ -875,16 +951,72 @@ struct world_object *construct_world(struct command_line_object *command_line){
 		"basins","construct_world");
 	
 	/*--------------------------------------------------------------*/
-	/*	Construct the basins. 										*/
+	/*	Construct the basins, leaving out any with none of the	*/
+	/*	hillslopes given with -hillslopes.			*/
 	/*--------------------------------------------------------------*/
+	num_basins = 0;
+	num_loaded = 0;
 	for (i=0; i<world[0].num_basin_files; i++ ){
+		basin_index = NULL;
+		if (worldfile_index != NULL) {
+			basin_index = &(worldfile_index[0].basins[i]);
+			for (h = 0; h < basin_index[0].num_hillslopes; h++)
+				if (hillslope_in_subset(command_line, basin_index[0].hillslopes[h].ID))
+					break;
+			if (h == basin_index[0].num_hillslopes) {
+				printf("\n Skipping basin %d\n", basin_index[0].ID);
+				fseek(world_file, basin_index[0].end_offset, SEEK_SET);
+				continue;
+			}
+		}
 	  printf("\n Creating basin %d\n", i);
-		world[0].basins[i] = construct_basin(
+		world[0].basins[num_basins] = construct_basin(
 			command_line, world_file, &(world[0].num_base_stations),
 			world[0].base_stations,	world[0].defaults, 
             world[0].base_station_ncheader,
-            world);
+            world, basin_index);
+		num_loaded += world[0].basins[num_basins][0].num_hillslopes;
+		num_basins++;
 	} /*end for*/
+	world[0].num_basin_files = num_basins;
+	destroy_worldfile_index(worldfile_index);
+
+	/*--------------------------------------------------------------*/
+	/*	Every hillslope given with -hillslopes must be loaded.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].num_hillslope_subset > 0) {
+		for (i = 0; i < command_line[0].num_hillslope_subset; i++) {
+			for (b = 0; b < world[0].num_basin_files; b++) {
+				for (h = 0; h < world[0].basins[b][0].num_hillslopes; h++)
+					if (world[0].basins[b][0].hillslopes[h][0].ID ==
+							command_line[0].hillslope_subset[i])
+						break;
+				if (h < world[0].basins[b][0].num_hillslopes)
+					break;
+			}
+			if (b == world[0].num_basin_files) {
+				fprintf(stderr,"FATAL ERROR: Hillslope %d given with %s is not in the worldfile\n",
+					command_line[0].hillslope_subset[i], subset_option);
+				exit(EXIT_FAILURE);
+			}
+		}
+		printf("\n Loaded %d hillslopes\n", num_loaded);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Preallocate the hourly objects of the world, basins,	*/
+	/*	hillslopes and strata.					*/
+	/*--------------------------------------------------------------*/
+	world[0].hourly_arena = construct_hourly_arena(world);
+
+	/*--------------------------------------------------------------*/
+	/*	Tabulate the solar geometry of each basin and set up	*/
+	/*	its hillslope schedule.					*/
+	/*--------------------------------------------------------------*/
+	for (i=0; i<world[0].num_basin_files; i++ ) {
+		construct_solar_table(world[0].basins[i]);
+		construct_hillslope_schedule(world[0].basins[i]);
+	}
 
 	/*--------------------------------------------------------------*/
 	/*	If spinup flag is set construct the spinup thresholds object*/
@@ -0,0 +1,141 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_world_id_index			*/
+/*								*/
+/*	construct_world_id_index.c - index world objects by ID	*/
+/*								*/
+/*	NAME							*/
+/*	construct_world_id_index.c - index world objects by ID	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct world_id_index_object *construct_world_id_index(	*/
+/*			struct world_object *world)		*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Builds sorted (parent, ID) indexes over the basins,	*/
+/*	hillslopes, zones, patches and strata of a world, so	*/
+/*	that events addressing objects by ID (redefine_world,	*/
+/*	state deltas) do not need the linear find_* scans.	*/
+/*								*/
+/*	Each object is keyed by its parent (basin by NULL,	*/
+/*	hillslope by basin, ..., stratum by patch).  Children	*/
+/*	are inserted last-to-first so that, as with the find_*	*/
+/*	scans, the first object with a duplicate ID wins.	*/
+/*								*/
+/*	The spatial structure does not change after		*/
+/*	construct_world, so the index is built on first use	*/
+/*	and kept in world[0].id_index until destroy_world.	*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+#include "id_index.h"
+
+struct world_id_index_object *construct_world_id_index(struct world_object *world)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int b, h, z, p, c;
+	struct world_id_index_object *index;
+	struct basin_object *basin;
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+	struct patch_object *patch;
+
+	index = (struct world_id_index_object *) alloc(1 * sizeof(struct world_id_index_object),
+		"id_index", "construct_world_id_index");
+	index[0].basins = newIdIndex(world[0].num_basin_files);
+	index[0].hillslopes = newIdIndex(256);
+	index[0].zones = newIdIndex(1024);
+	index[0].patches = newIdIndex(4096);
+	index[0].strata = newIdIndex(4096);
+
+	for (b = world[0].num_basin_files - 1; b >= 0; b--) {
+		basin = world[0].basins[b];
+		idIndexInsertInParent(index[0].basins, NULL, basin[0].ID, basin);
+		for (h = basin[0].num_hillslopes - 1; h >= 0; h--) {
+			hillslope = basin[0].hillslopes[h];
+			idIndexInsertInParent(index[0].hillslopes, basin, hillslope[0].ID, hillslope);
+			for (z = hillslope[0].num_zones - 1; z >= 0; z--) {
+				zone = hillslope[0].zones[z];
+				idIndexInsertInParent(index[0].zones, hillslope, zone[0].ID, zone);
+				for (p = zone[0].num_patches - 1; p >= 0; p--) {
+					patch = zone[0].patches[p];
+					idIndexInsertInParent(index[0].patches, zone, patch[0].ID, patch);
+					for (c = patch[0].num_canopy_strata - 1; c >= 0; c--) {
+						idIndexInsertInParent(index[0].strata, patch,
+							patch[0].canopy_strata[c][0].ID, patch[0].canopy_strata[c]);
+					}
+				}
+			}
+		}
+	}
+
+	idIndexFinalize(index[0].basins);
+	idIndexFinalize(index[0].hillslopes);
+	idIndexFinalize(index[0].zones);
+	idIndexFinalize(index[0].patches);
+	idIndexFinalize(index[0].strata);
+	return(index);
+} /*end construct_world_id_index*/
+
+void destroy_world_id_index(struct world_id_index_object *index)
+{
+	if (index == NULL) return;
+	freeIdIndex(index[0].basins);
+	freeIdIndex(index[0].hillslopes);
+	freeIdIndex(index[0].zones);
+	freeIdIndex(index[0].patches);
+	freeIdIndex(index[0].strata);
+	free(index);
+} /*end destroy_world_id_index*/
+
+/*--------------------------------------------------------------*/
+/*	Indexed equivalents of find_basin, find_hillslope_in_basin,	*/
+/*	find_zone_in_hillslope, find_patch_in_zone and		*/
+/*	find_stratum_in_patch; NULL if the object is not found.	*/
+/*--------------------------------------------------------------*/
+struct basin_object *find_basin_indexed(int basin_ID,
+		struct world_id_index_object *index)
+{
+	return((struct basin_object *) idIndexGetInParent(index[0].basins, NULL, basin_ID));
+}
+
+struct hillslope_object *find_hillslope_in_basin_indexed(int hill_ID,
+		struct basin_object *basin,
+		struct world_id_index_object *index)
+{
+	return((struct hillslope_object *) idIndexGetInParent(index[0].hillslopes, basin, hill_ID));
+}
+
+struct zone_object *find_zone_in_hillslope_indexed(int zone_ID,
+		struct hillslope_object *hillslope,
+		struct world_id_index_object *index)
+{
+	return((struct zone_object *) idIndexGetInParent(index[0].zones, hillslope, zone_ID));
+}
+
+struct patch_object *find_patch_in_zone_indexed(int patch_ID,
+		struct zone_object *zone,
+		struct world_id_index_object *index)
+{
+	return((struct patch_object *) idIndexGetInParent(index[0].patches, zone, patch_ID));
+}
+
+struct canopy_strata_object *find_stratum_in_patch_indexed(int stratum_ID,
+		struct patch_object *patch,
+		struct world_id_index_object *index)
+{
+	return((struct canopy_strata_object *) idIndexGetInParent(index[0].strata, patch, stratum_ID));
+}
@@ -11,6 +11,7 @@
 /*	struct zone_object *construct_zone(										*/
 /*					struct	command_line_object	*command_line,	*/
 /*					FILE	*world_file,					*/
+/*					int		hillslope_ID,					*/
 /*					struct	default_object						*/
 /*																*/
 /*	OPTIONS														*/
@@ -55,11 +56,13 @@
 struct zone_object *construct_zone(
 								   struct	command_line_object	*command_line,
 								   FILE		*world_file,
+								   int		hillslope_ID,
 								   int		*num_world_base_stations,
 								   struct	base_station_object **world_base_stations,
 								   struct	default_object	*defaults,
 								   struct	base_station_ncheader_object *base_station_ncheader,
-								   struct	world_object *world)
+								   struct	world_object *world,
+								   struct	arena_object *arena)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -89,7 +92,8 @@ struct zone_object *construct_zone(
 		FILE	*,
 		int		num_world_base_stations,
 		struct base_station_object **world_base_stations,
-		struct	default_object	*defaults);
+		struct	default_object	*defaults,
+		struct	arena_object	*);
 
 	struct patch_family_object *construct_patch_family(
 		struct zone_object *zone,
@@ -112,14 +116,19 @@ struct zone_object *construct_zone(
 	int get_netcdf_xy(char *, char *, char *, float, float, float, float *, float *);
 	
 	void	*alloc(size_t, char *, char *);
+	void	*arena_alloc(struct arena_object *, size_t, char *, char *);
 	double	atm_pres( double );
+	int	patch_in_subcatchment(struct command_line_object *, int, int, int);
+	int	peek_worldfile_ID(FILE *, char *);
+	void	skip_worldfile_patch(FILE *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	int		base_stationID;
-	int		i, k, j;
+	int		i, k, j, p;
+	int		num_patches;
 	int		notfound;
     int     basestation_id;
 	float   base_x, base_y;
@@ -139,7 +148,7 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	/*	Allocate a zone object.								*/
 	/*--------------------------------------------------------------*/
-	zone = (struct zone_object *) alloc( 1 *
+	zone = (struct zone_object *) arena_alloc(arena, 1 *
 		sizeof( struct zone_object ),"zone","construct_zone" );
 	/*--------------------------------------------------------------*/
 	/*	Read in the next zone record for this hillslope.			*/
@@ -185,6 +194,7 @@ struct zone_object *construct_zone(
 	zone[0].cos_slope = cos(zone[0].slope);
 	zone[0].sin_aspect = sin(zone[0].aspect);
 	zone[0].sin_slope = sin(zone[0].slope);
+	zone[0].solar_coefs_valid = 0;
 	/*--------------------------------------------------------------*/
 	/*      Initialize accumulator variables                        */
 	/*--------------------------------------------------------------*/
@@ -197,14 +207,14 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	/*	Define hourly array zone				*/
 	/*--------------------------------------------------------------*/
-	zone[0].hourly = (struct zone_hourly_object *) alloc(
+	zone[0].hourly = (struct zone_hourly_object *) arena_alloc(arena,
 		sizeof( struct zone_hourly_object ),
 		"hourly","zone_hourly");
 	/*--------------------------------------------------------------*/
 	/*	Assign	defaults for this zone								*/
 	/*--------------------------------------------------------------*/
 	zone[0].defaults = (struct zone_default **)
-		alloc( sizeof(struct zone_default *),"defaults",
+		arena_alloc(arena, sizeof(struct zone_default *),"defaults",
 		"construct_zone" );
 	i = 0;
 	while (defaults[0].zone[i].ID != zone[0].zone_parm_ID) {
@@ -230,7 +240,7 @@ struct zone_object *construct_zone(
 	/*	Allocate a list of base stations for this zone.          */
 	/*--------------------------------------------------------------*/
 	zone[0].base_stations = (struct base_station_object **)
-		alloc(zone[0].num_base_stations *
+		arena_alloc(arena, zone[0].num_base_stations *
 		sizeof(struct base_station_object *),
 		"base_stations","construct_zone" );
 	/*--------------------------------------------------------------*/
@@ -383,7 +393,7 @@ struct zone_object *construct_zone(
 	/*	Allocate list of pointers to patch objects .				*/
   /*--------------------------------------------------------------*/
   zone[0].patches = (struct patch_object ** ) 
-		alloc( zone[0].num_patches * sizeof( struct patch_object *),
+		arena_alloc(arena, zone[0].num_patches * sizeof( struct patch_object *),
 		"patches","construct_zone");
 	/*--------------------------------------------------------------*/
 	/*	Initialize any variables that should be initialized at	*/
@@ -401,16 +411,40 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	/*	Construct the intervals in this zone.						*/
 	/*--------------------------------------------------------------*/
-	for ( i=0 ; i<zone[0].num_patches ; i++ ){
+	num_patches = zone[0].num_patches;
+	zone[0].num_patches = 0;
+	for ( p=0 ; p<num_patches ; p++ ){
+		/*--------------------------------------------------------------*/
+		/*	With -subcatchment leave out patches that do not	*/
+		/*	drain to the outlet.					*/
+		/*--------------------------------------------------------------*/
+		if ((command_line[0].subcatchment_flag == 1) &&
+				(patch_in_subcatchment(command_line,
+				peek_worldfile_ID(world_file, "patch_ID"), zone[0].ID, hillslope_ID) == 0)) {
+			skip_worldfile_patch(world_file);
+			continue;
+		}
+		i = zone[0].num_patches++;
 		zone[0].patches[i] = construct_patch(
 			command_line,
 			world_file,
 			*num_world_base_stations,
 			world_base_stations,
-			defaults);
+			defaults,
+			arena);
 		zone[0].patches[i][0].zone = zone;
 		sum_patch_area += zone[0].patches[i][0].area;
 	} /*end for*/
+	/*--------------------------------------------------------------*/
+	/*	Have zone_daily_F sum the patch canopies on the first day.	*/
+	/*--------------------------------------------------------------*/
+	zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+
+	/*--------------------------------------------------------------*/
+	/*	A zone cut down by -subcatchment covers its patches only.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].subcatchment_flag == 1)
+		zone[0].area = sum_patch_area;
 
 	// check that zone area is equal to sum of patch areas
 	if ( fabs(sum_patch_area -zone[0].area) > 0.01)
@@ -464,7 +498,7 @@ struct zone_object *construct_zone(
 	/*	Allocate pointers to patch family objects					*/
   	/*--------------------------------------------------------------*/
 		zone[0].patch_families = (struct patch_family_object **) 
-			alloc(zone[0].num_patch_families * sizeof(struct patch_family_object *), "patch_families", "construct_zone");
+			arena_alloc(arena, zone[0].num_patch_families * sizeof(struct patch_family_object *), "patch_families", "construct_zone");
 
 	/*--------------------------------------------------------------*/
 	/*	Construct patch families									*/
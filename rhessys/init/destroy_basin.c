@@ -27,6 +27,7 @@ void destroy_basin(
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
 	void	destroy_hillslope(
 		struct	command_line_object	*,
 		struct	hillslope_object	**);
@@ -44,23 +45,25 @@ void destroy_basin(
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of hillslopes.								*/
 	/*--------------------------------------------------------------*/
-	free(basin[0].hillslopes);
+	alloc_free(basin[0].hillslopes);
 	/*--------------------------------------------------------------*/
 	/*	Destroy the basins grow extension if it exists.			*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
-		free(basin[0].grow);
+		alloc_free(basin[0].grow);
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of base stations	*/
 	/*--------------------------------------------------------------*/
 	if ( basin[0].num_base_stations > 0 )
-		free( basin[0].base_stations);
+		alloc_free( basin[0].base_stations);
+	alloc_free( basin[0].solar_table );
+	alloc_free( basin[0].hillslope_order );
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of route_list: need further free	*/
 	/*--------------------------------------------------------------*/
 	/*--------------------------------------------------------------*/
 	/*	Destroy the main basin object.								*/
 	/*--------------------------------------------------------------*/
-	free(basin);
+	alloc_free(basin);
 	return;
 } /*end destroy_basin*/
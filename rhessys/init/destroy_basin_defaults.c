@@ -32,6 +32,7 @@ void destroy_basin_defaults(int num_default_files,
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	alloc_free(void *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -45,12 +46,12 @@ void destroy_basin_defaults(int num_default_files,
 		/*		Loop through all the default files and free grow extens */
 		/*--------------------------------------------------------------*/
 		for ( i=0 ; i<num_default_files; i++ )
-			free( default_object_list[i].grow_defaults );
+			alloc_free( default_object_list[i].grow_defaults );
 	} /*end if*/
 	/*--------------------------------------------------------------*/
 	/*	Delete the default records (all at once since they were		*/
 	/*	allocated in a contiguous array).							*/
 	/*--------------------------------------------------------------*/
-	free( default_object_list );
+	alloc_free( default_object_list );
 	return;
 } /*end destroy_basin_defaults*/
@@ -27,6 +27,7 @@ void destroy_canopy_stratum(
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
 	/*--------------------------------------------------------------*/
@@ -39,10 +40,10 @@ void destroy_canopy_stratum(
 	/*	destroy the list of base stations.	*/
 	/*--------------------------------------------------------------*/
 	if ( stratum[0].num_base_stations > 0 )
-		free(stratum[0].base_stations);
+		alloc_free(stratum[0].base_stations);
 	/*--------------------------------------------------------------*/
 	/*	destroy the main stratum object		*/
 	/*--------------------------------------------------------------*/
-	free(stratum);
+	alloc_free(stratum);
 	return;
 } /*end destroy_stratum*/
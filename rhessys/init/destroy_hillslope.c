@@ -27,6 +27,8 @@ void destroy_hillslope(
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
+	void	destroy_arena(struct arena_object *);
 	void	destroy_zone(
 		struct	command_line_object	*,
 		struct	zone_object	**);
@@ -39,33 +41,43 @@ void destroy_hillslope(
 	/*	destroy all the zones in this hillslope.					*/
 	/*--------------------------------------------------------------*/
 	hillslope = *hillslope_list;
-	for ( i=0 ; i< hillslope[0].num_zones; i++ )
-		destroy_zone( command_line, &(hillslope[0].zones[i]));
-	/*--------------------------------------------------------------*/
-	/*	destroy the list of zones.									*/
-	/*--------------------------------------------------------------*/
-	free(hillslope[0].zones);
+	if ( hillslope[0].arena == NULL ) {
+		for ( i=0 ; i< hillslope[0].num_zones; i++ )
+			destroy_zone( command_line, &(hillslope[0].zones[i]));
+		/*--------------------------------------------------------------*/
+		/*	destroy the list of zones.									*/
+		/*--------------------------------------------------------------*/
+		alloc_free(hillslope[0].zones);
+	}
+	else {
+		/*--------------------------------------------------------------*/
+		/*	zones, patches, strata and the list of zones all live	*/
+		/*	in the hillslope arena (see util/arena.c).				*/
+		/*--------------------------------------------------------------*/
+		destroy_arena(hillslope[0].arena);
+	}
+	alloc_free(hillslope[0].zone_chunk_start);
 	/*--------------------------------------------------------------*/
 	/*	destroy the hillslope's grow extension if it exists.		*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
-		free(hillslope[0].grow);
+		alloc_free(hillslope[0].grow);
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of pointers to base stations.				*/
 	/*--------------------------------------------------------------*/
 	if ( hillslope[0].num_base_stations > 0 )
-		free( hillslope[0].base_stations);
+		alloc_free( hillslope[0].base_stations);
 
 
   if (command_line[0].routing_flag==1){
-	    free(hillslope[0].route_list[0].list);
-	    free(hillslope[0].route_list);
-	    free(hillslope[0].surface_route_list[0].list);
-	    free(hillslope[0].surface_route_list);
+	    alloc_free(hillslope[0].route_list[0].list);
+	    alloc_free(hillslope[0].route_list);
+	    alloc_free(hillslope[0].surface_route_list[0].list);
+	    alloc_free(hillslope[0].surface_route_list);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Destroy the main hillslope object.							*/
 	/*--------------------------------------------------------------*/
-	free(hillslope);
+	alloc_free(hillslope);
 	return;
 } /*end destroy_hillslope*/
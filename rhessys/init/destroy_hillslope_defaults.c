@@ -32,11 +32,12 @@ void destroy_hillslope_defaults(int num_default_files,
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
 	int 	i;
 	/*--------------------------------------------------------------*/
 	/*	Delete the default records (all at once since they were		*/
 	/*	allocated in a contiguous array).							*/
 	/*--------------------------------------------------------------*/
-	free( default_object_list );
+	alloc_free( default_object_list );
 	return;
 } /*end destroy_hillslope_defaults*/
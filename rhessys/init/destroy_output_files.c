@@ -32,6 +32,7 @@ void	destroy_output_files(
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
 	void	*destroy_output_fileset( struct	output_files_object	*);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -72,7 +73,7 @@ void	destroy_output_files(
 	if ((command_line[0].b != NULL) || (command_line[0].h != NULL) ||
 		(command_line[0].z != NULL) || (command_line[0].p != NULL) ||
 		(command_line[0].c != NULL)){
-		free( output );
+		alloc_free( output );
 	}
 	return;
 } /*end destroy_output_files*/
@@ -29,6 +29,7 @@ void	destroy_output_fileset(	 struct	output_files_object *fileset)
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	alloc_free(void *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -41,6 +42,6 @@ void	destroy_output_fileset(	 struct	output_files_object *fileset)
 	fclose(  fileset[0].monthly );
 	fclose(  fileset[0].daily );
 	fclose(  fileset[0].hourly );
-	free( fileset );
+	alloc_free( fileset );
 	return;
 } /*end destroy_output_fileset*/
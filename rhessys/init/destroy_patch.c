@@ -27,6 +27,7 @@ void destroy_patch(
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
 	void	destroy_canopy_stratum( struct command_line_object *,
 		struct canopy_strata_object ** );
 	/*--------------------------------------------------------------*/
@@ -43,34 +44,35 @@ void destroy_patch(
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of canopy strata.							*/
 	/*--------------------------------------------------------------*/
-	free(patch[0].canopy_strata);
+	alloc_free(patch[0].canopy_strata);
 	/*--------------------------------------------------------------*/
 	/*	destroy the patch grow extension if it exists.				*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
-		free(patch[0].grow);
+		alloc_free(patch[0].grow);
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of base stations.							*/
 	/*--------------------------------------------------------------*/
 	if ( patch[0].num_base_stations > 0 )
-		free( patch[0].base_stations);
+		alloc_free( patch[0].base_stations);
 	
 	
 	/*--------------------------------------------------------------*/
 	/*	destroy the routing list							*/
 	/*--------------------------------------------------------------*/
-  free(patch[0].innundation_list[0].neighbours);
-	free(patch[0].innundation_list);
-  free(patch[0].surface_innundation_list[0].neighbours);
-  free(patch[0].surface_innundation_list);
-	free(patch[0].transmissivity_profile);
+  alloc_free(patch[0].innundation_list[0].neighbours);
+	alloc_free(patch[0].innundation_list);
+  alloc_free(patch[0].surface_innundation_list[0].neighbours);
+  alloc_free(patch[0].surface_innundation_list);
+	alloc_free(patch[0].transmissivity_profile);
 	
-	free(patch[0].hourly);
-	free(patch[0].layers);
+	alloc_free(patch[0].hourly);
+	alloc_free(patch[0].layers);
+	alloc_free(patch[0].layer_strata);
 	/*--------------------------------------------------------------*/
 	/*	destroy the main patch object.								*/
 	/*--------------------------------------------------------------*/
 
-	free(patch);
+	alloc_free(patch);
 	return;
 } /*end destroy_patch*/
@@ -32,15 +32,20 @@ void destroy_soil_defaults(int num_default_files,
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	alloc_free(void *);
+	void	destroy_porosity_profile(struct porosity_profile_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
+	int	i;
 	
+	for (i=0; i<num_default_files; i++)
+		destroy_porosity_profile(default_object_list[i].porosity_profile);
 	/*--------------------------------------------------------------*/
 	/*	Delete the default records (all at once since they were		*/
 	/*	allocated in a contiguous array).							*/
 	/*--------------------------------------------------------------*/
-	free( default_object_list );
+	alloc_free( default_object_list );
 	return;
 } /*end destroy_soil_defaults*/
@@ -32,6 +32,7 @@ void destroy_stratum_defaults(int num_default_files,
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	alloc_free(void *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -41,6 +42,6 @@ void destroy_stratum_defaults(int num_default_files,
 	/*	Delete the default records (all at once since they were		*/
 	/*	allocated in a contiguous array).							*/
 	/*--------------------------------------------------------------*/
-	free( default_object_list );
+	alloc_free( default_object_list );
 	return;
 } /*end destroy_stratum_defaults*/
@@ -34,6 +34,7 @@ void destroy_world(struct command_line_object *command_line,
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	alloc_free(void *);
 	
 	void	destroy_basin_defaults(
 		int,
@@ -75,6 +76,10 @@ void destroy_world(struct command_line_object *command_line,
 	void	destroy_base_station(
 		struct command_line_object *,
 		struct base_station_object *);
+	void	destroy_world_id_index(
+		struct world_id_index_object *);
+	void	destroy_hourly_arena(
+		struct hourly_arena_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -128,7 +133,7 @@ void destroy_world(struct command_line_object *command_line,
 		world[0].defaults[0].num_stratum_default_files,
 		command_line[0].grow_flag,
 		world[0].defaults[0].stratum);
-	free(world[0].defaults);
+	alloc_free(world[0].defaults);
 	/*--------------------------------------------------------------*/
 	/*	Destroy the base_stations objects.					*/
 	/*--------------------------------------------------------------*/
@@ -136,7 +141,7 @@ void destroy_world(struct command_line_object *command_line,
 		destroy_base_station( command_line,
 			world[0].base_stations[i]);
 	} /*end for*/
-	free( world[0].base_stations );
+	alloc_free( world[0].base_stations );
 	/*--------------------------------------------------------------*/
 	/*	Destroy the basins. 										*/
 	/*--------------------------------------------------------------*/
@@ -144,13 +149,35 @@ void destroy_world(struct command_line_object *command_line,
 		destroy_basin( 	command_line,
 			&(world[0].basins[i]) );
 	} /*end for*/
-	free( world[0].basins );
+	alloc_free( world[0].basins );
 
-	if (command_line[0].firespread_flag == 1)
-	/*	free(world[0].fire_grid);*/
+	/*--------------------------------------------------------------*/
+	/*	Destroy the patch fire grid; cells are one contiguous block.	*/
+	/*	fire_grid is handed back and forth with WMFire, leave it.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].firespread_flag == 1) {
+		alloc_free(world[0].patch_fire_grid[0]);
+		alloc_free(world[0].patch_fire_grid);
+		alloc_free(world[0].patch_fire_grid_patches);
+		alloc_free(world[0].patch_fire_grid_prop);
+		alloc_free(world[0].patch_fire_cells[0].patches);
+		alloc_free(world[0].patch_fire_cells[0].cell_start);
+		alloc_free(world[0].patch_fire_cells[0].cells);
+		alloc_free(world[0].patch_fire_cells[0].slots);
+		alloc_free(world[0].patch_fire_cells);
+	}
+	/*--------------------------------------------------------------*/
+	/*	Destroy the ID index built by redefine events.		*/
+	/*--------------------------------------------------------------*/
+	if (world[0].id_index != NULL)
+		destroy_world_id_index(world[0].id_index);
+	/*--------------------------------------------------------------*/
+	/*	Destroy the hourly arena.				*/
+	/*--------------------------------------------------------------*/
+	destroy_hourly_arena(world[0].hourly_arena);
 	/*--------------------------------------------------------------*/
 	/*	Destroy the world.											*/
 	/*--------------------------------------------------------------*/
-	free( world );
+	alloc_free( world );
 	return;
 } /*end destroy_world.c*/
@@ -27,6 +27,7 @@ void destroy_zone(
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
 	void	destroy_patch(
 		struct	command_line_object	*,
 		struct	patch_object	**);
@@ -44,26 +45,26 @@ void destroy_zone(
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of patches.								*/
 	/*--------------------------------------------------------------*/
-	free(zone[0].patches);
+	alloc_free(zone[0].patches);
 	/*--------------------------------------------------------------*/
 	/*	destroy the zone grow extension if it exists.				*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
-		free(zone[0].grow);
+		alloc_free(zone[0].grow);
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of pointers to the base stations 			*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].num_base_stations > 0 ){
-	       free(zone[0].base_stations);
+	       alloc_free(zone[0].base_stations);
 	}
       
 	/*--------------------------------------------------------------*/
 	/*	destroy the hourly zone			*/
 	/*--------------------------------------------------------------*/
-	free(zone[0].hourly);
+	alloc_free(zone[0].hourly);
 	/*--------------------------------------------------------------*/
 	/*	Destroy the main zone object.								*/
 	/*--------------------------------------------------------------*/
-	free(zone);
+	alloc_free(zone);
 	return;
 } /*end destroy_zone*/
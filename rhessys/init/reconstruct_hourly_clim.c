@@ -38,6 +38,7 @@ void reconstruct_hourly_clim(struct world_object * world,
   int get_num_daywhourly(struct base_station_object *);
   void *alloc(size_t, char *, char *);
   long	julday( struct date);
+  struct hourly_clim_slots construct_hourly_clim_slots(struct clim_event_sequence);
   /*-----------------------------------------------------------------------------
    *  Local variable definition
    *-----------------------------------------------------------------------------*/
@@ -181,6 +182,10 @@ void reconstruct_hourly_clim(struct world_object * world,
       }
       hourly_clim[0].rain.inx=0;
       hourly_clim[0].rain.seq = seq;
+      if(hourly_clim[0].rain_slots.value != NULL){
+	  free(hourly_clim[0].rain_slots.value);
+      }
+      hourly_clim[0].rain_slots = construct_hourly_clim_slots(hourly_clim[0].rain);
 
     }
 
@@ -0,0 +1,75 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					skip_routing_topology						*/
+/*																*/
+/*	skip_routing_topology.c - skips a hillslope's flow table	*/
+/*																*/
+/*	NAME														*/
+/*	skip_routing_topology.c - skips a hillslope's flow table	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void skip_routing_topology(FILE *routing_file)				*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Reads past the patch records of one hillslope in a flow		*/
+/*	table, as construct_routing_topology reads them, for a		*/
+/*	hillslope that was not loaded (see -hillslopes).  The		*/
+/*	hillslope ID must already have been read.					*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	Only the standard flow table format; construct_world		*/
+/*	does not allow -hillslopes with ddn routing.				*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rhessys.h"
+
+void skip_routing_topology(FILE *routing_file)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int		i, j;
+	int		num_patches, num_neighbours, drainage_type;
+	int		patch_ID, zone_ID, hill_ID;
+	double	x, y, z, area, gamma, width;
+
+	if (fscanf(routing_file,"%d",&num_patches) != 1) {
+		fprintf(stderr,"FATAL ERROR: in skip_routing_topology, flow table ends early\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i=0; i< num_patches; ++i) {
+		if (fscanf(routing_file,"%d %d %d %lf %lf %lf %lf %lf %d %lf %d",
+			&patch_ID,
+			&zone_ID,
+			&hill_ID,
+			&x,&y,&z,
+			&area,
+			&area,
+			&drainage_type,
+			&gamma,
+			&num_neighbours) != 11) {
+			fprintf(stderr,"FATAL ERROR: in skip_routing_topology, flow table ends early\n");
+			exit(EXIT_FAILURE);
+		}
+		for (j=0; j< num_neighbours; ++j)
+			fscanf(routing_file,"%d %d %d %lf",
+				&patch_ID,
+				&zone_ID,
+				&hill_ID,
+				&gamma);
+		if ( drainage_type == ROAD )
+			fscanf(routing_file,"%d %d %d %lf",
+				&patch_ID,
+				&zone_ID,
+				&hill_ID,
+				&width);
+	}
+	return;
+} /*end skip_routing_topology.c*/
@@ -294,6 +294,9 @@
 #include "rhessys.h"
 #include "output_filter/construct_output_filter.h"
 #include "output_filter/destroy_output_filter.h"
+#include "profile.h"
+#include "fast_format.h"
+#include "alloc_accounting.h"
 
 // The $$RHESSYS_VERSION$$ string will be replaced by the make
 // script to reflect the current RHESSys version.
@@ -315,6 +318,7 @@ int	main( int main_argc, char **main_argv)
 	struct	world_output_file_object	*output;
 	struct	world_output_file_object	*growth_output;
 	char	*prefix;
+	int	num_failed_scenarios;
 	
 	/*--------------------------------------------------------------*/
 	/* Local Function declarations 									*/
@@ -364,6 +368,13 @@ int	main( int main_argc, char **main_argv)
 		struct world_output_file_object *,
 		struct command_line_object * );
 
+	int	fork_scenarios(
+		int,
+		char **,
+		struct command_line_object **,
+		struct world_object **,
+		int *);
+
 
 	srand((unsigned)(time(0)));
 
@@ -391,13 +402,40 @@ int	main( int main_argc, char **main_argv)
 
 	if (command_line[0].verbose_flag > 0 )
 		fprintf(stderr,"FINISHED CON COMMAND LINE ***\n");
+
+	if (command_line[0].memprofile_flag > 0)
+		alloc_accounting_init(command_line[0].memprofile_filename);
+
+	if (command_line[0].profile_flag > 0)
+		profile_init(command_line[0].profile_trace_filename);
+
+	fast_format_set_decimals(command_line[0].output_precision);
 	
 	/*--------------------------------------------------------------*/
 	/*	Construct the world object.									*/
 	/*--------------------------------------------------------------*/
+	PROFILE_BEGIN(PROFILE_CONSTRUCT_WORLD);
 	world = construct_world( command_line );
+	PROFILE_END(PROFILE_CONSTRUCT_WORLD);
 	if (command_line[0].verbose_flag > 0  )
 		fprintf(stderr,"FINISHED CON WORLD ***\n");
+
+	/*--------------------------------------------------------------*/
+	/*	With -scenarios each scenario carries on from here in	*/
+	/*	its own worker process, with its own command line and	*/
+	/*	(if its sensitivity differs) world, while this process	*/
+	/*	waits for them all.					*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].scenarios_flag > 0) {
+		if (fork_scenarios(main_argc, main_argv, &command_line, &world,
+				&num_failed_scenarios) == 1) {
+			profile_report(stdout);
+			profile_destroy();
+			if (num_failed_scenarios > 0)
+				return(EXIT_FAILURE);
+			return(EXIT_SUCCESS);
+		}
+	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the output file objects.							*/
 	/*--------------------------------------------------------------*/
@@ -489,8 +527,11 @@ int	main( int main_argc, char **main_argv)
 	
 	/*--------------------------------------------------------------*/
 	/*	Destroy the world.											*/
+	/*	A scenario worker leaves it to exit, as freeing it would	*/
+	/*	copy the pages it shares with the other workers.			*/
 	/*--------------------------------------------------------------*/
-	destroy_world(command_line, world );
+	if (command_line[0].scenarios_flag == 0)
+		destroy_world(command_line, world );
 	
 	if (command_line[0].verbose_flag > 0 )
 		fprintf(stderr,"FINISHED DES WORLD\n");
@@ -510,6 +551,12 @@ int	main( int main_argc, char **main_argv)
 	
     printf("\ntime cost = %ld seconds\n",(endClock - startClock)/CLOCKS_PER_SEC);
 
+	/*--------------------------------------------------------------*/
+	/*	Per-phase timing summary (and trace) for -profile.	*/
+	/*--------------------------------------------------------------*/
+	profile_report(stdout);
+	profile_destroy();
+
 	return(EXIT_SUCCESS);
 	
 } /*end main*/
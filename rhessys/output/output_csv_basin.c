@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_basin(			int routing_flag,
 					 struct	basin_object	*basin,
@@ -194,7 +195,7 @@ void	output_csv_basin(			int routing_flag,
 	if (routing_flag == 0)
 		astreamflow += areturn_flow;
 
-	fprintf(outfile,"%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf \n",
+	fast_fprintf(outfile,"%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf \n",
 		date.day,
 		date.month,
 		date.year,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_growth_basin(
 							struct	basin_object	*basin,
@@ -227,7 +228,7 @@ void	output_csv_growth_basin(
 
 	astreamflow_N += (hstreamflow_N)/ basin_area;
 
-	fprintf(outfile,"%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
+	fast_fprintf(outfile,"%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
 		current_date.day,
 		current_date.month,
 		current_date.year,
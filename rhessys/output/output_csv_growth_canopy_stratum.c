@@ -29,6 +29,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_growth_canopy_stratum( int basinID, int hillID, int zoneID,
 									 int patchID,
@@ -44,7 +45,7 @@ void	output_csv_growth_canopy_stratum( int basinID, int hillID, int zoneID,
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
 
-	fprintf(outfile,
+	fast_fprintf(outfile,
 		"%d,%d,%d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d,%lf \n",
 		current_date.day,
 		current_date.month,
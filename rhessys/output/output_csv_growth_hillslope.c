@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_growth_hillslope(
 								int basinID,
@@ -74,7 +75,7 @@ void	output_csv_growth_hillslope(
 	}
 	apsn /= aarea ;
 	alai /= aarea ;
-	fprintf(outfile,"%d,%d,%d,%d,%d,%lf,%lf\n",
+	fast_fprintf(outfile,"%d,%d,%d,%d,%d,%lf,%lf\n",
 		date.day,
 		date.month,
 		date.year,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_growth_patch(
 							int basinID, int hillID, int zoneID,
@@ -96,7 +97,7 @@ void	output_csv_growth_patch(
 			aheight += strata->cover_fraction * (strata->epv.height) ;
 		}
 	}
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d,%d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d \n",
 		current_date.day,
 		current_date.month,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_monthly_basin(
 							 struct	basin_object	*basin,
@@ -46,7 +47,7 @@ void	output_csv_monthly_basin(
 
 	basin[0].acc_month.length /= basin->route_list->num_patches;
 
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%3d,%4d,%3d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
 		current_date.month,
 		current_date.year,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_monthly_canopy_stratum( int basinID, int hillID,
 									  int zoneID,
@@ -45,7 +46,7 @@ void	output_csv_monthly_canopy_stratum( int basinID, int hillID,
 	/*--------------------------------------------------------------*/
 	/*	output_csv variables					*/
 	/*--------------------------------------------------------------*/
-	fprintf(outfile,"%4d,%4d,%d,%d,%d,%d,%d,%lf,%lf,%lf\n",
+	fast_fprintf(outfile,"%4d,%4d,%d,%d,%d,%d,%d,%lf,%lf,%lf\n",
 		current_date.month,
 		current_date.year,
 		basinID,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_monthly_patch(
 							 int basinID, int hillID, int zoneID,
@@ -48,7 +49,7 @@ void	output_csv_monthly_patch(
 	if (patch[0].acc_month.leach > 0.0)
 		patch[0].acc_month.leach = log(patch[0].acc_month.leach*1000.0*1000.0);
 		
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d,%d,%d,%d,%d,%d,%f,%f,%f,%f,%f,%f,%f,%8.3f,%f,%f,%f,%f,%f,%d\n",
 		current_date.month,
 		current_date.year,
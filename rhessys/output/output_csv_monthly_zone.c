@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_monthly_zone(	int basinID, int hillID,
 							struct	zone_object	*zone,
@@ -46,7 +47,7 @@ void	output_csv_monthly_zone(	int basinID, int hillID,
 	/*	output variables					*/
 	/*--------------------------------------------------------------*/
 	if (zone[0].acc_month.length == 0) zone[0].acc_month.length = 1;
-	fprintf(outfile,"%4d,%4d,%3d,%3d,%3d,%8.5f,%8.5f,%8.5f,%8.3f,%8.3f \n ",
+	fast_fprintf(outfile,"%4d,%4d,%3d,%3d,%3d,%8.5f,%8.5f,%8.5f,%8.3f,%8.3f \n ",
 		current_date.month,
 		current_date.year,
 		basinID,
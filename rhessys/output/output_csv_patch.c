@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_patch(
 					 int basinID, int hillID, int zoneID,
@@ -57,7 +58,7 @@ void	output_csv_patch(
 				* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.net_psn ;
 		}
 	}
-	check = fprintf(outfile,"%d,%d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
+	check = fast_fprintf(outfile,"%d,%d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
 		current_date.day,
 		current_date.month,
 		current_date.year,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_yearly_basin(
 							 struct	basin_object	*basin,
@@ -46,7 +47,7 @@ void	output_csv_yearly_basin(
     basin[0].acc_year.length /= basin[0].route_list[0].num_patches;
 	if (basin[0].acc_year.length == 0) basin[0].acc_year.length = 1;
 
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d\n",
 		current_date.year,
 		basin[0].ID,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_yearly_growth_basin(
 								   struct	basin_object	*basin,
@@ -125,7 +126,7 @@ void	output_csv_yearly_growth_basin(
 	asoilhr /= aarea;
 	astreamflow_N /= aarea;
 	adenitrif /= aarea;
-	fprintf(outfile,"%d,%d,%lf,%lf,%lf,%lf,%lf,%lf \n",
+	fast_fprintf(outfile,"%d,%d,%lf,%lf,%lf,%lf,%lf,%lf \n",
 		date.year,
 		basin[0].ID,
 		agpsn,
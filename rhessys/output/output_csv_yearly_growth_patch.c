@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_yearly_growth_patch(
 				int basinID, int hillID, int zoneID,
@@ -42,7 +43,7 @@ void	output_csv_yearly_growth_patch(
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 
-     fprintf(outfile,
+     fast_fprintf(outfile,
 	"%4d,%4d,%4d,%4d,%3d,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
         current_date.year,
         basinID,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_yearly_hillslope(	int basinID,
 							 struct	hillslope_object	*hillslope,
@@ -47,7 +48,7 @@ void	output_csv_yearly_hillslope(	int basinID,
 	if (hillslope[0].acc_year.length == 0) hillslope[0].acc_year.length = 1;
 
 
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d\n",
 		current_date.year-1,
 		basinID,
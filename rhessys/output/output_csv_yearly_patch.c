@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_csv_yearly_patch(
 				int basinID, int hillID, int zoneID,
@@ -46,7 +47,7 @@ void	output_csv_yearly_patch(
 	if (patch[0].acc_year.length > 0)
 		patch[0].acc_year.theta /= patch[0].acc_year.length;
 
-	fprintf(outfile,"%4d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d\n",
+	fast_fprintf(outfile,"%4d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d\n",
 			current_date.year,
 			basinID,
 			hillID,
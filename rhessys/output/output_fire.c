@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_fire( int basinID, int hillID, int zoneID, int patchID,
 							  struct	canopy_strata_object	*stratum,
@@ -42,7 +43,7 @@ void	output_fire( int basinID, int hillID, int zoneID, int patchID,
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
 	
-	fprintf(outfile,
+	fast_fprintf(outfile,
 		"%d %d %d %d %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
 		current_date.day,
 		current_date.month,
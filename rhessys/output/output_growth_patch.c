@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_growth_patch(
 							int basinID, int hillID, int zoneID,
@@ -125,7 +126,7 @@ void	output_growth_patch(
 			aheight += strata->cover_fraction * (strata->epv.height) ;
 		}
 	}
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%ld %ld %ld %ld %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
 		current_date.day,
 		current_date.month,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_growth_zone(	int basinID, int hillID,
 						   struct	zone_object	*zone,
@@ -42,7 +43,7 @@ void	output_growth_zone(	int basinID, int hillID,
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
 	
-	fprintf(outfile,
+	fast_fprintf(outfile,
 		"%4d %4d %4d %3d %3d %3d %8.5f %8.5f %8.3f %8.3f %8.5f %f %f %f %f \n ",
 		current_date.day,
 		current_date.month,
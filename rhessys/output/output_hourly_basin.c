@@ -37,6 +37,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_hourly_basin(	int routing_flag,
 					struct	basin_object	*basin,
@@ -272,7 +273,7 @@ void	output_hourly_basin(	int routing_flag,
 	var_acctrans /= aarea;
 				
 	*/
-	fprintf(outfile,"%ld %ld %ld %ld %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf \n",
+	fast_fprintf(outfile,"%ld %ld %ld %ld %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf \n",
 		date.hour,		
 		date.day,
 		date.month,
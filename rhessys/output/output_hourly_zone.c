@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_hourly_zone(	int basinID, int hillID,
 					struct	zone_object	*zone,
@@ -41,7 +42,7 @@ void	output_hourly_zone(	int basinID, int hillID,
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	fprintf(outfile,
+	fast_fprintf(outfile,
 		"%d %d %d %d %d %d %d %f %f %f %f %f %f %f %f %f \n ",
 		current_date.day,
 		current_date.month,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_monthly_basin(
 							 struct	basin_object	*basin,
@@ -54,7 +55,7 @@ void	output_monthly_basin(
   if( patchCount == 0 ) patchCount = 1;
   basin[0].acc_month.length /= patchCount;
 
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
 		current_date.month,
 		current_date.year,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_monthly_canopy_stratum( int basinID, int hillID,
 									  int zoneID,
@@ -47,7 +48,7 @@ void	output_monthly_canopy_stratum( int basinID, int hillID,
 	/*--------------------------------------------------------------*/
 	/*	output variables					*/
 	/*--------------------------------------------------------------*/
-	fprintf(outfile,"%4d %4d %d %d %d %d %d %lf \n",
+	fast_fprintf(outfile,"%4d %4d %d %d %d %d %d %lf \n",
 		current_date.month,
 		current_date.year,
 		basinID,
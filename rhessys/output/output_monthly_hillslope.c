@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_monthly_hillslope(	int basinID,
 							 struct	hillslope_object	*hillslope,
@@ -44,7 +45,7 @@ void	output_monthly_hillslope(	int basinID,
 	int check;
 	if (hillslope[0].acc_month.length == 0) hillslope[0].acc_month.length = 1;
 
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
 		current_date.month,
 		current_date.year,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_stream_routing(			
 					 struct	stream_network_object  *stream_network,
@@ -47,7 +48,7 @@ void	output_stream_routing(
 	/*--------------------------------------------------------------*/
 	
 
-	fprintf(outfile, "%d %d %d %d %lf %lf %lf %lf %lf\n", 
+	fast_fprintf(outfile, "%d %d %d %d %lf %lf %lf %lf %lf\n", 
                 date.day,
 		date.month,
 		date.year,
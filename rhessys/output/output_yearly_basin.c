@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_yearly_basin(
 							 struct	basin_object	*basin,
@@ -57,7 +58,7 @@ void	output_yearly_basin(
 	if (basin[0].acc_year.length == 0) basin[0].acc_year.length = 1;
 
 
-	check = fprintf(outfile,
+	check = fast_fprintf(outfile,
 		"%d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %d %lf\n",
 		current_date.year,
 		basin[0].ID,
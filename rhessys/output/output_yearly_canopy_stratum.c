@@ -29,6 +29,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_yearly_canopy_stratum( int basinID, int hillID,
 									 int zoneID,
@@ -51,7 +52,7 @@ void	output_yearly_canopy_stratum( int basinID, int hillID,
 	/*--------------------------------------------------------------*/
 	/*	output variables					*/
 	/*--------------------------------------------------------------*/
-	fprintf(outfile,"%d %d %d %d %d %d %lf %lf %lf %lf %lf %lf \n",
+	fast_fprintf(outfile,"%d %d %d %d %d %d %lf %lf %lf %lf %lf %lf \n",
 		current_date.year,
 		basinID,
 		hillID,
@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_yearly_fire( int basinID, int hillID, int zoneID, int patchID,
 							  struct	canopy_strata_object	*stratum,
@@ -45,7 +46,7 @@ void	output_yearly_fire( int basinID, int hillID, int zoneID, int patchID,
 	if(stratum[0].fe.acc_year.length == 0)
         stratum[0].fe.acc_year.length = 1;
 
-	fprintf(outfile,
+	fast_fprintf(outfile,
 		"%d %d %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %d\n",
 		current_date.year,
 		basinID,
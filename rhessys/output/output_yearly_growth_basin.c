@@ -28,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_yearly_growth_basin(
 								   struct	basin_object	*basin,
@@ -132,7 +133,7 @@ void	output_yearly_growth_basin(
 	astreamflow_N /= aarea;
 	adenitrif /= aarea;
 	ard /= aarea;
-	fprintf(outfile,"%d %d %lf %lf %lf %lf %lf %lf %lf %lf \n",
+	fast_fprintf(outfile,"%d %d %lf %lf %lf %lf %lf %lf %lf %lf \n",
 		date.year,
 		basin[0].ID,
 		agpsn,
@@ -30,6 +30,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
+#include "fast_format.h"
 
 void	output_yearly_growth_canopy_stratum( int basinID, int hillID, int zoneID,
 			int patchID,
@@ -42,7 +43,7 @@ void	output_yearly_growth_canopy_stratum( int basinID, int hillID, int zoneID,
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
 
-  	fprintf(outfile,
+  	fast_fprintf(outfile,
        		 "%d %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf \n",
 
         	current_date.year,
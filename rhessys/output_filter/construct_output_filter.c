@@ -3,6 +3,7 @@
 #include "rhessys.h"
 #include "output_filter.h"
 #include "index_struct_fields.h"
+#include "output_filter/output_filter_output.h"
 #include "output_filter/output_format_csv.h"
 #include "output_filter/output_format_netcdf.h"
 
@@ -250,6 +251,33 @@ static bool init_variables(OutputFilter *f, StructIndex_t *i, bool verbose) {
 	return true;
 }
 
+static bool check_group_variables(OutputFilter *f) {
+	if (f->group_by == GROUP_BY_NONE) return true;
+
+	// Grouped filters aggregate each variable as a double, so only numeric
+	// scalar variables can be grouped
+	for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
+		if (v->variable_type != NAMED && v->variable_type != VAR_TYPE_EXPR) {
+			fprintf(stderr, "check_group_variables: variable type %d cannot be aggregated by group_by.\n",
+					v->variable_type);
+			return false;
+		}
+		switch (v->data_type) {
+		case DATA_TYPE_BOOL:
+		case DATA_TYPE_INT:
+		case DATA_TYPE_LONG:
+		case DATA_TYPE_FLOAT:
+		case DATA_TYPE_DOUBLE:
+			break;
+		default:
+			fprintf(stderr, "check_group_variables: variable %s of data type %d is not a number, so it cannot be aggregated by group_by.\n",
+					v->name, v->data_type);
+			return false;
+		}
+	}
+	return true;
+}
+
 static bool init_spatial_hierarchy_basin(OutputFilter *f,
 		struct world_object * const w,
 		struct command_line_object * const cmd) {
@@ -679,8 +707,13 @@ bool construct_output_filter(char * const error, size_t error_len,
 			return return_with_error(error, error_len, init_error);
 		}
 
+		// Flatten the filter's zones, patches or strata into an entity array,
+		// sorted into groups if the filter has a group_by clause
+		status = output_filter_resolve_entities(error, error_len, f);
+		if (!status) return false;
+
 		// Validate variables and write offsets and data types to filter
-		status = init_variables(f, idx, cmd->verbose_flag);
+		status = init_variables(f, idx, cmd->verbose_flag) && check_group_variables(f);
 		if (!status) {
 			char *init_error = (char *)calloc(MAXSTR, sizeof(char));
 			snprintf(init_error, MAXSTR, "unable to initialize variables for output filter with path %s and filename %s.",
@@ -701,6 +734,18 @@ bool construct_output_filter(char * const error, size_t error_len,
 			return return_with_error(error, error_len,
 					"Output filter did not specify output filename.");
 		}
+		// A -scenarios worker writes its files under its own prefix
+		if (cmd->scenarios_flag && cmd->output_prefix != NULL) {
+			size_t len = strlen(cmd->output_prefix) + strlen(f->output->filename) + 2;
+			char *filename = (char *)calloc(len, sizeof(char));
+			if (filename == NULL) {
+				perror("construct_output_filter: Unable to allocate output filename");
+				return false;
+			}
+			snprintf(filename, len, "%s_%s", cmd->output_prefix, f->output->filename);
+			free(f->output->filename);
+			f->output->filename = filename;
+		}
 		status = init_output(f);
 		if (!status) {
 			char *init_error = (char *)calloc(MAXSTR, sizeof(char));
@@ -43,6 +43,9 @@ bool destroy_output_filter(char * const error, size_t error_len,
 					f->output->path, f->output->filename);
 			return returnWithError(error, error_len, destroy_error);
 		}
+		free(f->entities);
+		f->entities = NULL;
+		f->num_entities = 0;
 	}
 
 	return true;
@@ -2,12 +2,10 @@
 
 #include "rhessys.h"
 #include "output_filter/output_format_csv.h"
+#include "fast_format.h"
 
 #define BUFFER_SIZE 4096
 
-#define FMT_STR_TIMESTAMP_FIELD "%ld%s"
-#define FMT_STR_ID_FIELD "%d%s"
-
 #define FMT_STR_BOOL "%s%h"
 #define FMT_STR_CHAR "%s%c"
 #define FMT_STR_CHAR_ARRAY "%s%s"
@@ -24,6 +22,9 @@
 #define HEADER_ID_ZONE "basinID,hillID,zoneID,"
 #define HEADER_ID_PATCH "basinID,hillID,zoneID,patchID,"
 #define HEADER_ID_CANOPY_STRATUM "basinID,hillID,zoneID,patchID,stratumID,"
+#define HEADER_ID_HILLSLOPE "basinID,hillID,"
+#define HEADER_ID_FAMILY "basinID,hillID,zoneID,familyID,"
+#define HEADER_ID_GROUP "groupID,"
 
 
 bool output_format_csv_init(OutputFilter * const f) {
@@ -58,6 +59,32 @@ bool output_format_csv_destroy(OutputFilter * const f) {
 	return !fclose(f->output->fp);
 }
 
+static void write_group_id_headers(FILE *fp, OutputGroupBy group_by) {
+	switch (group_by) {
+	case GROUP_BY_BASIN:
+		fprintf(fp, HEADER_ID_BASIN);
+		break;
+	case GROUP_BY_HILLSLOPE:
+		fprintf(fp, HEADER_ID_HILLSLOPE);
+		break;
+	case GROUP_BY_ZONE:
+		fprintf(fp, HEADER_ID_ZONE);
+		break;
+	case GROUP_BY_PATCH:
+		fprintf(fp, HEADER_ID_PATCH);
+		break;
+	case GROUP_BY_FAMILY:
+		fprintf(fp, HEADER_ID_FAMILY);
+		break;
+	case GROUP_BY_MAP:
+		fprintf(fp, HEADER_ID_GROUP);
+		break;
+	case GROUP_BY_NONE:
+	default:
+		break;
+	}
+}
+
 bool output_format_csv_write_headers(OutputFilter * const f) {
 	if (f->variables == NULL) {
 		fprintf(stderr, "No variables specified for filter, so no CSV headers could be written.\n");
@@ -85,22 +112,27 @@ bool output_format_csv_write_headers(OutputFilter * const f) {
 	}
 
 	// Output ID headers
-	switch (f->type) {
-	case OUTPUT_FILTER_BASIN:
-		fprintf(fp, HEADER_ID_BASIN);
-		break;
-	case OUTPUT_FILTER_ZONE:
-		fprintf(fp, HEADER_ID_ZONE);
-		break;
-	case OUTPUT_FILTER_PATCH:
-		fprintf(fp, HEADER_ID_PATCH);
-		break;
-	case OUTPUT_FILTER_CANOPY_STRATUM:
-		fprintf(fp, HEADER_ID_CANOPY_STRATUM);
-		break;
-	default:
-		// Do not print ID headers for unknown output filter types
-		break;
+	if (f->group_by != GROUP_BY_NONE) {
+		// Grouped filters write the IDs of their groups
+		write_group_id_headers(fp, f->group_by);
+	} else {
+		switch (f->type) {
+		case OUTPUT_FILTER_BASIN:
+			fprintf(fp, HEADER_ID_BASIN);
+			break;
+		case OUTPUT_FILTER_ZONE:
+			fprintf(fp, HEADER_ID_ZONE);
+			break;
+		case OUTPUT_FILTER_PATCH:
+			fprintf(fp, HEADER_ID_PATCH);
+			break;
+		case OUTPUT_FILTER_CANOPY_STRATUM:
+			fprintf(fp, HEADER_ID_CANOPY_STRATUM);
+			break;
+		default:
+			// Do not print ID headers for unknown output filter types
+			break;
+		}
 	}
 
 	// Output header for first field
@@ -121,37 +153,47 @@ bool output_format_csv_write_headers(OutputFilter * const f) {
 	return !fflush(fp);
 }
 
-static bool output_variable_to_stream(char * const error, size_t error_len,
-		FILE *fp, MaterializedVariable v, char *delim) {
+// Timestamp and ID fields, each followed by a delimiter
+static inline void append_id_field(FastFormatRow *row, long value) {
+	fast_format_append_long(row, value);
+	fast_format_append_string(row, CSV_DELIM_DEFAULT);
+}
+
+static inline void append_double_value(FastFormatRow *row, char *delim, double value) {
+	fast_format_append_string(row, delim);
+	fast_format_append_double(row, value, fast_format_decimals);
+}
+
+static bool output_variable_to_row(char * const error, size_t error_len,
+		FastFormatRow *row, MaterializedVariable v, char *delim) {
 	char *local_error;
-	int rv;
 	switch (v.data_type) {
 	case DATA_TYPE_BOOL:
-		rv = fprintf(fp, FMT_STR_BOOL, delim, v.u.bool_val);
+		fast_format_appendf(row, FMT_STR_BOOL, delim, v.u.bool_val);
 		break;
 	case DATA_TYPE_CHAR:
-		rv = fprintf(fp, FMT_STR_CHAR, delim, v.u.char_val);
+		fast_format_appendf(row, FMT_STR_CHAR, delim, v.u.char_val);
 		break;
 	case DATA_TYPE_STRING:
-		rv = fprintf(fp, FMT_STR_CHAR_ARRAY, delim, v.u.char_array);
+		fast_format_appendf(row, FMT_STR_CHAR_ARRAY, delim, v.u.char_array);
 		break;
 	case DATA_TYPE_INT:
-		rv = fprintf(fp, FMT_STR_INT, delim, v.u.int_val);
+		fast_format_appendf(row, FMT_STR_INT, delim, v.u.int_val);
 		break;
 	case DATA_TYPE_LONG:
-		rv = fprintf(fp, FMT_STR_LONG, delim, v.u.long_val);
+		fast_format_appendf(row, FMT_STR_LONG, delim, v.u.long_val);
 		break;
 	case DATA_TYPE_LONG_ARRAY:
-		rv = fprintf(fp, FMT_STR_LONG_ARRAY, delim, v.u.long_array);
+		fast_format_appendf(row, FMT_STR_LONG_ARRAY, delim, v.u.long_array);
 		break;
 	case DATA_TYPE_FLOAT:
-		rv = fprintf(fp, FMT_STR_FLOAT, delim, v.u.float_val);
+		append_double_value(row, delim, v.u.float_val);
 		break;
 	case DATA_TYPE_DOUBLE:
-		rv = fprintf(fp, FMT_STR_DOUBLE, delim, v.u.double_val);
+		append_double_value(row, delim, v.u.double_val);
 		break;
 	case DATA_TYPE_DOUBLE_ARRAY:
-		rv = fprintf(fp, FMT_STR_DOUBLE_ARRAY, delim, v.u.double_array);
+		fast_format_appendf(row, FMT_STR_DOUBLE_ARRAY, delim, v.u.double_array);
 		break;
 	default:
 		local_error = (char *)calloc(MAXSTR, sizeof(char));
@@ -159,14 +201,14 @@ static bool output_variable_to_stream(char * const error, size_t error_len,
 				 v.data_type);
 		return return_with_error(error, error_len, local_error);
 	}
-
-	if (rv < 1) {
-		perror("output_format_csv::output_variable_to_stream: error writing output");
-		return false;
-	}
 	return true;
 }
 
+/*
+ * Each row is built in memory (see fast_format.h) and written with a single
+ * fwrite.  Doubles are written with fast_format_decimals digits after the
+ * decimal point, as FMT_STR_DOUBLE would print them.
+ */
 bool output_format_csv_write_data(char * const error, size_t error_len,
 		struct date date, OutputFilter * const f,
 		EntityID id, MaterializedVariable * const vars, bool flush) {
@@ -180,17 +222,19 @@ bool output_format_csv_write_data(char * const error, size_t error_len,
 		return false;
 	}
 	FILE *fp = f->output->fp;
+	FastFormatRow row;
+	fast_format_row_init(&row);
 
 	// Output time step
 	switch (f->timestep) {
 	case TIMESTEP_HOURLY:
-		fprintf(fp, FMT_STR_TIMESTAMP_FIELD, date.hour, CSV_DELIM_DEFAULT);
+		append_id_field(&row, date.hour);
 	case TIMESTEP_DAILY:
-		fprintf(fp, FMT_STR_TIMESTAMP_FIELD, date.day, CSV_DELIM_DEFAULT);
+		append_id_field(&row, date.day);
 	case TIMESTEP_MONTHLY:
-		fprintf(fp, FMT_STR_TIMESTAMP_FIELD, date.month, CSV_DELIM_DEFAULT);
+		append_id_field(&row, date.month);
 	case TIMESTEP_YEARLY:
-		fprintf(fp, FMT_STR_TIMESTAMP_FIELD, date.year, CSV_DELIM_DEFAULT);
+		append_id_field(&row, date.year);
 		break;
 	default:
 		// Do not print time step for unknown time steps
@@ -199,40 +243,40 @@ bool output_format_csv_write_data(char * const error, size_t error_len,
 
 	// Output entity ID fields
 	if (id.basin_ID != OUTPUT_FILTER_ID_EMPTY) {
-		fprintf(fp, FMT_STR_ID_FIELD, id.basin_ID, CSV_DELIM_DEFAULT);
+		append_id_field(&row, id.basin_ID);
 	}
 	if (id.hillslope_ID != OUTPUT_FILTER_ID_EMPTY) {
-		fprintf(fp, FMT_STR_ID_FIELD, id.hillslope_ID, CSV_DELIM_DEFAULT);
+		append_id_field(&row, id.hillslope_ID);
 	}
 	if (id.zone_ID != OUTPUT_FILTER_ID_EMPTY) {
-		fprintf(fp, FMT_STR_ID_FIELD, id.zone_ID, CSV_DELIM_DEFAULT);
+		append_id_field(&row, id.zone_ID);
 	}
 	if (id.patch_ID != OUTPUT_FILTER_ID_EMPTY) {
-		fprintf(fp, FMT_STR_ID_FIELD, id.patch_ID, CSV_DELIM_DEFAULT);
+		append_id_field(&row, id.patch_ID);
 	}
 	if (id.canopy_strata_ID != OUTPUT_FILTER_ID_EMPTY) {
-		fprintf(fp, FMT_STR_ID_FIELD, id.canopy_strata_ID, CSV_DELIM_DEFAULT);
+		append_id_field(&row, id.canopy_strata_ID);
 	}
 
 	// Output first value
 	MaterializedVariable v = vars[curr_var++];
-	status = output_variable_to_stream(error, error_len, fp, v, CSV_DELIM_NONE);
-	if (!status) {
-		return false;
-	}
+	status = output_variable_to_row(error, error_len, &row, v, CSV_DELIM_NONE);
 	// Output remaining values
-	while (curr_var < f->num_variables) {
+	while (status && curr_var < f->num_variables) {
 		MaterializedVariable v = vars[curr_var++];
-		status = output_variable_to_stream(error, error_len, fp, v, CSV_DELIM_DEFAULT);
-		if (!status) {
-			return false;
-		}
+		status = output_variable_to_row(error, error_len, &row, v, CSV_DELIM_DEFAULT);
+	}
+	if (!status) {
+		fast_format_row_free(&row);
+		return false;
 	}
 
-	// Write end of line
-	int rv = fprintf(fp, CSV_EOL);
+	// Write row and end of line
+	fast_format_append_string(&row, CSV_EOL);
+	int rv = fast_format_write_row(&row, fp);
+	fast_format_row_free(&row);
 	if (rv < 1) {
-		perror("output_format_csv_write_data: failed to write end of line");
+		perror("output_format_csv_write_data: error writing output");
 		return false;
 	}
 	// Flush stream (if requested)
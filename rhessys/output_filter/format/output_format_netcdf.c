@@ -27,8 +27,9 @@ static inline bool create_meta_variable(char *abs_path, int ncid, int dimids[],
 	return true;
 }
 
-static inline bool create_variable(OutputFilterVariable *v, int ncid, int dimids[]) {
-	int nc_type = get_netcdf_data_type(v->data_type);
+static inline bool create_variable(OutputFilterVariable *v, int ncid, int dimids[], bool grouped) {
+	// Grouped filters write every variable as a double (see output_groups())
+	int nc_type = get_netcdf_data_type(grouped ? DATA_TYPE_DOUBLE : v->data_type);
 	if (nc_type == INVALID_TYPE) {
 		char *error_mesg = (char *) malloc(MAXSTR * sizeof(char));
 		snprintf(error_mesg, MAXSTR, "Unable to create variable %s, output filter data type %d not supported by netCDF driver.\n",
@@ -240,6 +241,24 @@ bool output_format_netcdf_destroy(OutputFilter * const f) {
 
 	return true;
 }
+// ID variables for the groups of a grouped filter, in the slots
+// output_format_netcdf_write_data() writes EntityID fields to
+static bool create_group_id_variables(char *abs_path, int ncid, int dimids[],
+		OutputGroupBy group_by, OutputFormatNetCDFMetadata *meta) {
+	bool status;
+	if (group_by == GROUP_BY_MAP) {
+		return create_meta_variable(abs_path, ncid, dimids, OF_VAR_GROUP, NC_INT, &(meta->var_id_basin_id));
+	}
+	status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_BASIN, NC_INT, &(meta->var_id_basin_id));
+	if (!status || group_by == GROUP_BY_BASIN) return status;
+	status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
+	if (!status || group_by == GROUP_BY_HILLSLOPE) return status;
+	status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
+	if (!status || group_by == GROUP_BY_ZONE) return status;
+	return create_meta_variable(abs_path, ncid, dimids,
+			group_by == GROUP_BY_FAMILY ? OF_VAR_FAMILY : OF_VAR_PATCH, NC_INT, &(meta->var_id_patch_id));
+}
+
 bool output_format_netcdf_write_headers(OutputFilter * const f) {
 	bool status = true;
 	int retval;
@@ -280,51 +299,57 @@ bool output_format_netcdf_write_headers(OutputFilter * const f) {
 	}
 
 	// Create variables for ID fields
-	// Basin ID
-	status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_BASIN, NC_INT, &(meta->var_id_basin_id));
-	if (!status) return false;
-
-	switch (f->type) {
-		case OUTPUT_FILTER_ZONE:
-			// Hillslope ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
-			if (!status) return false;
-			// Zone ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
-			if (!status) return false;
-			break;
-		case OUTPUT_FILTER_PATCH:
-			// Hillslope ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
-			if (!status) return false;
-			// Zone ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
-			if (!status) return false;
-			// Patch ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_PATCH, NC_INT, &(meta->var_id_patch_id));
-			if (!status) return false;
-			break;
-		case OUTPUT_FILTER_CANOPY_STRATUM:
-			// Hillslope ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
-			if (!status) return false;
-			// Zone ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
-			if (!status) return false;
-			// Patch ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_PATCH, NC_INT, &(meta->var_id_patch_id));
-			if (!status) return false;
-			// Stratum ID
-			status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_STRATUM, NC_INT, &(meta->var_id_stratum_id));
-			if (!status) return false;
-			break;
-		default:
-			// Do not print ID headers for unknown output filter types
-			break;
+	if (f->group_by != GROUP_BY_NONE) {
+		// Grouped filters write the IDs of their groups
+		status = create_group_id_variables(abs_path, ncid, dimids, f->group_by, meta);
+		if (!status) return false;
+	} else {
+		// Basin ID
+		status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_BASIN, NC_INT, &(meta->var_id_basin_id));
+		if (!status) return false;
+
+		switch (f->type) {
+			case OUTPUT_FILTER_ZONE:
+				// Hillslope ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
+				if (!status) return false;
+				// Zone ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
+				if (!status) return false;
+				break;
+			case OUTPUT_FILTER_PATCH:
+				// Hillslope ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
+				if (!status) return false;
+				// Zone ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
+				if (!status) return false;
+				// Patch ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_PATCH, NC_INT, &(meta->var_id_patch_id));
+				if (!status) return false;
+				break;
+			case OUTPUT_FILTER_CANOPY_STRATUM:
+				// Hillslope ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_HILL, NC_INT, &(meta->var_id_hill_id));
+				if (!status) return false;
+				// Zone ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_ZONE, NC_INT, &(meta->var_id_zone_id));
+				if (!status) return false;
+				// Patch ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_PATCH, NC_INT, &(meta->var_id_patch_id));
+				if (!status) return false;
+				// Stratum ID
+				status = create_meta_variable(abs_path, ncid, dimids, OF_VAR_STRATUM, NC_INT, &(meta->var_id_stratum_id));
+				if (!status) return false;
+				break;
+			default:
+				// Do not print ID headers for unknown output filter types
+				break;
+		}
 	}
 
 	// Create variable for first field
-	status = create_variable(f->variables, ncid, dimids);
+	status = create_variable(f->variables, ncid, dimids, f->group_by != GROUP_BY_NONE);
 	if (!status) {
 		char *error_mesg = (char *) malloc(MAXSTR * sizeof(char));
 		snprintf(error_mesg, MAXSTR, "Failed variable creation was in netCDF file %s.\n",
@@ -336,7 +361,7 @@ bool output_format_netcdf_write_headers(OutputFilter * const f) {
 	OutputFilterVariable *v = f->variables->next;
 	// Create variables for remaining fields
 	while (v != NULL) {
-		status = create_variable(v, ncid, dimids);
+		status = create_variable(v, ncid, dimids, f->group_by != GROUP_BY_NONE);
 		if (!status) {
 			char *error_mesg = (char *) malloc(MAXSTR * sizeof(char));
 			snprintf(error_mesg, MAXSTR, "Failed variable creation was in netCDF file %s.\n",
@@ -676,6 +676,11 @@ OutputFilter *create_new_output_filter() {
 	new_filter->strata = NULL;
 	new_filter->variables = NULL;
 	new_filter->num_variables = 0;
+	new_filter->group_by = GROUP_BY_NONE;
+	new_filter->aggregate = AGGREGATE_MEAN;
+	new_filter->group_map = NULL;
+	new_filter->entities = NULL;
+	new_filter->num_entities = 0;
 	new_filter->parse_error = false;
 	return new_filter;
 }
@@ -706,6 +711,8 @@ void free_output_filter(OutputFilter *head) {
 	free_output_filter_zone_list(head->zones);
 	free_output_filter_patch_list(head->patches);
 	free_output_filter_stratum_list(head->strata);
+	free(head->group_map);
+	free(head->entities);
 
 	free_output_filter_output(head->output);
 	free(head);
@@ -1041,6 +1048,14 @@ void print_output_filter(OutputFilter *f) {
 			fprintf(stderr, ",\n");
 		}
 		fprintf(stderr, "\t],\n");
+
+		if (f->group_by != GROUP_BY_NONE) {
+			fprintf(stderr, "\tgroup_by: %d,\n", f->group_by);
+			fprintf(stderr, "\taggregate: %d,\n", f->aggregate);
+			if (f->group_map != NULL) {
+				fprintf(stderr, "\tgroup_map: %s,\n", f->group_map);
+			}
+		}
 	}
 
 	fprintf(stderr, "}\n");
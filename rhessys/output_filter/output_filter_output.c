@@ -4,7 +4,6 @@
 
 #include "rhessys.h"
 #include "output_filter/output_filter_output.h"
-#include "pointer_set.h"
 
 
 bool output_format_csv_write_data(char * const error, size_t error_len,
@@ -78,48 +77,62 @@ inline static void accum_materialized_variable(MaterializedVariable *accum, Mate
 	accum->meta = value->meta;
 }
 
-inline static void reset_accum_obj(PointerSet *set, size_t len) {
-	if (set == NULL) return;
-	memset(set->ptr, 0, len);
-	reset_accum_obj(set->next, len);
-}
-
-inline static void add_to_accum_reset_list(PointerSet **set_ptr, void *entity) {
-	if (set_ptr == NULL) {
-		fprintf(stderr, "WARNING: output_filter_output::add_to_accum_reset_list(): set_ptr was NULL but should not be!");
-	} else if (*set_ptr == NULL) {
-		*set_ptr = newPointerSet(entity);
-	} else {
-		pointerSetAppend(*set_ptr, entity);
+/*
+ * Accumulators (acc_month/acc_year) written by monthly or yearly filters are
+ * zeroed only after every filter for that timestep has run, since more than
+ * one filter may output the same entity.  They are collected in flat arrays
+ * kept from one output call to the next, so after the first call collecting
+ * them needs no allocation.  An accumulator listed twice is simply zeroed
+ * twice.
+ */
+typedef struct accum_reset_list_s {
+	void **ptrs;
+	size_t num;
+	size_t capacity;
+} AccumResetList;
+
+typedef struct accum_reset_lists_s {
+	AccumResetList hillslope;
+	AccumResetList zone;
+	AccumResetList patch;
+	AccumResetList stratum;
+} AccumResetLists;
+
+static AccumResetLists monthly_accum_resets;
+static AccumResetLists yearly_accum_resets;
+
+inline static void add_to_accum_reset_list(AccumResetList *list, void *entity) {
+	if (list == NULL) {
+		fprintf(stderr, "WARNING: output_filter_output::add_to_accum_reset_list(): list was NULL but should not be!");
+		return;
 	}
-}
-
-static void reset_accumulator_zone(PointerSet **acc_objs_to_reset) {
-	if (*acc_objs_to_reset) {
-		reset_accum_obj(*acc_objs_to_reset, sizeof(struct accumulate_zone_object));
-		freePointerSet(*acc_objs_to_reset);
-		*acc_objs_to_reset = NULL;
+	if (list->num == list->capacity) {
+		size_t capacity = list->capacity == 0 ? 64 : 2 * list->capacity;
+		void **ptrs = realloc(list->ptrs, capacity * sizeof(void *));
+		if (ptrs == NULL) {
+			fprintf(stderr, "FATAL ERROR: output_filter_output::add_to_accum_reset_list(): unable to grow list to %zu entries.\n",
+					capacity);
+			exit(EXIT_FAILURE);
+		}
+		list->ptrs = ptrs;
+		list->capacity = capacity;
 	}
+	list->ptrs[list->num++] = entity;
 }
 
-static void reset_accumulator_patch(PointerSet **acc_objs_to_reset) {
-	if (*acc_objs_to_reset) {
-		reset_accum_obj(*acc_objs_to_reset, sizeof(struct accumulate_patch_object));
-		freePointerSet(*acc_objs_to_reset);
-		*acc_objs_to_reset = NULL;
+static void reset_accumulators(AccumResetList *list, size_t len) {
+	for (size_t i = 0; i < list->num; i++) {
+		memset(list->ptrs[i], 0, len);
 	}
+	list->num = 0;
 }
 
-inline static void reset_accumulator_hillslope(PointerSet **acc_objs_to_reset) {
-	reset_accumulator_patch(acc_objs_to_reset);
-}
-
-static void reset_accumulator_stratum(PointerSet **acc_objs_to_reset) {
-	if (*acc_objs_to_reset) {
-		reset_accum_obj(*acc_objs_to_reset, sizeof(struct accumulate_strata_object));
-		freePointerSet(*acc_objs_to_reset);
-		*acc_objs_to_reset = NULL;
-	}
+static void reset_accumulator_lists(AccumResetLists *lists) {
+	// Hillslope accumulators are accumulate_patch_objects
+	reset_accumulators(&lists->hillslope, sizeof(struct accumulate_patch_object));
+	reset_accumulators(&lists->zone, sizeof(struct accumulate_zone_object));
+	reset_accumulators(&lists->patch, sizeof(struct accumulate_patch_object));
+	reset_accumulators(&lists->stratum, sizeof(struct accumulate_strata_object));
 }
 
 inline static MaterializedVariable materialize_named_variable(OutputFilterVariable const * const v,
@@ -404,17 +417,14 @@ inline static MaterializedVariable materialize_variable(OutputFilterVariable con
 }
 
 inline static void *determine_stratum_entity(OutputFilterTimestep timestep,
-		struct canopy_strata_object *stratum,
-		PointerSet **accum_objs_to_reset) {
+		struct canopy_strata_object *stratum) {
 	void *entity = NULL;
 	switch (timestep) {
 	case TIMESTEP_MONTHLY:
 		entity = (void *)(&(stratum->acc_month));
-		add_to_accum_reset_list(accum_objs_to_reset, entity);
 		break;
 	case TIMESTEP_YEARLY:
 		entity = (void *)(&(stratum->acc_year));
-		add_to_accum_reset_list(accum_objs_to_reset, entity);
 		break;
 	case TIMESTEP_HOURLY:
 	case TIMESTEP_DAILY:
@@ -426,17 +436,14 @@ inline static void *determine_stratum_entity(OutputFilterTimestep timestep,
 }
 
 inline static void *determine_zone_entity(OutputFilterTimestep timestep,
-                                           struct zone_object *zone,
-                                           PointerSet **acc_objs_to_reset) {
+                                           struct zone_object *zone) {
 	void *entity = NULL;
 	switch (timestep) {
 	case TIMESTEP_MONTHLY:
 		entity = (void *)(&(zone->acc_month));
-		add_to_accum_reset_list(acc_objs_to_reset, entity);
 		break;
 	case TIMESTEP_YEARLY:
 		entity = (void *)(&(zone->acc_year));
-		add_to_accum_reset_list(acc_objs_to_reset, entity);
 		break;
 	case TIMESTEP_HOURLY:
 	case TIMESTEP_DAILY:
@@ -449,17 +456,14 @@ inline static void *determine_zone_entity(OutputFilterTimestep timestep,
 }
 
 inline static void *determine_patch_entity(OutputFilterTimestep timestep,
-		struct patch_object *patch,
-		PointerSet **acc_objs_to_reset) {
+		struct patch_object *patch) {
 	void *entity = NULL;
 	switch (timestep) {
 	case TIMESTEP_MONTHLY:
 		entity = (void *)(&(patch->acc_month));
-		add_to_accum_reset_list(acc_objs_to_reset, entity);
 		break;
 	case TIMESTEP_YEARLY:
 		entity = (void *)(&(patch->acc_year));
-		add_to_accum_reset_list(acc_objs_to_reset, entity);
 		break;
 	case TIMESTEP_HOURLY:
 	case TIMESTEP_DAILY:
@@ -472,17 +476,14 @@ inline static void *determine_patch_entity(OutputFilterTimestep timestep,
 }
 
 inline static void *determine_hillslope_entity(OutputFilterTimestep timestep,
-		struct hillslope_object *hillslope,
-		PointerSet **acc_objs_to_reset) {
+		struct hillslope_object *hillslope) {
 	void *entity = NULL;
 	switch (timestep) {
 	case TIMESTEP_MONTHLY:
 		entity = (void *)(&(hillslope->acc_month));
-		add_to_accum_reset_list(acc_objs_to_reset, entity);
 		break;
 	case TIMESTEP_YEARLY:
 		entity = (void *)(&(hillslope->acc_year));
-		add_to_accum_reset_list(acc_objs_to_reset, entity);
 		break;
 	case TIMESTEP_HOURLY:
 	case TIMESTEP_DAILY:
@@ -494,190 +495,434 @@ inline static void *determine_hillslope_entity(OutputFilterTimestep timestep,
 	return entity;
 }
 
-static bool apply_to_strata_in_patch(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterStratum const * const s, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < s->patch->num_canopy_strata; i++) {
-		struct canopy_strata_object *stratum = s->patch->canopy_strata[i];
-		id.canopy_strata_ID = stratum->ID;
-		void *entity = determine_stratum_entity(filter->timestep, stratum, acc_objs_to_reset);
-		bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-		if (!status) return false;
+/*
+ * Zone, patch and stratum filters are resolved once, by
+ * output_filter_resolve_entities(), into a flat array of the entities they
+ * output (the object itself for daily output, its acc_month or acc_year for
+ * monthly or yearly output) and the IDs written with each.  Each output
+ * timestep is then one loop over that array instead of a walk of the filter's
+ * spatial selectors.
+ *
+ * A filter with a group_by clause is aggregated before it is written: each
+ * entity is given the IDs of its group instead of its own, and the array is
+ * sorted on them so that each group is one run of entities; output_groups()
+ * then writes a single row per run.  Groups are named by basinID, hillID,
+ * zoneID and patchID down to the group_by level; patch families are named by
+ * their zone's IDs and the family ID in place of a patch ID, and map groups by
+ * the group ID alone.
+ */
+typedef struct group_map_entry_s {
+	int ID;
+	int group_ID;
+} GroupMapEntry;
+
+typedef struct entity_resolver_s {
+	size_t capacity;
+	// group_by map: patch ID (zone ID for zone filters) to group ID, sorted by ID
+	GroupMapEntry *map;
+	size_t map_len;
+	int unmapped_ID;
+} EntityResolver;
+
+static int compare_group_map_entries(const void *a, const void *b) {
+	int l = ((GroupMapEntry const *)a)->ID;
+	int r = ((GroupMapEntry const *)b)->ID;
+	return (l > r) - (l < r);
+}
+
+static bool read_group_map(char * const error, size_t error_len,
+		char const * const path, EntityResolver *r) {
+	char *local_error;
+	size_t capacity = 0;
+	int ID, group_ID, rv;
+
+	FILE *fp = fopen(path, "r");
+	if (fp == NULL) {
+		local_error = (char *)calloc(MAXSTR, sizeof(char));
+		snprintf(local_error, MAXSTR, "output_filter_resolve_entities: unable to open group map %s.", path);
+		return return_with_error(error, error_len, local_error);
+	}
+	while ((rv = fscanf(fp, "%d %d", &ID, &group_ID)) == 2) {
+		if (r->map_len == capacity) {
+			capacity = capacity == 0 ? 256 : 2 * capacity;
+			GroupMapEntry *map = realloc(r->map, capacity * sizeof(GroupMapEntry));
+			if (map == NULL) {
+				fprintf(stderr, "FATAL ERROR: output_filter_output::read_group_map(): unable to grow group map to %zu entries.\n",
+						capacity);
+				exit(EXIT_FAILURE);
+			}
+			r->map = map;
+		}
+		r->map[r->map_len].ID = ID;
+		r->map[r->map_len].group_ID = group_ID;
+		r->map_len++;
+	}
+	fclose(fp);
+	if (rv != EOF) {
+		local_error = (char *)calloc(MAXSTR, sizeof(char));
+		snprintf(local_error, MAXSTR, "output_filter_resolve_entities: group map %s must contain only pairs of ID and group ID.", path);
+		return return_with_error(error, error_len, local_error);
 	}
+	qsort(r->map, r->map_len, sizeof(GroupMapEntry), compare_group_map_entries);
 	return true;
 }
 
-static bool apply_to_patches_in_zone(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterPatch const * const p, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < p->zone->num_patches; i++) {
-		struct patch_object *patch = p->zone->patches[i];
-		id.patch_ID = patch->ID;
-		void *entity = determine_patch_entity(filter->timestep, patch, acc_objs_to_reset);
-		bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-		if (!status) return false;
+static EntityID group_entity_id(OutputFilter const * const f, EntityResolver *r,
+		EntityID id, int family_ID) {
+	EntityID group = {id.basin_ID, OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY,
+			OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY};
+	GroupMapEntry key, *entry;
+
+	switch (f->group_by) {
+	case GROUP_BY_PATCH:
+		group.patch_ID = id.patch_ID;
+		// fall through
+	case GROUP_BY_ZONE:
+		group.zone_ID = id.zone_ID;
+		// fall through
+	case GROUP_BY_HILLSLOPE:
+		group.hillslope_ID = id.hillslope_ID;
+		break;
+	case GROUP_BY_FAMILY:
+		group.hillslope_ID = id.hillslope_ID;
+		group.zone_ID = id.zone_ID;
+		group.patch_ID = family_ID;
+		break;
+	case GROUP_BY_MAP:
+		key.ID = f->type == OUTPUT_FILTER_ZONE ? id.zone_ID : id.patch_ID;
+		entry = bsearch(&key, r->map, r->map_len, sizeof(GroupMapEntry), compare_group_map_entries);
+		if (entry == NULL) {
+			if (r->unmapped_ID == OUTPUT_FILTER_ID_EMPTY) r->unmapped_ID = key.ID;
+		} else {
+			group.basin_ID = entry->group_ID;
+		}
+		break;
+	case GROUP_BY_BASIN:
+	case GROUP_BY_NONE:
+	default:
+		break;
 	}
-	return true;
+	return group;
+}
+
+static void append_entity(OutputFilter * const f, EntityResolver *r,
+		void *entity, EntityID id, double const *area, int family_ID) {
+	if (f->num_entities == r->capacity) {
+		r->capacity = r->capacity == 0 ? 64 : 2 * r->capacity;
+		OutputFilterEntity *entities = realloc(f->entities, r->capacity * sizeof(OutputFilterEntity));
+		if (entities == NULL) {
+			fprintf(stderr, "FATAL ERROR: output_filter_output::append_entity(): unable to grow entity list to %zu entries.\n",
+					r->capacity);
+			exit(EXIT_FAILURE);
+		}
+		f->entities = entities;
+	}
+	if (f->group_by != GROUP_BY_NONE) id = group_entity_id(f, r, id, family_ID);
+	f->entities[f->num_entities].id = id;
+	f->entities[f->num_entities].entity = entity;
+	f->entities[f->num_entities].area = area;
+	f->num_entities++;
+}
+
+inline static void append_zone(OutputFilter * const f, EntityResolver *r,
+		struct zone_object *zone, EntityID id) {
+	append_entity(f, r, determine_zone_entity(f->timestep, zone), id, &(zone->area),
+			OUTPUT_FILTER_ID_EMPTY);
+}
+
+inline static void append_patch(OutputFilter * const f, EntityResolver *r,
+		struct patch_object *patch, EntityID id) {
+	append_entity(f, r, determine_patch_entity(f->timestep, patch), id, &(patch->area),
+			patch->family_ID);
 }
 
-static bool apply_to_strata_in_zone(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterStratum const * const s, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < s->zone->num_patches; i++) {
-		struct patch_object *patch = s->zone->patches[i];
+inline static void append_stratum(OutputFilter * const f, EntityResolver *r,
+		struct patch_object *patch, struct canopy_strata_object *stratum, EntityID id) {
+	// Strata are weighted by the area of their patch, as in basin filters
+	append_entity(f, r, determine_stratum_entity(f->timestep, stratum), id, &(patch->area),
+			patch->family_ID);
+}
+
+static void resolve_strata_in_patch(OutputFilter * const f, EntityResolver *r,
+		struct patch_object *patch, EntityID id) {
+	for (size_t i = 0; i < patch->num_canopy_strata; i++) {
+		struct canopy_strata_object *stratum = patch->canopy_strata[i];
+		id.canopy_strata_ID = stratum->ID;
+		append_stratum(f, r, patch, stratum, id);
+	}
+}
+
+static void resolve_patches_in_zone(OutputFilter * const f, EntityResolver *r,
+		struct zone_object *zone, EntityID id, bool strata) {
+	for (size_t i = 0; i < zone->num_patches; i++) {
+		struct patch_object *patch = zone->patches[i];
 		id.patch_ID = patch->ID;
-		for (size_t j = 0; j < patch->num_canopy_strata; j++) {
-			struct canopy_strata_object *stratum = patch->canopy_strata[j];
-			id.canopy_strata_ID = stratum->ID;
-			void *entity = determine_stratum_entity(filter->timestep, stratum, acc_objs_to_reset);
-			bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-			if (!status) return false;
+		if (strata) {
+			resolve_strata_in_patch(f, r, patch, id);
+		} else {
+			append_patch(f, r, patch, id);
 		}
 	}
-	return true;
 }
 
-static bool apply_to_zones_in_hillslope(char * const error, size_t error_len, bool verbose,
-                                        struct date date,
-                                        OutputFilter const * const filter, OutputFilterZone const * const z, EntityID id,
-                                        PointerSet **acc_objs_to_reset,
-                                        bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < z->hill->num_zones; i++) {
-		struct zone_object *zone = z->hill->zones[i];
+static void resolve_zones_in_hillslope(OutputFilter * const f, EntityResolver *r,
+		struct hillslope_object *hill, EntityID id, OutputFilterType level) {
+	for (size_t i = 0; i < hill->num_zones; i++) {
+		struct zone_object *zone = hill->zones[i];
 		id.zone_ID = zone->ID;
-		void *entity = determine_zone_entity(filter->timestep, zone, acc_objs_to_reset);
-		bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-		if (!status) return false;
+		if (level == OUTPUT_FILTER_ZONE) {
+			append_zone(f, r, zone, id);
+		} else {
+			resolve_patches_in_zone(f, r, zone, id, level == OUTPUT_FILTER_CANOPY_STRATUM);
+		}
 	}
-	return true;
 }
 
-static bool apply_to_patches_in_hillslope(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterPatch const * const p, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < p->hill->num_zones; i++) {
-		struct zone_object *z = p->hill->zones[i];
-		id.zone_ID = z->ID;
-		for (size_t j = 0; j < z->num_patches; j++) {
-			struct patch_object *patch = z->patches[j];
-			id.patch_ID = patch->ID;
-			void *entity = determine_patch_entity(filter->timestep, patch, acc_objs_to_reset);
-			bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-			if (!status) return false;
-		}
+static void resolve_hillslopes_in_basin(OutputFilter * const f, EntityResolver *r,
+		struct basin_object *basin, EntityID id, OutputFilterType level) {
+	for (size_t i = 0; i < basin->num_hillslopes; i++) {
+		struct hillslope_object *hill = basin->hillslopes[i];
+		id.hillslope_ID = hill->ID;
+		resolve_zones_in_hillslope(f, r, hill, id, level);
 	}
-	return true;
 }
 
-static bool apply_to_strata_in_hillslope(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterStratum const * const s, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < s->hill->num_zones; i++) {
-		struct zone_object *z = s->hill->zones[i];
-		id.zone_ID = z->ID;
-		for (size_t j = 0; j < z->num_patches; j++) {
-			struct patch_object *patch = z->patches[j];
-			id.patch_ID = patch->ID;
-			for (size_t k = 0; k < patch->num_canopy_strata; k++) {
-				struct canopy_strata_object *stratum = patch->canopy_strata[k];
-				id.canopy_strata_ID = stratum->ID;
-				void *entity = determine_stratum_entity(filter->timestep, stratum, acc_objs_to_reset);
-				bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-				if (!status) return false;
-			}
+static bool resolve_zone_entities(char * const error, size_t error_len,
+		OutputFilter * const f, EntityResolver *r) {
+	char *local_error;
+
+	for (OutputFilterZone *z = f->zones; z != NULL; z = z->next) {
+		EntityID id = {z->basinID, OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY,
+				OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY};
+		switch (z->output_zone_type) {
+		case ZONE_TYPE_ZONE:
+			id.hillslope_ID = z->hillslopeID;
+			id.zone_ID = z->zoneID;
+			append_zone(f, r, z->zone, id);
+			break;
+		case ZONE_TYPE_HILLSLOPE:
+			id.hillslope_ID = z->hillslopeID;
+			resolve_zones_in_hillslope(f, r, z->hill, id, OUTPUT_FILTER_ZONE);
+			break;
+		case ZONE_TYPE_BASIN:
+			resolve_hillslopes_in_basin(f, r, z->basin, id, OUTPUT_FILTER_ZONE);
+			break;
+		default:
+			local_error = (char *)calloc(MAXSTR, sizeof(char));
+			snprintf(local_error, MAXSTR, "output_zone: zone type %d is unknown or not yet implemented.",
+			         z->output_zone_type);
+			return return_with_error(error, error_len, local_error);
 		}
 	}
 	return true;
 }
 
-static bool apply_to_zones_in_basin(char * const error, size_t error_len, bool verbose,
-									struct date date, OutputFilter const * const filter, OutputFilterZone const * const z, EntityID id,
-									PointerSet **acc_objs_to_reset,
-									bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < z->basin->num_hillslopes; i++) {
-		struct hillslope_object *h = z->basin->hillslopes[i];
-		id.hillslope_ID = h->ID;
-		for (size_t j = 0; j < h->num_zones; j++) {
-			struct zone_object *zone = h->zones[j];
-			id.zone_ID = zone->ID;
-			void *entity = determine_zone_entity(filter->timestep, zone, acc_objs_to_reset);
-			bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-			if (!status) return false;
+static bool resolve_patch_entities(char * const error, size_t error_len,
+		OutputFilter * const f, EntityResolver *r) {
+	char *local_error;
+
+	for (OutputFilterPatch *p = f->patches; p != NULL; p = p->next) {
+		EntityID id = {p->basinID, OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY,
+				OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY};
+		switch (p->output_patch_type) {
+		case PATCH_TYPE_PATCH:
+			id.hillslope_ID = p->hillslopeID;
+			id.zone_ID = p->zoneID;
+			id.patch_ID = p->patchID;
+			append_patch(f, r, p->patch, id);
+			break;
+		case PATCH_TYPE_ZONE:
+			id.hillslope_ID = p->hillslopeID;
+			id.zone_ID = p->zoneID;
+			resolve_patches_in_zone(f, r, p->zone, id, false);
+			break;
+		case PATCH_TYPE_HILLSLOPE:
+			id.hillslope_ID = p->hillslopeID;
+			resolve_zones_in_hillslope(f, r, p->hill, id, OUTPUT_FILTER_PATCH);
+			break;
+		case PATCH_TYPE_BASIN:
+			resolve_hillslopes_in_basin(f, r, p->basin, id, OUTPUT_FILTER_PATCH);
+			break;
+		default:
+			local_error = (char *)calloc(MAXSTR, sizeof(char));
+			snprintf(local_error, MAXSTR, "output_patch: patch type %d is unknown or not yet implemented.",
+					p->output_patch_type);
+			return return_with_error(error, error_len, local_error);
 		}
 	}
 	return true;
 }
 
-static bool apply_to_patches_in_basin(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterPatch const * const p, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < p->basin->num_hillslopes; i++) {
-		struct hillslope_object *h = p->basin->hillslopes[i];
-		id.hillslope_ID = h->ID;
-		for (size_t j = 0; j < h->num_zones; j++) {
-			struct zone_object *z = h->zones[j];
-			id.zone_ID = z->ID;
-			for (size_t k = 0; k < z->num_patches; k++) {
-				struct patch_object *patch = z->patches[k];
-				id.patch_ID = patch->ID;
-				void *entity = determine_patch_entity(filter->timestep, patch, acc_objs_to_reset);
-				bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-				if (!status) return false;
-			}
+static bool resolve_stratum_entities(char * const error, size_t error_len,
+		OutputFilter * const f, EntityResolver *r) {
+	char *local_error;
+
+	for (OutputFilterStratum *s = f->strata; s != NULL; s = s->next) {
+		EntityID id = {s->basinID, OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY,
+				OUTPUT_FILTER_ID_EMPTY, OUTPUT_FILTER_ID_EMPTY};
+		switch (s->output_stratum_type) {
+		case STRATUM_TYPE_STRATUM:
+			id.hillslope_ID = s->hillslopeID;
+			id.zone_ID = s->zoneID;
+			id.patch_ID = s->patchID;
+			id.canopy_strata_ID = s->stratumID;
+			append_stratum(f, r, s->patch, s->stratum, id);
+			break;
+		case STRATUM_TYPE_PATCH:
+			id.hillslope_ID = s->hillslopeID;
+			id.zone_ID = s->zoneID;
+			id.patch_ID = s->patchID;
+			resolve_strata_in_patch(f, r, s->patch, id);
+			break;
+		case STRATUM_TYPE_ZONE:
+			id.hillslope_ID = s->hillslopeID;
+			id.zone_ID = s->zoneID;
+			resolve_patches_in_zone(f, r, s->zone, id, true);
+			break;
+		case STRATUM_TYPE_HILLSLOPE:
+			id.hillslope_ID = s->hillslopeID;
+			resolve_zones_in_hillslope(f, r, s->hill, id, OUTPUT_FILTER_CANOPY_STRATUM);
+			break;
+		case STRATUM_TYPE_BASIN:
+			resolve_hillslopes_in_basin(f, r, s->basin, id, OUTPUT_FILTER_CANOPY_STRATUM);
+			break;
+		default:
+			local_error = (char *)calloc(MAXSTR, sizeof(char));
+			snprintf(local_error, MAXSTR, "output_stratum: stratum type %d is unknown or not yet implemented.",
+					s->output_stratum_type);
+			return return_with_error(error, error_len, local_error);
 		}
 	}
 	return true;
 }
 
-static bool apply_to_strata_in_basin(char * const error, size_t error_len, bool verbose,
-		struct date date,
-		OutputFilter const * const filter, OutputFilterStratum const * const s, EntityID id,
-		PointerSet **acc_objs_to_reset,
-		bool (*output_fn)(char * const, size_t, bool, struct date date, void * const, EntityID, OutputFilter const * const)) {
-	for (size_t i = 0; i < s->basin->num_hillslopes; i++) {
-		struct hillslope_object *h = s->basin->hillslopes[i];
-		id.hillslope_ID = h->ID;
-		for (size_t j = 0; j < h->num_zones; j++) {
-			struct zone_object *z = h->zones[j];
-			id.zone_ID = z->ID;
-			for (size_t k = 0; k < z->num_patches; k++) {
-				struct patch_object *patch = z->patches[k];
-				id.patch_ID = patch->ID;
-				for (size_t l = 0; l < patch->num_canopy_strata; l++) {
-					struct canopy_strata_object *stratum = patch->canopy_strata[l];
-					id.canopy_strata_ID = stratum->ID;
-					void *entity = determine_stratum_entity(filter->timestep, stratum, acc_objs_to_reset);
-					bool status = (*output_fn)(error, error_len, verbose, date, entity, id, filter);
-					if (!status) return false;
-				}
-			}
+static bool group_by_matches_filter_type(OutputFilter const * const f) {
+	switch (f->group_by) {
+	case GROUP_BY_NONE:
+		return true;
+	case GROUP_BY_BASIN:
+	case GROUP_BY_HILLSLOPE:
+	case GROUP_BY_MAP:
+		return f->type == OUTPUT_FILTER_ZONE || f->type == OUTPUT_FILTER_PATCH
+				|| f->type == OUTPUT_FILTER_CANOPY_STRATUM;
+	case GROUP_BY_ZONE:
+	case GROUP_BY_FAMILY:
+		return f->type == OUTPUT_FILTER_PATCH || f->type == OUTPUT_FILTER_CANOPY_STRATUM;
+	case GROUP_BY_PATCH:
+		return f->type == OUTPUT_FILTER_CANOPY_STRATUM;
+	default:
+		return false;
+	}
+}
+
+inline static int compare_entity_ids(EntityID const *l, EntityID const *r) {
+	if (l->basin_ID != r->basin_ID) return l->basin_ID < r->basin_ID ? -1 : 1;
+	if (l->hillslope_ID != r->hillslope_ID) return l->hillslope_ID < r->hillslope_ID ? -1 : 1;
+	if (l->zone_ID != r->zone_ID) return l->zone_ID < r->zone_ID ? -1 : 1;
+	if (l->patch_ID != r->patch_ID) return l->patch_ID < r->patch_ID ? -1 : 1;
+	if (l->canopy_strata_ID != r->canopy_strata_ID) return l->canopy_strata_ID < r->canopy_strata_ID ? -1 : 1;
+	return 0;
+}
+
+typedef struct ordered_entity_s {
+	OutputFilterEntity e;
+	size_t order;
+} OrderedEntity;
+
+static int compare_ordered_entities(const void *a, const void *b) {
+	OrderedEntity const *l = (OrderedEntity const *)a;
+	OrderedEntity const *r = (OrderedEntity const *)b;
+	int cmp = compare_entity_ids(&(l->e.id), &(r->e.id));
+	if (cmp != 0) return cmp;
+	// Keep entities of a group in the order they were resolved so that sums
+	// are always taken in the same order
+	return (l->order > r->order) - (l->order < r->order);
+}
+
+static void sort_entities_by_group(OutputFilter * const f) {
+	if (f->num_entities < 2) return;
+	OrderedEntity *ordered = malloc(f->num_entities * sizeof(OrderedEntity));
+	if (ordered == NULL) {
+		fprintf(stderr, "FATAL ERROR: output_filter_output::sort_entities_by_group(): unable to allocate %zu entities.\n",
+				f->num_entities);
+		exit(EXIT_FAILURE);
+	}
+	for (size_t i = 0; i < f->num_entities; i++) {
+		ordered[i].e = f->entities[i];
+		ordered[i].order = i;
+	}
+	qsort(ordered, f->num_entities, sizeof(OrderedEntity), compare_ordered_entities);
+	for (size_t i = 0; i < f->num_entities; i++) {
+		f->entities[i] = ordered[i].e;
+	}
+	free(ordered);
+}
+
+bool output_filter_resolve_entities(char * const error, size_t error_len,
+		OutputFilter * const f) {
+	char *local_error;
+	bool status;
+	EntityResolver r = {0, NULL, 0, OUTPUT_FILTER_ID_EMPTY};
+
+	f->entities = NULL;
+	f->num_entities = 0;
+
+	if (!group_by_matches_filter_type(f)) {
+		return return_with_error(error, error_len,
+				"output_filter_resolve_entities: group_by must name a level above the filter's zones, patches or strata.");
+	}
+	if ((f->group_by == GROUP_BY_MAP) != (f->group_map != NULL)) {
+		return return_with_error(error, error_len,
+				"output_filter_resolve_entities: group_map must be given for, and only for, group_by: map.");
+	}
+	if (f->group_by == GROUP_BY_MAP) {
+		status = read_group_map(error, error_len, f->group_map, &r);
+		if (!status) {
+			free(r.map);
+			return false;
 		}
 	}
+
+	switch (f->type) {
+	case OUTPUT_FILTER_ZONE:
+		status = resolve_zone_entities(error, error_len, f, &r);
+		break;
+	case OUTPUT_FILTER_PATCH:
+		status = resolve_patch_entities(error, error_len, f, &r);
+		break;
+	case OUTPUT_FILTER_CANOPY_STRATUM:
+		status = resolve_stratum_entities(error, error_len, f, &r);
+		break;
+	case OUTPUT_FILTER_BASIN:
+	default:
+		// Basin filters aggregate over their basins as they output
+		status = true;
+		break;
+	}
+	free(r.map);
+	if (!status) return false;
+
+	if (r.unmapped_ID != OUTPUT_FILTER_ID_EMPTY) {
+		local_error = (char *)calloc(MAXSTR, sizeof(char));
+		snprintf(local_error, MAXSTR, "output_filter_resolve_entities: group map %s has no group for ID %d.",
+				f->group_map, r.unmapped_ID);
+		return return_with_error(error, error_len, local_error);
+	}
+	if (f->group_by != GROUP_BY_NONE) sort_entities_by_group(f);
 	return true;
 }
 
 static inline bool output_materialized_variables(char * const error, size_t error_len,
-		struct date date, EntityID id, OutputFilter const * const f, MaterializedVariable *mat_vars) {
+		struct date date, EntityID id, OutputFilter const * const f, MaterializedVariable *mat_vars,
+		bool flush) {
 	// Output materialized variables array using appropriate driver
 	switch (f->output->format) {
 	case OUTPUT_TYPE_CSV:
 		return output_format_csv_write_data(error, error_len,
-				date, f, id, mat_vars, true);
+				date, f, id, mat_vars, flush);
 	case OUTPUT_TYPE_NETCDF:
 		return output_format_netcdf_write_data(error, error_len,
-				date, f, id, mat_vars, true);
+				date, f, id, mat_vars, flush);
 	default:
 		fprintf(stderr, "output_materialized_variables: output format type %d is unknown or not yet implemented.",
 				f->output->format);
@@ -685,28 +930,67 @@ static inline bool output_materialized_variables(char * const error, size_t erro
 	}
 }
 
-static bool output_variables(char * const error, size_t error_len, bool verbose,
-		struct date date, void * const entity, EntityID id, OutputFilter const * const f) {
-	if (verbose) fprintf(stderr, "\t\toutput_variables(num_variables: %hu)...\n", f->num_variables);
+/*
+ * Zone, patch and stratum filters materialize their variables a block of
+ * OUTPUT_FILTER_ROW_BLOCK entities at a time: the rows of a block are
+ * materialized in parallel into one row buffer, each thread filling its own
+ * rows, and are then written (or aggregated) in entity order, so output is the
+ * same as materializing one entity at a time.  The buffer is kept from one
+ * output call to the next.
+ */
+#define OUTPUT_FILTER_ROW_BLOCK 4096
+
+static MaterializedVariable *row_buffer = NULL;
+static size_t row_buffer_len = 0;
+
+static MaterializedVariable *get_row_buffer(num_elements_t num_variables) {
+	size_t len = (size_t)OUTPUT_FILTER_ROW_BLOCK * num_variables;
+	if (len > row_buffer_len) {
+		MaterializedVariable *rows = realloc(row_buffer, len * sizeof(MaterializedVariable));
+		if (rows == NULL) {
+			fprintf(stderr, "FATAL ERROR: output_filter_output::get_row_buffer(): unable to grow row buffer to %zu variables.\n",
+					len);
+			exit(EXIT_FAILURE);
+		}
+		row_buffer = rows;
+		row_buffer_len = len;
+	}
+	return row_buffer;
+}
+
+inline static void materialize_row(OutputFilter const * const f, void * const entity,
+		MaterializedVariable *row) {
+	num_elements_t curr_var = 0;
+	for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
+		if (v->variable_type == NAMED || v->variable_type == VAR_TYPE_EXPR) {
+			row[curr_var++] = materialize_variable(v, entity);
+		}
+	}
+}
+
+static void materialize_rows(OutputFilter const * const f, size_t first, size_t num_rows,
+		MaterializedVariable *rows) {
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < (int)num_rows; i++) {
+		materialize_row(f, f->entities[first + i].entity, &rows[i * f->num_variables]);
+	}
+}
 
+static void check_row(char * const error, size_t error_len, OutputFilter const * const f,
+		MaterializedVariable const *row) {
 	char *local_error;
-	MaterializedVariable mat_var;
-	MaterializedVariable *mat_vars = f->output->materialized_variables;
 	num_elements_t curr_var = 0;
 
 	for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
 		switch (v->variable_type) {
 		case NAMED:
 		case VAR_TYPE_EXPR:
-			// Materialize variable and add it to array
-			mat_var = materialize_variable(v, entity);
-			if (mat_var.data_type == DATA_TYPE_UNDEFINED) {
+			if (row[curr_var++].data_type == DATA_TYPE_UNDEFINED) {
 				local_error = (char *)calloc(MAXSTR, sizeof(char));
 				snprintf(local_error, MAXSTR, "output_variables:  data type %d of variable %s is unknown or not yet implemented.",
 						 v->data_type, v->name);
 				return_with_error(error, error_len, local_error);
 			}
-			mat_vars[curr_var++] = mat_var;
 			break;
 		case ANY_VAR:
 		default:
@@ -716,14 +1000,12 @@ static bool output_variables(char * const error, size_t error_len, bool verbose,
 			return_with_error(error, error_len, local_error);
 		}
 	}
-
-	return output_materialized_variables(error, error_len, date, id, f, mat_vars);
 }
 
 static bool output_basin(char * const error, size_t error_len, bool verbose,
 		struct date date, OutputFilter const * const f,
-		PointerSet **hillslope_acc_objs_to_reset, PointerSet **zone_acc_objs_to_reset,
-		PointerSet **patch_acc_objs_to_reset, PointerSet **stratum_acc_objs_to_reset) {
+		AccumResetList *hillslope_acc_objs_to_reset, AccumResetList *zone_acc_objs_to_reset,
+		AccumResetList *patch_acc_objs_to_reset, AccumResetList *stratum_acc_objs_to_reset) {
 	if (verbose) fprintf(stderr, "\toutput_basin()...\n");
 
 	bool status;
@@ -752,12 +1034,17 @@ static bool output_basin(char * const error, size_t error_len, bool verbose,
 
 				for (size_t k = 0; k < z->num_patches; k++) {
 					struct patch_object *patch = z->patches[k];
+					void *patch_entity = NULL;
 					// Iterate over filter variables accumulating any patch variables
 					int var_num = 0;
 					for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
 						if (v->variable_type == NAMED) {
 							if (v->hierarchy_level == OF_HIERARCHY_LEVEL_PATCH) {
-								void *entity = determine_patch_entity(f->timestep, patch, patch_acc_objs_to_reset);
+								if (patch_entity == NULL) {
+									patch_entity = determine_patch_entity(f->timestep, patch);
+									if (patch_acc_objs_to_reset) add_to_accum_reset_list(patch_acc_objs_to_reset, patch_entity);
+								}
+								void *entity = patch_entity;
 								mat_var = materialize_variable(v, entity);
 								accum_materialized_variable(&mat_vars[var_num], &mat_var, patch->area);
 							}
@@ -766,12 +1053,17 @@ static bool output_basin(char * const error, size_t error_len, bool verbose,
 					}
 					for (size_t l = 0; l < patch->num_canopy_strata; l++) {
 						struct canopy_strata_object *stratum = patch->canopy_strata[l];
+						void *stratum_entity = NULL;
 						// Iterate over filter variables accumulating any stratum variables
 						int var_num = 0;
 						for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
 							if (v->variable_type == NAMED) {
 								if (v->hierarchy_level == OF_HIERARCHY_LEVEL_STRATUM) {
-									void *entity = determine_stratum_entity(f->timestep, stratum, stratum_acc_objs_to_reset);
+									if (stratum_entity == NULL) {
+										stratum_entity = determine_stratum_entity(f->timestep, stratum);
+										if (stratum_acc_objs_to_reset) add_to_accum_reset_list(stratum_acc_objs_to_reset, stratum_entity);
+									}
+									void *entity = stratum_entity;
 									mat_var = materialize_variable(v, entity);
 									accum_materialized_variable(&mat_vars[var_num], &mat_var, patch->area);
 								}
@@ -784,11 +1076,16 @@ static bool output_basin(char * const error, size_t error_len, bool verbose,
 				}
 
 				// Iterate over filter variables accumulating any zone variables
+				void *zone_entity = NULL;
 				int var_num = 0;
 				for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
 					if (v->variable_type == NAMED) {
 						if (v->hierarchy_level == OF_HIERARCHY_LEVEL_ZONE) {
-							void *entity = determine_zone_entity(f->timestep, z, zone_acc_objs_to_reset);
+							if (zone_entity == NULL) {
+								zone_entity = determine_zone_entity(f->timestep, z);
+								if (zone_acc_objs_to_reset) add_to_accum_reset_list(zone_acc_objs_to_reset, zone_entity);
+							}
+							void *entity = zone_entity;
 							mat_var = materialize_variable(v, entity);
 							accum_materialized_variable(&mat_vars[var_num], &mat_var, z->area);
 						}
@@ -798,11 +1095,16 @@ static bool output_basin(char * const error, size_t error_len, bool verbose,
 			}
 
 			// Iterate over filter variables accumulating any hillslope variables
+			void *hillslope_entity = NULL;
 			int var_num = 0;
 			for (OutputFilterVariable *v = f->variables; v != NULL; v = v->next) {
 				if (v->variable_type == NAMED) {
 					if (v->hierarchy_level == OF_HIERARCHY_LEVEL_HILLSLOPE) {
-						void *entity = determine_hillslope_entity(f->timestep, hillslope, hillslope_acc_objs_to_reset);
+						if (hillslope_entity == NULL) {
+							hillslope_entity = determine_hillslope_entity(f->timestep, hillslope);
+							if (hillslope_acc_objs_to_reset) add_to_accum_reset_list(hillslope_acc_objs_to_reset, hillslope_entity);
+						}
+						void *entity = hillslope_entity;
 						mat_var = materialize_variable(v, entity);
 						accum_materialized_variable(&mat_vars[var_num], &mat_var, hillslope_area);
 					}
@@ -812,7 +1114,7 @@ static bool output_basin(char * const error, size_t error_len, bool verbose,
 		}
 		// Scale values by basin area (not sure this makes sense for all variables, including many zone variables)
 		scale_materialized_variable_array_values(f, basin_area);
-		status = output_materialized_variables(error, error_len, date, id, f, mat_vars);
+		status = output_materialized_variables(error, error_len, date, id, f, mat_vars, true);
 		if (status == false) {
 			char *local_error = (char *)calloc(MAXSTR, sizeof(char));
 			snprintf(local_error, MAXSTR, "output_filter_output::output_basin: failed to output materialized variables.");
@@ -822,181 +1124,109 @@ static bool output_basin(char * const error, size_t error_len, bool verbose,
 	return true;
 }
 
-static bool output_zone(char * const error, size_t error_len, bool verbose,
-                         struct date date, OutputFilter const * const filter,
-                         PointerSet **acc_objs_to_reset) {
-	if (verbose) fprintf(stderr, "\toutput_zone()...\n");
-
-	char *local_error;
-	bool status;
-
-	for (OutputFilterZone *z = filter->zones; z != NULL; z = z->next) {
-		status = true;
-		EntityID id;
-		switch (z->output_zone_type) {
-		case ZONE_TYPE_ZONE:
-			id.basin_ID = z->basinID;
-			id.hillslope_ID = z->hillslopeID;
-			id.zone_ID = z->zoneID;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			void *entity = determine_zone_entity(filter->timestep, z->zone, acc_objs_to_reset);
-			status = output_variables(error, error_len, verbose, date, entity, id, filter);
-			break;
-		case ZONE_TYPE_HILLSLOPE:
-			id.basin_ID = z->basinID;
-			id.hillslope_ID = z->hillslopeID;
-			id.zone_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_zones_in_hillslope(error, error_len, verbose, date, filter, z, id, acc_objs_to_reset,
-									             *output_variables);
-			break;
-		case ZONE_TYPE_BASIN:
-			id.basin_ID = z->basinID;
-			id.hillslope_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.zone_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_zones_in_basin(error, error_len, verbose, date, filter, z, id, acc_objs_to_reset,
-								             *output_variables);
-			break;
-		default:
-			local_error = (char *)calloc(MAXSTR, sizeof(char));
-			snprintf(local_error, MAXSTR, "output_zone: zone type %d is unknown or not yet implemented.",
-			         z->output_zone_type);
-			return_with_error(error, error_len, local_error);
-		}
-		if (!status) return false;
+inline static void aggregate_materialized_variable(MaterializedVariable *agg, MaterializedVariable value,
+		double area, OutputAggregate aggregate, bool first) {
+	double v = mat_var_scalar_to_double(value);
+	switch (aggregate) {
+	case AGGREGATE_MIN:
+		if (first || v < agg->u.double_val) agg->u.double_val = v;
+		break;
+	case AGGREGATE_MAX:
+		if (first || v > agg->u.double_val) agg->u.double_val = v;
+		break;
+	case AGGREGATE_MEAN:
+	case AGGREGATE_SUM:
+	default:
+		if (first) agg->u.double_val = 0.0;
+		agg->u.double_val += v * area;
+		break;
 	}
-
-	return true;
+	agg->data_type = DATA_TYPE_DOUBLE;
+	agg->meta = value.meta;
 }
 
-static bool output_patch(char * const error, size_t error_len, bool verbose,
+/*
+ * Write one row per group of a grouped filter (see
+ * output_filter_resolve_entities()).  Groups are the runs of entities sharing
+ * an ID.  mean is the area-weighted mean, sum the area-weighted sum (e.g. a
+ * depth summed to a volume); min and max are not weighted.  Every value is
+ * written as a double.
+ */
+static bool output_groups(char * const error, size_t error_len, bool verbose,
 		struct date date, OutputFilter const * const filter,
-		PointerSet **acc_objs_to_reset) {
-	if (verbose) fprintf(stderr, "\toutput_patch()...\n");
-
-	char *local_error;
-	bool status;
-
-	for (OutputFilterPatch *p = filter->patches; p != NULL; p = p->next) {
-		status = true;
-		EntityID id;
-		switch (p->output_patch_type) {
-		case PATCH_TYPE_PATCH:
-			id.basin_ID = p->basinID;
-			id.hillslope_ID = p->hillslopeID;
-			id.zone_ID = p->zoneID;
-			id.patch_ID = p->patchID;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			void *entity = determine_patch_entity(filter->timestep, p->patch, acc_objs_to_reset);
-			status = output_variables(error, error_len, verbose, date, entity, id, filter);
-			break;
-		case PATCH_TYPE_ZONE:
-			id.basin_ID = p->basinID;
-			id.hillslope_ID = p->hillslopeID;
-			id.zone_ID = p->zoneID;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_patches_in_zone(error, error_len, verbose, date, filter, p, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		case PATCH_TYPE_HILLSLOPE:
-			id.basin_ID = p->basinID;
-			id.hillslope_ID = p->hillslopeID;
-			id.zone_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_patches_in_hillslope(error, error_len, verbose, date, filter, p, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		case PATCH_TYPE_BASIN:
-			id.basin_ID = p->basinID;
-			id.hillslope_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.zone_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_patches_in_basin(error, error_len, verbose, date, filter, p, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		default:
-			local_error = (char *)calloc(MAXSTR, sizeof(char));
-			snprintf(local_error, MAXSTR, "output_patch: patch type %d is unknown or not yet implemented.",
-					p->output_patch_type);
-			return_with_error(error, error_len, local_error);
+		AccumResetList *acc_objs_to_reset) {
+	if (verbose) fprintf(stderr, "\toutput_groups(num_entities: %zu)...\n", filter->num_entities);
+
+	bool accum = (filter->timestep == TIMESTEP_MONTHLY) || (filter->timestep == TIMESTEP_YEARLY);
+	num_elements_t num_variables = filter->num_variables;
+	MaterializedVariable *mat_vars = filter->output->materialized_variables;
+	MaterializedVariable *rows = get_row_buffer(num_variables);
+
+	EntityID id;
+	double area = 0.0;
+	for (size_t first = 0; first < filter->num_entities; first += OUTPUT_FILTER_ROW_BLOCK) {
+		size_t num_rows = filter->num_entities - first;
+		if (num_rows > OUTPUT_FILTER_ROW_BLOCK) num_rows = OUTPUT_FILTER_ROW_BLOCK;
+		materialize_rows(filter, first, num_rows, rows);
+
+		for (size_t i = 0; i < num_rows; i++) {
+			OutputFilterEntity const *e = &(filter->entities[first + i]);
+			bool first_in_group = (first + i == 0) || compare_entity_ids(&(e->id), &id) != 0;
+			if (first_in_group && first + i > 0) {
+				// Write out the group that just ended
+				if (filter->aggregate == AGGREGATE_MEAN && area > 0.0) {
+					scale_materialized_variable_array_values(filter, area);
+				}
+				if (!output_materialized_variables(error, error_len, date, id, filter, mat_vars, false)) return false;
+			}
+			if (first_in_group) {
+				id = e->id;
+				area = 0.0;
+			}
+			if (accum) add_to_accum_reset_list(acc_objs_to_reset, e->entity);
+			for (num_elements_t v = 0; v < num_variables; v++) {
+				aggregate_materialized_variable(&mat_vars[v], rows[i * num_variables + v],
+						*(e->area), filter->aggregate, first_in_group);
+			}
+			area += *(e->area);
+		}
+	}
+	if (filter->num_entities > 0) {
+		if (filter->aggregate == AGGREGATE_MEAN && area > 0.0) {
+			scale_materialized_variable_array_values(filter, area);
 		}
-		if (!status) return false;
+		if (!output_materialized_variables(error, error_len, date, id, filter, mat_vars, true)) return false;
 	}
 
 	return true;
 }
 
-static bool output_stratum(char * const error, size_t error_len, bool verbose,
+static bool output_entities(char * const error, size_t error_len, bool verbose,
 		struct date date, OutputFilter const * const filter,
-		PointerSet **acc_objs_to_reset) {
-	if (verbose) fprintf(stderr, "\toutput_stratum()...\n");
-
-	char *local_error;
-	bool status;
-
-	for (OutputFilterStratum *s = filter->strata; s != NULL; s = s->next) {
-		status = true;
-		EntityID id;
-		switch (s->output_stratum_type) {
-		case STRATUM_TYPE_STRATUM:
-			id.basin_ID = s->basinID;
-			id.hillslope_ID = s->hillslopeID;
-			id.zone_ID = s->zoneID;
-			id.patch_ID = s->patchID;
-			id.canopy_strata_ID = s->stratumID;
-			void *entity = determine_stratum_entity(filter->timestep, s->stratum, acc_objs_to_reset);
-			status = output_variables(error, error_len, verbose, date, entity, id, filter);
-			break;
-		case STRATUM_TYPE_PATCH:
-			id.basin_ID = s->basinID;
-			id.hillslope_ID = s->hillslopeID;
-			id.zone_ID = s->zoneID;
-			id.patch_ID = s->patchID;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_strata_in_patch(error, error_len, verbose, date, filter, s, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		case STRATUM_TYPE_ZONE:
-			id.basin_ID = s->basinID;
-			id.hillslope_ID = s->hillslopeID;
-			id.zone_ID = s->zoneID;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_strata_in_zone(error, error_len, verbose, date, filter, s, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		case STRATUM_TYPE_HILLSLOPE:
-			id.basin_ID = s->basinID;
-			id.hillslope_ID = s->hillslopeID;
-			id.zone_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_strata_in_hillslope(error, error_len, verbose, date, filter, s, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		case STRATUM_TYPE_BASIN:
-			id.basin_ID = s->basinID;
-			id.hillslope_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.zone_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.patch_ID = OUTPUT_FILTER_ID_EMPTY;
-			id.canopy_strata_ID = OUTPUT_FILTER_ID_EMPTY;
-			status = apply_to_strata_in_basin(error, error_len, verbose, date, filter, s, id, acc_objs_to_reset,
-					*output_variables);
-			break;
-		default:
-			local_error = (char *)calloc(MAXSTR, sizeof(char));
-			snprintf(local_error, MAXSTR, "output_stratum: stratum type %d is unknown or not yet implemented.",
-					s->output_stratum_type);
-			return_with_error(error, error_len, local_error);
+		AccumResetList *acc_objs_to_reset) {
+	if (filter->group_by != GROUP_BY_NONE) {
+		return output_groups(error, error_len, verbose, date, filter, acc_objs_to_reset);
+	}
+	if (verbose) fprintf(stderr, "\toutput_entities(num_entities: %zu)...\n", filter->num_entities);
+
+	bool accum = (filter->timestep == TIMESTEP_MONTHLY) || (filter->timestep == TIMESTEP_YEARLY);
+	MaterializedVariable *rows = get_row_buffer(filter->num_variables);
+
+	for (size_t first = 0; first < filter->num_entities; first += OUTPUT_FILTER_ROW_BLOCK) {
+		size_t num_rows = filter->num_entities - first;
+		if (num_rows > OUTPUT_FILTER_ROW_BLOCK) num_rows = OUTPUT_FILTER_ROW_BLOCK;
+		materialize_rows(filter, first, num_rows, rows);
+
+		for (size_t i = 0; i < num_rows; i++) {
+			OutputFilterEntity const *e = &(filter->entities[first + i]);
+			MaterializedVariable *row = &rows[i * filter->num_variables];
+			if (accum) add_to_accum_reset_list(acc_objs_to_reset, e->entity);
+			check_row(error, error_len, filter, row);
+			// Flush once, after the last row
+			bool flush = (first + i + 1 == filter->num_entities);
+			bool status = output_materialized_variables(error, error_len, date, e->id, filter, row, flush);
+			if (!status) return false;
 		}
-		if (!status) return false;
 	}
 
 	return true;
@@ -1017,15 +1247,15 @@ bool output_filter_output_daily(char * const error, size_t error_len, bool verbo
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_ZONE:
-				status = output_zone(error, error_len, verbose, date, f, NULL);
+				status = output_entities(error, error_len, verbose, date, f, NULL);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_PATCH:
-				status = output_patch(error, error_len, verbose, date, f, NULL);
+				status = output_entities(error, error_len, verbose, date, f, NULL);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_CANOPY_STRATUM:
-				status = output_stratum(error, error_len, verbose, date, f, NULL);
+				status = output_entities(error, error_len, verbose, date, f, NULL);
 				if (!status) return false;
 				break;
 			default:
@@ -1048,30 +1278,25 @@ bool output_filter_output_monthly(char * const error, size_t error_len, bool ver
 	char *local_error;
 	bool status = true;
 
-	PointerSet *acc_hillslope_obj_to_reset = NULL;
-	PointerSet *acc_zone_obj_to_reset = NULL;
-	PointerSet *acc_patch_obj_to_reset = NULL;
-	PointerSet *acc_stratum_obj_to_reset = NULL;
-
 	for (OutputFilter const * f = filters; f != NULL; f = f->next) {
 		if (f->timestep == TIMESTEP_MONTHLY) {
 			switch (f->type) {
 			case OUTPUT_FILTER_BASIN:
 				status = output_basin(error, error_len, verbose, date, f,
-						&acc_hillslope_obj_to_reset, &acc_zone_obj_to_reset,
-						&acc_patch_obj_to_reset, &acc_stratum_obj_to_reset);
+						&monthly_accum_resets.hillslope, &monthly_accum_resets.zone,
+						&monthly_accum_resets.patch, &monthly_accum_resets.stratum);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_ZONE:
-				status = output_zone(error, error_len, verbose, date, f, &acc_zone_obj_to_reset);
+				status = output_entities(error, error_len, verbose, date, f, &monthly_accum_resets.zone);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_PATCH:
-				status = output_patch(error, error_len, verbose, date, f, &acc_patch_obj_to_reset);
+				status = output_entities(error, error_len, verbose, date, f, &monthly_accum_resets.patch);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_CANOPY_STRATUM:
-				status = output_stratum(error, error_len, verbose, date, f, &acc_stratum_obj_to_reset);
+				status = output_entities(error, error_len, verbose, date, f, &monthly_accum_resets.stratum);
 				if (!status) return false;
 				break;
 			default:
@@ -1083,10 +1308,7 @@ bool output_filter_output_monthly(char * const error, size_t error_len, bool ver
 	}
 
 	// Reset monthly accumulators as necessary
-	reset_accumulator_hillslope(&acc_hillslope_obj_to_reset);
-	reset_accumulator_zone(&acc_zone_obj_to_reset);
-	reset_accumulator_patch(&acc_patch_obj_to_reset);
-	reset_accumulator_stratum(&acc_stratum_obj_to_reset);
+	reset_accumulator_lists(&monthly_accum_resets);
 
 	if (verbose) fprintf(stderr, "output_filter_output_monthly(): END\n");
 
@@ -1100,30 +1322,25 @@ bool output_filter_output_yearly(char * const error, size_t error_len, bool verb
 	char *local_error;
 	bool status = true;
 
-	PointerSet *acc_hillslope_obj_to_reset = NULL;
-	PointerSet *acc_zone_obj_to_reset = NULL;
-	PointerSet *acc_patch_obj_to_reset = NULL;
-	PointerSet *acc_stratum_obj_to_reset = NULL;
-
 	for (OutputFilter const * f = filters; f != NULL; f = f->next) {
 		if (f->timestep == TIMESTEP_YEARLY) {
 			switch (f->type) {
 			case OUTPUT_FILTER_BASIN:
 				status = output_basin(error, error_len, verbose, date, f,
-						&acc_hillslope_obj_to_reset, &acc_zone_obj_to_reset,
-						&acc_patch_obj_to_reset, &acc_stratum_obj_to_reset);
+						&yearly_accum_resets.hillslope, &yearly_accum_resets.zone,
+						&yearly_accum_resets.patch, &yearly_accum_resets.stratum);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_ZONE:
-				status = output_zone(error, error_len, verbose, date, f, &acc_zone_obj_to_reset);
+				status = output_entities(error, error_len, verbose, date, f, &yearly_accum_resets.zone);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_PATCH:
-				status = output_patch(error, error_len, verbose, date, f, &acc_patch_obj_to_reset);
+				status = output_entities(error, error_len, verbose, date, f, &yearly_accum_resets.patch);
 				if (!status) return false;
 				break;
 			case OUTPUT_FILTER_CANOPY_STRATUM:
-				status = output_stratum(error, error_len, verbose, date, f, &acc_stratum_obj_to_reset);
+				status = output_entities(error, error_len, verbose, date, f, &yearly_accum_resets.stratum);
 				if (!status) return false;
 				break;
 			default:
@@ -1135,10 +1352,7 @@ bool output_filter_output_yearly(char * const error, size_t error_len, bool verb
 	}
 
 	// Reset yearly accumulators as necessary
-	reset_accumulator_hillslope(&acc_hillslope_obj_to_reset);
-	reset_accumulator_zone(&acc_zone_obj_to_reset);
-	reset_accumulator_patch(&acc_patch_obj_to_reset);
-	reset_accumulator_stratum(&acc_stratum_obj_to_reset);
+	reset_accumulator_lists(&yearly_accum_resets);
 
 	if (verbose) fprintf(stderr, "output_filter_output_yearly(): END\n");
 
@@ -51,6 +51,9 @@ OutputFilter *curr_filter = NULL;
 %token STRATUM_TOK
 %token IDS
 %token VARS
+%token GROUP_BY
+%token GROUP_MAP
+%token AGGREGATE
 /* output format components */
 %token <string> PATH_SPEC
 %token <string> FILENAME_SPEC
@@ -94,6 +97,9 @@ filter_list:
   | filter_list stratum EOL {}
   | filter_list ids {}
   | filter_list variables {}
+  | filter_list group_by EOL {}
+  | filter_list group_map EOL {}
+  | filter_list aggregate EOL {}
   ;
 
 filter: FILTER {
@@ -525,6 +531,74 @@ id_spec: | NUMBER {
 	| id_spec EOL id_spec { }
 	;
 
+group_by: GROUP_BY IDENTIFIER {
+		if (!in_zone && !in_patch && !in_stratum) {
+			syntax_error = true;
+			yyerror("group_by definition must be nested within zone, patch, or stratum definition");
+		} else {
+			if (strcmp($2, OUTPUT_GROUP_BY_BASIN) == 0) {
+				curr_filter->group_by = GROUP_BY_BASIN;
+			} else if (strcmp($2, OUTPUT_GROUP_BY_HILLSLOPE) == 0) {
+				curr_filter->group_by = GROUP_BY_HILLSLOPE;
+			} else if (strcmp($2, OUTPUT_GROUP_BY_ZONE) == 0) {
+				curr_filter->group_by = GROUP_BY_ZONE;
+			} else if (strcmp($2, OUTPUT_GROUP_BY_PATCH) == 0) {
+				curr_filter->group_by = GROUP_BY_PATCH;
+			} else if (strcmp($2, OUTPUT_GROUP_BY_FAMILY) == 0) {
+				curr_filter->group_by = GROUP_BY_FAMILY;
+			} else if (strcmp($2, OUTPUT_GROUP_BY_MAP) == 0) {
+				curr_filter->group_by = GROUP_BY_MAP;
+			} else {
+				syntax_error = true;
+				yyerror("unknown group_by definition");
+			}
+			if (verbose_output) fprintf(stderr, "\t\tGROUP BY: %s\n", $2);
+		}
+	}
+	;
+
+group_map: GROUP_MAP PATH_SPEC {
+		if (!in_zone && !in_patch && !in_stratum) {
+			syntax_error = true;
+			yyerror("group_map definition must be nested within zone, patch, or stratum definition");
+		} else {
+			curr_filter->group_map = strip($2);
+			if (verbose_output) fprintf(stderr, "\t\tGROUP MAP IS: %s\n", $2);
+		}
+	}
+	| GROUP_MAP FILENAME_SPEC {
+		if (!in_zone && !in_patch && !in_stratum) {
+			syntax_error = true;
+			yyerror("group_map definition must be nested within zone, patch, or stratum definition");
+		} else {
+			curr_filter->group_map = strip($2);
+			if (verbose_output) fprintf(stderr, "\t\tGROUP MAP IS: %s\n", $2);
+		}
+	}
+	;
+
+aggregate: AGGREGATE IDENTIFIER {
+		if (!in_zone && !in_patch && !in_stratum) {
+			syntax_error = true;
+			yyerror("aggregate definition must be nested within zone, patch, or stratum definition");
+		} else {
+			if (strcmp($2, OUTPUT_AGGREGATE_MEAN) == 0) {
+				curr_filter->aggregate = AGGREGATE_MEAN;
+			} else if (strcmp($2, OUTPUT_AGGREGATE_SUM) == 0) {
+				curr_filter->aggregate = AGGREGATE_SUM;
+			} else if (strcmp($2, OUTPUT_AGGREGATE_MIN) == 0) {
+				curr_filter->aggregate = AGGREGATE_MIN;
+			} else if (strcmp($2, OUTPUT_AGGREGATE_MAX) == 0) {
+				curr_filter->aggregate = AGGREGATE_MAX;
+			} else {
+				syntax_error = true;
+				yyerror("unknown aggregate definition");
+			}
+			if (verbose_output) fprintf(stderr, "\t\tAGGREGATE: %s\n", $2);
+		}
+	}
+	;
+
 variables: VARS variable_spec {
 		if (!in_basin && !in_zone && !in_patch && !in_stratum) {
 			syntax_error = true;
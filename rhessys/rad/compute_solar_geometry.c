@@ -0,0 +1,195 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		compute_solar_geometry				*/
+/*								*/
+/*	NAME							*/
+/*	compute_solar_geometry.c - sun position terms that	*/
+/*		depend only on date, hour and latitude		*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	double	compute_declination( int year_day )		*/
+/*								*/
+/*	double	compute_daylength( double latitude,		*/
+/*			double cos_declin, double sin_declin)	*/
+/*								*/
+/*	void	compute_basin_solar_geometry(			*/
+/*			double cos_declin, double sin_declin,	*/
+/*			double cos_latitude, double sin_latitude,*/
+/*			int hour,				*/
+/*			struct basin_hourly_object *geometry)	*/
+/*								*/
+/*	void	compute_zone_solar_coefs(			*/
+/*			struct zone_object *zone,		*/
+/*			struct basin_object *basin)		*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Formerly computed inline in world_daily_I, basin_daily_I*/
+/*	and basin_hourly.  They are shared with			*/
+/*	construct_solar_table so that table entries are		*/
+/*	bit-for-bit what the inline code produced.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+#include "rhessys.h"
+#include "phys_constants.h"
+
+/*--------------------------------------------------------------*/
+/*  Compute the solar declination (radians).                    */
+/*                                                              */
+/*  Based on a numerical approximation to the equation:         */
+/*                                                              */
+/*      declination = 23.45 sin(0.986 Nm) degrees               */
+/*                                                              */
+/*      where Nm = number of days since March 21 assuming       */
+/*                  day and night are of equal length.          */
+/*                                                              */
+/*  Equation from Linacre, Climate Data and Resources, p. 148.  */
+/*  Approximation taken from C version of rhessys.              */
+/*--------------------------------------------------------------*/
+double	compute_declination( int year_day )
+{
+	int index;
+	static const double declination_array[47] = { 0.0, -23.0, -22.0, -21.0, -19.0,
+		-17.0, -15.0, -12.0, -9.0, -6.0, -3.0, 0.0, 3.0,
+		6.0, 9.0, 12.0, 14.0, 17.0, 19.0, 21.0, 22.0,
+		23.0, 23.5, 23.5, 23.0, 21.5, 20.0, 18.0, 16.0, 14.0,
+		12.0, 9.0, 6.0, 3.0, 0.0, -3.0, -6.0, -9.0, -12.0,
+		-15.0, -17.0, -19.0, -21.0, -22.0, -23.0, -23.5,
+		-23.5 };
+
+	index = (int) ( 1.0 + ((double)year_day)/8);
+	return(declination_array[index]*DtoR);
+} /*end compute_declination*/
+
+/*--------------------------------------------------------------*/
+/*	Daylength (seconds)											*/
+/*	Now using GBGC computation taken from Jones,		*/
+/*	Plans and Microclimate.					*/
+/*	Note that I am assuming this is the time when the solar		*/
+/*		zenith angle has a cosine >0.   						*/
+/*	Note that we may want to consider daylengths with both		*/
+/*		diffuse and direct irradiance and only diffuse irradianc*/
+/*		This can be computed using the zone level horizons.		*/
+/*--------------------------------------------------------------*/
+double	compute_daylength(
+						  double latitude,
+						  double cos_declin,
+						  double sin_declin)
+{
+	double	cosegeom;
+	double	sinegeom;
+	double	coshss;
+	double	hss;
+
+	cosegeom = cos(latitude*DtoR) * cos_declin;
+	sinegeom = sin(latitude*DtoR) * sin_declin;
+	coshss = -(sinegeom) / cosegeom;
+	if (coshss < -1.0) coshss = -1.0; /* 24-hr daylight */
+	if (coshss > 1.0) coshss = 1.0;   /* 0-hr daylight */
+	hss = acos(coshss);  /* hour angle at sunset (radians) */
+	return(2.0 * hss * SECPERRAD);
+} /*end compute_daylength*/
+
+/*--------------------------------------------------------------*/
+/*	Figure out solar geometry and air  mass number for one	*/
+/*	hour.  Note that solar geometry except for cos_sza may	*/
+/*	be garbage if cos_sza < 0 (no daylight).		*/
+/*--------------------------------------------------------------*/
+void	compute_basin_solar_geometry(
+									 double cos_declin,
+									 double sin_declin,
+									 double cos_latitude,
+									 double sin_latitude,
+									 int hour,
+									 struct basin_hourly_object *geometry)
+{
+	int	ML;
+	static const double	air_mass_array[22]  =
+	{0.0, 2.90,3.05,3.21,3.39, 3.69, 3.82, 4.07, 4.37, 4.72, 5.12,
+	5.60,6.18,6.88,7.77,8.90,10.39,12.44,15.36,19.79,26.96,30.00};
+
+	/*--------------------------------------------------------------*/
+	/*  Hour angle (in radians)                                 */
+	/*                                                              */
+	/*  Eq. 8, Appendix D, "MTCLIM"                             */
+	/*                                                             */
+	/*  hour_angle =  (hour*3600-43200)*0.0041667*DtoR;         */
+	/*                                                              */
+	/*  If I understand the equation properly it states that    */
+	/*  that at noon (43200 seconds in to the day) the hour     */
+	/*  angle is zero (the sun is at zenith).                   */
+	/*  Although the solar noon changes with date the maximum   */
+	/*  deviation is 16 minutes so we ignore it for now.        */
+	/*  e.g. Table A7.1 Appendix &, Jones, "Plants and          */
+	/*                                  Microclimate."              */
+	/*--------------------------------------------------------------*/
+	geometry[0].hour_angle
+		= (hour*3600-43200)*0.0041667*DtoR;
+	geometry[0].cos_hour_angle = cos(geometry[0].hour_angle);
+	geometry[0].sin_hour_angle = sin(geometry[0].hour_angle);
+	/*--------------------------------------------------------------*/
+	/*  Cosine of Solar Zenith Angle (no units)                 */
+	/*                                                             */
+	/*  Eq. 11, Appendix D, "MTCLIM"                            */
+	/*--------------------------------------------------------------*/
+	geometry[0].cos_sza = cos_declin
+		* cos_latitude * geometry[0].cos_hour_angle
+		+ sin_declin *	sin_latitude;
+	/*--------------------------------------------------------------*/
+	/*	We only bother to compute solar geometry if the sun is up 	*/
+	/*--------------------------------------------------------------*/
+	if ( geometry[0].cos_sza > 0 ){
+		/*--------------------------------------------------------------*/
+		/*		Optical Air Mass (no units)                             */
+		/*                                                              */
+		/* 		Eq. 6., Appendix D "MTCLIM"                             */
+		/*		Following Eq 6 we adjust based on C code of Rhessys 	*/
+		/*			which did not match Appendix D of "MTCLIM"			*/
+		/*--------------------------------------------------------------*/
+		geometry[0].optical_air_mass
+			= 1.0	/(geometry[0].cos_sza + 1.0e-7);
+		if ( geometry[0].optical_air_mass > 2.9 ) {
+			ML = ( (int) (acos(geometry[0].cos_sza)/0.0174533)) - 69;
+			if ( ML < 1 ) ML = 1;
+			if ( ML > 21 ) ML = 21;
+			geometry[0].optical_air_mass = air_mass_array[ML];
+		}
+		/*--------------------------------------------------------------*/
+		/*		Precompute 	some angle formulae							*/
+		/*--------------------------------------------------------------*/
+		geometry[0].cos_declin_cos_hourangle
+			= cos_declin * geometry[0].cos_hour_angle;
+		geometry[0].cos_declin_sin_hourangle
+			= cos_declin * geometry[0].sin_hour_angle;
+	} /*end if*/
+	return;
+} /*end compute_basin_solar_geometry*/
+
+/*--------------------------------------------------------------*/
+/*	Zone terms of the cosine of beam slope angle (Eq. 8	*/
+/*	Appendix D of "MTCLIM") and of the diffuse horizon view	*/
+/*	factor.  These depend only on zone slope and aspect and	*/
+/*	the basin latitude, so zone_hourly recomputes them only	*/
+/*	when one of those changes (solar_coefs_valid is cleared	*/
+/*	by construct_solar_table and input_new_zone).		*/
+/*--------------------------------------------------------------*/
+void	compute_zone_solar_coefs(
+								 struct zone_object *zone,
+								 struct basin_object *basin)
+{
+	zone[0].beam_slope_coef[0] = -1 * zone[0].sin_slope * zone[0].sin_aspect;
+	zone[0].beam_slope_coef[1] = ( -1 * zone[0].cos_aspect * zone[0].sin_slope
+		* basin[0].sin_latitude + zone[0].cos_slope
+		* basin[0].cos_latitude);
+	zone[0].beam_slope_coef[2] = ( zone[0].cos_aspect * zone[0].sin_slope
+		* basin[0].cos_latitude + zone[0].cos_slope
+		* basin[0].sin_latitude );
+	zone[0].diffuse_view_factor = pow(cos(zone[0].slope/2.0),2.0);
+	zone[0].solar_coefs_valid = 1;
+	return;
+} /*end compute_zone_solar_coefs*/
@@ -24,9 +24,21 @@
 /*--------------------------------------------------------------*/
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "rhessys.h"
 
-// test comment
+/*--------------------------------------------------------------*/
+/* Per-row partial sums of watershed cells, used to fill the	*/
+/* buffer with mean values.  Rows are summed in order after the	*/
+/* parallel sweep so the means do not depend on thread count.	*/
+/*--------------------------------------------------------------*/
+struct fire_buffer_sums
+{
+	double denom;
+	double fuel_veg, fuel_litter, fuel_moist, soil_moist, relative_humidity, wind_direction,
+		wind, temp, et, pet, understory_et, understory_pet;
+};
+
 void execute_firespread_event(
 									 struct	world_object *world,
 									 struct	command_line_object	*command_line,
@@ -51,12 +63,11 @@ void execute_firespread_event(
 	/*--------------------------------------------------------------*/
 	struct fire_object **fire_grid;
 	struct patch_fire_object **patch_fire_grid;
-	struct patch_object *patch;
+	struct fire_buffer_sums *row_sums;
 //	struct node_fire_wui_dist *tmp_node;
-	int i,j,p,c,layer;
-	double pspread;
+	int i;
 	double mean_fuel_veg=0,mean_fuel_litter=0,mean_soil_moist=0,mean_fuel_moist=0,mean_relative_humidity=0,
-		mean_wind_direction=0,mean_wind=0,mean_z=0,mean_temp=0,mean_et=0,mean_pet=0,mean_understory_et=0,mean_understory_pet=0;
+		mean_wind_direction=0,mean_wind=0,mean_temp=0,mean_et=0,mean_pet=0,mean_understory_et=0,mean_understory_pet=0;
 	double denom_for_mean=0;
 
 	patch_fire_grid=world[0].patch_fire_grid;
@@ -73,8 +84,14 @@ void execute_firespread_event(
 	/* first reset the values				*/
 	/*--------------------------------------------------------------*/
 	printf("In WMFire\n");
-	for  (i=0; i< world[0].num_fire_grid_row; i++) {
-  	  for (j=0; j < world[0].num_fire_grid_col; j++) {
+	row_sums = (struct fire_buffer_sums *) calloc(world[0].num_fire_grid_row + 1, sizeof(struct fire_buffer_sums));
+	// cells are independent, so rows are swept in parallel; each row keeps its own buffer sums
+	#pragma omp parallel for schedule(dynamic)
+	for  (int i=0; i< world[0].num_fire_grid_row; i++) {
+	  struct fire_buffer_sums *sums = &(row_sums[i]);
+  	  for (int j=0; j < world[0].num_fire_grid_col; j++) {
+		struct patch_object *patch;
+		int p, c, layer;
 		  world[0].fire_grid[i][j].fire_size=0; // reset grid to no fire
 		if(world[0].patch_fire_grid[i][j].occupied_area==0)
 		{
@@ -208,19 +225,19 @@ void execute_firespread_event(
 		}
 		if(world[0].patch_fire_grid[i][j].occupied_area>0&&world[0].defaults[0].fire[0].fire_in_buffer==1) // if allowing fire into the buffer (on raster grid outside of watershed boundaries), then fill with mean field values within watershed boundary
 		{ // this loop fills sums to calculate the mean value across watershed
-			denom_for_mean+=1;
-			mean_fuel_veg+=world[0].fire_grid[i][j].fuel_veg; // this should work to initialize the grid, so if none of the patches overlap a grid point the fuel is zero and fire doesn't spread
-			mean_fuel_litter+=world[0].fire_grid[i][j].fuel_litter;
-			mean_fuel_moist+=world[0].fire_grid[i][j].fuel_moist;
-			mean_soil_moist+=world[0].fire_grid[i][j].soil_moist;
-			mean_relative_humidity+=world[0].fire_grid[i][j].relative_humidity;
-			mean_wind_direction+=world[0].fire_grid[i][j].wind_direction;
-			mean_wind+=world[0].fire_grid[i][j].wind;
-			mean_temp+=world[0].fire_grid[i][j].temp;
-			mean_et+=world[0].fire_grid[i][j].et;
-			mean_pet+=world[0].fire_grid[i][j].pet;
-			mean_understory_et+=world[0].fire_grid[i][j].understory_et;
-			mean_understory_pet+=world[0].fire_grid[i][j].understory_pet;
+			sums[0].denom+=1;
+			sums[0].fuel_veg+=world[0].fire_grid[i][j].fuel_veg; // this should work to initialize the grid, so if none of the patches overlap a grid point the fuel is zero and fire doesn't spread
+			sums[0].fuel_litter+=world[0].fire_grid[i][j].fuel_litter;
+			sums[0].fuel_moist+=world[0].fire_grid[i][j].fuel_moist;
+			sums[0].soil_moist+=world[0].fire_grid[i][j].soil_moist;
+			sums[0].relative_humidity+=world[0].fire_grid[i][j].relative_humidity;
+			sums[0].wind_direction+=world[0].fire_grid[i][j].wind_direction;
+			sums[0].wind+=world[0].fire_grid[i][j].wind;
+			sums[0].temp+=world[0].fire_grid[i][j].temp;
+			sums[0].et+=world[0].fire_grid[i][j].et;
+			sums[0].pet+=world[0].fire_grid[i][j].pet;
+			sums[0].understory_et+=world[0].fire_grid[i][j].understory_et;
+			sums[0].understory_pet+=world[0].fire_grid[i][j].understory_pet;
 		//	printf("et: %f  pet: %f  ",world[0].fire_grid[i][j].et,world[0].fire_grid[i][j].pet);
 		}
 
@@ -232,6 +249,22 @@ void execute_firespread_event(
 
 	}
 	}
+	for (i=0; i< world[0].num_fire_grid_row; i++) {
+		denom_for_mean+=row_sums[i].denom;
+		mean_fuel_veg+=row_sums[i].fuel_veg;
+		mean_fuel_litter+=row_sums[i].fuel_litter;
+		mean_fuel_moist+=row_sums[i].fuel_moist;
+		mean_soil_moist+=row_sums[i].soil_moist;
+		mean_relative_humidity+=row_sums[i].relative_humidity;
+		mean_wind_direction+=row_sums[i].wind_direction;
+		mean_wind+=row_sums[i].wind;
+		mean_temp+=row_sums[i].temp;
+		mean_et+=row_sums[i].et;
+		mean_pet+=row_sums[i].pet;
+		mean_understory_et+=row_sums[i].understory_et;
+		mean_understory_pet+=row_sums[i].understory_pet;
+	}
+	free(row_sums);
 //	printf("denom: %lf\t",denom_for_mean);
 	if(denom_for_mean>0&&world[0].defaults[0].fire[0].fire_in_buffer==1) // so here we calculate the mean value
 	{
@@ -252,8 +285,9 @@ void execute_firespread_event(
 
 	//	printf("mean pet, mean et: %lf\t%lf\n",mean_pet,mean_et);
 	//	printf("mean wind: %lf, mean direction %lf \n",mean_wind,mean_wind_direction);
-		for  (i=0; i< world[0].num_fire_grid_row; i++) {
-		  for (j=0; j < world[0].num_fire_grid_col; j++) {
+		#pragma omp parallel for
+		for  (int i=0; i< world[0].num_fire_grid_row; i++) {
+		  for (int j=0; j < world[0].num_fire_grid_col; j++) {
 			  if(world[0].patch_fire_grid[i][j].occupied_area==0) // and here we fill in the buffer
 			  {
 
@@ -288,10 +322,16 @@ void execute_firespread_event(
 	/*--------------------------------------------------------------*/
 
 	// if(world[0].fire_grid[0][0].fire_size>0) // only do this if there was a fire
-	for  (i=0; i< world[0].num_fire_grid_row; i++) {
-  		for (j=0; j < world[0].num_fire_grid_col; j++) {
-			for (p=0; p < patch_fire_grid[i][j].num_patches; ++p) {
-				patch = world[0].patch_fire_grid[i][j].patches[p];
+	// walk the grid per patch (patch_fire_cells is the inverse of patch_fire_grid) so that
+	// patches can be updated in parallel; each patch still sees its cells in row-major order
+	#pragma omp parallel for schedule(dynamic)
+	for (int n=0; n < world[0].patch_fire_cells[0].num_patches; n++) {
+			struct patch_object *patch = world[0].patch_fire_cells[0].patches[n];
+			double pspread;
+			for (int e=world[0].patch_fire_cells[0].cell_start[n]; e < world[0].patch_fire_cells[0].cell_start[n+1]; e++) {
+				int i = world[0].patch_fire_cells[0].cells[e] / world[0].num_fire_grid_col;
+				int j = world[0].patch_fire_cells[0].cells[e] % world[0].num_fire_grid_col;
+				int p = world[0].patch_fire_cells[0].slots[e];
 
 				patch[0].burn = world[0].fire_grid[i][j].burn * world[0].patch_fire_grid[i][j].prop_grid_in_patch[p];
 				pspread = world[0].fire_grid[i][j].burn * world[0].patch_fire_grid[i][j].prop_grid_in_patch[p];
@@ -321,7 +361,6 @@ void execute_firespread_event(
 				}
 
 			}
-		}
 	}
 	return;
 } /*end execute_firespread_event.c*/
@@ -103,17 +103,25 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 		struct default_object *,
 		struct basin_object *);	
 	
-	void compute_mean_hillslope_parameters( struct hillslope_object *);
-	struct canopy_strata_object	*find_stratum_in_patch( int, 
-		struct patch_object *);
-	struct patch_object	*find_patch_in_zone( int, 
-		struct zone_object *);
-	struct zone_object	*find_zone_in_hillslope( int, 
-		struct hillslope_object *);
-	struct hillslope_object	*find_hillslope_in_basin( int, 
-		struct basin_object *);
-	struct basin_object	*find_basin( int, 
+	void compute_mean_hillslope_parameters_list( struct hillslope_object **,
+		int);
+	void	*alloc(	size_t, char *, char *);
+	struct world_id_index_object *construct_world_id_index(
 		struct world_object *);
+	struct canopy_strata_object	*find_stratum_in_patch_indexed( int, 
+		struct patch_object *,
+		struct world_id_index_object *);
+	struct patch_object	*find_patch_in_zone_indexed( int, 
+		struct zone_object *,
+		struct world_id_index_object *);
+	struct zone_object	*find_zone_in_hillslope_indexed( int, 
+		struct hillslope_object *,
+		struct world_id_index_object *);
+	struct hillslope_object	*find_hillslope_in_basin_indexed( int, 
+		struct basin_object *,
+		struct world_id_index_object *);
+	struct basin_object	*find_basin_indexed( int, 
+		struct world_id_index_object *);
 	void sort_patch_layers( struct patch_object *, int *);
 	
 	/*--------------------------------------------------------------*/
@@ -131,6 +139,8 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 	struct	zone_object	*zone;
 	struct	hillslope_object	*hillslope;
 	struct	basin_object	*basin;
+	struct	hillslope_object	**redefined_hillslopes;
+	int	num_redefined_hillslopes, num_world_hillslopes;
 	
 	rec = 0;	
 	/*--------------------------------------------------------------*/
@@ -151,6 +161,22 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 
 	printf("\n Redefine using %s", world_input_filename);
 	/*--------------------------------------------------------------*/
+	/*	Objects are looked up through the world ID index.	*/
+	/*--------------------------------------------------------------*/
+	if (world[0].id_index == NULL)
+		world[0].id_index = construct_world_id_index(world);
+	/*--------------------------------------------------------------*/
+	/*	Hillslope means are recomputed in parallel once all	*/
+	/*	redefined objects have been read.			*/
+	/*--------------------------------------------------------------*/
+	num_world_hillslopes = 0;
+	for (b=0; b < world[0].num_basin_files; b++)
+		num_world_hillslopes += world[0].basins[b][0].num_hillslopes;
+	redefined_hillslopes = (struct hillslope_object **) alloc(
+		(num_world_hillslopes + 1) * sizeof(struct hillslope_object *),
+		"redefined_hillslopes", "execute_redefine_world_thin_event");
+	num_redefined_hillslopes = 0;
+	/*--------------------------------------------------------------*/
 	/*	Read in the world ID.							*/
 	/*--------------------------------------------------------------*/
 	fscanf(world_input_file,"%d",&world_ID);
@@ -166,8 +192,8 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 	for (b=0; b < num_basin; b++ ){
 		fscanf(world_input_file,"%d",&basin_ID);
 		read_record(world_input_file, record);
-		basin = find_basin( basin_ID,
-			world);
+		basin = find_basin_indexed( basin_ID,
+			world[0].id_index);
 		if (basin != NULL) {
 			input_new_basin_mult(command_line, world_input_file,
 							world[0].num_base_stations,
@@ -179,8 +205,8 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 		for ( h = 0; h < num_hill; h++){
 			fscanf(world_input_file,"%d",&hill_ID);
 			read_record(world_input_file, record);
-			hillslope = find_hillslope_in_basin( hill_ID,
-				basin);
+			hillslope = find_hillslope_in_basin_indexed( hill_ID,
+				basin, world[0].id_index);
 			if (hillslope != NULL) {
 				input_new_hillslope_mult(command_line, world_input_file,
 									world[0].num_base_stations,
@@ -192,7 +218,7 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 				for ( z=0; z < num_zone; z++) {
 					fscanf(world_input_file,"%d",&zone_ID);
 					read_record(world_input_file, record);
-					zone = find_zone_in_hillslope(zone_ID,hillslope);
+					zone = find_zone_in_hillslope_indexed(zone_ID,hillslope,world[0].id_index);
 					if (zone != NULL) {
 						input_new_zone_mult(command_line, world_input_file,
 								   world[0].num_base_stations,
@@ -204,7 +230,7 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 						for (p=0; p < num_patch; p++) {
 							fscanf(world_input_file,"%d",&patch_ID);
 							read_record(world_input_file, record);
-							patch = find_patch_in_zone(patch_ID, zone);
+							patch = find_patch_in_zone_indexed(patch_ID, zone, world[0].id_index);
 							if (patch != NULL) {
 								input_new_patch_mult(command_line, world_input_file,
 										world[0].num_base_stations,
@@ -216,7 +242,7 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 								for (c=0; c < num_stratum; c++) {
 									fscanf(world_input_file,"%d",&stratum_ID);
 									read_record(world_input_file, record);
-									stratum = find_stratum_in_patch(stratum_ID,patch);
+									stratum = find_stratum_in_patch_indexed(stratum_ID,patch,world[0].id_index);
 									if (stratum != NULL) {
 										input_new_strata_thin(command_line, world_input_file,
 											 world[0].num_base_stations,
@@ -299,7 +325,17 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 
 					} /* end zone loop */
 				
-				compute_mean_hillslope_parameters(hillslope);
+				if (num_redefined_hillslopes == num_world_hillslopes) {
+					num_world_hillslopes *= 2;
+					redefined_hillslopes = (struct hillslope_object **) realloc(
+						redefined_hillslopes,
+						(num_world_hillslopes + 1) * sizeof(struct hillslope_object *));
+					if (redefined_hillslopes == NULL) {
+						fprintf(stderr,"FATAL ERROR: out of memory in execute_redefine_world_thin_event\n");
+						exit(EXIT_FAILURE);
+					}
+				}
+				redefined_hillslopes[num_redefined_hillslopes++] = hillslope;
 				
 			} /* end hillslope if */
 
@@ -359,8 +395,8 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 			for ( h = 0; h < num_hill; h++){
 				fscanf(world_input_file,"%d",&hill_ID);
 				read_record(world_input_file, record);
-				hillslope = find_hillslope_in_basin( hill_ID,
-													basin);				
+				hillslope = find_hillslope_in_basin_indexed( hill_ID,
+													basin, world[0].id_index);				
 				skip_hillslope(command_line, world_input_file,
 							   world[0].num_base_stations,
 							   world[0].base_stations,
@@ -405,6 +441,9 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 		
 		} /*end basin loop */
 	
+	compute_mean_hillslope_parameters_list(redefined_hillslopes, num_redefined_hillslopes);
+	free(redefined_hillslopes);
+
 	/*--------------------------------------------------------------*/
 	/*	Close the world_input_file.										*/
 	/*--------------------------------------------------------------*/
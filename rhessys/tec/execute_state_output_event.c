@@ -58,7 +58,14 @@ void	execute_state_output_event(
 		current_date.day,
 		current_date.hour);
 
-	strcpy(filename, command_line[0].world_filename);
+	/*--------------------------------------------------------------*/
+	/*	-scenarios workers share the world file, so each names	*/
+	/*	its state files after its own output prefix.		*/
+	/*--------------------------------------------------------------*/
+	if ((command_line[0].scenarios_flag > 0) && (command_line[0].output_prefix != NULL))
+		strcpy(filename, command_line[0].output_prefix);
+	else
+		strcpy(filename, command_line[0].world_filename);
 	strcat(filename, ext);
 	strcat(filename, ".state");
 
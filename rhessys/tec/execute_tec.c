@@ -91,6 +91,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "rhessys.h"
+#include "profile.h"
+#include "alloc_accounting.h"
 
 void	execute_tec(
 					struct	tec_object *tecfile ,
@@ -122,6 +124,16 @@ void	execute_tec(
 		struct tec_entry *,
 		struct date);
 	
+	void	world_hourly_day(
+		struct world_object *,
+		struct command_line_object *,
+		struct tec_entry *,
+		struct date);
+	
+	int		world_daily_only(
+		struct world_object *,
+		struct command_line_object *);
+	
 	void	world_daily_F(
 		long,
 		struct world_object *,
@@ -194,12 +206,14 @@ void	execute_tec(
 	/*--------------------------------------------------------------*/
 	int check;
 	int 	reset_flag;	
+	int	daily_only_flag;
 	long	day;
 	long	hour;
 	long	month;
 	long	year;
 	struct	date	current_date;
 	struct	date	next_date;
+	struct	date	day_end;
 	struct	tec_entry	*event;
 	
 	/*--------------------------------------------------------------*/
@@ -226,7 +240,15 @@ void	execute_tec(
 		/*--------------------------------------------------------------*/
 		/*		Perform the tec event.									*/
 		/*--------------------------------------------------------------*/
+		PROFILE_BEGIN(PROFILE_TEC_EVENT);
 		handle_event(event,command_line,current_date,world);
+		PROFILE_END(PROFILE_TEC_EVENT);
+		/*--------------------------------------------------------------*/
+		/*		Events can switch on hourly output or redefine zones	*/
+		/*		onto other base stations, so recheck whether days can	*/
+		/*		be simulated in one pass (world_hourly_day).			*/
+		/*--------------------------------------------------------------*/
+		daily_only_flag = world_daily_only(world, command_line);
 		/*--------------------------------------------------------------*/
 		/*		read the next tec file entry.							*/
 		/*		if we are not at the end of the tec file.				*/
@@ -277,45 +299,72 @@ void	execute_tec(
                     // current_date.year,current_date.month,current_date.day);
             //fflush(stdout);
 			if ( current_date.hour == 1 ){
+                PROFILE_BEGIN(PROFILE_WORLD_DAILY_I);
                 world_daily_I(
 					day,
 					world,
 					command_line,
 					event,
                     current_date);
+                PROFILE_END(PROFILE_WORLD_DAILY_I);
 			} /*end if*/
 			/*--------------------------------------------------------------*/
-			/*          Do hourly stuff for the day.                        */
-			/*--------------------------------------------------------------*/
-            world_hourly( world,
-				command_line,
-				event,
-                current_date);
-			
-			/*--------------------------------------------------------------*/
-			/*			Perform any requested hourly output					*/
+			/*			If nothing is hourly and the next event is not		*/
+			/*			until tomorrow, run the whole day's hours in one	*/
+			/*			pass (world_hourly_day).							*/
 			/*--------------------------------------------------------------*/
-			if (command_line[0].output_flags.hourly == 1){
-				execute_hourly_output_event(
-							  world,
-							  command_line,
-							  current_date,
-							  outfile);
+			day_end = current_date;
+			day_end.hour = 24;
+			if ( (daily_only_flag == 1) && (current_date.hour == 1)
+				&& cal_date_lt(day_end, event[0].cal_date) ){
+				PROFILE_BEGIN(PROFILE_WORLD_HOURLY);
+				world_hourly_day( world,
+					command_line,
+					event,
+					current_date);
+				PROFILE_END(PROFILE_WORLD_HOURLY);
+				current_date.hour = 25;
 			}
+			else {
+				/*--------------------------------------------------------------*/
+				/*          Do hourly stuff for the day.                        */
+				/*--------------------------------------------------------------*/
+				PROFILE_BEGIN(PROFILE_WORLD_HOURLY);
+				world_hourly( world,
+					command_line,
+					event,
+					current_date);
+				PROFILE_END(PROFILE_WORLD_HOURLY);
+
+				/*--------------------------------------------------------------*/
+				/*			Perform any requested hourly output					*/
+				/*--------------------------------------------------------------*/
+				if (command_line[0].output_flags.hourly == 1){
+					PROFILE_BEGIN(PROFILE_OUTPUT_HOURLY);
+					execute_hourly_output_event(
+								  world,
+								  command_line,
+								  current_date,
+								  outfile);
+					PROFILE_END(PROFILE_OUTPUT_HOURLY);
+				}
 
-			if(command_line[0].output_flags.hourly_growth ==1 &&
-					(command_line[0].grow_flag > 0) ){
-				  execute_hourly_growth_output_event(
-							      world, 
-							      command_line, 
-							      current_date, 
-							      growth_outfile);
+				if(command_line[0].output_flags.hourly_growth ==1 &&
+						(command_line[0].grow_flag > 0) ){
+					  PROFILE_BEGIN(PROFILE_OUTPUT_HOURLY);
+					  execute_hourly_growth_output_event(
+								      world, 
+								      command_line, 
+								      current_date, 
+								      growth_outfile);
+					  PROFILE_END(PROFILE_OUTPUT_HOURLY);
 				  
-				};
-			/*--------------------------------------------------------------*/
-			/*			Increment to the next hour.							*/
-			/*--------------------------------------------------------------*/
-			current_date.hour++;
+					};
+				/*--------------------------------------------------------------*/
+				/*			Increment to the next hour.							*/
+				/*--------------------------------------------------------------*/
+				current_date.hour++;
+			}
 			/*--------------------------------------------------------------*/
 			/*			Check if this is a day end.							*/
 			/*--------------------------------------------------------------*/
@@ -323,36 +372,44 @@ void	execute_tec(
 				/*--------------------------------------------------------------*/
 				/*			Simulate the world for the end of this day e		*/
 				/*--------------------------------------------------------------*/
+                PROFILE_BEGIN(PROFILE_WORLD_DAILY_F);
                 world_daily_F(
 					day,
 					world,
 					command_line,
 					event,
                     current_date);
+                PROFILE_END(PROFILE_WORLD_DAILY_F);
 				/*--------------------------------------------------------------*/
 				/*			Perform any requested daily output					*/
 				/*--------------------------------------------------------------*/
 				if ((command_line[0].output_flags.daily_growth == 1) &&
 							(command_line[0].grow_flag > 0) ) {
+						PROFILE_BEGIN(PROFILE_OUTPUT_DAILY);
 						execute_daily_growth_output_event(
 						world,
 						command_line,
 						current_date,
 						growth_outfile);
+						PROFILE_END(PROFILE_OUTPUT_DAILY);
 				}
 				if (command_line[0].output_flags.daily == 1) {
+						PROFILE_BEGIN(PROFILE_OUTPUT_DAILY);
 						execute_daily_output_event(
 						world,
 						command_line,
 						current_date,
 						outfile);
+						PROFILE_END(PROFILE_OUTPUT_DAILY);
                                }
 				/*--------------------------------------------------------------*/
         /*  Output world state in spinup mode if targets met            */
 				/*--------------------------------------------------------------*/
 
 				if((command_line[0].vegspinup_flag > 0) && (world[0].target_status > 0)) {
+		      PROFILE_BEGIN(PROFILE_OUTPUT_STATE);
 		      execute_state_output_event(world, current_date, world[0].end_date,command_line);
+		      PROFILE_END(PROFILE_OUTPUT_STATE);
           printf("\nSpinup completed YEAR %d MONTH %d DAY %d \n", current_date.year,current_date.month,current_date.day);
           exit(0);
         } 
@@ -363,23 +420,34 @@ void	execute_tec(
 				if (command_line[0].output_flags.yearly_growth == 1) {reset_flag=0;}
 				if ((command_line[0].output_flags.yearly == 1) &&
 					(command_line[0].output_yearly_date.month==current_date.month)&&
-					(command_line[0].output_yearly_date.day == current_date.day))
+					(command_line[0].output_yearly_date.day == current_date.day)) {
+							PROFILE_BEGIN(PROFILE_OUTPUT_YEARLY);
 							execute_yearly_output_event(
 							reset_flag,
 							world,
 							command_line,
 							current_date,
 							outfile);
+							PROFILE_END(PROFILE_OUTPUT_YEARLY);
+				}
 
 				if ((command_line[0].output_flags.yearly_growth == 1) &&
 					(command_line[0].output_yearly_date.month==current_date.month)&&
 					(command_line[0].output_yearly_date.day == current_date.day) &&
-					(command_line[0].grow_flag > 0) )
+					(command_line[0].grow_flag > 0) ) {
+					PROFILE_BEGIN(PROFILE_OUTPUT_YEARLY);
 					execute_yearly_growth_output_event(
 					world,
 					command_line,
 					current_date,
 					growth_outfile);
+					PROFILE_END(PROFILE_OUTPUT_YEARLY);
+				}
+				/*--------------------------------------------------------------*/
+				/*				Memory report requested with SIGUSR1			*/
+				/*--------------------------------------------------------------*/
+				if (alloc_accounting_enabled)
+					alloc_accounting_poll();
 				/*--------------------------------------------------------------*/
 				/*				Determine the new calendar date if we add 1 day.*/
 				/*				Do this by first conversting the current cal	*/
@@ -408,21 +476,26 @@ void	execute_tec(
 				/* if fire spread is called - initiate fire spread routine 	*/
 				/*--------------------------------------------------------------*/
 				if (command_line[0].firespread_flag == 1) {
+					PROFILE_BEGIN(PROFILE_FIRE);
 					execute_firespread_event(
 						world,
 						command_line,
 						current_date);
+					PROFILE_END(PROFILE_FIRE);
 				}	
 				
 				/*--------------------------------------------------------------*/
 				/*			Perform any requested monthly output				*/
 				/*--------------------------------------------------------------*/
-				if (command_line[0].output_flags.monthly == 1)
+				if (command_line[0].output_flags.monthly == 1) {
+						PROFILE_BEGIN(PROFILE_OUTPUT_MONTHLY);
 						execute_monthly_output_event(
 						world,
 						command_line,
 						current_date,
 						outfile);
+						PROFILE_END(PROFILE_OUTPUT_MONTHLY);
+				}
 				/*--------------------------------------------------------------*/
 				/*				increment month 								*/
 				/*--------------------------------------------------------------*/
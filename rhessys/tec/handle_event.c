@@ -44,6 +44,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "rhessys.h"
+#include "profile.h"
 
 void	handle_event(
 					 struct	tec_entry	*event,
@@ -164,8 +165,10 @@ void	handle_event(
 		command_line[0].output_flags.hourly_growth = 0;
 	}
 	else if ( !strcmp(event[0].command,"output_current_state") ){
+		PROFILE_BEGIN(PROFILE_OUTPUT_STATE);
 		execute_state_output_event(world, current_date,
 			world[0].end_date,command_line);
+		PROFILE_END(PROFILE_OUTPUT_STATE);
 	}
 	else if ( !strcmp(event[0].command,"redefine_strata") ){
 		execute_redefine_strata_event(world, command_line, current_date);
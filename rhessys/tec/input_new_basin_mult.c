@@ -120,7 +120,8 @@ void input_new_basin_mult(
 	/*--------------------------------------------------------------*/
 	/*  Assign  defaults for this basin                             */
 	/*--------------------------------------------------------------*/
-	if (basin[0].basin_parm_ID > 0) {
+	if ((basin[0].basin_parm_ID > 0) && ((basin[0].defaults[0] == NULL)
+		|| (basin[0].defaults[0][0].ID != basin[0].basin_parm_ID))) {
 		i = 0;
 		while (defaults[0].basin[i].ID != basin[0].basin_parm_ID) {
 			i++;
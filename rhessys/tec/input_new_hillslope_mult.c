@@ -105,7 +105,8 @@ void input_new_hillslope_mult(
 	/*--------------------------------------------------------------*/
 	/*  Assign  defaults for this hillslope                             */
 	/*--------------------------------------------------------------*/
-	if (hillslope[0].hill_parm_ID > 0) {	
+	if ((hillslope[0].hill_parm_ID > 0) && ((hillslope[0].defaults[0] == NULL)
+		|| (hillslope[0].defaults[0][0].ID != hillslope[0].hill_parm_ID))) {	
 		i = 0;
 		while (defaults[0].hillslope[i].ID != hillslope[0].hill_parm_ID) {
 			i++;
@@ -104,7 +104,10 @@
 
 	
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"area","%lf",patch[0].area,1);	
-	if (fabs(ltmp - NULLVAL) >= ONE)  patch[0].area = ltmp;
+	if (fabs(ltmp - NULLVAL) >= ONE) {
+		patch[0].area = ltmp;
+		patch[0].zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		}
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"slope","%lf",patch[0].slope,1);
 	if (fabs(ltmp - NULLVAL) >= ONE)  patch[0].slope = ltmp * DtoR;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"lna","%lf",patch[0].lna,1);	
@@ -232,7 +235,8 @@
 	/*--------------------------------------------------------------*/
 	/*	Assign	defaults for this patch								*/
 	/*--------------------------------------------------------------*/
-	if (patch[0].soil_parm_ID > 0) {
+	if ((patch[0].soil_parm_ID > 0) && ((patch[0].soil_defaults[0] == NULL)
+		|| (patch[0].soil_defaults[0][0].ID != patch[0].soil_parm_ID))) {
 		i = 0;
 		while (defaults[0].soil[i].ID != patch[0].soil_parm_ID) {
 			i++;
@@ -251,7 +255,8 @@
 	patch[0].soil_defaults[0] = &defaults[0].soil[i];
 	}
 
-	if (patch[0].landuse_parm_ID > 0) {
+	if ((patch[0].landuse_parm_ID > 0) && ((patch[0].landuse_defaults[0] == NULL)
+		|| (patch[0].landuse_defaults[0][0].ID != patch[0].landuse_parm_ID))) {
 		i = 0;
 		while (defaults[0].landuse[i].ID != patch[0].landuse_parm_ID) {
 			i++;
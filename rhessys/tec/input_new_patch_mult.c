@@ -99,7 +99,10 @@
 	dtmp  = getIntWorldfile(&paramCnt,&paramPtr,"landuse_parm_ID","%d",patch[0].landuse_parm_ID,1);
 	if (abs(dtmp - NULLVAL) >= ONE)  patch[0].landuse_parm_ID = dtmp;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"area","%lf",1,1);	
-	if (fabs(ltmp - NULLVAL) >= ONE)  patch[0].area = ltmp * patch[0].area;
+	if (fabs(ltmp - NULLVAL) >= ONE) {
+		patch[0].area = ltmp * patch[0].area;
+		patch[0].zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		}
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"slope","%lf",1,1);
 	if (fabs(ltmp - NULLVAL) >= ONE)  patch[0].slope = ltmp * patch[0].slope * DtoR;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"lna","%lf",1,1);	
@@ -220,7 +223,8 @@
 	/*--------------------------------------------------------------*/
 	/*	Assign	defaults for this patch								*/
 	/*--------------------------------------------------------------*/
-	if (patch[0].soil_parm_ID > 0) {
+	if ((patch[0].soil_parm_ID > 0) && ((patch[0].soil_defaults[0] == NULL)
+		|| (patch[0].soil_defaults[0][0].ID != patch[0].soil_parm_ID))) {
 		i = 0;
 		while (defaults[0].soil[i].ID != patch[0].soil_parm_ID) {
 			i++;
@@ -239,7 +243,8 @@
 	patch[0].soil_defaults[0] = &defaults[0].soil[i];
 	}
 
-	if (patch[0].landuse_parm_ID > 0) {
+	if ((patch[0].landuse_parm_ID > 0) && ((patch[0].landuse_defaults[0] == NULL)
+		|| (patch[0].landuse_defaults[0][0].ID != patch[0].landuse_parm_ID))) {
 		i = 0;
 		while (defaults[0].landuse[i].ID != patch[0].landuse_parm_ID) {
 			i++;
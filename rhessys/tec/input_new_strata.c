@@ -126,7 +126,10 @@ void input_new_strata(
 	 if (dtmp > 0)  canopy_strata[0].veg_parm_ID = dtmp;
 
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"cover_fraction","%lf",canopy_strata[0].cover_fraction,1);	
-	  if (fabs(ltmp - NULLVAL) >= ONE) canopy_strata[0].cover_fraction = ltmp;
+	  if (fabs(ltmp - NULLVAL) >= ONE) {
+		canopy_strata[0].cover_fraction = ltmp;
+		patch[0].zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		}
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"gap_fraction","%lf",canopy_strata[0].gap_fraction,1);
 	  if (fabs(ltmp - NULLVAL) >= ONE) canopy_strata[0].gap_fraction = ltmp;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"rootzone.depth","%lf",canopy_strata[0].rootzone.depth,1);
@@ -247,7 +250,8 @@ void input_new_strata(
 		/*--------------------------------------------------------------*/
 		/*	Assign	defaults for this canopy_strata								*/
 		/*--------------------------------------------------------------*/
-		if (canopy_strata[0].veg_parm_ID > 0) {
+		if ((canopy_strata[0].veg_parm_ID > 0) && ((canopy_strata[0].defaults[0] == NULL)
+			|| (canopy_strata[0].defaults[0][0].ID != canopy_strata[0].veg_parm_ID))) {
 			i=0;
 			while (defaults[0].stratum[i].ID != canopy_strata[0].veg_parm_ID) {
 				i++;
@@ -126,7 +126,10 @@ void input_new_strata_mult(
 	 if (dtmp > 0)  canopy_strata[0].veg_parm_ID = dtmp;
 	
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"cover_fraction","%lf",1,1);	
-	  if (fabs(ltmp - NULLVAL) >= ONE) canopy_strata[0].cover_fraction = ltmp * canopy_strata[0].cover_fraction;
+	  if (fabs(ltmp - NULLVAL) >= ONE) {
+		canopy_strata[0].cover_fraction = ltmp * canopy_strata[0].cover_fraction;
+		patch[0].zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		}
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"gap_fraction","%lf",1,1);
 	  if (fabs(ltmp - NULLVAL) >= ONE) canopy_strata[0].gap_fraction = ltmp * canopy_strata[0].gap_fraction;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"rootzone.depth","%lf",1,1);
@@ -243,7 +246,8 @@ void input_new_strata_mult(
 		/*--------------------------------------------------------------*/
 		/*	Assign	defaults for this canopy_strata								*/
 		/*--------------------------------------------------------------*/
-		if (canopy_strata[0].veg_parm_ID > 0) {
+		if ((canopy_strata[0].veg_parm_ID > 0) && ((canopy_strata[0].defaults[0] == NULL)
+			|| (canopy_strata[0].defaults[0][0].ID != canopy_strata[0].veg_parm_ID))) {
 			i=0;
 			while (defaults[0].stratum[i].ID != canopy_strata[0].veg_parm_ID) {
 				i++;
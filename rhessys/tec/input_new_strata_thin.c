@@ -152,7 +152,10 @@ void input_new_strata_thin(
 	dtmp = getIntWorldfile(&paramCnt,&paramPtr,"veg_parm_ID","%d",canopy_strata[0].veg_parm_ID,1);
 	 if (dtmp > 0)  canopy_strata[0].veg_parm_ID = dtmp;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"cover_fraction","%lf",canopy_strata[0].cover_fraction,1);	
-	  if (fabs(ltmp - NULLVAL) >= ONE) canopy_strata[0].cover_fraction = ltmp;
+	  if (fabs(ltmp - NULLVAL) >= ONE) {
+		canopy_strata[0].cover_fraction = ltmp;
+		patch[0].zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		}
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"gap_fraction","%lf",canopy_strata[0].gap_fraction,1);
 	  if (fabs(ltmp - NULLVAL) >= ONE) canopy_strata[0].gap_fraction = ltmp;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"cs.stem_density","%lf",canopy_strata[0].cs.stem_density,1);
@@ -185,7 +188,8 @@ void input_new_strata_thin(
 		/*--------------------------------------------------------------*/
 		/*	Assign	defaults for this canopy_strata								*/
 		/*--------------------------------------------------------------*/
-		if (default_object_ID > 0) {
+		if ((default_object_ID > 0) && ((canopy_strata[0].defaults[0] == NULL)
+			|| (canopy_strata[0].defaults[0][0].ID != default_object_ID))) {
 			i=0;
 			while (defaults[0].stratum[i].ID != default_object_ID) {
 				i++;
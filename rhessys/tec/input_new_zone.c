@@ -102,7 +102,10 @@
 	 if (dtmp > 0)  zone[0].zone_parm_ID = dtmp;
 
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"area","%lf",zone[0].area,1);
-	if (fabs(ltmp - NULLVAL) >= ZERO)  zone[0].area = ltmp;
+	if (fabs(ltmp - NULLVAL) >= ZERO) {
+		zone[0].area = ltmp;
+		zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		}
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"slope","%lf",zone[0].slope,1);
 	if (fabs(ltmp - NULLVAL) >= ZERO) {
 		zone[0].slope = ltmp * DtoR;
@@ -115,6 +118,7 @@
 		zone[0].cos_aspect = cos(zone[0].aspect);
 		zone[0].sin_aspect = sin(zone[0].aspect);
 		}
+	zone[0].solar_coefs_valid = 0;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"precip_lapse_rate","%lf",zone[0].precip_lapse_rate,1);
 	if (fabs(ltmp - NULLVAL) >= ZERO)  zone[0].precip_lapse_rate = ltmp;
 	ltmp = getDoubleWorldfile(&paramCnt,&paramPtr,"e_horizon","%lf",zone[0].e_horizon,1);
@@ -130,7 +134,8 @@
 	/*--------------------------------------------------------------*/
 	/*	Assign	defaults for this zone								*/
 	/*--------------------------------------------------------------*/
-	if (zone[0].zone_parm_ID > 0) {
+	if ((zone[0].zone_parm_ID > 0) && ((zone[0].defaults[0] == NULL)
+		|| (zone[0].defaults[0][0].ID != zone[0].zone_parm_ID))) {
 		i = 0;
 		while (defaults[0].zone[i].ID != zone[0].zone_parm_ID) {
 			i++;
@@ -0,0 +1,431 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		input_world_state_delta				*/
+/*								*/
+/*	input_world_state_delta.c - apply a binary state delta	*/
+/*								*/
+/*	NAME							*/
+/*	input_world_state_delta.c - apply a binary state delta	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	int is_world_state_delta(FILE *file)			*/
+/*	void input_world_state_delta(world, command_line,	*/
+/*			file, filename)				*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	A state delta is a sparse alternative to a full		*/
+/*	redefine worldfile: it lists only the (object, variable,*/
+/*	value) triples that change.  All values are little	*/
+/*	endian; they are byte swapped on big endian hosts.	*/
+/*								*/
+/*	header:	char magic[4] = "RHSD"				*/
+/*		int32 version = 1				*/
+/*		int32 num_vars					*/
+/*	num_vars variable definitions:				*/
+/*		int32 level	2 hillslope, 3 zone, 4 patch,	*/
+/*				5 stratum			*/
+/*		int32 op	0 set, 1 multiply		*/
+/*		char name[64]	struct member, e.g. "sat_deficit"*/
+/*				or one nested member "cs.leafc"	*/
+/*	int64 num_records					*/
+/*	num_records records:					*/
+/*		int32 var	index into the definitions	*/
+/*		int32 ID[5]	basin, hillslope, zone, patch,	*/
+/*				stratum (unused levels ignored)	*/
+/*		double value					*/
+/*								*/
+/*	Names are resolved through index_struct_fields(), the	*/
+/*	same index used by the output filters.  Only the raw	*/
+/*	member is written - unlike input_new_*, no derived	*/
+/*	state is recomputed other than the canopy layer order	*/
+/*	of patches whose strata were touched and the hillslope	*/
+/*	means; touched zones resync their canopy sums the next	*/
+/*	day.							*/
+/*								*/
+/*	Records are resolved to object addresses serially and	*/
+/*	grouped by hillslope; groups are then applied in	*/
+/*	parallel.  Within a group records are applied in file	*/
+/*	order, so repeated records behave as they would		*/
+/*	sequentially.						*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "rhessys.h"
+#include "index_struct_fields.h"
+
+#define STATE_DELTA_MAGIC "RHSD"
+#define STATE_DELTA_VERSION 1
+#define STATE_DELTA_NAME_LEN 64
+
+#define STATE_DELTA_LEVEL_HILLSLOPE 2
+#define STATE_DELTA_LEVEL_ZONE 3
+#define STATE_DELTA_LEVEL_PATCH 4
+#define STATE_DELTA_LEVEL_STRATUM 5
+
+#define STATE_DELTA_OP_SET 0
+#define STATE_DELTA_OP_MULTIPLY 1
+
+struct state_delta_var {
+	int level;
+	int op;
+	size_t offset;
+	DataType data_type;
+};
+
+struct state_delta_target {
+	struct hillslope_object *hillslope;
+	struct patch_object *patch;	/* non-NULL for stratum records */
+	char *object;
+	int var;
+	size_t seq;
+	double value;
+};
+
+int is_world_state_delta(FILE *file)
+{
+	char magic[4];
+	long start;
+	int is_delta;
+
+	start = ftell(file);
+	is_delta = (fread(magic, 1, 4, file) == 4)
+		&& (memcmp(magic, STATE_DELTA_MAGIC, 4) == 0);
+	fseek(file, start, SEEK_SET);
+	return(is_delta);
+}
+
+static void state_delta_read(void *buf, size_t size, FILE *file, char *filename)
+{
+	if (fread(buf, size, 1, file) != 1) {
+		fprintf(stderr,"FATAL ERROR: truncated state delta %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+}
+
+/*--------------------------------------------------------------*/
+/*	Reads count little endian values of size bytes each,	*/
+/*	reversing the bytes of each on a big endian host.	*/
+/*--------------------------------------------------------------*/
+static void state_delta_read_le(void *buf, size_t size, size_t count,
+	FILE *file, char *filename)
+{
+	const uint16_t one = 1;
+	unsigned char *bytes = (unsigned char *) buf;
+	unsigned char tmp;
+	size_t i, j;
+
+	state_delta_read(buf, size * count, file, filename);
+	if (*(const unsigned char *) &one == 1)
+		return;
+	for (i = 0; i < count; i++, bytes += size) {
+		for (j = 0; j < size / 2; j++) {
+			tmp = bytes[j];
+			bytes[j] = bytes[size - 1 - j];
+			bytes[size - 1 - j] = tmp;
+		}
+	}
+}
+
+static void state_delta_resolve_var(struct state_delta_var *v, char *name,
+	StructIndex_t *idx, char *filename)
+{
+	Dictionary_t *dict;
+	DictionaryValue_t *entry, *sub_entry;
+	char *sub_name;
+
+	switch (v->level) {
+	case STATE_DELTA_LEVEL_HILLSLOPE: dict = idx->hillslope_object; break;
+	case STATE_DELTA_LEVEL_ZONE: dict = idx->zone_object; break;
+	case STATE_DELTA_LEVEL_PATCH: dict = idx->patch_object; break;
+	case STATE_DELTA_LEVEL_STRATUM: dict = idx->canopy_strata_object; break;
+	default:
+		fprintf(stderr,"FATAL ERROR: state delta %s: variable %s has unknown level %d\n",
+			filename, name, v->level);
+		exit(EXIT_FAILURE);
+	}
+	if ((v->op != STATE_DELTA_OP_SET) && (v->op != STATE_DELTA_OP_MULTIPLY)) {
+		fprintf(stderr,"FATAL ERROR: state delta %s: variable %s has unknown op %d\n",
+			filename, name, v->op);
+		exit(EXIT_FAILURE);
+	}
+
+	sub_name = strchr(name, '.');
+	if (sub_name != NULL)
+		*sub_name++ = '\0';
+	entry = dictionaryGet(dict, name);
+	if (entry == NULL) {
+		fprintf(stderr,"FATAL ERROR: state delta %s: %s is not a member at level %d\n",
+			filename, name, v->level);
+		exit(EXIT_FAILURE);
+	}
+	v->offset = entry->offset;
+	v->data_type = entry->data_type;
+	if (sub_name != NULL) {
+		if ((entry->data_type != DATA_TYPE_STRUCT) || (entry->sub_struct_index == NULL)
+			|| ((sub_entry = dictionaryGet(entry->sub_struct_index, sub_name)) == NULL)) {
+			fprintf(stderr,"FATAL ERROR: state delta %s: %s.%s is not a member at level %d\n",
+				filename, name, sub_name, v->level);
+			exit(EXIT_FAILURE);
+		}
+		v->offset += sub_entry->offset;
+		v->data_type = sub_entry->data_type;
+	}
+	switch (v->data_type) {
+	case DATA_TYPE_DOUBLE:
+	case DATA_TYPE_FLOAT:
+	case DATA_TYPE_INT:
+	case DATA_TYPE_LONG:
+		break;
+	default:
+		fprintf(stderr,"FATAL ERROR: state delta %s: %s is not a numeric member\n",
+			filename, name);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void state_delta_apply(struct state_delta_var *v, char *object, double value)
+{
+	char *field = object + v->offset;
+
+	switch (v->data_type) {
+	case DATA_TYPE_DOUBLE:
+		if (v->op == STATE_DELTA_OP_SET) *(double *)field = value;
+		else *(double *)field *= value;
+		break;
+	case DATA_TYPE_FLOAT:
+		if (v->op == STATE_DELTA_OP_SET) *(float *)field = (float) value;
+		else *(float *)field *= (float) value;
+		break;
+	case DATA_TYPE_INT:
+		if (v->op == STATE_DELTA_OP_SET) *(int *)field = (int) value;
+		else *(int *)field = (int) (*(int *)field * value);
+		break;
+	case DATA_TYPE_LONG:
+		if (v->op == STATE_DELTA_OP_SET) *(long *)field = (long) value;
+		else *(long *)field = (long) (*(long *)field * value);
+		break;
+	default:
+		break;
+	}
+}
+
+static int compare_patch_ptr(const void *a, const void *b)
+{
+	const struct patch_object *pa = *(struct patch_object * const *) a;
+	const struct patch_object *pb = *(struct patch_object * const *) b;
+
+	if (pa != pb)
+		return (pa < pb) ? -1 : 1;
+	return 0;
+}
+
+static int compare_state_delta_target(const void *a, const void *b)
+{
+	const struct state_delta_target *ta = (const struct state_delta_target *) a;
+	const struct state_delta_target *tb = (const struct state_delta_target *) b;
+
+	if (ta->hillslope != tb->hillslope)
+		return (ta->hillslope < tb->hillslope) ? -1 : 1;
+	if (ta->seq != tb->seq)
+		return (ta->seq < tb->seq) ? -1 : 1;
+	return 0;
+}
+
+void input_world_state_delta(struct world_object *world,
+	struct command_line_object *command_line,
+	FILE *file,
+	char *filename)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	struct world_id_index_object *construct_world_id_index(struct world_object *);
+	void sort_patch_layers(struct patch_object *, int *);
+	void compute_mean_hillslope_parameters_list(struct hillslope_object **, int);
+	struct basin_object *find_basin_indexed(int, struct world_id_index_object *);
+	struct hillslope_object *find_hillslope_in_basin_indexed(int,
+		struct basin_object *, struct world_id_index_object *);
+	struct zone_object *find_zone_in_hillslope_indexed(int,
+		struct hillslope_object *, struct world_id_index_object *);
+	struct patch_object *find_patch_in_zone_indexed(int,
+		struct zone_object *, struct world_id_index_object *);
+	struct canopy_strata_object *find_stratum_in_patch_indexed(int,
+		struct patch_object *, struct world_id_index_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	char magic[4];
+	char name[STATE_DELTA_NAME_LEN + 1];
+	int32_t version, num_vars, level, op, var, ID[5];
+	int64_t num_records;
+	double value;
+	int i, num_groups, num_skipped;
+	size_t r, n;
+	int *group_start;
+	struct hillslope_object **hillslopes;
+	struct patch_object **touched;
+	struct state_delta_var *vars;
+	struct state_delta_target *targets;
+	struct world_id_index_object *index;
+	struct basin_object *basin;
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+	struct patch_object *patch;
+	struct canopy_strata_object *stratum;
+	StructIndex_t *idx;
+
+	if (world[0].id_index == NULL)
+		world[0].id_index = construct_world_id_index(world);
+	index = world[0].id_index;
+
+	/*--------------------------------------------------------------*/
+	/*	Header and variable definitions.			*/
+	/*--------------------------------------------------------------*/
+	state_delta_read(magic, 4, file, filename);
+	state_delta_read_le(&version, sizeof(version), 1, file, filename);
+	state_delta_read_le(&num_vars, sizeof(num_vars), 1, file, filename);
+	if ((memcmp(magic, STATE_DELTA_MAGIC, 4) != 0) || (version != STATE_DELTA_VERSION)
+		|| (num_vars <= 0)) {
+		fprintf(stderr,"FATAL ERROR: %s is not a version %d state delta\n",
+			filename, STATE_DELTA_VERSION);
+		exit(EXIT_FAILURE);
+	}
+	vars = (struct state_delta_var *) alloc(num_vars * sizeof(struct state_delta_var),
+		"vars", "input_world_state_delta");
+	idx = index_struct_fields();
+	for (i = 0; i < num_vars; i++) {
+		state_delta_read_le(&level, sizeof(level), 1, file, filename);
+		state_delta_read_le(&op, sizeof(op), 1, file, filename);
+		state_delta_read(name, STATE_DELTA_NAME_LEN, file, filename);
+		name[STATE_DELTA_NAME_LEN] = '\0';
+		vars[i].level = level;
+		vars[i].op = op;
+		state_delta_resolve_var(&vars[i], name, idx, filename);
+	}
+	free_struct_index(idx);
+
+	/*--------------------------------------------------------------*/
+	/*	Resolve each record to the object it addresses.	*/
+	/*	Records naming objects not in this world are skipped,	*/
+	/*	as redefine_world skips unknown IDs.			*/
+	/*--------------------------------------------------------------*/
+	state_delta_read_le(&num_records, sizeof(num_records), 1, file, filename);
+	if (num_records < 0) {
+		fprintf(stderr,"FATAL ERROR: state delta %s has a negative record count\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	targets = (struct state_delta_target *) alloc(
+		((size_t) num_records + 1) * sizeof(struct state_delta_target),
+		"targets", "input_world_state_delta");
+	n = 0;
+	num_skipped = 0;
+	for (r = 0; r < (size_t) num_records; r++) {
+		state_delta_read_le(&var, sizeof(var), 1, file, filename);
+		state_delta_read_le(ID, sizeof(ID[0]), 5, file, filename);
+		state_delta_read_le(&value, sizeof(value), 1, file, filename);
+		if ((var < 0) || (var >= num_vars)) {
+			fprintf(stderr,"FATAL ERROR: state delta %s record %zu names variable %d of %d\n",
+				filename, r, var, num_vars);
+			exit(EXIT_FAILURE);
+		}
+		level = vars[var].level;
+		zone = NULL;
+		patch = NULL;
+		stratum = NULL;
+		basin = find_basin_indexed(ID[0], index);
+		hillslope = (basin != NULL) ?
+			find_hillslope_in_basin_indexed(ID[1], basin, index) : NULL;
+		if ((hillslope != NULL) && (level >= STATE_DELTA_LEVEL_ZONE))
+			zone = find_zone_in_hillslope_indexed(ID[2], hillslope, index);
+		if ((zone != NULL) && (level >= STATE_DELTA_LEVEL_PATCH))
+			patch = find_patch_in_zone_indexed(ID[3], zone, index);
+		if ((patch != NULL) && (level >= STATE_DELTA_LEVEL_STRATUM))
+			stratum = find_stratum_in_patch_indexed(ID[4], patch, index);
+
+		targets[n].hillslope = hillslope;
+		targets[n].patch = NULL;
+		switch (level) {
+		case STATE_DELTA_LEVEL_HILLSLOPE: targets[n].object = (char *) hillslope; break;
+		case STATE_DELTA_LEVEL_ZONE: targets[n].object = (char *) zone; break;
+		case STATE_DELTA_LEVEL_PATCH: targets[n].object = (char *) patch; break;
+		default:
+			targets[n].object = (char *) stratum;
+			targets[n].patch = patch;
+			break;
+		}
+		if (targets[n].object == NULL) {
+			num_skipped++;
+			continue;
+		}
+		/* the zone's running canopy sums assume fixed areas and covers */
+		if (zone != NULL)
+			zone[0].canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+		targets[n].var = var;
+		targets[n].seq = r;
+		targets[n].value = value;
+		n++;
+	}
+	if (num_skipped > 0)
+		fprintf(stderr,"WARNING: state delta %s: %d records name objects not in this world\n",
+			filename, num_skipped);
+
+	/*--------------------------------------------------------------*/
+	/*	Group by hillslope; no two groups share an object.	*/
+	/*--------------------------------------------------------------*/
+	qsort(targets, n, sizeof(struct state_delta_target), compare_state_delta_target);
+	group_start = (int *) alloc((n + 1) * sizeof(int), "group_start",
+		"input_world_state_delta");
+	hillslopes = (struct hillslope_object **) alloc((n + 1) * sizeof(struct hillslope_object *),
+		"hillslopes", "input_world_state_delta");
+	touched = (struct patch_object **) alloc((n + 1) * sizeof(struct patch_object *),
+		"touched", "input_world_state_delta");
+	num_groups = 0;
+	for (r = 0; r < n; r++) {
+		if ((r == 0) || (targets[r].hillslope != targets[r-1].hillslope)) {
+			group_start[num_groups] = (int) r;
+			hillslopes[num_groups] = targets[r].hillslope;
+			num_groups++;
+		}
+	}
+	group_start[num_groups] = (int) n;
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int g = 0; g < num_groups; g++) {
+		int rec = 0;
+		for (int t = group_start[g]; t < group_start[g+1]; t++)
+			state_delta_apply(&vars[targets[t].var], targets[t].object, targets[t].value);
+		/* re-sort each patch whose strata were touched, once */
+		int num_touched = 0;
+		for (int t = group_start[g]; t < group_start[g+1]; t++)
+			if (targets[t].patch != NULL)
+				touched[group_start[g] + num_touched++] = targets[t].patch;
+		qsort(&touched[group_start[g]], num_touched, sizeof(struct patch_object *),
+			compare_patch_ptr);
+		for (int t = 0; t < num_touched; t++)
+			if ((t == 0) || (touched[group_start[g] + t] != touched[group_start[g] + t - 1]))
+				sort_patch_layers(touched[group_start[g] + t], &rec);
+	}
+
+	compute_mean_hillslope_parameters_list(hillslopes, num_groups);
+
+	if (command_line[0].verbose_flag > 0)
+		fprintf(stderr,"\n Applied %zu state delta records to %d hillslopes from %s",
+			n, num_groups, filename);
+
+	free(touched);
+	free(hillslopes);
+	free(group_start);
+	free(targets);
+	free(vars);
+	return;
+} /*end input_world_state_delta*/
@@ -85,7 +85,15 @@ int	 valid_option( char *command_line){
 
 		(strcmp(command_line,"-vegspinup") == 0) ||
 		(strcmp(command_line,"-template") == 0) ||
-		(strcmp(command_line,"-msr") == 0))
+		(strcmp(command_line,"-msr") == 0) ||
+		(strcmp(command_line,"-profile") == 0) ||
+		(strcmp(command_line,"-exactporosity") == 0) ||
+		(strcmp(command_line,"-outprecision") == 0) ||
+		(strcmp(command_line,"-memprofile") == 0) ||
+		(strcmp(command_line,"-scenarios") == 0) ||
+		(strcmp(command_line,"-worldindex") == 0) ||
+		(strcmp(command_line,"-hillslopes") == 0) ||
+		(strcmp(command_line,"-subcatchment") == 0))
 
 		i = 0;
 	if ( i == 0 ){
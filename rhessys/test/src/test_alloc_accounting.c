@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "alloc_accounting.h"
+
+void *alloc(size_t, char *, char *);
+void alloc_free(void *);
+
+static char *read_report(void) {
+	FILE *out = tmpfile();
+	long len;
+	char *report;
+
+	g_assert(out != NULL);
+	alloc_accounting_report(out);
+	len = ftell(out);
+	report = calloc(len + 1, 1);
+	rewind(out);
+	g_assert(fread(report, 1, len, out) == (size_t)len);
+	fclose(out);
+	return report;
+}
+
+void test_alloc_accounting() {
+	void *blocks[1000];
+	char *report, *big, *small;
+	int i;
+
+	alloc_accounting_init(NULL);
+	for (i = 0; i < 1000; i++) {
+		blocks[i] = alloc(1024, "daily_clim", "construct_clim");
+	}
+	void *one = alloc(64, "innundation_list", "construct_patch");
+
+	// Sorted by peak bytes
+	report = read_report();
+	big = strstr(report, "daily_clim");
+	small = strstr(report, "innundation_list");
+	g_assert(big != NULL && small != NULL && big < small);
+	g_assert(strstr(report, "1001 blocks") != NULL);
+	free(report);
+
+	// Released blocks are credited back, peak is kept
+	for (i = 0; i < 1000; i++) alloc_free(blocks[i]);
+	alloc_free(one);
+	report = read_report();
+	g_assert(strstr(report, "0.000 MB live") != NULL);
+	g_assert(strstr(report, "in 0 blocks") != NULL);
+	g_assert(strstr(report, "daily_clim") < strstr(report, "innundation_list"));
+	free(report);
+}
+
+// Blocks allocated and released from many threads at once are all counted
+void test_alloc_accounting_parallel() {
+	char *report;
+	int i;
+
+	alloc_accounting_init(NULL);
+	#pragma omp parallel for schedule(dynamic,1)
+	for (i = 0; i < 64; i++) {
+		void *zones[100];
+		int j;
+
+		for (j = 0; j < 100; j++) zones[j] = alloc(1024, "zone", "construct_zone");
+		if (i % 2 == 0) {
+			for (j = 0; j < 100; j++) alloc_free(zones[j]);
+		}
+	}
+	report = read_report();
+	g_assert(strstr(report, "3.125 MB live") != NULL);
+	g_assert(strstr(report, "in 3200 blocks") != NULL);
+	free(report);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test alloc accounting", test_alloc_accounting);
+	g_test_add_func("/set1/test alloc accounting parallel", test_alloc_accounting_parallel);
+	return g_test_run();
+}
@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+struct arena_object *construct_arena(char *);
+void *arena_alloc(struct arena_object *, size_t, char *, char *);
+void destroy_arena(struct arena_object *);
+
+void test_arena() {
+	struct arena_object *arena = construct_arena("test_arena");
+	char *arrays[2000];
+	size_t sizes[2000];
+	size_t i, j;
+
+	for (i = 0; i < 2000; i++) {
+		// Mostly small objects, with the odd one bigger than a chunk
+		sizes[i] = (i % 500 == 499) ? 5 * 1024 * 1024 : 1 + (i * 37) % 3000;
+		arrays[i] = arena_alloc(arena, sizes[i], "array", "test_arena");
+		g_assert(arrays[i] != NULL);
+		g_assert_cmpuint((uintptr_t)arrays[i] % sizeof(double), ==, 0);
+		// Zeroed like alloc()
+		for (j = 0; j < sizes[i]; j++) g_assert(arrays[i][j] == 0);
+		memset(arrays[i], (int)(i % 255) + 1, sizes[i]);
+	}
+	// No two arrays overlap
+	for (i = 0; i < 2000; i++) {
+		g_assert(arrays[i][0] == (char)(i % 255 + 1));
+		g_assert(arrays[i][sizes[i] - 1] == (char)(i % 255 + 1));
+	}
+	g_assert(arena_alloc(arena, 0, "empty", "test_arena") == NULL);
+	destroy_arena(arena);
+}
+
+void test_arena_null() {
+	// Without an arena arrays come from alloc()
+	char *array = arena_alloc(NULL, 64, "array", "test_arena_null");
+	g_assert(array != NULL);
+	g_assert(array[63] == 0);
+	free(array);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test arena", test_arena);
+	g_test_add_func("/set1/test arena null", test_arena_null);
+	return g_test_run();
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <glib.h>
+
+#include "fast_format.h"
+
+static void check_double(double x, int decimals) {
+	FastFormatRow row;
+	char expected[512];
+
+	fast_format_row_init(&row);
+	fast_format_append_double(&row, x, decimals);
+	snprintf(expected, sizeof(expected), "%.*f", decimals, x);
+	g_assert_cmpuint(row.len, ==, strlen(expected));
+	g_assert(memcmp(row.buf, expected, row.len) == 0);
+	fast_format_row_free(&row);
+}
+
+void test_fast_format_double() {
+	int i, d;
+	double x;
+
+	// Exact halves round to even, as printf does
+	for (i = -4096; i <= 4096; i++) {
+		for (d = 0; d <= 6; d++) check_double(i / 1024.0, d);
+	}
+	srand(1);
+	for (i = 0; i < 100000; i++) {
+		x = (rand() / (double)RAND_MAX - 0.5) * pow(10.0, rand() % 20 - 10);
+		for (d = 0; d <= FAST_FORMAT_MAX_DECIMALS; d++) check_double(x, d);
+	}
+	check_double(-0.0, 6);
+	check_double(-1e-9, 6);
+	check_double(1e300, 6);
+	check_double(NAN, 6);
+	check_double(-INFINITY, 6);
+}
+
+void test_fast_format_row() {
+	FastFormatRow row;
+	char expected[64];
+	int i;
+
+	fast_format_row_init(&row);
+	fast_format_appendf(&row, "%d %ld %s %lf %8.3f %-5d|", -12, 1234567890L, "abc", 0.1, 2.5, 7);
+	snprintf(expected, sizeof(expected), "%d %ld %s %lf %8.3f %-5d|", -12, 1234567890L, "abc", 0.1, 2.5, 7);
+	g_assert_cmpuint(row.len, ==, strlen(expected));
+	g_assert(memcmp(row.buf, expected, row.len) == 0);
+
+	// Rows outgrow their own storage
+	for (i = 0; i < FAST_FORMAT_ROW_LEN; i++) fast_format_append_long(&row, i % 10);
+	g_assert_cmpuint(row.len, ==, strlen(expected) + FAST_FORMAT_ROW_LEN);
+	g_assert(row.buf != row.local);
+	g_assert(row.buf[row.len - 1] == '0' + (FAST_FORMAT_ROW_LEN - 1) % 10);
+	fast_format_row_free(&row);
+}
+
+void test_fast_format_decimals() {
+	FastFormatRow row;
+
+	fast_format_set_decimals(3);
+	fast_format_row_init(&row);
+	fast_format_appendf(&row, "%f %lf %.1f", 1.23456, -0.0004, 1.25);
+	g_assert_cmpuint(row.len, ==, strlen("1.235 -0.000 1.2"));
+	g_assert(memcmp(row.buf, "1.235 -0.000 1.2", row.len) == 0);
+	fast_format_row_free(&row);
+	fast_format_set_decimals(FAST_FORMAT_DEFAULT_DECIMALS);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test fast format double", test_fast_format_double);
+	g_test_add_func("/set1/test fast format row", test_fast_format_row);
+	g_test_add_func("/set1/test fast format decimals", test_fast_format_decimals);
+	return g_test_run();
+}
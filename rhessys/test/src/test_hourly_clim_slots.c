@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+struct hourly_clim_slots construct_hourly_clim_slots(struct clim_event_sequence);
+double hourly_clim_value(struct hourly_clim_slots *, struct date);
+int hourly_clim_day_has_event(struct hourly_clim_slots *, struct date);
+
+static struct date make_date(long year, long month, long day, long hour) {
+	struct date d;
+	d.year = year;
+	d.month = month;
+	d.day = day;
+	d.hour = hour;
+	return d;
+}
+
+void test_hourly_clim_slots_none() {
+	struct clim_event_sequence sequence;
+	struct hourly_clim_slots slots;
+	sequence.inx = -999;
+	slots = construct_hourly_clim_slots(sequence);
+	g_assert(slots.value == NULL);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 1, 1, 1)), ==, -999.0);
+	g_assert_cmpint(hourly_clim_day_has_event(&slots, make_date(2000, 1, 1, 1)), ==, 0);
+}
+
+void test_hourly_clim_slots() {
+	struct dated_sequence seq[6];
+	struct clim_event_sequence sequence;
+	struct hourly_clim_slots slots;
+	// Two days with a gap day between them, across a month end
+	seq[0].edate = make_date(2000, 1, 31, 1);  seq[0].value = 1.0;
+	seq[1].edate = make_date(2000, 1, 31, 24); seq[1].value = 2.0;
+	seq[2].edate = make_date(2000, 2, 2, 5);   seq[2].value = 3.0;
+	// A repeated hour keeps the first event, as the old cursor did
+	seq[3].edate = make_date(2000, 2, 2, 5);   seq[3].value = 4.0;
+	// Hours outside 1-24 never matched and are dropped
+	seq[4].edate = make_date(2000, 2, 3, 0);   seq[4].value = 5.0;
+	seq[5].edate.year = 0;
+	sequence.inx = 0;
+	sequence.seq = seq;
+
+	slots = construct_hourly_clim_slots(sequence);
+	g_assert(slots.value != NULL);
+	g_assert_cmpint(slots.num_days, ==, 3);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 1, 31, 1)), ==, 1.0);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 1, 31, 2)), ==, -999.0);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 1, 31, 24)), ==, 2.0);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 2, 2, 5)), ==, 3.0);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 1, 30, 24)), ==, -999.0);
+	g_assert_cmpfloat(hourly_clim_value(&slots, make_date(2000, 2, 3, 1)), ==, -999.0);
+
+	g_assert_cmpint(hourly_clim_day_has_event(&slots, make_date(2000, 1, 31, 1)), ==, 1);
+	g_assert_cmpint(hourly_clim_day_has_event(&slots, make_date(2000, 2, 1, 1)), ==, 0);
+	g_assert_cmpint(hourly_clim_day_has_event(&slots, make_date(2000, 2, 2, 1)), ==, 1);
+	free(slots.value);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test hourly clim slots none", test_hourly_clim_slots_none);
+	g_test_add_func("/set1/test hourly clim slots", test_hourly_clim_slots);
+	return g_test_run();
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <glib.h>
+
+#include "id_index.h"
+
+void test_empty_id_index() {
+	IdIndex_t *index = newIdIndex(0);
+	idIndexFinalize(index);
+	g_assert(index->num_entries == 0);
+	g_assert(idIndexGet(index, 42) == NULL);
+	freeIdIndex(index);
+}
+
+void test_id_index() {
+	int dummy[64];
+	IdIndex_t *index = newIdIndex(4);
+	// Insert in descending order to force growth and sorting
+	for (int i = 63; i >= 0; i--) {
+		idIndexInsert(index, i * 3, &dummy[i]);
+	}
+	idIndexFinalize(index);
+	g_assert(index->num_entries == 64);
+	for (int i = 0; i < 64; i++) {
+		g_assert(idIndexGet(index, i * 3) == &dummy[i]);
+		g_assert(idIndexGet(index, i * 3 + 1) == NULL);
+	}
+	g_assert(idIndexGet(index, -1) == NULL);
+	freeIdIndex(index);
+}
+
+void test_id_index_duplicates() {
+	int first = 1;
+	int second = 2;
+	int other = 3;
+	IdIndex_t *index = newIdIndex(8);
+	idIndexInsert(index, 7, &first);
+	idIndexInsert(index, 5, &other);
+	idIndexInsert(index, 7, &second);
+	idIndexFinalize(index);
+	// Last insertion wins
+	g_assert(index->num_entries == 2);
+	g_assert(idIndexGet(index, 7) == &second);
+	g_assert(idIndexGet(index, 5) == &other);
+	freeIdIndex(index);
+}
+
+void test_id_index_insert_after_finalize() {
+	int first = 1;
+	int second = 2;
+	int third = 3;
+	int fourth = 4;
+	IdIndex_t *index = newIdIndex(8);
+	idIndexInsert(index, 7, &first);
+	idIndexInsert(index, 7, &second);
+	idIndexInsert(index, 7, &third);
+	idIndexFinalize(index);
+	g_assert(index->num_entries == 1);
+	g_assert(idIndexGet(index, 7) == &third);
+	// Fewer entries now than inserts so far; the new one must still win
+	idIndexInsert(index, 7, &fourth);
+	idIndexFinalize(index);
+	g_assert(index->num_entries == 1);
+	g_assert(idIndexGet(index, 7) == &fourth);
+	freeIdIndex(index);
+}
+
+void test_id_index_in_parent() {
+	int parent1, parent2;
+	int a = 1;
+	int b = 2;
+	IdIndex_t *index = newIdIndex(0);
+	// Same ID under two different parents
+	idIndexInsertInParent(index, &parent1, 10, &a);
+	idIndexInsertInParent(index, &parent2, 10, &b);
+	idIndexFinalize(index);
+	g_assert(index->num_entries == 2);
+	g_assert(idIndexGetInParent(index, &parent1, 10) == &a);
+	g_assert(idIndexGetInParent(index, &parent2, 10) == &b);
+	g_assert(idIndexGetInParent(index, &parent1, 11) == NULL);
+	g_assert(idIndexGet(index, 10) == NULL);
+	freeIdIndex(index);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL );
+	g_test_add_func("/set1/test empty id_index", test_empty_id_index);
+	g_test_add_func("/set1/test id_index", test_id_index);
+	g_test_add_func("/set1/test id_index duplicates", test_id_index_duplicates);
+	g_test_add_func("/set1/test id_index insert after finalize", test_id_index_insert_after_finalize);
+	g_test_add_func("/set1/test id_index in parent", test_id_index_in_parent);
+	return g_test_run();
+}
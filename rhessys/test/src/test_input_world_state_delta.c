@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+int is_world_state_delta(FILE *);
+void input_world_state_delta(struct world_object *, struct command_line_object *,
+	FILE *, char *);
+
+#define DELTA "test_input_world_state_delta.delta"
+
+// Values are written a byte at a time, least significant first, so the
+// file is little endian whatever the host is
+static void write_le(FILE *file, uint64_t bits, int size) {
+	int i;
+
+	for (i = 0; i < size; i++)
+		fputc((int) ((bits >> (8 * i)) & 0xff), file);
+}
+
+static void write_double(FILE *file, double value) {
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	write_le(file, bits, 8);
+}
+
+static void write_var(FILE *file, int level, int op, char *name) {
+	char padded[64];
+
+	memset(padded, 0, sizeof(padded));
+	strcpy(padded, name);
+	write_le(file, level, 4);
+	write_le(file, op, 4);
+	fwrite(padded, 1, sizeof(padded), file);
+}
+
+static void write_record(FILE *file, int var, int patch_ID, double value) {
+	int ID[5] = {1, 10, 100, patch_ID, 0};
+	int i;
+
+	write_le(file, var, 4);
+	for (i = 0; i < 5; i++)
+		write_le(file, ID[i], 4);
+	write_double(file, value);
+}
+
+static void write_delta(void) {
+	FILE *file = fopen(DELTA, "wb");
+
+	g_assert(file != NULL);
+	fwrite("RHSD", 1, 4, file);
+	write_le(file, 1, 4);
+	write_le(file, 4, 4);
+	write_var(file, 4, 0, "sat_deficit");
+	write_var(file, 4, 0, "area");
+	write_var(file, 3, 1, "slope");
+	write_var(file, 2, 0, "gw.storage");
+	write_le(file, 6, 8);
+	write_record(file, 0, 1000, 0.25);
+	write_record(file, 1, 1001, 30.0);
+	write_record(file, 2, 0, 2.0);
+	write_record(file, 2, 0, 3.0);
+	write_record(file, 3, 0, 7.5);
+	// Not in this world, so skipped
+	write_record(file, 0, 1002, 9.0);
+	fclose(file);
+}
+
+void test_input_world_state_delta() {
+	struct world_object world;
+	struct basin_object basin, *basins[1];
+	struct hillslope_object hillslope, *hillslopes[1];
+	struct zone_object zone, *zones[1];
+	struct patch_object patch[2], *patches[2];
+	struct soil_default soil, *soil_defaults[1];
+	struct command_line_object command_line;
+	FILE *file;
+	int p;
+
+	memset(&world, 0, sizeof(world));
+	memset(&basin, 0, sizeof(basin));
+	memset(&hillslope, 0, sizeof(hillslope));
+	memset(&zone, 0, sizeof(zone));
+	memset(patch, 0, sizeof(patch));
+	memset(&soil, 0, sizeof(soil));
+	memset(&command_line, 0, sizeof(command_line));
+
+	soil_defaults[0] = &soil;
+	for (p = 0; p < 2; p++) {
+		patch[p].ID = 1000 + p;
+		patch[p].area = 10.0;
+		patch[p].soil_defaults = soil_defaults;
+		patches[p] = &patch[p];
+	}
+	zone.ID = 100;
+	zone.slope = 0.5;
+	zone.num_patches = 2;
+	zone.patches = patches;
+	zones[0] = &zone;
+	hillslope.ID = 10;
+	hillslope.num_zones = 1;
+	hillslope.zones = zones;
+	hillslopes[0] = &hillslope;
+	basin.ID = 1;
+	basin.num_hillslopes = 1;
+	basin.hillslopes = hillslopes;
+	basins[0] = &basin;
+	world.num_basin_files = 1;
+	world.basins = basins;
+
+	write_delta();
+	file = fopen(DELTA, "rb");
+	g_assert(file != NULL);
+	g_assert(is_world_state_delta(file));
+	input_world_state_delta(&world, &command_line, file, DELTA);
+	fclose(file);
+
+	g_assert(patch[0].sat_deficit == 0.25);
+	g_assert(patch[1].sat_deficit == 0.0);
+	g_assert(patch[1].area == 30.0);
+	// Multiplies apply in file order
+	g_assert(zone.slope == 3.0);
+	// Touched zones redo their canopy sums
+	g_assert_cmpint(zone.canopy_sums_age, ==, ZONE_CANOPY_RESYNC_DAYS);
+	g_assert(hillslope.gw.storage == 7.5);
+	// The hillslope means are recomputed from the new patch areas
+	g_assert(hillslope.area == 40.0);
+
+	remove(DELTA);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test input world state delta", test_input_world_state_delta);
+	return g_test_run();
+}
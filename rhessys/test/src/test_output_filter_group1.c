@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+
+#include "output_filter.h"
+
+OutputFilter *parse(const char* input, bool verbose);
+
+void test_output_filter_group1() {
+	OutputFilter *filter = parse("fixtures/filter_group1.yml", true);
+
+	print_output_filter(filter);
+
+	g_assert(filter->parse_error == false);
+	// First filter: patches of hillslope 1:2, largest value per zone
+	g_assert(filter->type == OUTPUT_FILTER_PATCH);
+	g_assert(filter->timestep == TIMESTEP_MONTHLY);
+	g_assert(filter->group_by == GROUP_BY_ZONE);
+	g_assert(filter->aggregate == AGGREGATE_MAX);
+	g_assert(filter->group_map == NULL);
+	OutputFilterPatch *p1 = filter->patches;
+	g_assert(p1->output_patch_type == PATCH_TYPE_HILLSLOPE);
+	g_assert(p1->basinID == 1);
+	g_assert(p1->hillslopeID == 2);
+	g_assert(p1->next == NULL);
+	OutputFilterVariable *v1 = filter->variables;
+	int cmp = strcmp(v1->name, "lai");
+	g_assert(cmp == 0);
+	cmp = strcmp(v1->next->name, "evaporation");
+	g_assert(cmp == 0);
+	g_assert(v1->next->next == NULL);
+
+	// Second filter: strata of basin 1, area-weighted mean per mapped group
+	OutputFilter *f2 = filter->next;
+	g_assert(f2 != NULL);
+	g_assert(f2->type == OUTPUT_FILTER_CANOPY_STRATUM);
+	g_assert(f2->timestep == TIMESTEP_DAILY);
+	g_assert(f2->group_by == GROUP_BY_MAP);
+	g_assert(f2->aggregate == AGGREGATE_MEAN);
+	cmp = strcmp(f2->group_map, "groups.txt");
+	g_assert(cmp == 0);
+	OutputFilterVariable *v2 = f2->variables;
+	cmp = strcmp(v2->name, "epv");
+	g_assert(cmp == 0);
+	cmp = strcmp(v2->sub_struct_varname, "proj_lai");
+	g_assert(cmp == 0);
+	g_assert(f2->next == NULL);
+
+	free(filter);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL );
+	g_test_add_func("/set1/test output_filter_group1", test_output_filter_group1);
+	return g_test_run();
+}
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <glib.h>
+
+#include "rhessys.h"
+#include "output_filter.h"
+#include "output_filter/output_filter_output.h"
+#include "output_filter/output_format_csv.h"
+
+#define GROUP_OUTPUT "test_output_filter_group2"
+
+static struct basin_object basin;
+static struct basin_object *basins[1];
+static struct hillslope_object hillslope[2];
+static struct hillslope_object *hillslopes[2];
+static struct zone_object zone[2];
+static struct zone_object *zones[2][1];
+static struct patch_object patch[5];
+static struct patch_object *patches[5];
+
+// Hillslope 10 has patches of 10 and 30 m^2 with lai 1 and 3, hillslope 11
+// patches of 20, 20 and 60 m^2 with lai 2, 4 and 1
+static void init_world(void) {
+	double area[5] = {10.0, 30.0, 20.0, 20.0, 60.0};
+	double lai[5] = {1.0, 3.0, 2.0, 4.0, 1.0};
+	int h, p;
+
+	memset(&basin, 0, sizeof(basin));
+	memset(hillslope, 0, sizeof(hillslope));
+	memset(zone, 0, sizeof(zone));
+	memset(patch, 0, sizeof(patch));
+	for (p = 0; p < 5; p++) {
+		patch[p].ID = 1000 + p;
+		patch[p].area = area[p];
+		patch[p].lai = lai[p];
+		patches[p] = &patch[p];
+	}
+	for (h = 0; h < 2; h++) {
+		zone[h].ID = 100 + h;
+		zone[h].num_patches = (h == 0) ? 2 : 3;
+		zone[h].patches = (h == 0) ? &patches[0] : &patches[2];
+		zones[h][0] = &zone[h];
+		hillslope[h].ID = 10 + h;
+		hillslope[h].num_zones = 1;
+		hillslope[h].zones = zones[h];
+		hillslopes[h] = &hillslope[h];
+	}
+	basin.ID = 1;
+	basin.num_hillslopes = 2;
+	basin.hillslopes = hillslopes;
+	basins[0] = &basin;
+}
+
+// A daily patch filter over basin 1 writing lai by hillslope
+static OutputFilter *create_filter(OutputAggregate aggregate) {
+	OutputFilter *f = create_new_output_filter();
+	OutputFilterPatch *p = create_new_output_filter_patch();
+	OutputFilterVariable *v = create_new_output_filter_variable(OF_HIERARCHY_LEVEL_PATCH, "lai");
+
+	f->type = OUTPUT_FILTER_PATCH;
+	f->timestep = TIMESTEP_DAILY;
+	f->group_by = GROUP_BY_HILLSLOPE;
+	f->aggregate = aggregate;
+	p->output_patch_type = PATCH_TYPE_BASIN;
+	p->basinID = 1;
+	p->basin = basins[0];
+	f->patches = p;
+	v->data_type = DATA_TYPE_DOUBLE;
+	v->offset = offsetof(struct patch_object, lai);
+	f->variables = v;
+	f->num_variables = 1;
+	f->output = create_new_output_filter_output();
+	f->output->format = OUTPUT_TYPE_CSV;
+	f->output->path = strdup(".");
+	f->output->filename = strdup(GROUP_OUTPUT);
+	f->output->materialized_variables = calloc(f->num_variables, sizeof(MaterializedVariable));
+	return f;
+}
+
+static void resolve_filter(OutputFilter *f) {
+	char error[MAXSTR];
+
+	g_assert(output_filter_resolve_entities(error, MAXSTR, f));
+	g_assert_cmpint(f->num_entities, ==, 5);
+}
+
+// Write one day of a resolved filter and return the lines of its CSV file
+static void write_output(OutputFilter *f, char lines[3][MAXSTR]) {
+	char error[MAXSTR];
+	struct date date = {0};
+	FILE *file;
+	int i;
+
+	date.year = 2000;
+	date.month = 3;
+	date.day = 15;
+	g_assert(output_format_csv_init(f));
+	g_assert(output_format_csv_write_headers(f));
+	g_assert(output_filter_output_daily(error, MAXSTR, false, date, f));
+	fclose(f->output->fp);
+	f->output->fp = NULL;
+
+	file = fopen(GROUP_OUTPUT ".csv", "r");
+	g_assert(file != NULL);
+	for (i = 0; i < 3; i++) {
+		g_assert(fgets(lines[i], MAXSTR, file) != NULL);
+	}
+	g_assert(fgets(error, MAXSTR, file) == NULL);
+	fclose(file);
+	remove(GROUP_OUTPUT ".csv");
+}
+
+void test_output_filter_group_mean() {
+	char lines[3][MAXSTR];
+	OutputFilter *f;
+
+	init_world();
+	f = create_filter(AGGREGATE_MEAN);
+	resolve_filter(f);
+	write_output(f, lines);
+
+	g_assert_cmpint(strcmp(lines[0], "day,month,year,basinID,hillID,lai\n"), ==, 0);
+	// (10 * 1 + 30 * 3) / 40 and (20 * 2 + 20 * 4 + 60 * 1) / 100
+	g_assert_cmpint(strcmp(lines[1], "15,3,2000,1,10,2.500000\n"), ==, 0);
+	g_assert_cmpint(strcmp(lines[2], "15,3,2000,1,11,1.800000\n"), ==, 0);
+}
+
+void test_output_filter_group_sum() {
+	char lines[3][MAXSTR];
+	OutputFilter *f;
+
+	init_world();
+	f = create_filter(AGGREGATE_SUM);
+	resolve_filter(f);
+	write_output(f, lines);
+
+	g_assert_cmpint(strcmp(lines[0], "day,month,year,basinID,hillID,lai\n"), ==, 0);
+	g_assert_cmpint(strcmp(lines[1], "15,3,2000,1,10,100.000000\n"), ==, 0);
+	g_assert_cmpint(strcmp(lines[2], "15,3,2000,1,11,180.000000\n"), ==, 0);
+}
+
+void test_output_filter_group_redefined_area() {
+	char lines[3][MAXSTR];
+	OutputFilter *f;
+
+	init_world();
+	f = create_filter(AGGREGATE_MEAN);
+	resolve_filter(f);
+	// Areas redefined after the filter is resolved are used as weights
+	patch[0].area = 30.0;
+	write_output(f, lines);
+
+	// (30 * 1 + 30 * 3) / 60
+	g_assert_cmpint(strcmp(lines[1], "15,3,2000,1,10,2.000000\n"), ==, 0);
+	g_assert_cmpint(strcmp(lines[2], "15,3,2000,1,11,1.800000\n"), ==, 0);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test output_filter_group mean", test_output_filter_group_mean);
+	g_test_add_func("/set1/test output_filter_group sum", test_output_filter_group_sum);
+	g_test_add_func("/set1/test output_filter_group redefined area", test_output_filter_group_redefined_area);
+	return g_test_run();
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+struct porosity_profile_object *construct_porosity_profile(struct soil_default *);
+void destroy_porosity_profile(struct porosity_profile_object *);
+double compute_sat_deficit_z(struct soil_default *, double);
+double compute_sat_deficit(struct soil_default *, double);
+double compute_z_final(int, double, double, double, double, double);
+double compute_delta_water(int, double, double, double, double, double);
+
+static void check_profile(double porosity_0, double porosity_decay, double soil_depth) {
+	struct soil_default defaults;
+	int i;
+	double z, s, exact;
+
+	defaults.porosity_0 = porosity_0;
+	defaults.porosity_decay = porosity_decay;
+	defaults.soil_depth = soil_depth;
+	defaults.porosity_profile = construct_porosity_profile(&defaults);
+	g_assert(defaults.porosity_profile != NULL);
+
+	for (i = 0; i <= 1000; i++) {
+		// Within tolerance of the exact math both ways
+		z = defaults.porosity_profile[0].max_z * i / 1000.0;
+		s = compute_sat_deficit(&defaults, z);
+		exact = compute_delta_water(0, porosity_0, porosity_decay, soil_depth, z, 0.0);
+		g_assert_cmpfloat(fabs(s - exact), <=, POROSITY_PROFILE_TOLERANCE);
+		exact = compute_z_final(0, porosity_0, porosity_decay, soil_depth, 0.0, -s);
+		g_assert_cmpfloat(fabs(compute_sat_deficit_z(&defaults, s) - exact), <=,
+			POROSITY_PROFILE_TOLERANCE);
+		// and the two lookups invert each other
+		g_assert_cmpfloat(fabs(compute_sat_deficit_z(&defaults, s) - z), <=,
+			POROSITY_PROFILE_TOLERANCE);
+	}
+	// Ponding and the bottom of the column fall back to the exact math
+	g_assert_cmpfloat(compute_sat_deficit_z(&defaults, -0.1), ==,
+		compute_z_final(0, porosity_0, porosity_decay, soil_depth, 0.0, 0.1));
+	g_assert_cmpfloat(compute_sat_deficit(&defaults, 2 * soil_depth), ==,
+		compute_delta_water(0, porosity_0, porosity_decay, soil_depth, 2 * soil_depth, 0.0));
+	destroy_porosity_profile(defaults.porosity_profile);
+}
+
+void test_porosity_profile() {
+	check_profile(0.435, 0.5, 2.0);
+	check_profile(0.6, 0.05, 3.0);
+	check_profile(0.3, 100.0, 1.0);
+}
+
+void test_porosity_profile_linear() {
+	// Porosity that does not decay needs no table
+	struct soil_default defaults;
+	defaults.porosity_0 = 0.435;
+	defaults.porosity_decay = 4000.0;
+	defaults.soil_depth = 2.0;
+	g_assert(construct_porosity_profile(&defaults) == NULL);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test porosity profile", test_porosity_profile);
+	g_test_add_func("/set1/test porosity profile linear", test_porosity_profile_linear);
+	return g_test_run();
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+
+#include "profile.h"
+
+static char *read_all(FILE *f) {
+	static char buf[8192];
+	size_t n;
+	rewind(f);
+	n = fread(buf, 1, sizeof(buf) - 1, f);
+	buf[n] = '\0';
+	return buf;
+}
+
+void test_profile_nested() {
+	char trace_name[] = "test_profile_trace.json";
+	FILE *out = tmpfile();
+	g_assert(out != NULL);
+
+	profile_init(trace_name);
+	g_assert(profile_enabled);
+	for (int day = 0; day < 3; day++) {
+		PROFILE_BEGIN(PROFILE_WORLD_DAILY_F);
+		PROFILE_BEGIN(PROFILE_ZONE_DAILY_F);
+		PROFILE_BEGIN(PROFILE_PATCH_DAILY_F);
+		PROFILE_END(PROFILE_PATCH_DAILY_F);
+		PROFILE_END(PROFILE_ZONE_DAILY_F);
+		PROFILE_END(PROFILE_WORLD_DAILY_F);
+	}
+	profile_report(out);
+
+	char *report = read_all(out);
+	// Children are listed under their parent, indented
+	g_assert(strstr(report, "\nworld_daily_F ") != NULL);
+	g_assert(strstr(report, "\n  zone_daily_F ") != NULL);
+	g_assert(strstr(report, "\n    patch_daily_F ") != NULL);
+	g_assert(strstr(report, "construct_world") == NULL);
+	fclose(out);
+
+	FILE *trace = fopen(trace_name, "r");
+	g_assert(trace != NULL);
+	char *json = read_all(trace);
+	g_assert(strncmp(json, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 38) == 0);
+	g_assert(strstr(json, "\"name\":\"patch_daily_F\",\"ph\":\"X\"") != NULL);
+	fclose(trace);
+	remove(trace_name);
+
+	profile_destroy();
+	g_assert(!profile_enabled);
+}
+
+void test_profile_disabled() {
+	// Without profile_init the macros must be no-ops
+	PROFILE_BEGIN(PROFILE_FIRE);
+	PROFILE_END(PROFILE_FIRE);
+	g_assert(!profile_enabled);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL );
+	g_test_add_func("/set1/test profile disabled", test_profile_disabled);
+	g_test_add_func("/set1/test profile nested", test_profile_nested);
+	return g_test_run();
+}
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+void construct_subcatchment(struct command_line_object *);
+int patch_in_subcatchment(struct command_line_object *, int, int, int);
+int zone_in_subcatchment(struct command_line_object *, int, int);
+int reach_in_subcatchment(struct command_line_object *, int);
+
+#define FLOW_TABLE "test_subcatchment.flow"
+#define STREAM_TABLE "test_subcatchment.stream"
+
+// Hillslope 1: 1 -> 2 -> 3 (stream), road 9 -> 1 with its cut draining
+// to 3, and 4 -> 5 (stream) with a zero gamma edge to 2.
+// Hillslope 2: 6 -> 7 (stream).
+static void write_flow_table(void) {
+	FILE *flow = fopen(FLOW_TABLE, "w");
+
+	g_assert(flow != NULL);
+	fprintf(flow, "2\n1\n6\n");
+	fprintf(flow, "1 1 1 0 0 10 1 1 0 0.5 1\n2 1 1 1.0\n");
+	fprintf(flow, "2 1 1 0 0 9 1 1 0 0.5 1\n3 1 1 1.0\n");
+	fprintf(flow, "3 1 1 0 0 8 1 1 1 0.0 0\n");
+	fprintf(flow, "9 1 1 0 0 11 1 1 2 0.5 1\n1 1 1 1.0\n3 1 1 10.0\n");
+	fprintf(flow, "4 2 1 0 0 9 1 1 0 0.5 2\n2 1 1 0.0\n5 2 1 1.0\n");
+	fprintf(flow, "5 2 1 0 0 8 1 1 1 0.0 0\n");
+	fprintf(flow, "2\n2\n");
+	fprintf(flow, "6 3 2 0 0 9 1 1 0 0.5 1\n7 3 2 1.0\n");
+	fprintf(flow, "7 3 2 0 0 7 1 1 1 0.0 0\n");
+	fclose(flow);
+}
+
+// Reach 2 flows into reach 1; reach 3 is on its own
+static void write_stream_table(void) {
+	FILE *stream = fopen(STREAM_TABLE, "w");
+
+	g_assert(stream != NULL);
+	fprintf(stream, "3\n");
+	fprintf(stream, "1 1 1 1 0.01 0.03 100 1\n3 1 1\n1 2\n0\n");
+	fprintf(stream, "2 1 1 1 0.01 0.03 100 1\n7 3 2\n0\n1 1\n");
+	fprintf(stream, "3 1 1 1 0.01 0.03 100 1\n5 2 1\n0\n0\n");
+	fclose(stream);
+}
+
+static void init_command_line(struct command_line_object *command_line) {
+	memset(command_line, 0, sizeof(struct command_line_object));
+	command_line[0].routing_flag = 1;
+	strcpy(command_line[0].routing_filename, FLOW_TABLE);
+	command_line[0].subcatchment_flag = 1;
+}
+
+void test_subcatchment() {
+	struct command_line_object command_line;
+
+	write_flow_table();
+	init_command_line(&command_line);
+	command_line.subcatchment_patch_ID = 2;
+	command_line.subcatchment_zone_ID = 1;
+	command_line.subcatchment_hill_ID = 1;
+	construct_subcatchment(&command_line);
+
+	g_assert_cmpint(command_line.num_subcatchment_patches, ==, 4);
+	g_assert(patch_in_subcatchment(&command_line, 1, 1, 1));
+	g_assert(patch_in_subcatchment(&command_line, 2, 1, 1));
+	g_assert(patch_in_subcatchment(&command_line, 9, 1, 1));
+	// The road's stream patch, though downstream of the outlet
+	g_assert(patch_in_subcatchment(&command_line, 3, 1, 1));
+	// Zero gamma edges do not count
+	g_assert(!patch_in_subcatchment(&command_line, 4, 2, 1));
+	g_assert(!patch_in_subcatchment(&command_line, 5, 2, 1));
+	g_assert(!patch_in_subcatchment(&command_line, 6, 3, 2));
+	g_assert(zone_in_subcatchment(&command_line, 1, 1));
+	g_assert(!zone_in_subcatchment(&command_line, 2, 1));
+	g_assert_cmpint(command_line.num_hillslope_subset, ==, 1);
+	g_assert_cmpint(command_line.hillslope_subset[0], ==, 1);
+
+	remove(FLOW_TABLE);
+}
+
+void test_subcatchment_stream_routing() {
+	struct command_line_object command_line;
+
+	write_flow_table();
+	write_stream_table();
+	init_command_line(&command_line);
+	command_line.stream_routing_flag = 1;
+	strcpy(command_line.stream_routing_filename, STREAM_TABLE);
+	command_line.subcatchment_patch_ID = 3;
+	command_line.subcatchment_zone_ID = 1;
+	command_line.subcatchment_hill_ID = 1;
+	construct_subcatchment(&command_line);
+
+	g_assert_cmpint(command_line.num_subcatchment_reaches, ==, 2);
+	g_assert(reach_in_subcatchment(&command_line, 1));
+	g_assert(reach_in_subcatchment(&command_line, 2));
+	g_assert(!reach_in_subcatchment(&command_line, 3));
+	// Reach 2 brings in hillslope 2
+	g_assert(patch_in_subcatchment(&command_line, 6, 3, 2));
+	g_assert(patch_in_subcatchment(&command_line, 7, 3, 2));
+	g_assert(!patch_in_subcatchment(&command_line, 5, 2, 1));
+	g_assert_cmpint(command_line.num_subcatchment_patches, ==, 6);
+	g_assert_cmpint(command_line.num_hillslope_subset, ==, 2);
+
+	remove(FLOW_TABLE);
+	remove(STREAM_TABLE);
+}
+
+void test_subcatchment_off() {
+	struct command_line_object command_line;
+
+	memset(&command_line, 0, sizeof(struct command_line_object));
+	g_assert(patch_in_subcatchment(&command_line, 4, 2, 1));
+	g_assert(zone_in_subcatchment(&command_line, 2, 1));
+	g_assert(reach_in_subcatchment(&command_line, 3));
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test subcatchment", test_subcatchment);
+	g_test_add_func("/set1/test subcatchment stream routing", test_subcatchment_stream_routing);
+	g_test_add_func("/set1/test subcatchment off", test_subcatchment_off);
+	return g_test_run();
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+struct worldfile_index_object *construct_worldfile_index(char *, long, int);
+void destroy_worldfile_index(struct worldfile_index_object *);
+int hillslope_in_subset(struct command_line_object *, int);
+int peek_worldfile_ID(FILE *, char *);
+void skip_worldfile_zone(FILE *);
+
+#define WORLD "test_worldfile_index.world"
+#define WORLD_INDEX WORLD ".idx"
+
+static long hillslope_offsets[3];
+
+// A world header line, one basin with three hillslopes, the last
+// with two zones, and a second basin after it
+static void write_world(int patches_in_last_zone) {
+	FILE *world = fopen(WORLD, "w");
+	int h, z, p, num_zones;
+
+	g_assert(world != NULL);
+	fprintf(world, "1\tworld_ID\n2\tnum_basins\n");
+	fprintf(world, "1\tbasin_ID\n0.0\tx\n1\tbasin_n_basestations\n101\tbasin_basestation_ID\n");
+	fprintf(world, "3\tnum_hillslopes\n");
+	for (h = 0; h < 3; h++) {
+		hillslope_offsets[h] = ftell(world);
+		num_zones = (h == 2) ? 2 : 1;
+		fprintf(world, "%d\thillslope_ID\n0.0\tx\n0\thillslope_n_basestations\n", 10 + h);
+		fprintf(world, "%d\tnum_zones\n", num_zones);
+		for (z = 0; z < num_zones; z++) {
+			fprintf(world, "%d\tzone_ID\n1\tzone_n_basestations\n101\tzone_basestation_ID\n",
+				100 * h + z);
+			fprintf(world, "%d\tnum_patches\n", (z == 1) ? patches_in_last_zone : 1);
+			for (p = 0; p < ((z == 1) ? patches_in_last_zone : 1); p++) {
+				fprintf(world, "%d\tpatch_ID\n0\tpatch_n_basestations\n1\tnum_canopy_strata\n",
+					1000 * h + 10 * z + p);
+				fprintf(world, "%d\tcanopy_strata_ID\n0\tcanopy_strata_n_basestations\n",
+					10000 * h + 100 * z + p);
+			}
+		}
+	}
+	fprintf(world, "2\tbasin_ID\n0\tbasin_n_basestations\n0\tnum_hillslopes\n");
+	fclose(world);
+}
+
+static void check_index(struct worldfile_index_object *index, int patches_in_last_zone) {
+	struct basin_index_object *basin;
+	int h;
+
+	g_assert(index != NULL);
+	g_assert_cmpint(index[0].num_basins, ==, 2);
+	basin = &(index[0].basins[0]);
+	g_assert_cmpint(basin[0].ID, ==, 1);
+	g_assert_cmpint(basin[0].num_hillslopes, ==, 3);
+	for (h = 0; h < 3; h++) {
+		g_assert_cmpint(basin[0].hillslopes[h].ID, ==, 10 + h);
+		g_assert_cmpint(basin[0].hillslopes[h].offset, ==, hillslope_offsets[h]);
+	}
+	g_assert_cmpint(basin[0].hillslopes[2].num_zones, ==, 2);
+	g_assert_cmpint(basin[0].hillslopes[2].num_patches, ==, 1 + patches_in_last_zone);
+	g_assert_cmpint(basin[0].hillslopes[2].num_strata, ==, 1 + patches_in_last_zone);
+	// The second basin starts where the first ends
+	g_assert_cmpint(index[0].basins[1].ID, ==, 2);
+	g_assert_cmpint(index[0].basins[1].offset, ==, basin[0].end_offset);
+	g_assert_cmpint(index[0].basins[1].num_hillslopes, ==, 0);
+}
+
+void test_worldfile_index() {
+	struct worldfile_index_object *index;
+	FILE *sidecar;
+	long offset = strlen("1\tworld_ID\n2\tnum_basins\n");
+
+	remove(WORLD_INDEX);
+	write_world(2);
+	index = construct_worldfile_index(WORLD, offset, 2);
+	check_index(index, 2);
+	destroy_worldfile_index(index);
+	sidecar = fopen(WORLD_INDEX, "r");
+	g_assert(sidecar != NULL);
+	fclose(sidecar);
+
+	// Read back from the sidecar
+	index = construct_worldfile_index(WORLD, offset, 2);
+	check_index(index, 2);
+	destroy_worldfile_index(index);
+
+	// A changed worldfile is indexed again
+	write_world(3);
+	index = construct_worldfile_index(WORLD, offset, 2);
+	check_index(index, 3);
+	destroy_worldfile_index(index);
+
+	// A worldfile with fewer basins than expected has no index
+	g_assert(construct_worldfile_index(WORLD, offset, 3) == NULL);
+
+	remove(WORLD);
+	remove(WORLD_INDEX);
+}
+
+void test_skip_worldfile_zone() {
+	struct worldfile_index_object *index;
+	FILE *world;
+	long offset = strlen("1\tworld_ID\n2\tnum_basins\n");
+
+	write_world(2);
+	index = construct_worldfile_index(WORLD, offset, 2);
+	g_assert(index != NULL);
+	world = fopen(WORLD, "r");
+	g_assert(world != NULL);
+	// The first zone of the last hillslope, after its header
+	fseek(world, hillslope_offsets[2] + strlen("12\thillslope_ID\n0.0\tx\n"
+		"0\thillslope_n_basestations\n2\tnum_zones\n"), SEEK_SET);
+	g_assert_cmpint(peek_worldfile_ID(world, "zone_ID"), ==, 200);
+	g_assert_cmpint(peek_worldfile_ID(world, "zone_ID"), ==, 200);
+	skip_worldfile_zone(world);
+	g_assert_cmpint(peek_worldfile_ID(world, "zone_ID"), ==, 201);
+	skip_worldfile_zone(world);
+	g_assert_cmpint(ftell(world), ==, index[0].basins[0].end_offset);
+	fclose(world);
+	destroy_worldfile_index(index);
+
+	remove(WORLD);
+	remove(WORLD_INDEX);
+}
+
+void test_hillslope_in_subset() {
+	struct command_line_object command_line;
+	int subset[] = {3, 7, 12};
+
+	command_line.num_hillslope_subset = 0;
+	command_line.hillslope_subset = NULL;
+	g_assert(hillslope_in_subset(&command_line, 5));
+	command_line.num_hillslope_subset = 3;
+	command_line.hillslope_subset = subset;
+	g_assert(hillslope_in_subset(&command_line, 7));
+	g_assert(hillslope_in_subset(&command_line, 12));
+	g_assert(!hillslope_in_subset(&command_line, 5));
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test worldfile index", test_worldfile_index);
+	g_test_add_func("/set1/test skip worldfile zone", test_skip_worldfile_zone);
+	g_test_add_func("/set1/test hillslope in subset", test_hillslope_in_subset);
+	return g_test_run();
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+void update_zone_canopy_sums(struct zone_object *);
+void input_new_patch(struct command_line_object *, FILE *, int,
+	struct base_station_object **, struct default_object *,
+	struct basin_object *, struct patch_object *);
+
+#define REDEFINE "test_zone_canopy_sums.world"
+
+static struct zone_object zone;
+static struct patch_object patch[2];
+static struct patch_object *patches[2];
+static struct soil_default soil;
+static struct soil_default *soil_defaults[1];
+static struct landuse_default landuse;
+static struct landuse_default *landuse_defaults[1];
+
+// A zone of two 10 m^2 patches with lai 1 and 3, its sums up to date
+static void init_zone(void) {
+	int p;
+
+	memset(&zone, 0, sizeof(zone));
+	memset(patch, 0, sizeof(patch));
+	memset(&soil, 0, sizeof(soil));
+	memset(&landuse, 0, sizeof(landuse));
+	soil.porosity_0 = 0.5;
+	soil.porosity_decay = 4000.0;
+	soil.soil_depth = 2.0;
+	soil_defaults[0] = &soil;
+	landuse_defaults[0] = &landuse;
+	for (p = 0; p < 2; p++) {
+		patch[p].ID = p + 1;
+		patch[p].area = 10.0;
+		patch[p].lai = 1.0 + 2.0 * p;
+		patch[p].effective_lai = patch[p].lai;
+		patch[p].soil_defaults = soil_defaults;
+		patch[p].landuse_defaults = landuse_defaults;
+		patch[p].zone = &zone;
+		patches[p] = &patch[p];
+	}
+	zone.area = 20.0;
+	zone.num_patches = 2;
+	zone.patches = patches;
+	zone.canopy_sums_age = ZONE_CANOPY_RESYNC_DAYS;
+	update_zone_canopy_sums(&zone);
+}
+
+void test_zone_canopy_sums_resync() {
+	init_zone();
+	g_assert_cmpint(zone.canopy_sums_age, ==, 1);
+	g_assert(zone.lai_sum == 40.0);
+	g_assert(zone.lai == 2.0);
+
+	// Between resyncs the zone means come from the running sums
+	zone.lai_sum += (2.0 - patch[1].lai) * patch[1].area;
+	patch[1].lai = 2.0;
+	update_zone_canopy_sums(&zone);
+	g_assert_cmpint(zone.canopy_sums_age, ==, 2);
+	g_assert(zone.lai == 1.5);
+}
+
+void test_zone_canopy_sums_redefine_area() {
+	struct command_line_object command_line;
+	struct default_object defaults;
+	struct basin_object basin;
+	FILE *file;
+
+	init_zone();
+	memset(&command_line, 0, sizeof(command_line));
+	memset(&defaults, 0, sizeof(defaults));
+	memset(&basin, 0, sizeof(basin));
+
+	file = fopen(REDEFINE, "w");
+	g_assert(file != NULL);
+	fprintf(file, "30.0\tarea\n0\tpatch_n_basestations\n");
+	fclose(file);
+	file = fopen(REDEFINE, "r");
+	g_assert(file != NULL);
+	input_new_patch(&command_line, file, 0, NULL, &defaults, &basin, &patch[0]);
+	fclose(file);
+	g_assert(patch[0].area == 30.0);
+	g_assert_cmpint(zone.canopy_sums_age, ==, ZONE_CANOPY_RESYNC_DAYS);
+
+	// The sums are redone with the new area rather than carried over
+	update_zone_canopy_sums(&zone);
+	g_assert(zone.lai_sum == 30.0 * 1.0 + 10.0 * 3.0);
+	g_assert(zone.effective_lai_sum == zone.lai_sum);
+	g_assert(zone.lai == 60.0 / 20.0);
+
+	remove(REDEFINE);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test zone canopy sums resync", test_zone_canopy_sums_resync);
+	g_test_add_func("/set1/test zone canopy sums redefine area", test_zone_canopy_sums_redefine_area);
+	return g_test_run();
+}
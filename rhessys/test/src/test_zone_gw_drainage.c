@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "rhessys.h"
+
+int update_gw_drainage(struct patch_object *, struct hillslope_object *,
+	struct zone_object *, struct command_line_object *, struct date);
+void add_zone_gw_drainage(struct hillslope_object *);
+
+void test_zone_gw_drainage() {
+	struct hillslope_object hillslope;
+	struct zone_object zone[2], *zones[2];
+	struct patch_object patch[3], *patches[3];
+	struct soil_default soil, *soil_defaults[1];
+	struct command_line_object command_line;
+	struct date date = {0};
+	int p;
+
+	memset(&hillslope, 0, sizeof(hillslope));
+	memset(zone, 0, sizeof(zone));
+	memset(patch, 0, sizeof(patch));
+	memset(&soil, 0, sizeof(soil));
+	memset(&command_line, 0, sizeof(command_line));
+
+	// Half of each patch's detention store and surface NO3 drains
+	soil.sat_to_gw_coeff = 0.5;
+	soil_defaults[0] = &soil;
+	for (p = 0; p < 3; p++) {
+		patch[p].area = 10.0 * (p + 1);
+		patch[p].Ksat_vertical = 1.0;
+		patch[p].detention_store = 0.2;
+		patch[p].surface_NO3 = 0.02;
+		patch[p].soil_defaults = soil_defaults;
+		patches[p] = &patch[p];
+	}
+	// Zone 0 has the first patch, zone 1 the other two
+	zone[0].num_patches = 1;
+	zone[0].patches = &patches[0];
+	zone[1].num_patches = 2;
+	zone[1].patches = &patches[1];
+	zones[0] = &zone[0];
+	zones[1] = &zone[1];
+	hillslope.area = 60.0;
+	hillslope.num_zones = 2;
+	hillslope.zones = zones;
+	hillslope.gw.storage = 1.0;
+
+	for (p = 0; p < 3; p++) {
+		g_assert_cmpint(update_gw_drainage(&patch[p], &hillslope,
+			(p == 0) ? &zone[0] : &zone[1], &command_line, date), ==, 0);
+		g_assert(patch[p].detention_store == 0.1);
+	}
+	// Nothing reaches the hillslope until its zones are done
+	g_assert(hillslope.gw.storage == 1.0);
+	g_assert(zone[0].gw_drainage.storage == 0.1 * 10.0 / 60.0);
+	g_assert(zone[1].gw_drainage.storage == 0.1 * 20.0 / 60.0 + 0.1 * 30.0 / 60.0);
+
+	add_zone_gw_drainage(&hillslope);
+	// The zone sums are added in zone order
+	g_assert(hillslope.gw.storage == (1.0 + 0.1 * 10.0 / 60.0)
+		+ (0.1 * 20.0 / 60.0 + 0.1 * 30.0 / 60.0));
+	g_assert(hillslope.gw.NO3 == 0.01 * 10.0 / 60.0
+		+ (0.01 * 20.0 / 60.0 + 0.01 * 30.0 / 60.0));
+	g_assert(zone[0].gw_drainage.storage == 0.0);
+	g_assert(zone[1].gw_drainage.NO3 == 0.0);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+	g_test_add_func("/set1/test zone gw drainage", test_zone_gw_drainage);
+	return g_test_run();
+}
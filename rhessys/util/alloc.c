@@ -23,12 +23,17 @@
 /*	is used.  If malloc returns a NULL pointer a fatal			*/
 /* 	error results.												*/
 /*																*/
+/*	With -memprofile each array is recorded under its			*/
+/*	array_name and calling_function (see alloc_accounting.h);	*/
+/*	alloc_free releases an array and credits it back.			*/
+/*																*/
 /*	PROGRAMMER NOTES											*/
 /*	The routine performs as follows:							*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include "alloc_accounting.h"
 
 void	*alloc(size_t size, char *array_name, char *calling_function)
 {
@@ -72,6 +77,8 @@ void	*alloc(size_t size, char *array_name, char *calling_function)
 			/*		Initialize array to zero								*/
 			/*--------------------------------------------------------------*/
 			memset(array, 0, size);
+			if ( alloc_accounting_enabled )
+				alloc_accounting_add(array, size, array_name, calling_function);
 			/*--------------------------------------------------------------*/
 			/*			Return pointer to allocated array.	*/
 			/*--------------------------------------------------------------*/
@@ -79,6 +86,13 @@ void	*alloc(size_t size, char *array_name, char *calling_function)
 		}
 	}
 } /*end alloc.c*/
+
+void	alloc_free(void *array)
+{
+	if ( alloc_accounting_enabled )
+		alloc_accounting_remove(array);
+	free(array);
+} /*end alloc_free*/
 #ifdef LIU_NETCDF_READER
 int is_approximately(const double value,const double target,const double tolerance)
 { return ((value) < ((target) +(tolerance))) && ((value) > ((target) - (tolerance)));}
@@ -0,0 +1,299 @@
+/** @file alloc_accounting.c
+ *  @brief Implements the allocation accounting declared in
+ *  alloc_accounting.h.
+ *
+ *  Tags and live blocks are kept in two open addressing hash tables.  The
+ *  tables, their counts and the live and peak totals are only touched
+ *  with accounting enabled and inside the alloc_accounting critical
+ *  section, so alloc() and alloc_free() may be called from OpenMP loops
+ *  such as the parallel indexed hillslope load in construct_basin.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+
+#include "alloc_accounting.h"
+
+#define ALLOC_TABLE_MIN 1024
+#define ALLOC_EMPTY -1
+
+int alloc_accounting_enabled = 0;
+
+typedef struct {
+	char *array_name;
+	char *calling_function;
+	size_t live;
+	size_t peak;
+	size_t total;
+	size_t calls;
+	size_t frees;
+} AllocTag;
+
+typedef struct {
+	void *array;
+	size_t size;
+	int tag;
+} AllocBlock;
+
+static AllocTag *tags = NULL;
+static int num_tags = 0;
+static int max_tags = 0;
+// Tag indices by hash of the tag names, ALLOC_EMPTY when unused
+static int *tag_slots = NULL;
+static size_t tag_slots_len = 0;
+
+static AllocBlock *blocks = NULL;
+static size_t num_blocks = 0;
+static size_t blocks_len = 0;
+
+static size_t total_live = 0;
+static size_t total_peak = 0;
+static char *report_filename = NULL;
+static volatile sig_atomic_t report_requested = 0;
+
+static void *accounting_calloc(size_t n, size_t size) {
+	void *p = calloc(n, size);
+	if (p == NULL) {
+		fprintf(stderr, "FATAL ERROR: unable to allocate memory accounting tables\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+static uint64_t hash_string(uint64_t h, const char *s) {
+	// FNV-1a
+	for (; *s != '\0'; s++) {
+		h ^= (unsigned char)*s;
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+static uint64_t hash_pointer(void *p) {
+	uint64_t h = (uint64_t)(uintptr_t)p;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	return h;
+}
+
+static uint64_t hash_tag(const char *array_name, const char *calling_function) {
+	return hash_string(hash_string(14695981039346656037ull, array_name), calling_function);
+}
+
+static void grow_tag_slots(void) {
+	size_t len = (tag_slots_len == 0) ? ALLOC_TABLE_MIN : 2 * tag_slots_len;
+	int *slots = accounting_calloc(len, sizeof(int));
+	for (size_t i = 0; i < len; i++) slots[i] = ALLOC_EMPTY;
+	for (int t = 0; t < num_tags; t++) {
+		size_t i = hash_tag(tags[t].array_name, tags[t].calling_function) & (len - 1);
+		while (slots[i] != ALLOC_EMPTY) i = (i + 1) & (len - 1);
+		slots[i] = t;
+	}
+	free(tag_slots);
+	tag_slots = slots;
+	tag_slots_len = len;
+}
+
+static int find_tag(const char *array_name, const char *calling_function) {
+	if (array_name == NULL) array_name = "(unnamed)";
+	if (calling_function == NULL) calling_function = "(unknown)";
+
+	size_t i = hash_tag(array_name, calling_function) & (tag_slots_len - 1);
+	while (tag_slots[i] != ALLOC_EMPTY) {
+		AllocTag *t = &tags[tag_slots[i]];
+		if (strcmp(t->array_name, array_name) == 0
+				&& strcmp(t->calling_function, calling_function) == 0) {
+			return tag_slots[i];
+		}
+		i = (i + 1) & (tag_slots_len - 1);
+	}
+
+	// New tag; names are copied since callers may pass buffers
+	if (num_tags == max_tags) {
+		max_tags = (max_tags == 0) ? 256 : 2 * max_tags;
+		AllocTag *grown = realloc(tags, max_tags * sizeof(AllocTag));
+		if (grown == NULL) {
+			fprintf(stderr, "FATAL ERROR: unable to allocate memory accounting tables\n");
+			exit(EXIT_FAILURE);
+		}
+		tags = grown;
+	}
+	AllocTag *t = &tags[num_tags];
+	memset(t, 0, sizeof(AllocTag));
+	t->array_name = accounting_calloc(strlen(array_name) + 1, 1);
+	strcpy(t->array_name, array_name);
+	t->calling_function = accounting_calloc(strlen(calling_function) + 1, 1);
+	strcpy(t->calling_function, calling_function);
+	tag_slots[i] = num_tags++;
+	if (2 * (size_t)num_tags > tag_slots_len) grow_tag_slots();
+	return num_tags - 1;
+}
+
+static void grow_blocks(void) {
+	size_t len = (blocks_len == 0) ? ALLOC_TABLE_MIN : 2 * blocks_len;
+	AllocBlock *grown = accounting_calloc(len, sizeof(AllocBlock));
+	for (size_t b = 0; b < blocks_len; b++) {
+		if (blocks[b].array == NULL) continue;
+		size_t i = hash_pointer(blocks[b].array) & (len - 1);
+		while (grown[i].array != NULL) i = (i + 1) & (len - 1);
+		grown[i] = blocks[b];
+	}
+	free(blocks);
+	blocks = grown;
+	blocks_len = len;
+}
+
+static size_t find_block(void *array) {
+	size_t i = hash_pointer(array) & (blocks_len - 1);
+	while (blocks[i].array != NULL && blocks[i].array != array) i = (i + 1) & (blocks_len - 1);
+	return i;
+}
+
+// Credit a block back to its tag and close the gap it leaves in the table
+static void release_block(size_t i) {
+	AllocTag *t = &tags[blocks[i].tag];
+	t->live -= blocks[i].size;
+	t->frees++;
+	total_live -= blocks[i].size;
+	num_blocks--;
+
+	size_t j = i;
+	for (;;) {
+		j = (j + 1) & (blocks_len - 1);
+		if (blocks[j].array == NULL) break;
+		size_t home = hash_pointer(blocks[j].array) & (blocks_len - 1);
+		// Move block j into the gap unless its home slot lies in (i, j]
+		if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+			blocks[i] = blocks[j];
+			i = j;
+		}
+	}
+	blocks[i].array = NULL;
+}
+
+static void report_signal(int sig) {
+	report_requested = 1;
+	signal(sig, report_signal);
+}
+
+static void report_at_exit(void) {
+	report_requested = 1;
+	alloc_accounting_poll();
+}
+
+void alloc_accounting_init(char *filename) {
+	if (alloc_accounting_enabled) return;
+	grow_tag_slots();
+	grow_blocks();
+	// The command line is destroyed before the report at exit
+	if (filename != NULL) {
+		report_filename = accounting_calloc(strlen(filename) + 1, 1);
+		strcpy(report_filename, filename);
+	}
+	alloc_accounting_enabled = 1;
+	atexit(report_at_exit);
+#ifdef SIGUSR1
+	signal(SIGUSR1, report_signal);
+#endif
+}
+
+void alloc_accounting_add(void *array, size_t size, const char *array_name,
+		const char *calling_function) {
+	if (array == NULL) return;
+	#pragma omp critical(alloc_accounting)
+	{
+		size_t i = find_block(array);
+		// Seen before: the block was released with plain free()
+		if (blocks[i].array != NULL) {
+			release_block(i);
+			i = find_block(array);
+		}
+		int tag = find_tag(array_name, calling_function);
+		AllocTag *t = &tags[tag];
+		blocks[i].array = array;
+		blocks[i].size = size;
+		blocks[i].tag = tag;
+		num_blocks++;
+		t->calls++;
+		t->total += size;
+		t->live += size;
+		if (t->live > t->peak) t->peak = t->live;
+		total_live += size;
+		if (total_live > total_peak) total_peak = total_live;
+		if (2 * num_blocks > blocks_len) grow_blocks();
+	}
+	alloc_accounting_poll();
+}
+
+void alloc_accounting_remove(void *array) {
+	if (array == NULL) return;
+	#pragma omp critical(alloc_accounting)
+	{
+		size_t i = find_block(array);
+		if (blocks[i].array != NULL) release_block(i);
+	}
+}
+
+void alloc_accounting_poll(void) {
+	if (!report_requested) return;
+	// Only one of the threads that see a request writes the report
+	int requested;
+	#pragma omp critical(alloc_accounting)
+	{
+		requested = report_requested;
+		report_requested = 0;
+	}
+	if (!requested) return;
+	if (report_filename == NULL) {
+		alloc_accounting_report(stderr);
+		return;
+	}
+	FILE *out = fopen(report_filename, "a");
+	if (out == NULL) {
+		fprintf(stderr, "WARNING: unable to open memory report %s, writing it to stderr\n",
+				report_filename);
+		alloc_accounting_report(stderr);
+		return;
+	}
+	alloc_accounting_report(out);
+	fclose(out);
+}
+
+static int compare_peak(const void *a, const void *b) {
+	const AllocTag *ta = &tags[*(const int *)a];
+	const AllocTag *tb = &tags[*(const int *)b];
+	if (ta->peak != tb->peak) return (ta->peak < tb->peak) ? 1 : -1;
+	if (ta->live != tb->live) return (ta->live < tb->live) ? 1 : -1;
+	return (*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b);
+}
+
+void alloc_accounting_report(FILE *out) {
+	if (!alloc_accounting_enabled) return;
+	#pragma omp critical(alloc_accounting)
+	{
+		int *order = accounting_calloc((size_t)num_tags + 1, sizeof(int));
+		for (int t = 0; t < num_tags; t++) order[t] = t;
+		qsort(order, (size_t)num_tags, sizeof(int), compare_peak);
+
+		time_t now = time(NULL);
+		fprintf(out, "\nMemory allocated with alloc() at %s", ctime(&now));
+		fprintf(out, "%.3f MB live, %.3f MB peak in %zu blocks, %d tags\n",
+				total_live / 1048576.0, total_peak / 1048576.0, num_blocks, num_tags);
+		fprintf(out, "%14s %14s %14s %12s %12s  %-32s %s\n",
+				"live (MB)", "peak (MB)", "total (MB)", "calls", "frees", "array_name", "calling_function");
+		for (int k = 0; k < num_tags; k++) {
+			AllocTag *t = &tags[order[k]];
+			fprintf(out, "%14.3f %14.3f %14.3f %12zu %12zu  %-32s %s\n",
+					t->live / 1048576.0, t->peak / 1048576.0, t->total / 1048576.0,
+					t->calls, t->frees, t->array_name, t->calling_function);
+		}
+		fflush(out);
+		free(order);
+	}
+}
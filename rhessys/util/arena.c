@@ -0,0 +1,135 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		arena						*/
+/*								*/
+/*	arena.c - allocate a hillslope's objects together	*/
+/*								*/
+/*	NAME							*/
+/*	arena.c - allocate a hillslope's objects together	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct arena_object *construct_arena(char *)		*/
+/*	void	*arena_alloc(struct arena_object *, size_t,	*/
+/*			char *, char *)				*/
+/*	void	destroy_arena(struct arena_object *)		*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	construct_hillslope gives each hillslope an arena, and	*/
+/*	its zones, patches, canopy strata, their pointer lists	*/
+/*	and the patches' innundation lists are carved out of it	*/
+/*	in the order they are constructed, which is the order	*/
+/*	hillslope_daily_F visits them.  destroy_hillslope frees	*/
+/*	the whole arena at once instead of every object.	*/
+/*								*/
+/*	Memory comes from chunks allocated with alloc(), so it	*/
+/*	is zeroed like alloc() memory.  Chunks start small, so	*/
+/*	small hillslopes waste little, and double up to		*/
+/*	ARENA_MAX_CHUNK.					*/
+/*								*/
+/*	arena_alloc with a NULL arena is alloc(); that is how	*/
+/*	objects are allocated with -memprofile, so each keeps	*/
+/*	its own tag in the memory report.			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	Memory from an arena must never be passed to free().	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+#define ARENA_MIN_CHUNK (64 * 1024)
+#define ARENA_MAX_CHUNK (4 * 1024 * 1024)
+
+/* Keep every object aligned for doubles and long doubles */
+#define ARENA_ALIGN 16
+#define ARENA_ROUND(n) (((n) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+struct arena_object *construct_arena(char *calling_function)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	struct arena_object *arena;
+
+	arena = (struct arena_object *) alloc(1 * sizeof(struct arena_object),
+		"arena", calling_function);
+	arena[0].chunks = NULL;
+	arena[0].next_chunk_size = ARENA_MIN_CHUNK;
+	arena[0].num_bytes = 0;
+	return(arena);
+} /*end construct_arena*/
+
+void	*arena_alloc(struct arena_object *arena, size_t size,
+		char *array_name, char *calling_function)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	size_t	chunk_size;
+	char	*array;
+	struct arena_chunk_object *chunk;
+
+	if (arena == NULL)
+		return(alloc(size, array_name, calling_function));
+	if (size == 0)
+		return(NULL);
+
+	size = ARENA_ROUND(size);
+	chunk = arena[0].chunks;
+	if ((chunk == NULL) || (chunk[0].used + size > chunk[0].size)) {
+		/*--------------------------------------------------------------*/
+		/*	Start a new chunk, big enough for this array.		*/
+		/*--------------------------------------------------------------*/
+		chunk_size = arena[0].next_chunk_size;
+		while (chunk_size < size)
+			chunk_size *= 2;
+		if (arena[0].next_chunk_size < ARENA_MAX_CHUNK)
+			arena[0].next_chunk_size *= 2;
+		chunk = (struct arena_chunk_object *) alloc(
+			ARENA_ROUND(sizeof(struct arena_chunk_object)) + chunk_size,
+			"arena_chunk", "arena_alloc");
+		chunk[0].base = (char *) chunk + ARENA_ROUND(sizeof(struct arena_chunk_object));
+		chunk[0].size = chunk_size;
+		chunk[0].used = 0;
+		chunk[0].next = arena[0].chunks;
+		arena[0].chunks = chunk;
+		arena[0].num_bytes += chunk_size;
+	}
+	array = chunk[0].base + chunk[0].used;
+	chunk[0].used += size;
+	return(array);
+} /*end arena_alloc*/
+
+void	destroy_arena(struct arena_object *arena)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	struct arena_chunk_object *chunk, *next;
+
+	if (arena == NULL) return;
+	for (chunk = arena[0].chunks; chunk != NULL; chunk = next) {
+		next = chunk[0].next;
+		alloc_free(chunk);
+	}
+	alloc_free(arena);
+} /*end destroy_arena*/
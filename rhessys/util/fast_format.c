@@ -0,0 +1,317 @@
+/** @file fast_format.c
+ *  @brief Implements the row builder and fast_fprintf() declared in
+ *  fast_format.h.
+ *
+ *  A row lives in the FastFormatRow's own storage until it outgrows it,
+ *  then on the heap, so rows of any length are written in one piece and
+ *  threads writing different rows share nothing.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "fast_format.h"
+
+/* Longest conversion specification copied for snprintf */
+#define FAST_FORMAT_SPEC_LEN 32
+
+int fast_format_decimals = FAST_FORMAT_DEFAULT_DECIMALS;
+
+static const double pow10_double[FAST_FORMAT_MAX_DECIMALS + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+	1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+static const uint64_t pow10_int[FAST_FORMAT_MAX_DECIMALS + 1] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+	100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+	1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL
+};
+
+void fast_format_set_decimals(int decimals)
+{
+	if (decimals < 0 || decimals > FAST_FORMAT_MAX_DECIMALS) {
+		fprintf(stderr, "FATAL ERROR: output precision must be between 0 and %d digits, not %d.\n",
+			FAST_FORMAT_MAX_DECIMALS, decimals);
+		exit(EXIT_FAILURE);
+	}
+	fast_format_decimals = decimals;
+}
+
+void fast_format_row_init(FastFormatRow *row)
+{
+	row->buf = row->local;
+	row->len = 0;
+	row->size = FAST_FORMAT_ROW_LEN;
+}
+
+void fast_format_row_free(FastFormatRow *row)
+{
+	if (row->buf != row->local) free(row->buf);
+	fast_format_row_init(row);
+}
+
+static char *reserve(FastFormatRow *row, size_t n)
+{
+	if (row->len + n > row->size) {
+		size_t size = 2 * row->size;
+		while (row->len + n > size) size *= 2;
+		char *buf = (row->buf == row->local) ? malloc(size) : realloc(row->buf, size);
+		if (buf == NULL) {
+			fprintf(stderr, "FATAL ERROR: fast_format: unable to grow row to %zu bytes.\n", size);
+			exit(EXIT_FAILURE);
+		}
+		if (row->buf == row->local) memcpy(buf, row->local, row->len);
+		row->buf = buf;
+		row->size = size;
+	}
+	return row->buf + row->len;
+}
+
+static void append_bytes(FastFormatRow *row, const char *s, size_t n)
+{
+	memcpy(reserve(row, n), s, n);
+	row->len += n;
+}
+
+void fast_format_append_string(FastFormatRow *row, const char *s)
+{
+	append_bytes(row, s, strlen(s));
+}
+
+/* Digits of n, right to left, ending at end; returns the first digit */
+static char *format_digits(char *end, uint64_t n)
+{
+	do {
+		*--end = (char)('0' + n % 10);
+		n /= 10;
+	} while (n != 0);
+	return end;
+}
+
+void fast_format_append_long(FastFormatRow *row, long n)
+{
+	char digits[24];
+	char *end = digits + sizeof(digits);
+	uint64_t u = (n < 0) ? (uint64_t)0 - (uint64_t)n : (uint64_t)n;
+	char *start = format_digits(end, u);
+	if (n < 0) *--start = '-';
+	append_bytes(row, start, (size_t)(end - start));
+}
+
+/*--------------------------------------------------------------*/
+/*	printf prints the exact binary value of x rounded to	*/
+/*	decimals places, ties to even.  a * 10^decimals is p + e	*/
+/*	exactly (e from fma), and as long as p < 2^52 the	*/
+/*	fraction of p is exact and e is less than half a unit	*/
+/*	in its last place, so e only decides exact halves.	*/
+/*--------------------------------------------------------------*/
+void fast_format_append_double(FastFormatRow *row, double x, int decimals)
+{
+	char digits[48];
+	char *end = digits + sizeof(digits);
+	char *start;
+	double a, p, e, fl, frac;
+	uint64_t n, scale;
+	int i;
+
+	if (decimals < 0 || decimals > FAST_FORMAT_MAX_DECIMALS || !isfinite(x)
+		|| fabs(x) * pow10_double[decimals] >= 4503599627370496.0) {
+		int len = snprintf(NULL, 0, "%.*f", decimals, x);
+		char *buf = reserve(row, (size_t)len + 1);
+		snprintf(buf, (size_t)len + 1, "%.*f", decimals, x);
+		row->len += (size_t)len;
+		return;
+	}
+
+	a = fabs(x);
+	p = a * pow10_double[decimals];
+	e = fma(a, pow10_double[decimals], -p);
+	fl = floor(p);
+	frac = p - fl;
+	if ((frac > 0.5) || ((frac == 0.5)
+		&& ((e > 0.0) || ((e == 0.0) && (fmod(fl, 2.0) != 0.0)))))
+		fl += 1.0;
+
+	n = (uint64_t)fl;
+	scale = pow10_int[decimals];
+	start = end;
+	if (decimals > 0) {
+		uint64_t f = n % scale;
+		for (i = 0; i < decimals; i++) {
+			*--start = (char)('0' + f % 10);
+			f /= 10;
+		}
+		*--start = '.';
+	}
+	start = format_digits(start, n / scale);
+	if (signbit(x)) *--start = '-';
+	append_bytes(row, start, (size_t)(end - start));
+}
+
+int fast_format_write_row(FastFormatRow *row, FILE *fp)
+{
+	size_t len = row->len;
+	size_t written = fwrite(row->buf, 1, len, fp);
+	row->len = 0;
+	return (written == len) ? (int)len : -1;
+}
+
+/*--------------------------------------------------------------*/
+/*	A conversion specification that needs snprintf, with	*/
+/*	the argument it consumes.				*/
+/*--------------------------------------------------------------*/
+static int format_spec(char *buf, size_t room, const char *spec, char conversion,
+	int length, va_list *args)
+{
+	switch (conversion) {
+	case 'd': case 'i': case 'c':
+		if (length >= 2) return(snprintf(buf, room, spec, va_arg(*args, long long)));
+		if (length == 1) return(snprintf(buf, room, spec, va_arg(*args, long)));
+		return(snprintf(buf, room, spec, va_arg(*args, int)));
+	case 'u': case 'o': case 'x': case 'X':
+		if (length >= 2) return(snprintf(buf, room, spec, va_arg(*args, unsigned long long)));
+		if (length == 1) return(snprintf(buf, room, spec, va_arg(*args, unsigned long)));
+		return(snprintf(buf, room, spec, va_arg(*args, unsigned int)));
+	case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+		if (length < 0) return(snprintf(buf, room, spec, va_arg(*args, long double)));
+		return(snprintf(buf, room, spec, va_arg(*args, double)));
+	case 's':
+		return(snprintf(buf, room, spec, va_arg(*args, char *)));
+	case 'p':
+		return(snprintf(buf, room, spec, va_arg(*args, void *)));
+	default:
+		return(-1);
+	}
+}
+
+static int append_spec(FastFormatRow *row, const char *spec, char conversion,
+	int length, va_list *args)
+{
+	va_list value;
+	size_t room;
+	int len;
+
+	for (;;) {
+		room = row->size - row->len;
+		va_copy(value, *args);
+		len = format_spec(row->buf + row->len, room, spec, conversion, length, &value);
+		va_end(value);
+		if (len < 0) return(-1);
+		if ((size_t)len < room) break;
+		reserve(row, (size_t)len + 1);
+	}
+	row->len += (size_t)len;
+	/* Consume the argument for real */
+	format_spec(NULL, 0, spec, conversion, length, args);
+	return(0);
+}
+
+static int vformat_row(FastFormatRow *row, const char *format, va_list *args)
+{
+	const char *s = format;
+	const char *spec_start, *text;
+	char spec[FAST_FORMAT_SPEC_LEN];
+	int length, plain;
+
+	while (*s != '\0') {
+		text = s;
+		while ((*s != '\0') && (*s != '%')) s++;
+		if (s > text) append_bytes(row, text, (size_t)(s - text));
+		if (*s == '\0') break;
+
+		/*--------------------------------------------------------------*/
+		/*	Parse one conversion specification.			*/
+		/*--------------------------------------------------------------*/
+		spec_start = s++;
+		plain = 1;
+		while ((*s != '\0') && (strchr("-+ #0123456789.*", *s) != NULL)) {
+			if (*s == '*') return(-1);
+			plain = 0;
+			s++;
+		}
+		length = 0;
+		while ((*s == 'l') || (*s == 'h') || (*s == 'L') || (*s == 'z')
+			|| (*s == 'j') || (*s == 't')) {
+			if (*s == 'l') length++;
+			else if (*s == 'L') length = -1;
+			else if ((*s == 'z') || (*s == 'j') || (*s == 't')) length = 2;
+			else plain = 0;
+			s++;
+		}
+		if (*s == '\0') return(-1);
+
+		if (*s == '%') {
+			append_bytes(row, "%", 1);
+		}
+		else if (plain && ((*s == 'd') || (*s == 'i')) && (length >= 0) && (length < 2)) {
+			if (length == 1) fast_format_append_long(row, va_arg(*args, long));
+			else fast_format_append_long(row, (long)va_arg(*args, int));
+		}
+		else if (plain && ((*s == 'f') || (*s == 'F')) && (length >= 0)) {
+			fast_format_append_double(row, va_arg(*args, double), fast_format_decimals);
+		}
+		else if (plain && (*s == 's') && (length == 0)) {
+			fast_format_append_string(row, va_arg(*args, char *));
+		}
+		else {
+			if ((size_t)(s - spec_start + 1) >= FAST_FORMAT_SPEC_LEN) return(-1);
+			memcpy(spec, spec_start, (size_t)(s - spec_start + 1));
+			spec[s - spec_start + 1] = '\0';
+			if (append_spec(row, spec, *s, length, args) != 0) return(-1);
+		}
+		s++;
+	}
+	return(0);
+}
+
+/* Specifications the row builder does not parse go to vsnprintf */
+static void vappend_row(FastFormatRow *row, const char *format, va_list args)
+{
+	va_list value, fallback;
+	size_t start = row->len;
+	int len;
+
+	va_copy(value, args);
+	if (vformat_row(row, format, &value) != 0) {
+		row->len = start;
+		va_copy(fallback, args);
+		len = vsnprintf(NULL, 0, format, fallback);
+		va_end(fallback);
+		if (len > 0) {
+			reserve(row, (size_t)len + 1);
+			va_copy(fallback, args);
+			vsnprintf(row->buf + row->len, (size_t)len + 1, format, fallback);
+			va_end(fallback);
+			row->len += (size_t)len;
+		}
+	}
+	va_end(value);
+}
+
+void fast_format_appendf(FastFormatRow *row, const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vappend_row(row, format, args);
+	va_end(args);
+}
+
+int fast_fprintf(FILE *fp, const char *format, ...)
+{
+	FastFormatRow row;
+	va_list args;
+	int rv;
+
+	fast_format_row_init(&row);
+	va_start(args, format);
+	vappend_row(&row, format, args);
+	va_end(args);
+	rv = fast_format_write_row(&row, fp);
+	fast_format_row_free(&row);
+	return(rv);
+}
@@ -0,0 +1,284 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		fork_scenarios					*/
+/*								*/
+/*	fork_scenarios.c - run a batch of scenarios over one	*/
+/*		loaded world					*/
+/*								*/
+/*	NAME							*/
+/*	fork_scenarios.c - run a batch of scenarios over one	*/
+/*		loaded world					*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	int	fork_scenarios(int main_argc, char **main_argv,	*/
+/*			struct command_line_object **command_line, */
+/*			struct world_object **world,		*/
+/*			int *num_failed)			*/
+/*								*/
+/*	OPTIONS							*/
+/*	-scenarios <file> [jobs]				*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Called by main once the world has been constructed.	*/
+/*	Each non blank line of the scenarios file that does	*/
+/*	not start with # is one scenario:			*/
+/*								*/
+/*	<output prefix> [-t tec] [-s m K [sd]] [-sv m K]	*/
+/*		[-svalt pa po] [-vgsen s1 s2 s3]		*/
+/*								*/
+/*	A scenario's command line is the run's own command	*/
+/*	line with those options and -pre <output prefix>	*/
+/*	appended, so later options win as they always do.	*/
+/*	All scenario lines are parsed before anything is	*/
+/*	forked, so a bad line stops the batch at once.		*/
+/*								*/
+/*	Each scenario runs in a worker process forked from	*/
+/*	this one, at most jobs (default one per online core)	*/
+/*	at a time.  fork_scenarios returns 0 in a worker, with	*/
+/*	*command_line and *world set to the scenario's, and	*/
+/*	main carries on with outputs, tec and simulation as	*/
+/*	for a single run.  In this process it returns 1 once	*/
+/*	every worker has exited, with the number that failed.	*/
+/*								*/
+/*	Workers share the loaded world copy-on-write, so only	*/
+/*	the pages a scenario writes to are copied.  The soil	*/
+/*	and vegetation sensitivity multipliers are folded into	*/
+/*	the defaults and into the patch and strata states as	*/
+/*	they are constructed, so a scenario whose multipliers	*/
+/*	differ from this run's rebuilds its world from the	*/
+/*	worldfile; it still shares the base stations, so the	*/
+/*	climate is only read once.				*/
+/*								*/
+/*	A worker's stdout goes to <output prefix>.log.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	The OpenMP thread pool does not survive fork(): a	*/
+/*	worker opening a parallel region with more than one	*/
+/*	thread hangs.  Workers therefore run single threaded;	*/
+/*	the batch is spread over the cores instead.		*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "rhessys.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#define SCENARIO_DELIMITERS " \t\r\n"
+
+/* Options a scenario line may set, see the file header */
+static int scenario_option(char *option)
+{
+	return((strcmp(option, "-t") == 0) ||
+		(strcmp(option, "-s") == 0) ||
+		(strcmp(option, "-sv") == 0) ||
+		(strcmp(option, "-svalt") == 0) ||
+		(strcmp(option, "-vgsen") == 0));
+}
+
+/* Whether two command lines construct the same world */
+static int same_world(struct command_line_object *a,
+		struct command_line_object *b)
+{
+	return((a[0].sen_flag == b[0].sen_flag) &&
+		(a[0].sen[M] == b[0].sen[M]) &&
+		(a[0].sen[K] == b[0].sen[K]) &&
+		(a[0].sen[SOIL_DEPTH] == b[0].sen[SOIL_DEPTH]) &&
+		(a[0].vsen_flag == b[0].vsen_flag) &&
+		(a[0].vsen[M] == b[0].vsen[M]) &&
+		(a[0].vsen[K] == b[0].vsen[K]) &&
+		(a[0].vsen_alt_flag == b[0].vsen_alt_flag) &&
+		(a[0].vsen_alt[PA] == b[0].vsen_alt[PA]) &&
+		(a[0].vsen_alt[PO] == b[0].vsen_alt[PO]) &&
+		(a[0].vgsen_flag == b[0].vgsen_flag) &&
+		(a[0].veg_sen1 == b[0].veg_sen1) &&
+		(a[0].veg_sen2 == b[0].veg_sen2) &&
+		(a[0].veg_sen3 == b[0].veg_sen3));
+}
+
+int	fork_scenarios(int main_argc, char **main_argv,
+		struct command_line_object **command_line,
+		struct world_object **world,
+		int *num_failed)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	int	valid_option(char *);
+	struct	command_line_object *construct_command_line(int, char **);
+	struct	world_object *construct_world(struct command_line_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	FILE	*scenarios_file;
+	char	*line, *token, *log_filename;
+	char	**scenario_argv;
+	size_t	line_len;
+	int	s, num_scenarios, max_scenarios, scenario_argc, line_num;
+	int	jobs, running, next, status;
+	pid_t	pid;
+	pid_t	*pids;
+	char	**prefixes;
+	struct	command_line_object	**scenarios;
+
+	/*--------------------------------------------------------------*/
+	/*	Parse every scenario into its own command line.		*/
+	/*--------------------------------------------------------------*/
+	if ((scenarios_file = fopen((*command_line)[0].scenarios_filename, "r")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open scenarios file %s\n",
+			(*command_line)[0].scenarios_filename);
+		exit(EXIT_FAILURE);
+	}
+	max_scenarios = 16;
+	num_scenarios = 0;
+	scenarios = (struct command_line_object **) alloc(max_scenarios *
+		sizeof(struct command_line_object *), "scenarios", "fork_scenarios");
+	prefixes = (char **) alloc(max_scenarios * sizeof(char *),
+		"prefixes", "fork_scenarios");
+	line = NULL;
+	line_len = 0;
+	line_num = 0;
+	while (getline(&line, &line_len, scenarios_file) != -1) {
+		line_num++;
+		token = strtok(line, SCENARIO_DELIMITERS);
+		if ((token == NULL) || (token[0] == '#'))
+			continue;
+		if (valid_option(token) == 1) {
+			fprintf(stderr,"FATAL ERROR: Scenario on line %d of %s does not start with an output prefix\n",
+				line_num, (*command_line)[0].scenarios_filename);
+			exit(EXIT_FAILURE);
+		}
+		if (num_scenarios == max_scenarios) {
+			max_scenarios *= 2;
+			scenarios = (struct command_line_object **) realloc(scenarios,
+				max_scenarios * sizeof(struct command_line_object *));
+			prefixes = (char **) realloc(prefixes, max_scenarios * sizeof(char *));
+			if ((scenarios == NULL) || (prefixes == NULL)) {
+				fprintf(stderr,"FATAL ERROR: Cannot allocate scenarios\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		prefixes[num_scenarios] = (char *) alloc((1+strlen(token)) * sizeof(char),
+			"prefix", "fork_scenarios");
+		strcpy(prefixes[num_scenarios], token);
+
+		/*--------------------------------------------------------------*/
+		/*	The run's arguments, then the line's options, then	*/
+		/*	-pre <output prefix>.  A line has fewer tokens than	*/
+		/*	half its buffer.					*/
+		/*--------------------------------------------------------------*/
+		scenario_argv = (char **) alloc((main_argc + line_len / 2 + 3)
+			* sizeof(char *), "scenario_argv", "fork_scenarios");
+		for (scenario_argc = 0; scenario_argc < main_argc; scenario_argc++)
+			scenario_argv[scenario_argc] = main_argv[scenario_argc];
+		while ((token = strtok(NULL, SCENARIO_DELIMITERS)) != NULL) {
+			if ((valid_option(token) == 1) && (scenario_option(token) == 0)) {
+				fprintf(stderr,"FATAL ERROR: Option %s on line %d of %s cannot vary between scenarios\n",
+					token, line_num, (*command_line)[0].scenarios_filename);
+				exit(EXIT_FAILURE);
+			}
+			scenario_argv[scenario_argc] = (char *) alloc((1+strlen(token)) * sizeof(char),
+				"scenario_arg", "fork_scenarios");
+			strcpy(scenario_argv[scenario_argc++], token);
+		}
+		scenario_argv[scenario_argc++] = "-pre";
+		scenario_argv[scenario_argc++] = prefixes[num_scenarios];
+		scenario_argv[scenario_argc] = NULL;
+		scenarios[num_scenarios] = construct_command_line(scenario_argc, scenario_argv);
+		num_scenarios++;
+	}
+	free(line);
+	fclose(scenarios_file);
+	if (num_scenarios == 0) {
+		fprintf(stderr,"FATAL ERROR: No scenarios in %s\n",
+			(*command_line)[0].scenarios_filename);
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Run the scenarios, at most jobs at a time.		*/
+	/*--------------------------------------------------------------*/
+	jobs = (*command_line)[0].scenario_jobs;
+	if (jobs < 1)
+		jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	if (jobs < 1)
+		jobs = 1;
+	printf("\nRunning %d scenarios, %d at a time\n", num_scenarios, jobs);
+	pids = (pid_t *) alloc(num_scenarios * sizeof(pid_t), "pids", "fork_scenarios");
+	*num_failed = 0;
+	running = 0;
+	next = 0;
+	while ((next < num_scenarios) || (running > 0)) {
+		if ((next < num_scenarios) && (running < jobs)) {
+			/* Nothing buffered may be written twice */
+			fflush(stdout);
+			fflush(stderr);
+			pid = fork();
+			if (pid < 0) {
+				fprintf(stderr,"FATAL ERROR: Cannot fork scenario %s: %s\n",
+					prefixes[next], strerror(errno));
+				exit(EXIT_FAILURE);
+			}
+			if (pid == 0) {
+				/*--------------------------------------------------------------*/
+				/*	Worker: take on the scenario and return to main.	*/
+				/*--------------------------------------------------------------*/
+#if defined(_OPENMP)
+				omp_set_num_threads(1);
+#endif
+				log_filename = (char *) alloc((strlen(prefixes[next]) + 5) * sizeof(char),
+					"log_filename", "fork_scenarios");
+				sprintf(log_filename, "%s.log", prefixes[next]);
+				if (freopen(log_filename, "w", stdout) == NULL) {
+					fprintf(stderr,"FATAL ERROR: Cannot open scenario log %s\n",
+						log_filename);
+					exit(EXIT_FAILURE);
+				}
+				if (same_world(*command_line, scenarios[next]) == 0) {
+					scenarios[next][0].scenario_world = *world;
+					*world = construct_world(scenarios[next]);
+				}
+				*command_line = scenarios[next];
+				return(0);
+			}
+			pids[next++] = pid;
+			running++;
+			continue;
+		}
+		pid = waitpid(-1, &status, 0);
+		if (pid < 0) {
+			if (errno == EINTR)
+				continue;
+			fprintf(stderr,"FATAL ERROR: Waiting for scenarios: %s\n", strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+		for (s = 0; (s < next) && (pids[s] != pid); s++);
+		if (s == next)
+			continue;
+		running--;
+		if (WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS)) {
+			printf("Scenario %s finished\n", prefixes[s]);
+		}
+		else {
+			(*num_failed)++;
+			if (WIFSIGNALED(status))
+				fprintf(stderr,"Scenario %s killed by signal %d\n",
+					prefixes[s], WTERMSIG(status));
+			else
+				fprintf(stderr,"Scenario %s failed with status %d\n",
+					prefixes[s], WEXITSTATUS(status));
+		}
+	}
+	printf("%d of %d scenarios finished\n", num_scenarios - *num_failed, num_scenarios);
+	return(1);
+} /*end fork_scenarios*/
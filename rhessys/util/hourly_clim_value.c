@@ -0,0 +1,62 @@
+/*--------------------------------------------------------------*/
+/*	hourly_clim_value - value of an indexed hourly clim		*/
+/*		sequence for a date and hour							*/
+/*																*/
+/*	hourly_clim_day_has_event - whether any hour of a date	*/
+/*		has an event											*/
+/*																*/
+/*	PROGRAMMERS NOTES											*/
+/*	Both return -999.0 / 0 for dates outside the sequence or	*/
+/*	when there is no sequence.  See construct_hourly_clim_slots.*/
+/*	Neither modifies the slots, so they are safe to call from	*/
+/*	hillslopes running in parallel.								*/
+/*--------------------------------------------------------------*/
+#include	<stdio.h>
+#include	"rhessys.h"
+
+double	hourly_clim_value(
+						  struct hourly_clim_slots *slots,
+						  struct date current_date)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	long	julday(struct date);
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 							*/
+	/*------------------------------------------------------*/
+	long	day;
+
+	if ( (slots[0].value == NULL)
+		|| (current_date.hour < 1) || (current_date.hour > 24) )
+		return(-999.0);
+	day = julday(current_date) - slots[0].first_day;
+	if ( (day < 0) || (day >= slots[0].num_days) )
+		return(-999.0);
+	return(slots[0].value[day * 24 + current_date.hour - 1]);
+}/*end hourly_clim_value*/
+
+int		hourly_clim_day_has_event(
+								  struct hourly_clim_slots *slots,
+								  struct date current_date)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	long	julday(struct date);
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 							*/
+	/*------------------------------------------------------*/
+	long	day;
+	int		hour;
+
+	if ( slots[0].value == NULL )
+		return(0);
+	day = julday(current_date) - slots[0].first_day;
+	if ( (day < 0) || (day >= slots[0].num_days) )
+		return(0);
+	for ( hour = 0; hour < 24; hour++ )
+		if ( slots[0].value[day * 24 + hour] != -999.0 )
+			return(1);
+	return(0);
+}/*end hourly_clim_day_has_event*/
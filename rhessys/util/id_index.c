@@ -0,0 +1,100 @@
+/** @file id_index.c
+ *  @brief Implements a sorted index mapping integer object IDs to object
+ *  pointers, replacing linear scans of the spatial hierarchy with a
+ *  binary search.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "id_index.h"
+
+#define ID_INDEX_MIN_CAPACITY 16
+
+static int compareEntries(const void *a, const void *b) {
+	const IdIndexEntry_t *e1 = (const IdIndexEntry_t *) a;
+	const IdIndexEntry_t *e2 = (const IdIndexEntry_t *) b;
+	if (e1->parent != e2->parent) return ((uintptr_t) e1->parent < (uintptr_t) e2->parent) ? -1 : 1;
+	if (e1->id < e2->id) return -1;
+	if (e1->id > e2->id) return 1;
+	// Same ID, order by insertion so that the last insertion sorts last
+	if (e1->seq < e2->seq) return -1;
+	if (e1->seq > e2->seq) return 1;
+	return 0;
+}
+
+IdIndex_t *newIdIndex(size_t capacity) {
+	IdIndex_t *index = (IdIndex_t *) malloc(sizeof(IdIndex_t));
+	assert(index);
+	if (capacity < ID_INDEX_MIN_CAPACITY) capacity = ID_INDEX_MIN_CAPACITY;
+	index->num_entries = 0;
+	index->capacity = capacity;
+	index->next_seq = 0;
+	index->finalized = 0;
+	index->entries = (IdIndexEntry_t *) malloc(capacity * sizeof(IdIndexEntry_t));
+	assert(index->entries);
+	return index;
+}
+
+void freeIdIndex(IdIndex_t *index) {
+	if (index == NULL) return;
+	free(index->entries);
+	free(index);
+}
+
+void idIndexInsert(IdIndex_t *index, int id, void *ptr) {
+	idIndexInsertInParent(index, NULL, id, ptr);
+}
+
+void idIndexInsertInParent(IdIndex_t *index, const void *parent, int id, void *ptr) {
+	if (index->num_entries == index->capacity) {
+		index->capacity *= 2;
+		index->entries = (IdIndexEntry_t *) realloc(index->entries,
+				index->capacity * sizeof(IdIndexEntry_t));
+		assert(index->entries);
+	}
+	IdIndexEntry_t *e = index->entries + index->num_entries;
+	e->parent = parent;
+	e->id = id;
+	e->seq = index->next_seq++;
+	e->ptr = ptr;
+	index->num_entries++;
+	index->finalized = 0;
+}
+
+void idIndexFinalize(IdIndex_t *index) {
+	if (index->num_entries > 1) {
+		qsort(index->entries, index->num_entries, sizeof(IdIndexEntry_t), compareEntries);
+		// Collapse duplicate IDs, keeping the entry inserted last
+		size_t n = 0;
+		for (size_t i = 0; i < index->num_entries; i++) {
+			if (i + 1 < index->num_entries && index->entries[i + 1].id == index->entries[i].id
+					&& index->entries[i + 1].parent == index->entries[i].parent) continue;
+			index->entries[n++] = index->entries[i];
+		}
+		index->num_entries = n;
+	}
+	index->finalized = 1;
+}
+
+void *idIndexGet(const IdIndex_t *index, int id) {
+	return idIndexGetInParent(index, NULL, id);
+}
+
+void *idIndexGetInParent(const IdIndex_t *index, const void *parent, int id) {
+	assert(index->finalized);
+	size_t lo = 0;
+	size_t hi = index->num_entries;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const IdIndexEntry_t *e = index->entries + mid;
+		if (e->parent == parent && e->id == id) return e->ptr;
+		if ((uintptr_t) e->parent < (uintptr_t) parent || (e->parent == parent && e->id < id)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return NULL;
+}
@@ -0,0 +1,268 @@
+/** @file profile.c
+ *  @brief Implements the hierarchical phase profiler declared in profile.h.
+ *
+ *  Each thread owns a padded slot holding its region stack, per-region
+ *  counters and (when a trace file was requested) a buffer of completed
+ *  regions.  Nothing is shared between threads while the model runs;
+ *  slots are only combined by profile_report().
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "profile.h"
+
+#define PROFILE_MAX_DEPTH 32
+#define PROFILE_TRACE_MAX_EVENTS (1 << 20)
+#define PROFILE_ROOT -1
+
+int profile_enabled = 0;
+
+static const char *region_names[PROFILE_NUM_REGIONS] = {
+	"construct_world",
+	"climate_load",
+	"tec_event",
+	"world_daily_I",
+	"world_hourly",
+	"world_daily_F",
+	"zone_daily_F",
+	"patch_daily_F",
+	"canopy_stratum_daily_F",
+	"compute_subsurface_routing",
+	"stream_routing",
+	"fire",
+	"output_hourly",
+	"output_daily",
+	"output_monthly",
+	"output_yearly",
+	"output_state"
+};
+
+typedef struct {
+	int region;
+	uint64_t start;
+	uint64_t duration;
+} ProfileTraceEvent;
+
+typedef struct {
+	int depth;
+	int stack[PROFILE_MAX_DEPTH];
+	uint64_t start[PROFILE_MAX_DEPTH];
+	uint64_t child[PROFILE_MAX_DEPTH];
+	uint64_t inclusive[PROFILE_NUM_REGIONS];
+	uint64_t exclusive[PROFILE_NUM_REGIONS];
+	uint64_t calls[PROFILE_NUM_REGIONS];
+	int parent[PROFILE_NUM_REGIONS];
+	ProfileTraceEvent *trace;
+	size_t num_trace;
+	size_t dropped_trace;
+	uint64_t overflow;
+	// Keep neighbouring slots off each other's cache lines
+	char pad[64];
+} ProfileThread;
+
+static ProfileThread *threads = NULL;
+static int num_threads = 0;
+static uint64_t origin = 0;
+static char *trace_filename = NULL;
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static ProfileThread *this_thread(void) {
+#if defined(_OPENMP)
+	int t = omp_get_thread_num();
+	if (t >= num_threads) return NULL;
+	return &threads[t];
+#else
+	return &threads[0];
+#endif
+}
+
+void profile_init(char *filename) {
+#if defined(_OPENMP)
+	num_threads = omp_get_max_threads();
+#else
+	num_threads = 1;
+#endif
+	threads = (ProfileThread *) calloc(num_threads, sizeof(ProfileThread));
+	if (threads == NULL) {
+		fprintf(stderr, "FATAL ERROR: unable to allocate profiler state\n");
+		exit(EXIT_FAILURE);
+	}
+	for (int t = 0; t < num_threads; t++) {
+		for (int r = 0; r < PROFILE_NUM_REGIONS; r++) {
+			threads[t].parent[r] = PROFILE_ROOT;
+		}
+	}
+	if (filename != NULL) {
+		trace_filename = strdup(filename);
+	}
+	origin = now_ns();
+	profile_enabled = 1;
+}
+
+void profile_begin(ProfileRegion region) {
+	ProfileThread *p = this_thread();
+	if (p == NULL) return;
+	if (p->depth == PROFILE_MAX_DEPTH) {
+		p->overflow++;
+		return;
+	}
+	if (p->calls[region] == 0 && p->depth > 0) {
+		p->parent[region] = p->stack[p->depth - 1];
+	}
+	p->stack[p->depth] = region;
+	p->child[p->depth] = 0;
+	p->start[p->depth] = now_ns();
+	p->depth++;
+}
+
+void profile_end(ProfileRegion region) {
+	uint64_t end = now_ns();
+	ProfileThread *p = this_thread();
+	if (p == NULL) return;
+	if (p->overflow > 0) {
+		p->overflow--;
+		return;
+	}
+	if (p->depth == 0 || p->stack[p->depth - 1] != (int)region) {
+		fprintf(stderr, "WARNING: profile region %s ended out of order\n", region_names[region]);
+		return;
+	}
+	p->depth--;
+	uint64_t elapsed = end - p->start[p->depth];
+	p->inclusive[region] += elapsed;
+	p->exclusive[region] += elapsed - p->child[p->depth];
+	p->calls[region]++;
+	if (p->depth > 0) {
+		p->child[p->depth - 1] += elapsed;
+	}
+
+	if (trace_filename == NULL) return;
+	if (p->num_trace == PROFILE_TRACE_MAX_EVENTS) {
+		p->dropped_trace++;
+		return;
+	}
+	if (p->trace == NULL) {
+		p->trace = (ProfileTraceEvent *) malloc(PROFILE_TRACE_MAX_EVENTS * sizeof(ProfileTraceEvent));
+		if (p->trace == NULL) {
+			p->dropped_trace++;
+			return;
+		}
+	}
+	p->trace[p->num_trace].region = region;
+	p->trace[p->num_trace].start = p->start[p->depth] - origin;
+	p->trace[p->num_trace].duration = elapsed;
+	p->num_trace++;
+}
+
+static void report_region(FILE *out, int r, int level, uint64_t total) {
+	uint64_t inclusive = 0, exclusive = 0, calls = 0, max_thread = 0;
+	int active = 0;
+	for (int t = 0; t < num_threads; t++) {
+		if (threads[t].calls[r] == 0) continue;
+		inclusive += threads[t].inclusive[r];
+		exclusive += threads[t].exclusive[r];
+		calls += threads[t].calls[r];
+		if (threads[t].inclusive[r] > max_thread) max_thread = threads[t].inclusive[r];
+		active++;
+	}
+	if (calls > 0) {
+		double mean = (double)inclusive / active;
+		fprintf(out, "%*s%-*s %12llu %12.3f %12.3f %7.2f %4d %7.2f\n",
+				2 * level, "", 32 - 2 * level, region_names[r],
+				(unsigned long long)calls,
+				inclusive * 1e-9, exclusive * 1e-9,
+				(total > 0) ? 100.0 * exclusive / total : 0.0,
+				active, (mean > 0.0) ? max_thread / mean : 1.0);
+	}
+}
+
+static int region_parent(int r) {
+	// Regions entered on worker threads have no parent there; use the
+	// parent seen on any thread that opened it inside another region.
+	for (int t = 0; t < num_threads; t++) {
+		if (threads[t].parent[r] != PROFILE_ROOT) return threads[t].parent[r];
+	}
+	return PROFILE_ROOT;
+}
+
+static void report_tree(FILE *out, int parent, int level, uint64_t total, int *parents) {
+	if (level > PROFILE_NUM_REGIONS) return;
+	for (int r = 0; r < PROFILE_NUM_REGIONS; r++) {
+		if (parents[r] != parent) continue;
+		report_region(out, r, level, total);
+		report_tree(out, r, level + 1, total, parents);
+	}
+}
+
+static void write_trace(void) {
+	FILE *f = fopen(trace_filename, "w");
+	if (f == NULL) {
+		fprintf(stderr, "WARNING: unable to open profile trace file %s\n", trace_filename);
+		return;
+	}
+	fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	int first = 1;
+	size_t dropped = 0;
+	for (int t = 0; t < num_threads; t++) {
+		ProfileThread *p = &threads[t];
+		dropped += p->dropped_trace;
+		for (size_t e = 0; e < p->num_trace; e++) {
+			fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+					first ? "" : ",\n", region_names[p->trace[e].region], t,
+					p->trace[e].start * 1e-3, p->trace[e].duration * 1e-3);
+			first = 0;
+		}
+	}
+	fprintf(f, "\n]}\n");
+	fclose(f);
+	if (dropped > 0) {
+		fprintf(stderr, "WARNING: profile trace buffer full, %zu regions not written to %s\n",
+				dropped, trace_filename);
+	}
+}
+
+void profile_report(FILE *out) {
+	if (!profile_enabled) return;
+	uint64_t total = now_ns() - origin;
+	int parents[PROFILE_NUM_REGIONS];
+	for (int r = 0; r < PROFILE_NUM_REGIONS; r++) {
+		parents[r] = region_parent(r);
+		if (parents[r] == r) parents[r] = PROFILE_ROOT;
+	}
+
+	fprintf(out, "\nProfile (%.3f s wall, %d threads)\n", total * 1e-9, num_threads);
+	fprintf(out, "%-32s %12s %12s %12s %7s %4s %7s\n",
+			"region", "calls", "incl (s)", "excl (s)", "excl %", "thr", "imbal");
+	report_tree(out, PROFILE_ROOT, 0, total, parents);
+
+	if (trace_filename != NULL) {
+		write_trace();
+	}
+}
+
+void profile_destroy(void) {
+	if (threads != NULL) {
+		for (int t = 0; t < num_threads; t++) {
+			free(threads[t].trace);
+		}
+		free(threads);
+	}
+	free(trace_filename);
+	threads = NULL;
+	trace_filename = NULL;
+	num_threads = 0;
+	profile_enabled = 0;
+}
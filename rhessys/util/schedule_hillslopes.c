@@ -0,0 +1,208 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		schedule_hillslopes				*/
+/*								*/
+/*	schedule_hillslopes.c - cost ordered hillslope and	*/
+/*		zone chunk scheduling				*/
+/*								*/
+/*	NAME							*/
+/*	schedule_hillslopes.c - cost ordered hillslope and	*/
+/*		zone chunk scheduling				*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	construct_hillslope_schedule(			*/
+/*			struct basin_object *basin)		*/
+/*								*/
+/*	void	schedule_hillslopes(struct basin_object *basin)	*/
+/*								*/
+/*	double	schedule_clock(void)				*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	The basin_daily_I, basin_hourly and basin_daily_F	*/
+/*	hillslope loops hand out hillslopes one at a time	*/
+/*	(schedule(dynamic,1)) in basin[0].hillslope_order,	*/
+/*	most expensive first, so a large hillslope is not left	*/
+/*	to start last while the other threads sit idle.		*/
+/*								*/
+/*	A hillslope costing more than one thread's share of	*/
+/*	the basin is also split: hillslope_daily_I,		*/
+/*	hillslope_hourly and hillslope_daily_F then run its	*/
+/*	zones as OpenMP tasks, one per zone chunk, and wait	*/
+/*	for them before the hillslope level work (groundwater,	*/
+/*	subsurface routing) that depends on every zone.  Idle	*/
+/*	threads pick those tasks up from the OpenMP runtime's	*/
+/*	task queues, so the spare threads work on the big	*/
+/*	hillslope instead of waiting for it.  Stream routing	*/
+/*	in basin_daily_F still runs after every hillslope.	*/
+/*								*/
+/*	Zone chunks are cut once, from patch counts, into	*/
+/*	about four chunks per thread.  Hillslope costs start as	*/
+/*	patch counts; after the first day they are the seconds	*/
+/*	hillslope_daily_F spent in zone_daily_F and routing	*/
+/*	(summed over chunks, so a split hillslope's cost is	*/
+/*	its total work, not its wall time).			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	The smallest task is a zone chunk; the patches of a	*/
+/*	zone always run in order on one thread, because		*/
+/*	patch_daily_I and patch_daily_F update the zone LAI	*/
+/*	sums, and update_gw_drainage the zone's gw_drainage	*/
+/*	sums, without synchronisation.  A hillslope of		*/
+/*	one huge zone therefore does not split.			*/
+/*								*/
+/*	Zone chunks of one hillslope share its objects, so	*/
+/*	nothing a zone runs may write to the hillslope		*/
+/*	directly: groundwater drainage is summed per zone	*/
+/*	and added to the hillslope's gw, in zone order, by	*/
+/*	add_zone_gw_drainage after the chunks' taskwait.  The	*/
+/*	basin snowpack sums in patch_daily_F are atomic, as	*/
+/*	they were for parallel hillslopes.			*/
+/*								*/
+/*	Without OpenMP the order is still kept but nothing is	*/
+/*	split and schedule_clock() returns 0, so costs stay	*/
+/*	patch counts.						*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#define ZONE_CHUNKS_PER_THREAD 4
+
+struct hillslope_cost {
+	double cost;
+	int h;
+};
+
+static int compare_hillslope_cost(const void *a, const void *b)
+{
+	const struct hillslope_cost *ca = (const struct hillslope_cost *) a;
+	const struct hillslope_cost *cb = (const struct hillslope_cost *) b;
+
+	if (ca->cost > cb->cost) return(-1);
+	if (ca->cost < cb->cost) return(1);
+	/* Keep equal costs in worldfile order */
+	return(ca->h - cb->h);
+}
+
+static int num_threads(void)
+{
+#if defined(_OPENMP)
+	return(omp_get_max_threads());
+#else
+	return(1);
+#endif
+}
+
+double	schedule_clock(void)
+{
+#if defined(_OPENMP)
+	return(omp_get_wtime());
+#else
+	return(0.0);
+#endif
+} /*end schedule_clock*/
+
+void	construct_hillslope_schedule(struct basin_object *basin)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	void	schedule_hillslopes(struct basin_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int h, z, num_patches, target, chunk_patches;
+	struct hillslope_object *hillslope;
+
+	basin[0].hillslope_order = (int *) alloc(
+		basin[0].num_hillslopes * sizeof(int),
+		"hillslope_order", "construct_hillslope_schedule");
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		basin[0].hillslope_order[h] = h;
+		hillslope = basin[0].hillslopes[h];
+		num_patches = 0;
+		for (z = 0; z < hillslope[0].num_zones; z++)
+			num_patches += hillslope[0].zones[z][0].num_patches;
+		hillslope[0].cost = num_patches;
+		hillslope[0].measured_cost = 0.0;
+		hillslope[0].split_flag = 0;
+		/*--------------------------------------------------------------*/
+		/*	Cut the zones into chunks of about target patches.	*/
+		/*--------------------------------------------------------------*/
+		target = num_patches / (ZONE_CHUNKS_PER_THREAD * num_threads());
+		if (target < 1) target = 1;
+		hillslope[0].zone_chunk_start = (int *) alloc(
+			(hillslope[0].num_zones + 1) * sizeof(int),
+			"zone_chunk_start", "construct_hillslope_schedule");
+		hillslope[0].num_zone_chunks = 0;
+		chunk_patches = 0;
+		for (z = 0; z < hillslope[0].num_zones; z++) {
+			if (chunk_patches == 0)
+				hillslope[0].zone_chunk_start[hillslope[0].num_zone_chunks++] = z;
+			chunk_patches += hillslope[0].zones[z][0].num_patches;
+			if (chunk_patches >= target)
+				chunk_patches = 0;
+		}
+		hillslope[0].zone_chunk_start[hillslope[0].num_zone_chunks] =
+			hillslope[0].num_zones;
+	}
+	schedule_hillslopes(basin);
+	return;
+} /*end construct_hillslope_schedule*/
+
+void	schedule_hillslopes(struct basin_object *basin)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int h, threads;
+	double total_cost;
+	struct hillslope_object *hillslope;
+	struct hillslope_cost *order;
+
+	/*--------------------------------------------------------------*/
+	/*	Take up yesterday's timings, if there are any.		*/
+	/*--------------------------------------------------------------*/
+	order = (struct hillslope_cost *) alloc(
+		(basin[0].num_hillslopes + 1) * sizeof(struct hillslope_cost),
+		"order", "schedule_hillslopes");
+	total_cost = 0.0;
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		if (hillslope[0].measured_cost > 0.0)
+			hillslope[0].cost = hillslope[0].measured_cost;
+		hillslope[0].measured_cost = 0.0;
+		total_cost += hillslope[0].cost;
+		order[h].cost = hillslope[0].cost;
+		order[h].h = h;
+	}
+	qsort(order, basin[0].num_hillslopes, sizeof(struct hillslope_cost),
+		compare_hillslope_cost);
+	for (h = 0; h < basin[0].num_hillslopes; h++)
+		basin[0].hillslope_order[h] = order[h].h;
+	free(order);
+	/*--------------------------------------------------------------*/
+	/*	Split hillslopes that are more than a thread's share.	*/
+	/*--------------------------------------------------------------*/
+	threads = num_threads();
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		hillslope[0].split_flag = (threads > 1)
+			&& (hillslope[0].num_zone_chunks > 1)
+			&& (hillslope[0].cost * threads > total_cost);
+	}
+	return;
+} /*end schedule_hillslopes*/
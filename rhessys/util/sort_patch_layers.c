@@ -7,7 +7,7 @@
 /*                                                              */
 /*                                                              */
 /*  SYNOPSIS                                                    */
-/*  sort_patch_layers( struct patch_object *patch)					*/
+/*  sort_patch_layers( struct patch_object *patch, int *rec)	*/
 /*                                                              */
 /*  OPTIONS                                                     */
 /*                                                              */
@@ -18,36 +18,62 @@
 /*								*/
 /*  PROGRAMMER NOTES                                            */
 /*                                                              */
+/*	Called every day from patch_daily_I.  Stratum heights	*/
+/*	change a little each day but the order of the layers	*/
+/*	almost never does, so the layers from the last call are	*/
+/*	kept when they still hold: every stratum in a layer	*/
+/*	still has one height and the layers are still in	*/
+/*	strictly descending order.  Then only the layer		*/
+/*	heights, bases and null covers are updated.  Otherwise	*/
+/*	the layers are rebuilt and sorted as before.		*/
 /*                                                              */
+/*	layers[i].strata point into patch[0].layer_strata	*/
+/*	(num_canopy_strata long) and are not allocated here.	*/
 /*                                                              */
 /*--------------------------------------------------------------*/
 
 #include <stdio.h>
 #include "rhessys.h"
 
-void sort_patch_layers( struct patch_object *patch, int *rec)
+/*--------------------------------------------------------------*/
+/*	Do last call's layers still group and order the strata?	*/
+/*--------------------------------------------------------------*/
+static int layers_still_sorted(struct patch_object *patch)
+{
+	int i, k, num_strata;
+	double height;
+
+	if (patch[0].num_layers == 0)
+		return(0);
+	num_strata = 0;
+	for ( i=0 ; i<patch[0].num_layers ; i++ ) {
+		height = patch[0].canopy_strata[patch[0].layers[i].strata[0]][0].epv.height;
+		for ( k=1 ; k<patch[0].layers[i].count ; k++ )
+			if (patch[0].canopy_strata[patch[0].layers[i].strata[k]][0].epv.height
+				!= height)
+				return(0);
+		if ((i > 0) && (height >= patch[0].layers[i-1].height))
+			return(0);
+		patch[0].layers[i].height = height;
+		num_strata += patch[0].layers[i].count;
+	}
+	return(num_strata == patch[0].num_canopy_strata);
+}
+
+/*--------------------------------------------------------------*/
+/*	Group the strata into layers by height, tallest first.	*/
+/*--------------------------------------------------------------*/
+static void build_patch_layers(struct patch_object *patch)
 {
 	/*--------------------------------------------------------------*/
 	/*  Local function declaration                                  */
 	/*--------------------------------------------------------------*/
 	int key_compare(void *,  void *);
-	void	*alloc( 	size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
-	int s, i, j,k;
-	int list_bottom;
-	int maxstemcID, maxleafcID;
-	double cover_fraction;
-	double maxstemc, maxleafc;
-	struct canopy_strata_object *stratum;
-	/*--------------------------------------------------------------*/
-	/*	free current layer structure				*/
-	/*--------------------------------------------------------------*/
-	for ( i=0 ; i<patch[0].num_layers ; i++ ) {
-		free(patch[0].layers[i].strata);
-		patch[0].layers[i].count = 0;
-	}
+	int i, j, k;
+	int list_bottom, first;
 	/*--------------------------------------------------------------*/
 	/*		Establish index of next free list entry.	*/
 	/*--------------------------------------------------------------*/
@@ -98,25 +124,13 @@ void sort_patch_layers( struct patch_object *patch, int *rec)
 	/*	Now construct a list of pointers to strata at each	*/
 	/*	height layer						*/
 	/*--------------------------------------------------------------*/
+	first = 0;
 	for ( i=0 ; i<patch[0].num_layers ; i++ ){
 		/*--------------------------------------------------------------*/
-		/*		Allocate the list for layer i			*/
-		/*--------------------------------------------------------------*/
-		patch[0].layers[i].strata = (long *)
-			alloc(patch[0].layers[i].count*sizeof(long),
-			"patch[0].layers[i].strata",
-			"construct_patch");
-		/*--------------------------------------------------------------*/
-		/*		Reset the cover_fraction accumulator		*/
+		/*		The list for layer i follows layer i-1's	*/
 		/*--------------------------------------------------------------*/
-		cover_fraction = 0.0;
-		/*--------------------------------------------------------------*/
-		/*	assign a bottom of layer				*/
-		/*--------------------------------------------------------------*/
-		if (i != patch[0].num_layers - 1)
-			patch[0].layers[i].base = patch[0].layers[i+1].height;
-		else
-			patch[0].layers[i].base = 0.0;
+		patch[0].layers[i].strata = &(patch[0].layer_strata[first]);
+		first += patch[0].layers[i].count;
 		/*--------------------------------------------------------------*/
 		/*		Find all strata with height matching layer i	*/
 		/*--------------------------------------------------------------*/
@@ -132,13 +146,44 @@ void sort_patch_layers( struct patch_object *patch, int *rec)
 			/*--------------------------------------------------------------*/
 				patch[0].layers[i].strata[k] = j;
 				k++;
-				/*--------------------------------------------------------------*/
-				/*		Keep a running total of the cover fraction in	*/
-				/*		this layer to check that it adds to 1.0		*/
-				/*--------------------------------------------------------------*/
-				cover_fraction += patch[0].canopy_strata[j][0].cover_fraction;
 			}
 		}
+	}
+	return;
+}
+
+void sort_patch_layers( struct patch_object *patch, int *rec)
+{
+	/*--------------------------------------------------------------*/
+	/*  Local variable definition.                                  */
+	/*--------------------------------------------------------------*/
+	int s, i, k;
+	int maxstemcID, maxleafcID;
+	double cover_fraction;
+	double maxstemc, maxleafc;
+	struct canopy_strata_object *stratum;
+	/*--------------------------------------------------------------*/
+	/*	keep the current layers if the order has not changed	*/
+	/*--------------------------------------------------------------*/
+	if (!layers_still_sorted(patch))
+		build_patch_layers(patch);
+
+	for ( i=0 ; i<patch[0].num_layers ; i++ ){
+		/*--------------------------------------------------------------*/
+		/*	assign a bottom of layer				*/
+		/*--------------------------------------------------------------*/
+		if (i != patch[0].num_layers - 1)
+			patch[0].layers[i].base = patch[0].layers[i+1].height;
+		else
+			patch[0].layers[i].base = 0.0;
+		/*--------------------------------------------------------------*/
+		/*		Keep a running total of the cover fraction in	*/
+		/*		this layer to check that it adds to 1.0		*/
+		/*--------------------------------------------------------------*/
+		cover_fraction = 0.0;
+		for ( k=0 ; k<patch[0].layers[i].count ; k++ )
+			cover_fraction += patch[0].canopy_strata[
+				patch[0].layers[i].strata[k]][0].cover_fraction;
 		/*--------------------------------------------------------------*/
 		/*		Report a fatal error if the cover fraction for	*/
 		/*		this layer does not add to 1.0			*/
@@ -182,8 +227,9 @@ void sort_patch_layers( struct patch_object *patch, int *rec)
 			patch[0].layers[i].null_cover = 0.0;
 
 			/* recursively call patch layers to fix this - should always work because we are changing the height */
-			rec += 1;
-			sort_patch_layers(patch, *rec);
+			*rec += 1;
+			sort_patch_layers(patch, rec);
+			return;
 		}
 		else {
 			patch[0].layers[i].null_cover = 1.0 - cover_fraction;
@@ -0,0 +1,527 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		subcatchment					*/
+/*								*/
+/*	subcatchment.c - the patches upstream of an outlet	*/
+/*		patch						*/
+/*								*/
+/*	NAME							*/
+/*	subcatchment.c - the patches upstream of an outlet	*/
+/*		patch						*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	construct_subcatchment(				*/
+/*			struct command_line_object *command_line) */
+/*								*/
+/*	int	patch_in_subcatchment(				*/
+/*			struct command_line_object *command_line, */
+/*			int patch_ID, int zone_ID, int hill_ID)	*/
+/*								*/
+/*	int	zone_in_subcatchment(				*/
+/*			struct command_line_object *command_line, */
+/*			int zone_ID, int hill_ID)		*/
+/*								*/
+/*	int	reach_in_subcatchment(				*/
+/*			struct command_line_object *command_line, */
+/*			int reach_ID)				*/
+/*								*/
+/*	OPTIONS							*/
+/*	-subcatchment <patch ID> <zone ID> <hill ID>		*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	construct_subcatchment reads the flow table before	*/
+/*	the world is constructed and follows its neighbour	*/
+/*	edges backwards from the outlet patch, to find every	*/
+/*	patch that drains to it.  Only those patches, their	*/
+/*	zones and their hillslopes are then constructed and	*/
+/*	simulated: the hillslopes are loaded as with		*/
+/*	-hillslopes, construct_hillslope and construct_zone	*/
+/*	skip the other zones and patches in the worldfile, and	*/
+/*	construct_routing_topology skips their flow table	*/
+/*	records.						*/
+/*								*/
+/*	An edge counts if its gamma is above zero, as in	*/
+/*	assign_neighbours_in_hillslope.  A road patch's stream	*/
+/*	patch is kept with the road.  A kept patch may still	*/
+/*	split its outflow towards a patch that is not kept;	*/
+/*	that share never reaches the outlet and leaves the	*/
+/*	model there.  A zone is left with the area of its kept	*/
+/*	patches.						*/
+/*								*/
+/*	With stream routing (-str) the outlet patch must be a	*/
+/*	lateral input of a reach.  That reach and every reach	*/
+/*	upstream of it are kept, along with all their lateral	*/
+/*	inputs and the patches draining to them, and the	*/
+/*	stream network is trimmed to those reaches.  Without	*/
+/*	-str the channel is whatever neighbour edges the flow	*/
+/*	table gives its stream patches.				*/
+/*								*/
+/*	Only the subsurface flow table, the first file of -r,	*/
+/*	is followed.  Edges of a surface flow table (the	*/
+/*	second file of -r) are not: a patch that drains to the	*/
+/*	outlet only over the surface is left out, and surface	*/
+/*	flow from a kept patch to a left-out one leaves the	*/
+/*	model.							*/
+/*								*/
+/*	The *_in_subcatchment functions are 1 without		*/
+/*	-subcatchment.						*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	Only the standard flow table format.  construct_world	*/
+/*	does not allow -subcatchment with ddn routing,		*/
+/*	-hillslopes, -firespread or netcdf climate.		*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+struct subcatchment_node_object
+	{
+	struct	subcatchment_patch_object	key;
+	struct	subcatchment_patch_object	stream; /* of a road patch */
+	int	drainage_type;
+	int	first_upstream;
+	int	num_upstream;
+	int	kept;
+	};
+
+struct subcatchment_edge_object
+	{
+	struct	subcatchment_patch_object	from;
+	struct	subcatchment_patch_object	to;
+	int	from_node;
+	};
+
+struct subcatchment_reach_object
+	{
+	int	ID;
+	int	num_lateral_inputs;
+	struct	subcatchment_patch_object	*lateral_inputs;
+	int	num_upstream;
+	int	*upstream;
+	int	kept;
+	};
+
+static int compare_patch_key(const void *a, const void *b)
+{
+	const struct subcatchment_patch_object *p = a;
+	const struct subcatchment_patch_object *q = b;
+
+	if (p[0].hill_ID != q[0].hill_ID)
+		return((p[0].hill_ID > q[0].hill_ID) - (p[0].hill_ID < q[0].hill_ID));
+	if (p[0].zone_ID != q[0].zone_ID)
+		return((p[0].zone_ID > q[0].zone_ID) - (p[0].zone_ID < q[0].zone_ID));
+	return((p[0].patch_ID > q[0].patch_ID) - (p[0].patch_ID < q[0].patch_ID));
+}
+
+/* Equal for any patch of the zone */
+static int compare_zone_key(const void *a, const void *b)
+{
+	const struct subcatchment_patch_object *p = a;
+	const struct subcatchment_patch_object *q = b;
+
+	if (p[0].hill_ID != q[0].hill_ID)
+		return((p[0].hill_ID > q[0].hill_ID) - (p[0].hill_ID < q[0].hill_ID));
+	return((p[0].zone_ID > q[0].zone_ID) - (p[0].zone_ID < q[0].zone_ID));
+}
+
+static int compare_edge_to(const void *a, const void *b)
+{
+	return(compare_patch_key(&(((const struct subcatchment_edge_object *)a)[0].to),
+		&(((const struct subcatchment_edge_object *)b)[0].to)));
+}
+
+static int compare_reach_ID(const void *a, const void *b)
+{
+	int	p = ((const struct subcatchment_reach_object *)a)[0].ID;
+	int	q = ((const struct subcatchment_reach_object *)b)[0].ID;
+
+	return((p > q) - (p < q));
+}
+
+static int compare_int(const void *a, const void *b)
+{
+	return((*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b));
+}
+
+static void *grow(void *array, int *max, size_t size)
+{
+	*max = (*max == 0) ? 1024 : 2 * *max;
+	if ((array = realloc(array, *max * size)) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot allocate sub-catchment flow table\n");
+		exit(EXIT_FAILURE);
+	}
+	return(array);
+}
+
+static struct subcatchment_node_object *find_node(struct subcatchment_node_object *nodes,
+		int num_nodes, struct subcatchment_patch_object *key)
+{
+	return((struct subcatchment_node_object *) bsearch(key, nodes, num_nodes,
+		sizeof(struct subcatchment_node_object), compare_patch_key));
+}
+
+static void flow_table_ends_early(char *routing_filename)
+{
+	fprintf(stderr,"FATAL ERROR: in construct_subcatchment, flow table %s ends early\n",
+		routing_filename);
+	exit(EXIT_FAILURE);
+}
+
+/* Every patch of the flow table and every edge with gamma above zero */
+static void read_flow_table(char *routing_filename,
+		struct subcatchment_node_object **nodes, int *num_nodes,
+		struct subcatchment_edge_object **edges, int *num_edges)
+{
+	FILE	*routing_file;
+	int	h, i, j, num_hillslopes, hill_ID, num_patches, num_neighbours;
+	int	max_nodes, max_edges;
+	double	x, y, z, area, gamma;
+	struct	subcatchment_node_object	*node;
+	struct	subcatchment_edge_object	*edge;
+
+	if ((routing_file = fopen(routing_filename, "r")) == NULL) {
+		fprintf(stderr,"FATAL ERROR:  Cannot open routing file %s\n",
+			routing_filename);
+		exit(EXIT_FAILURE);
+	}
+	*nodes = NULL;
+	*edges = NULL;
+	*num_nodes = 0;
+	*num_edges = 0;
+	max_nodes = 0;
+	max_edges = 0;
+	if (fscanf(routing_file, "%d", &num_hillslopes) != 1)
+		flow_table_ends_early(routing_filename);
+	for (h = 0; h < num_hillslopes; h++) {
+		if (fscanf(routing_file, "%d %d", &hill_ID, &num_patches) != 2)
+			flow_table_ends_early(routing_filename);
+		for (i = 0; i < num_patches; i++) {
+			if (*num_nodes == max_nodes)
+				*nodes = grow(*nodes, &max_nodes, sizeof(struct subcatchment_node_object));
+			node = &((*nodes)[(*num_nodes)++]);
+			memset(node, 0, sizeof(struct subcatchment_node_object));
+			if (fscanf(routing_file, "%d %d %d %lf %lf %lf %lf %lf %d %lf %d",
+					&(node[0].key.patch_ID),
+					&(node[0].key.zone_ID),
+					&(node[0].key.hill_ID),
+					&x, &y, &z,
+					&area,
+					&area,
+					&(node[0].drainage_type),
+					&gamma,
+					&num_neighbours) != 11)
+				flow_table_ends_early(routing_filename);
+			for (j = 0; j < num_neighbours; j++) {
+				if (*num_edges == max_edges)
+					*edges = grow(*edges, &max_edges, sizeof(struct subcatchment_edge_object));
+				edge = &((*edges)[*num_edges]);
+				edge[0].from = node[0].key;
+				if (fscanf(routing_file, "%d %d %d %lf",
+						&(edge[0].to.patch_ID),
+						&(edge[0].to.zone_ID),
+						&(edge[0].to.hill_ID),
+						&gamma) != 4)
+					flow_table_ends_early(routing_filename);
+				if (gamma > 0.0)
+					(*num_edges)++;
+			}
+			if (node[0].drainage_type == ROAD) {
+				if (fscanf(routing_file, "%d %d %d %lf",
+						&(node[0].stream.patch_ID),
+						&(node[0].stream.zone_ID),
+						&(node[0].stream.hill_ID),
+						&gamma) != 4)
+					flow_table_ends_early(routing_filename);
+			}
+		}
+	}
+	fclose(routing_file);
+}
+
+static void stream_table_ends_early(char *stream_filename)
+{
+	fprintf(stderr,"FATAL ERROR: in construct_subcatchment, stream file %s ends early\n",
+		stream_filename);
+	exit(EXIT_FAILURE);
+}
+
+/* The reaches of the stream table, sorted by ID */
+static struct subcatchment_reach_object *read_stream_table(char *stream_filename,
+		int *num_reaches)
+{
+	void	*alloc(size_t, char *, char *);
+
+	FILE	*stream_file;
+	int	i, j, num_downstream, downstream;
+	double	width;
+	struct	subcatchment_reach_object	*reaches;
+
+	if ((stream_file = fopen(stream_filename, "r")) == NULL) {
+		fprintf(stderr,"FATAL ERROR:  Cannot open stream file %s\n",
+			stream_filename);
+		exit(EXIT_FAILURE);
+	}
+	if (fscanf(stream_file, "%d", num_reaches) != 1)
+		stream_table_ends_early(stream_filename);
+	reaches = (struct subcatchment_reach_object *) alloc(
+		*num_reaches * sizeof(struct subcatchment_reach_object),
+		"reaches", "construct_subcatchment");
+	for (i = 0; i < *num_reaches; i++) {
+		if (fscanf(stream_file, "%d %lf %lf %lf %lf %lf %lf %d",
+				&(reaches[i].ID),
+				&width, &width, &width, &width, &width, &width,
+				&(reaches[i].num_lateral_inputs)) != 8)
+			stream_table_ends_early(stream_filename);
+		reaches[i].lateral_inputs = (struct subcatchment_patch_object *) alloc(
+			reaches[i].num_lateral_inputs * sizeof(struct subcatchment_patch_object),
+			"lateral_inputs", "construct_subcatchment");
+		for (j = 0; j < reaches[i].num_lateral_inputs; j++) {
+			if (fscanf(stream_file, "%d %d %d",
+					&(reaches[i].lateral_inputs[j].patch_ID),
+					&(reaches[i].lateral_inputs[j].zone_ID),
+					&(reaches[i].lateral_inputs[j].hill_ID)) != 3)
+				stream_table_ends_early(stream_filename);
+		}
+		if (fscanf(stream_file, "%d", &(reaches[i].num_upstream)) != 1)
+			stream_table_ends_early(stream_filename);
+		reaches[i].upstream = (int *) alloc(reaches[i].num_upstream * sizeof(int),
+			"upstream", "construct_subcatchment");
+		for (j = 0; j < reaches[i].num_upstream; j++) {
+			if (fscanf(stream_file, "%d", &(reaches[i].upstream[j])) != 1)
+				stream_table_ends_early(stream_filename);
+		}
+		if (fscanf(stream_file, "%d", &num_downstream) != 1)
+			stream_table_ends_early(stream_filename);
+		for (j = 0; j < num_downstream; j++) {
+			if (fscanf(stream_file, "%d", &downstream) != 1)
+				stream_table_ends_early(stream_filename);
+		}
+	}
+	fclose(stream_file);
+	qsort(reaches, *num_reaches, sizeof(struct subcatchment_reach_object), compare_reach_ID);
+	return(reaches);
+}
+
+void	construct_subcatchment(struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	void	alloc_free(void *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	i, j, k, r, num_nodes, num_edges, num_reaches, num_kept, num_stack;
+	int	num_queue;
+	int	*stack, *queue;
+	struct	subcatchment_patch_object	outlet;
+	struct	subcatchment_node_object	*nodes, *node;
+	struct	subcatchment_edge_object	*edges;
+	struct	subcatchment_reach_object	*reaches, *reach, *upstream, key;
+
+	if (command_line[0].routing_flag != 1) {
+		fprintf(stderr,"FATAL ERROR: -subcatchment needs a flow table (-r)\n");
+		exit(EXIT_FAILURE);
+	}
+	outlet.patch_ID = command_line[0].subcatchment_patch_ID;
+	outlet.zone_ID = command_line[0].subcatchment_zone_ID;
+	outlet.hill_ID = command_line[0].subcatchment_hill_ID;
+
+	/*--------------------------------------------------------------*/
+	/*	Sort the patches, and the edges by the patch they	*/
+	/*	drain to, so each patch's upstream edges are together.	*/
+	/*--------------------------------------------------------------*/
+	read_flow_table(command_line[0].routing_filename, &nodes, &num_nodes,
+		&edges, &num_edges);
+	qsort(nodes, num_nodes, sizeof(struct subcatchment_node_object), compare_patch_key);
+	for (i = 0; i < num_edges; i++) {
+		node = find_node(nodes, num_nodes, &(edges[i].from));
+		edges[i].from_node = (int) (node - nodes);
+	}
+	qsort(edges, num_edges, sizeof(struct subcatchment_edge_object), compare_edge_to);
+	for (i = 0; i < num_edges; i = j) {
+		for (j = i + 1; (j < num_edges) &&
+			(compare_patch_key(&(edges[j].to), &(edges[i].to)) == 0); j++);
+		/* Edges to patches outside the flow table lead nowhere */
+		if ((node = find_node(nodes, num_nodes, &(edges[i].to))) != NULL) {
+			node[0].first_upstream = i;
+			node[0].num_upstream = j - i;
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Seed with the outlet patch, or with -str the lateral	*/
+	/*	inputs of the outlet's reach and the reaches above it.	*/
+	/*--------------------------------------------------------------*/
+	stack = (int *) alloc(num_nodes * sizeof(int), "stack", "construct_subcatchment");
+	num_stack = 0;
+	if ((node = find_node(nodes, num_nodes, &outlet)) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Sub-catchment outlet patch %d zone %d hill %d is not in the flow table\n",
+			outlet.patch_ID, outlet.zone_ID, outlet.hill_ID);
+		exit(EXIT_FAILURE);
+	}
+	node[0].kept = 1;
+	stack[num_stack++] = (int) (node - nodes);
+	if (command_line[0].stream_routing_flag == 1) {
+		reaches = read_stream_table(command_line[0].stream_routing_filename, &num_reaches);
+		for (r = 0; r < num_reaches; r++) {
+			for (j = 0; j < reaches[r].num_lateral_inputs; j++)
+				if (compare_patch_key(&(reaches[r].lateral_inputs[j]), &outlet) == 0)
+					break;
+			if (j < reaches[r].num_lateral_inputs)
+				break;
+		}
+		if (r == num_reaches) {
+			fprintf(stderr,"FATAL ERROR: Sub-catchment outlet patch %d zone %d hill %d is not a lateral input of any stream reach\n",
+				outlet.patch_ID, outlet.zone_ID, outlet.hill_ID);
+			exit(EXIT_FAILURE);
+		}
+		command_line[0].subcatchment_reaches = (int *) alloc(num_reaches * sizeof(int),
+			"subcatchment_reaches", "construct_subcatchment");
+		queue = (int *) alloc(num_reaches * sizeof(int), "queue", "construct_subcatchment");
+		num_queue = 0;
+		reaches[r].kept = 1;
+		queue[num_queue++] = r;
+		for (i = 0; i < num_queue; i++) {
+			reach = &(reaches[queue[i]]);
+			command_line[0].subcatchment_reaches[i] = reach[0].ID;
+			for (j = 0; j < reach[0].num_upstream; j++) {
+				key.ID = reach[0].upstream[j];
+				upstream = (struct subcatchment_reach_object *) bsearch(&key, reaches,
+					num_reaches, sizeof(struct subcatchment_reach_object), compare_reach_ID);
+				if ((upstream != NULL) && (upstream[0].kept == 0)) {
+					upstream[0].kept = 1;
+					queue[num_queue++] = (int) (upstream - reaches);
+				}
+			}
+			for (j = 0; j < reach[0].num_lateral_inputs; j++) {
+				node = find_node(nodes, num_nodes, &(reach[0].lateral_inputs[j]));
+				if ((node != NULL) && (node[0].kept == 0)) {
+					node[0].kept = 1;
+					stack[num_stack++] = (int) (node - nodes);
+				}
+			}
+		}
+		command_line[0].num_subcatchment_reaches = num_queue;
+		qsort(command_line[0].subcatchment_reaches, command_line[0].num_subcatchment_reaches,
+			sizeof(int), compare_int);
+		for (r = 0; r < num_reaches; r++) {
+			alloc_free(reaches[r].lateral_inputs);
+			alloc_free(reaches[r].upstream);
+		}
+		alloc_free(reaches);
+		alloc_free(queue);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Follow the edges upstream from the seeds.		*/
+	/*--------------------------------------------------------------*/
+	while (num_stack > 0) {
+		node = &(nodes[stack[--num_stack]]);
+		for (j = 0; j < node[0].num_upstream; j++) {
+			k = edges[node[0].first_upstream + j].from_node;
+			if (nodes[k].kept == 0) {
+				nodes[k].kept = 1;
+				stack[num_stack++] = k;
+			}
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Keep each kept road's stream patch, which its road	*/
+	/*	cut drains to.						*/
+	/*--------------------------------------------------------------*/
+	for (i = 0; i < num_nodes; i++) {
+		if ((nodes[i].kept == 1) && (nodes[i].drainage_type == ROAD)) {
+			node = find_node(nodes, num_nodes, &(nodes[i].stream));
+			if (node == NULL) {
+				fprintf(stderr,"FATAL ERROR: Stream patch %d of road patch %d is not in the flow table\n",
+					nodes[i].stream.patch_ID, nodes[i].key.patch_ID);
+				exit(EXIT_FAILURE);
+			}
+			if (node[0].kept == 0)
+				node[0].kept = 2;
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	The kept patches, still sorted, and their hillslopes	*/
+	/*	for hillslope_in_subset.				*/
+	/*--------------------------------------------------------------*/
+	for (i = 0, num_kept = 0; i < num_nodes; i++)
+		if (nodes[i].kept > 0)
+			num_kept++;
+	command_line[0].subcatchment_patches = (struct subcatchment_patch_object *) alloc(
+		num_kept * sizeof(struct subcatchment_patch_object),
+		"subcatchment_patches", "construct_subcatchment");
+	command_line[0].hillslope_subset = (int *) alloc(num_kept * sizeof(int),
+		"hillslope_subset", "construct_subcatchment");
+	command_line[0].num_subcatchment_patches = 0;
+	command_line[0].num_hillslope_subset = 0;
+	for (i = 0; i < num_nodes; i++) {
+		if (nodes[i].kept == 0)
+			continue;
+		command_line[0].subcatchment_patches[command_line[0].num_subcatchment_patches++] =
+			nodes[i].key;
+		k = command_line[0].num_hillslope_subset;
+		if ((k == 0) || (command_line[0].hillslope_subset[k-1] != nodes[i].key.hill_ID))
+			command_line[0].hillslope_subset[command_line[0].num_hillslope_subset++] =
+				nodes[i].key.hill_ID;
+	}
+	printf("\n Sub-catchment of patch %d zone %d hill %d: %d of %d patches in %d hillslopes",
+		outlet.patch_ID, outlet.zone_ID, outlet.hill_ID, num_kept, num_nodes,
+		command_line[0].num_hillslope_subset);
+	if (command_line[0].stream_routing_flag == 1)
+		printf(", %d stream reaches", command_line[0].num_subcatchment_reaches);
+	printf("\n");
+
+	alloc_free(stack);
+	free(nodes);
+	free(edges);
+	return;
+} /*end construct_subcatchment*/
+
+int	patch_in_subcatchment(struct command_line_object *command_line,
+		int patch_ID, int zone_ID, int hill_ID)
+{
+	struct	subcatchment_patch_object	key;
+
+	if (command_line[0].subcatchment_flag == 0)
+		return(1);
+	key.hill_ID = hill_ID;
+	key.zone_ID = zone_ID;
+	key.patch_ID = patch_ID;
+	return(bsearch(&key, command_line[0].subcatchment_patches,
+		command_line[0].num_subcatchment_patches,
+		sizeof(struct subcatchment_patch_object), compare_patch_key) != NULL);
+} /*end patch_in_subcatchment*/
+
+int	zone_in_subcatchment(struct command_line_object *command_line,
+		int zone_ID, int hill_ID)
+{
+	struct	subcatchment_patch_object	key;
+
+	if (command_line[0].subcatchment_flag == 0)
+		return(1);
+	key.hill_ID = hill_ID;
+	key.zone_ID = zone_ID;
+	key.patch_ID = 0;
+	return(bsearch(&key, command_line[0].subcatchment_patches,
+		command_line[0].num_subcatchment_patches,
+		sizeof(struct subcatchment_patch_object), compare_zone_key) != NULL);
+} /*end zone_in_subcatchment*/
+
+int	reach_in_subcatchment(struct command_line_object *command_line,
+		int reach_ID)
+{
+	if (command_line[0].subcatchment_flag == 0)
+		return(1);
+	return(bsearch(&reach_ID, command_line[0].subcatchment_reaches,
+		command_line[0].num_subcatchment_reaches, sizeof(int),
+		compare_int) != NULL);
+} /*end reach_in_subcatchment*/
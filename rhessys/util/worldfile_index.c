@@ -0,0 +1,488 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		worldfile_index					*/
+/*								*/
+/*	worldfile_index.c - where each hillslope record starts	*/
+/*		in the worldfile				*/
+/*								*/
+/*	NAME							*/
+/*	worldfile_index.c - where each hillslope record starts	*/
+/*		in the worldfile				*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct worldfile_index_object *construct_worldfile_index( */
+/*			char *world_filename,			*/
+/*			long offset,				*/
+/*			int num_basins)				*/
+/*								*/
+/*	void	destroy_worldfile_index(			*/
+/*			struct worldfile_index_object *index)	*/
+/*								*/
+/*	int	hillslope_in_subset(				*/
+/*			struct command_line_object *command_line, */
+/*			int hillslope_ID)			*/
+/*								*/
+/*	int	peek_worldfile_ID(FILE *world_file,		*/
+/*			char *ID_name)				*/
+/*	void	skip_worldfile_zone(FILE *world_file)		*/
+/*	void	skip_worldfile_patch(FILE *world_file)		*/
+/*								*/
+/*	OPTIONS							*/
+/*	-worldindex						*/
+/*	-hillslopes <ID> [ID ...]				*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	The worldfile is nested text records, so without an	*/
+/*	index the only way to find a hillslope is to parse	*/
+/*	everything before it.  construct_worldfile_index	*/
+/*	records the byte offset of every basin and hillslope	*/
+/*	record, from offset (where construct_world is about	*/
+/*	to read the first basin), and the number of zones,	*/
+/*	patches and strata in each hillslope.  construct_basin	*/
+/*	then constructs the hillslopes in parallel, each	*/
+/*	thread reading its hillslope through its own FILE,	*/
+/*	and with -hillslopes only the listed ones.		*/
+/*								*/
+/*	The index is kept in <worldfile>.idx, with the size	*/
+/*	and FNV-1a hash of the worldfile it was made from.	*/
+/*	A sidecar that is missing, stale or unreadable is	*/
+/*	rebuilt by one pass over the worldfile and written	*/
+/*	again (through a uniquely named temporary file and	*/
+/*	rename(), so runs sharing a worldfile never see or	*/
+/*	write into half of one).  If				*/
+/*	it cannot be written the run goes on with the index	*/
+/*	in memory.						*/
+/*								*/
+/*	The pass follows the worldfile exactly as the		*/
+/*	construct_ functions read it: records are read up to	*/
+/*	their _n_basestations line, as readtag_worldfile does,	*/
+/*	and counts and base station IDs as fscanf and		*/
+/*	read_record do.  It returns NULL if the worldfile	*/
+/*	ends early.						*/
+/*								*/
+/*	hillslope_in_subset is 1 if a hillslope is to be	*/
+/*	loaded: always without -hillslopes, otherwise if its	*/
+/*	ID was listed.						*/
+/*								*/
+/*	peek_worldfile_ID reads the ID of the record about to	*/
+/*	be read without moving past it, and the skip_ functions	*/
+/*	read past a whole zone or patch record, so that		*/
+/*	-subcatchment can leave out the zones and patches	*/
+/*	outside the sub-catchment (see subcatchment.c).		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*	Gridded netcdf zones read one base station line		*/
+/*	whatever their zone_n_basestations, and construct	*/
+/*	their base stations into the world's list as they go,	*/
+/*	so construct_world does not use the index for them.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "rhessys.h"
+
+#define WORLDFILE_INDEX_VERSION 1
+#define WORLDFILE_INDEX_EXT ".idx"
+/* The line buffer readtag_worldfile reads records with */
+#define WORLDFILE_INDEX_LINE_LEN 1024
+#define WORLDFILE_INDEX_BLOCK (1024 * 1024)
+
+static int compare_subset_ID(const void *a, const void *b)
+{
+	return((*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b));
+}
+
+/* FNV-1a over the whole worldfile */
+static int hash_worldfile(char *world_filename, unsigned long long *hash, long *size)
+{
+	FILE	*world_file;
+	unsigned char	*block;
+	size_t	n, i;
+
+	if ((world_file = fopen(world_filename, "rb")) == NULL)
+		return(0);
+	block = (unsigned char *) malloc(WORLDFILE_INDEX_BLOCK);
+	if (block == NULL) {
+		fclose(world_file);
+		return(0);
+	}
+	*hash = 14695981039346656037ULL;
+	*size = 0;
+	while ((n = fread(block, 1, WORLDFILE_INDEX_BLOCK, world_file)) > 0) {
+		for (i = 0; i < n; i++) {
+			*hash ^= block[i];
+			*hash *= 1099511628211ULL;
+		}
+		*size += (long) n;
+	}
+	free(block);
+	fclose(world_file);
+	return(1);
+}
+
+/* The rest of a record, as read_record reads it */
+static void skip_record(FILE *world_file)
+{
+	int	c;
+
+	while (((c = getc(world_file)) != '\n') && (c != EOF));
+}
+
+/* A count or base station ID, as fscanf("%d") and read_record read it */
+static int scan_count(FILE *world_file, int *count)
+{
+	if (fscanf(world_file, "%d", count) != 1)
+		return(0);
+	skip_record(world_file);
+	return(1);
+}
+
+/* An object's record, as readtag_worldfile reads it, then its base stations */
+static int scan_object(FILE *world_file, char *ID_name, int *ID)
+{
+	char	line[WORLDFILE_INDEX_LINE_LEN];
+	char	value[WORLDFILE_INDEX_LINE_LEN];
+	char	name[WORLDFILE_INDEX_LINE_LEN];
+	int	num_base_stations, i, station;
+
+	while (fgets(line, sizeof line, world_file) != NULL) {
+		value[0] = '\0';
+		name[0] = '\0';
+		sscanf(line, "%s %s", value, name);
+		if (strcmp(name, ID_name) == 0)
+			*ID = atoi(value);
+		if ((strcmp(name, "basin_n_basestations") == 0) ||
+				(strcmp(name, "hillslope_n_basestations") == 0) ||
+				(strcmp(name, "zone_n_basestations") == 0) ||
+				(strcmp(name, "patch_n_basestations") == 0) ||
+				(strcmp(name, "canopy_strata_n_basestations") == 0)) {
+			num_base_stations = atoi(value);
+			for (i = 0; i < num_base_stations; i++)
+				if (scan_count(world_file, &station) == 0)
+					return(0);
+			return(1);
+		}
+	}
+	return(0);
+}
+
+/* A patch and its strata, adding the strata to *num_strata */
+static int scan_patch(FILE *world_file, int *num_strata)
+{
+	int	s, ID, num_patch_strata;
+
+	if ((scan_object(world_file, "patch_ID", &ID) == 0) ||
+			(scan_count(world_file, &num_patch_strata) == 0))
+		return(0);
+	*num_strata += num_patch_strata;
+	for (s = 0; s < num_patch_strata; s++)
+		if (scan_object(world_file, "canopy_strata_ID", &ID) == 0)
+			return(0);
+	return(1);
+}
+
+/* A zone and its patches, adding them to *num_patches and *num_strata */
+static int scan_zone(FILE *world_file, int *num_patches, int *num_strata)
+{
+	int	p, ID, num_zone_patches;
+
+	if ((scan_object(world_file, "zone_ID", &ID) == 0) ||
+			(scan_count(world_file, &num_zone_patches) == 0))
+		return(0);
+	*num_patches += num_zone_patches;
+	for (p = 0; p < num_zone_patches; p++)
+		if (scan_patch(world_file, num_strata) == 0)
+			return(0);
+	return(1);
+}
+
+static int scan_hillslope(FILE *world_file, struct hillslope_index_object *hillslope)
+{
+	int	z;
+
+	hillslope[0].offset = ftell(world_file);
+	hillslope[0].num_patches = 0;
+	hillslope[0].num_strata = 0;
+	if ((scan_object(world_file, "hillslope_ID", &(hillslope[0].ID)) == 0) ||
+			(scan_count(world_file, &(hillslope[0].num_zones)) == 0))
+		return(0);
+	for (z = 0; z < hillslope[0].num_zones; z++)
+		if (scan_zone(world_file, &(hillslope[0].num_patches),
+				&(hillslope[0].num_strata)) == 0)
+			return(0);
+	return(1);
+}
+
+static struct worldfile_index_object *scan_worldfile(char *world_filename,
+		long offset, int num_basins)
+{
+	void	*alloc(size_t, char *, char *);
+	void	destroy_worldfile_index(struct worldfile_index_object *);
+
+	FILE	*world_file;
+	int	b, h;
+	struct	worldfile_index_object	*index;
+	struct	basin_index_object	*basin;
+
+	if ((world_file = fopen(world_filename, "r")) == NULL)
+		return(NULL);
+	index = (struct worldfile_index_object *) alloc(1 *
+		sizeof(struct worldfile_index_object), "index", "scan_worldfile");
+	index[0].offset = offset;
+	index[0].num_basins = num_basins;
+	index[0].basins = (struct basin_index_object *) alloc(num_basins *
+		sizeof(struct basin_index_object), "basins", "scan_worldfile");
+	fseek(world_file, offset, SEEK_SET);
+	for (b = 0; b < num_basins; b++) {
+		basin = &(index[0].basins[b]);
+		basin[0].offset = ftell(world_file);
+		if ((scan_object(world_file, "basin_ID", &(basin[0].ID)) == 0) ||
+				(scan_count(world_file, &(basin[0].num_hillslopes)) == 0) ||
+				(basin[0].num_hillslopes < 0)) {
+			index[0].num_basins = b;
+			break;
+		}
+		basin[0].hillslopes = (struct hillslope_index_object *) alloc(
+			basin[0].num_hillslopes * sizeof(struct hillslope_index_object),
+			"hillslopes", "scan_worldfile");
+		for (h = 0; h < basin[0].num_hillslopes; h++)
+			if (scan_hillslope(world_file, &(basin[0].hillslopes[h])) == 0)
+				break;
+		if (h < basin[0].num_hillslopes) {
+			index[0].num_basins = b + 1;
+			break;
+		}
+		basin[0].end_offset = ftell(world_file);
+	}
+	fclose(world_file);
+	if (b < num_basins) {
+		destroy_worldfile_index(index);
+		return(NULL);
+	}
+	return(index);
+}
+
+static struct worldfile_index_object *read_worldfile_index(char *index_filename,
+		unsigned long long hash, long size, long offset, int num_basins)
+{
+	void	*alloc(size_t, char *, char *);
+	void	destroy_worldfile_index(struct worldfile_index_object *);
+
+	FILE	*index_file;
+	char	label[WORLDFILE_INDEX_LINE_LEN];
+	int	version, b, h, ok;
+	struct	worldfile_index_object	*index;
+	struct	basin_index_object	*basin;
+	struct	hillslope_index_object	*hillslope;
+
+	if ((index_file = fopen(index_filename, "r")) == NULL)
+		return(NULL);
+	index = (struct worldfile_index_object *) alloc(1 *
+		sizeof(struct worldfile_index_object), "index", "read_worldfile_index");
+	ok = (fscanf(index_file, "%1023s %d %llx %ld %ld %d", label, &version,
+			&(index[0].hash), &(index[0].size), &(index[0].offset),
+			&(index[0].num_basins)) == 6) &&
+		(strcmp(label, "rhessys_worldfile_index") == 0) &&
+		(version == WORLDFILE_INDEX_VERSION) &&
+		(index[0].hash == hash) && (index[0].size == size) &&
+		(index[0].offset == offset) && (index[0].num_basins == num_basins);
+	if (!ok)
+		index[0].num_basins = 0;
+	else
+		index[0].basins = (struct basin_index_object *) alloc(num_basins *
+			sizeof(struct basin_index_object), "basins", "read_worldfile_index");
+	for (b = 0; ok && (b < index[0].num_basins); b++) {
+		basin = &(index[0].basins[b]);
+		ok = (fscanf(index_file, "%d %ld %ld %d", &(basin[0].ID), &(basin[0].offset),
+			&(basin[0].end_offset), &(basin[0].num_hillslopes)) == 4) &&
+			(basin[0].num_hillslopes >= 0);
+		if (!ok) {
+			index[0].num_basins = b;
+			break;
+		}
+		basin[0].hillslopes = (struct hillslope_index_object *) alloc(
+			basin[0].num_hillslopes * sizeof(struct hillslope_index_object),
+			"hillslopes", "read_worldfile_index");
+		for (h = 0; ok && (h < basin[0].num_hillslopes); h++) {
+			hillslope = &(basin[0].hillslopes[h]);
+			ok = (fscanf(index_file, "%d %ld %d %d %d", &(hillslope[0].ID),
+				&(hillslope[0].offset), &(hillslope[0].num_zones),
+				&(hillslope[0].num_patches), &(hillslope[0].num_strata)) == 5);
+		}
+		if (!ok)
+			index[0].num_basins = b + 1;
+	}
+	fclose(index_file);
+	if (!ok) {
+		destroy_worldfile_index(index);
+		return(NULL);
+	}
+	return(index);
+}
+
+static int write_worldfile_index(char *index_filename, struct worldfile_index_object *index)
+{
+	FILE	*index_file;
+	char	*tmp_filename;
+	int	b, h, ok, fd;
+	struct	basin_index_object	*basin;
+	struct	hillslope_index_object	*hillslope;
+
+	/*--------------------------------------------------------------*/
+	/*	Each run writes its own temporary file, so runs indexing	*/
+	/*	the same worldfile at once cannot interleave their writes.	*/
+	/*--------------------------------------------------------------*/
+	tmp_filename = (char *) malloc(strlen(index_filename) + 8);
+	if (tmp_filename == NULL)
+		return(0);
+	sprintf(tmp_filename, "%s.XXXXXX", index_filename);
+	if ((fd = mkstemp(tmp_filename)) < 0) {
+		free(tmp_filename);
+		return(0);
+	}
+	/* mkstemp creates the file readable by its owner only */
+	fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if ((index_file = fdopen(fd, "w")) == NULL) {
+		close(fd);
+		remove(tmp_filename);
+		free(tmp_filename);
+		return(0);
+	}
+	fprintf(index_file, "rhessys_worldfile_index %d\n%016llx %ld %ld %d\n",
+		WORLDFILE_INDEX_VERSION, index[0].hash, index[0].size, index[0].offset,
+		index[0].num_basins);
+	for (b = 0; b < index[0].num_basins; b++) {
+		basin = &(index[0].basins[b]);
+		fprintf(index_file, "%d %ld %ld %d\n", basin[0].ID, basin[0].offset,
+			basin[0].end_offset, basin[0].num_hillslopes);
+		for (h = 0; h < basin[0].num_hillslopes; h++) {
+			hillslope = &(basin[0].hillslopes[h]);
+			fprintf(index_file, "%d %ld %d %d %d\n", hillslope[0].ID,
+				hillslope[0].offset, hillslope[0].num_zones,
+				hillslope[0].num_patches, hillslope[0].num_strata);
+		}
+	}
+	ok = (ferror(index_file) == 0);
+	ok = (fclose(index_file) == 0) && ok;
+	ok = ok && (rename(tmp_filename, index_filename) == 0);
+	if (!ok)
+		remove(tmp_filename);
+	free(tmp_filename);
+	return(ok);
+}
+
+struct worldfile_index_object *construct_worldfile_index(char *world_filename,
+		long offset, int num_basins)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	void	alloc_free(void *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	char	*index_filename;
+	long	size;
+	unsigned long long	hash;
+	struct	worldfile_index_object	*index;
+
+	if (hash_worldfile(world_filename, &hash, &size) == 0)
+		return(NULL);
+	index_filename = (char *) alloc((strlen(world_filename) +
+		strlen(WORLDFILE_INDEX_EXT) + 1) * sizeof(char),
+		"index_filename", "construct_worldfile_index");
+	sprintf(index_filename, "%s%s", world_filename, WORLDFILE_INDEX_EXT);
+
+	index = read_worldfile_index(index_filename, hash, size, offset, num_basins);
+	if (index != NULL) {
+		printf("\n Read worldfile index %s\n", index_filename);
+	}
+	else {
+		printf("\n Indexing worldfile %s\n", world_filename);
+		index = scan_worldfile(world_filename, offset, num_basins);
+		if (index != NULL) {
+			index[0].hash = hash;
+			index[0].size = size;
+			if (write_worldfile_index(index_filename, index) == 0)
+				fprintf(stderr, "WARNING: Cannot write worldfile index %s\n",
+					index_filename);
+		}
+	}
+	alloc_free(index_filename);
+	return(index);
+} /*end construct_worldfile_index*/
+
+void	destroy_worldfile_index(struct worldfile_index_object *index)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	alloc_free(void *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	b;
+
+	if (index == NULL) return;
+	for (b = 0; b < index[0].num_basins; b++)
+		alloc_free(index[0].basins[b].hillslopes);
+	alloc_free(index[0].basins);
+	alloc_free(index);
+} /*end destroy_worldfile_index*/
+
+int	hillslope_in_subset(struct command_line_object *command_line,
+		int hillslope_ID)
+{
+	if (command_line[0].num_hillslope_subset == 0)
+		return(1);
+	return(bsearch(&hillslope_ID, command_line[0].hillslope_subset,
+		command_line[0].num_hillslope_subset, sizeof(int),
+		compare_subset_ID) != NULL);
+} /*end hillslope_in_subset*/
+
+int	peek_worldfile_ID(FILE *world_file, char *ID_name)
+{
+	long	offset;
+	int	ID;
+
+	offset = ftell(world_file);
+	ID = -9999;
+	if (scan_object(world_file, ID_name, &ID) == 0) {
+		fprintf(stderr,"FATAL ERROR: in peek_worldfile_ID, worldfile ends before %s\n",
+			ID_name);
+		exit(EXIT_FAILURE);
+	}
+	fseek(world_file, offset, SEEK_SET);
+	return(ID);
+} /*end peek_worldfile_ID*/
+
+void	skip_worldfile_zone(FILE *world_file)
+{
+	int	num_patches, num_strata;
+
+	num_patches = 0;
+	num_strata = 0;
+	if (scan_zone(world_file, &num_patches, &num_strata) == 0) {
+		fprintf(stderr,"FATAL ERROR: in skip_worldfile_zone, worldfile ends early\n");
+		exit(EXIT_FAILURE);
+	}
+} /*end skip_worldfile_zone*/
+
+void	skip_worldfile_patch(FILE *world_file)
+{
+	int	num_strata;
+
+	num_strata = 0;
+	if (scan_patch(world_file, &num_strata) == 0) {
+		fprintf(stderr,"FATAL ERROR: in skip_worldfile_patch, worldfile ends early\n");
+		exit(EXIT_FAILURE);
+	}
+} /*end skip_worldfile_patch*/